@@ -1626,6 +1626,20 @@ show_ring(char *name)
 	rte_ring_list_dump(stdout);
 }
 
+static void
+show_mempool_chunk(struct rte_mempool *mp __rte_unused, void *opaque __rte_unused,
+		struct rte_mempool_memhdr *memhdr, unsigned int mem_idx)
+{
+	struct rte_mempool_mem_locality loc;
+
+	if (rte_mempool_mem_locality_get(memhdr, &loc) < 0)
+		return;
+	printf("  - chunk %u: len %zu socket %d page size %" PRIu64
+		" pages %u IOVA contiguous (%c)\n",
+		mem_idx, memhdr->len, loc.socket_id, loc.page_sz,
+		loc.nb_pages, loc.iova_contig ? 'y' : 'n');
+}
+
 static void
 show_mempool(char *name)
 {
@@ -1637,6 +1651,7 @@ show_mempool(char *name)
 		if (ptr != NULL) {
 			struct rte_mempool_ops *ops;
 			uint64_t flags = ptr->flags;
+			uint64_t samples, remote;
 
 			ops = rte_mempool_get_ops(ptr->ops_index);
 			printf("  - Name: %s on socket %d\n"
@@ -1672,6 +1687,12 @@ show_mempool(char *name)
 				rte_mempool_in_use_count(ptr));
 			printf("  - ops_index %d ops_name %s\n",
 				ptr->ops_index, ops ? ops->name : "NA");
+			rte_mempool_mem_iter(ptr, show_mempool_chunk, NULL);
+			if (rte_mempool_locality_stats_get(ptr, &samples,
+					&remote) == 0)
+				printf("  - sampled objects %" PRIu64
+					", not on lcore socket %" PRIu64 "\n",
+					samples, remote);
 
 			return;
 		}
@@ -41,6 +41,8 @@
 #define	OPT_ITER_NUM		"iter"
 #define	OPT_VERBOSE		"verbose"
 #define	OPT_IPV6		"ipv6"
+#define	OPT_INC_SHARDS		"incshards"
+#define	OPT_INC_UPDATES		"incupdates"
 
 #define	TRACE_DEFAULT_NUM	0x10000
 #define	TRACE_STEP_MAX		0x1000
@@ -48,6 +50,8 @@
 
 #define	RULE_NUM		0x10000
 
+#define	INC_UPDATES_DEF		0x10
+
 #define COMMENT_LEAD_CHAR	'#'
 
 enum {
@@ -113,10 +117,15 @@ static struct {
 	uint32_t            iter_num;
 	uint32_t            verbose;
 	uint32_t            ipv6;
+	uint32_t            inc_shards;
+	uint32_t            inc_updates;
 	struct acl_alg      alg;
 	uint32_t            used_traces;
 	void               *traces;
 	struct rte_acl_ctx *acx;
+	struct rte_acl_inc *inc;
+	uint32_t            nb_inc_rules;
+	void               *inc_rules;
 } config = {
 	.bld_categories = 3,
 	.run_categories = 1,
@@ -130,6 +139,7 @@ static struct {
 		.alg = RTE_ACL_CLASSIFY_DEFAULT,
 	},
 	.ipv6 = IPV6_FRMT_NONE,
+	.inc_updates = INC_UPDATES_DEF,
 };
 
 static struct rte_acl_param prm = {
@@ -943,7 +953,21 @@ add_cb_rules(FILE *f, struct rte_acl_ctx *ctx)
 		v.data.priority = RTE_ACL_MAX_PRIORITY - n;
 		v.data.userdata = n;
 
-		rc = rte_acl_add_rules(ctx, (struct rte_acl_rule *)&v, 1);
+		/* remember first rules to update incremental object with. */
+		if (config.inc_rules != NULL &&
+				config.nb_inc_rules != config.inc_updates) {
+			memcpy((uint8_t *)config.inc_rules +
+				config.nb_inc_rules * prm.rule_size, &v,
+				prm.rule_size);
+			config.nb_inc_rules++;
+		}
+
+		if (config.inc != NULL)
+			rc = rte_acl_inc_add_rules(config.inc,
+				(struct rte_acl_rule *)&v, 1);
+		else
+			rc = rte_acl_add_rules(ctx, (struct rte_acl_rule *)&v,
+				1);
 		if (rc != 0) {
 			RTE_LOG(ERR, TESTACL, "line %u: failed to add rules "
 				"into ACL context, error code: %d (%s)\n",
@@ -955,11 +979,122 @@ add_cb_rules(FILE *f, struct rte_acl_ctx *ctx)
 	return 0;
 }
 
+static void
+inc_dump(const char *msg, int ret, uint64_t tm)
+{
+	struct rte_acl_inc_stats st;
+
+	rte_acl_inc_get_stats(config.inc, &st);
+	dump_verbose(DUMP_NONE, stdout,
+		"%s finished with %d, %" PRIu64 " cycles (%.2Lf sec), "
+		"rules: %u, sub-contexts: %u/%u, mem_size: %zu\n",
+		msg, ret, tm, (long double)tm / rte_get_timer_hz(),
+		st.num_rules, st.num_built, st.num_shards, st.mem_size);
+}
+
+/*
+ * Delete and add back some rules of the incremental ACL object,
+ * measuring how long it takes to commit each change.
+ */
+static void
+inc_update(void)
+{
+	int ret;
+	uint64_t tm;
+	char msg[64];
+
+	if (config.nb_inc_rules == 0)
+		return;
+
+	ret = rte_acl_inc_del_rules(config.inc, config.inc_rules,
+		config.nb_inc_rules);
+	if (ret != 0)
+		rte_exit(ret, "failed to delete rules from ACL object\n");
+
+	tm = rte_rdtsc_precise();
+	ret = rte_acl_inc_commit(config.inc);
+	tm = rte_rdtsc_precise() - tm;
+
+	snprintf(msg, sizeof(msg), "rte_acl_inc_commit(-%u rules)",
+		config.nb_inc_rules);
+	inc_dump(msg, ret, tm);
+	if (ret != 0)
+		rte_exit(ret, "failed to commit ACL object\n");
+
+	ret = rte_acl_inc_add_rules(config.inc, config.inc_rules,
+		config.nb_inc_rules);
+	if (ret != 0)
+		rte_exit(ret, "failed to add rules into ACL object\n");
+
+	tm = rte_rdtsc_precise();
+	ret = rte_acl_inc_commit(config.inc);
+	tm = rte_rdtsc_precise() - tm;
+
+	snprintf(msg, sizeof(msg), "rte_acl_inc_commit(+%u rules)",
+		config.nb_inc_rules);
+	inc_dump(msg, ret, tm);
+	if (ret != 0)
+		rte_exit(ret, "failed to commit ACL object\n");
+}
+
+static void
+inc_init(const struct rte_acl_config *cfg)
+{
+	int ret;
+	FILE *f;
+	uint64_t tm;
+	struct rte_acl_inc_param iprm;
+
+	iprm.name = prm.name;
+	iprm.socket_id = prm.socket_id;
+	iprm.rule_size = prm.rule_size;
+	iprm.max_rule_num = prm.max_rule_num;
+	iprm.num_shards = config.inc_shards;
+	iprm.cfg = cfg;
+
+	config.inc = rte_acl_inc_create(&iprm);
+	if (config.inc == NULL)
+		rte_exit(rte_errno, "failed to create incremental ACL object\n");
+
+	if (config.inc_updates != 0) {
+		config.inc_rules = rte_zmalloc("inc_rules",
+			(size_t)config.inc_updates * prm.rule_size,
+			RTE_CACHE_LINE_SIZE);
+		if (config.inc_rules == NULL)
+			rte_exit(-ENOMEM, "failed to allocate %u rules\n",
+				config.inc_updates);
+	}
+
+	/* add ACL rules. */
+	f = fopen(config.rule_file, "r");
+	if (f == NULL)
+		rte_exit(-EINVAL, "failed to open file %s\n",
+			config.rule_file);
+
+	ret = add_cb_rules(f, NULL);
+	if (ret != 0)
+		rte_exit(ret, "failed to add rules into ACL object\n");
+
+	fclose(f);
+
+	/* perform initial build of all sub-contexts. */
+	tm = rte_rdtsc_precise();
+	ret = rte_acl_inc_commit(config.inc);
+	tm = rte_rdtsc_precise() - tm;
+
+	inc_dump("rte_acl_inc_commit(initial)", ret, tm);
+	if (ret != 0)
+		rte_exit(ret, "failed to build incremental ACL object\n");
+
+	inc_update();
+}
+
 static void
 acx_init(void)
 {
 	int ret;
 	FILE *f;
+	uint64_t tm;
 	struct rte_acl_config cfg;
 
 	memset(&cfg, 0, sizeof(cfg));
@@ -982,6 +1117,11 @@ acx_init(void)
 	prm.rule_size = RTE_ACL_RULE_SZ(cfg.num_fields);
 	prm.max_rule_num = config.nb_rules;
 
+	if (config.inc_shards != 0) {
+		inc_init(&cfg);
+		return;
+	}
+
 	config.acx = rte_acl_create(&prm);
 	if (config.acx == NULL)
 		rte_exit(rte_errno, "failed to create ACL context\n");
@@ -1007,11 +1147,15 @@ acx_init(void)
 	fclose(f);
 
 	/* perform build. */
+	tm = rte_rdtsc_precise();
 	ret = rte_acl_build(config.acx, &cfg);
+	tm = rte_rdtsc_precise() - tm;
 
 	dump_verbose(DUMP_NONE, stdout,
-		"rte_acl_build(%u) finished with %d\n",
-		config.bld_categories, ret);
+		"rte_acl_build(%u) finished with %d, "
+		"%" PRIu64 " cycles (%.2Lf sec)\n",
+		config.bld_categories, ret, tm,
+		(long double)tm / rte_get_timer_hz());
 
 	rte_acl_dump(config.acx);
 
@@ -1037,8 +1181,12 @@ search_ip5tuples_once(uint32_t categories, uint32_t step, const char *alg)
 			v += config.trace_sz;
 		}
 
-		ret = rte_acl_classify(config.acx, data, results,
-			n, categories);
+		if (config.inc != NULL)
+			ret = rte_acl_inc_classify(config.inc, data, results,
+				n, categories);
+		else
+			ret = rte_acl_classify(config.acx, data, results,
+				n, categories);
 
 		if (ret != 0)
 			rte_exit(ret, "classify for ipv%c_5tuples returns %d\n",
@@ -1194,7 +1342,13 @@ print_usage(const char *prgname)
 		"[--" OPT_ITER_NUM "=<number of iterations to perform>]\n"
 		"[--" OPT_VERBOSE "=<verbose level>]\n"
 		"[--" OPT_SEARCH_ALG "=%s]\n"
-		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n",
+		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n"
+		"[--" OPT_INC_SHARDS
+			"=<number of sub-contexts for incremental updates> "
+			"leave 0 to use single ACL context]\n"
+		"[--" OPT_INC_UPDATES
+			"=<number of rules to delete and add back "
+			"in incremental mode>]\n",
 		prgname, RTE_ACL_RESULTS_MULTIPLIER,
 		(uint32_t)RTE_ACL_MAX_CATEGORIES,
 		buf);
@@ -1217,6 +1371,8 @@ dump_config(FILE *f)
 	fprintf(f, "%s:%u(%s)\n", OPT_SEARCH_ALG, config.alg.alg,
 		config.alg.name);
 	fprintf(f, "%s:%u\n", OPT_IPV6, config.ipv6);
+	fprintf(f, "%s:%u\n", OPT_INC_SHARDS, config.inc_shards);
+	fprintf(f, "%s:%u\n", OPT_INC_UPDATES, config.inc_updates);
 }
 
 static void
@@ -1246,6 +1402,8 @@ get_input_opts(int argc, char **argv)
 		{OPT_VERBOSE, 1, 0, 0},
 		{OPT_SEARCH_ALG, 1, 0, 0},
 		{OPT_IPV6, 2, 0, 0},
+		{OPT_INC_SHARDS, 1, 0, 0},
+		{OPT_INC_UPDATES, 1, 0, 0},
 		{NULL, 0, 0, 0}
 	};
 
@@ -1297,6 +1455,14 @@ get_input_opts(int argc, char **argv)
 			config.ipv6 = IPV6_FRMT_U32;
 			if (optarg != NULL)
 				get_ipv6_opt(optarg, lgopts[opt_idx].name);
+		} else if (strcmp(lgopts[opt_idx].name, OPT_INC_SHARDS) == 0) {
+			config.inc_shards = get_ulong_opt(optarg,
+				lgopts[opt_idx].name, 0,
+				RTE_ACL_INC_MAX_SHARDS);
+		} else if (strcmp(lgopts[opt_idx].name,
+				OPT_INC_UPDATES) == 0) {
+			config.inc_updates = get_ulong_opt(optarg,
+				lgopts[opt_idx].name, 0, RTE_ACL_MAX_INDEX);
 		}
 	}
 	config.trace_sz = config.ipv6 ? sizeof(struct ipv6_5tuple) :
@@ -1335,6 +1501,8 @@ main(int argc, char **argv)
 
 	rte_eal_mp_wait_lcore();
 
+	rte_acl_inc_free(config.inc);
+	rte_free(config.inc_rules);
 	rte_acl_free(config.acx);
 	return 0;
 }
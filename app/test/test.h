@@ -176,6 +176,7 @@ int command_valid(const char *cmd);
 
 int test_mp_secondary(void);
 int test_timer_secondary(void);
+int test_malloc_zero_reserve(void);
 
 int test_set_rxtx_conf(cmdline_fixed_string_t mode);
 int test_set_rxtx_anchor(cmdline_fixed_string_t type);
@@ -1722,6 +1722,189 @@ test_u32_range(void)
 	return rc;
 }
 
+/*
+ * Check results of incremental ACL lookup.
+ * If expect_match is zero, no rule is expected to match.
+ */
+static int
+test_inc_classify(const struct rte_acl_inc *inc, struct ipv4_7tuple test_data[],
+	size_t dim, int expect_match)
+{
+	int32_t ret;
+	uint32_t i, allow, deny;
+	const uint8_t *data[dim];
+	uint32_t results[dim * RTE_ACL_MAX_CATEGORIES];
+
+	bswap_test_data(test_data, dim, 1);
+	for (i = 0; i < dim; i++)
+		data[i] = (uint8_t *)&test_data[i];
+
+	ret = rte_acl_inc_classify(inc, data, results, dim,
+		RTE_ACL_MAX_CATEGORIES);
+	bswap_test_data(test_data, dim, 0);
+	if (ret != 0) {
+		printf("Line %i: incremental classify failed!\n", __LINE__);
+		return ret;
+	}
+
+	for (i = 0; i < dim; i++) {
+		allow = expect_match ? test_data[i].allow : 0;
+		deny = expect_match ? test_data[i].deny : 0;
+		if (results[i * RTE_ACL_MAX_CATEGORIES + ACL_ALLOW] != allow ||
+				results[i * RTE_ACL_MAX_CATEGORIES + ACL_DENY] !=
+				deny) {
+			printf("Line %i: Error in results at %i "
+				"(expected %"PRIu32"/%"PRIu32
+				" got %"PRIu32"/%"PRIu32")!\n",
+				__LINE__, i, allow, deny,
+				results[i * RTE_ACL_MAX_CATEGORIES + ACL_ALLOW],
+				results[i * RTE_ACL_MAX_CATEGORIES + ACL_DENY]);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Add, delete and re-add rules of an incremental ACL object,
+ * checking lookup results after each commit.
+ */
+static int
+test_incremental(void)
+{
+	struct rte_acl_inc_param param;
+	struct rte_acl_inc_stats stats;
+	struct rte_acl_config cfg;
+	struct rte_acl_inc *inc;
+	struct acl_ipv4vlan_rule r;
+	uint32_t i, half;
+	int32_t rc;
+
+	memset(&cfg, 0, sizeof(cfg));
+	convert_config(&cfg);
+
+	param.name = "acl_inc";
+	param.socket_id = SOCKET_ID_ANY;
+	param.rule_size = RTE_ACL_IPV4VLAN_RULE_SZ;
+	param.max_rule_num = RTE_DIM(acl_test_rules);
+	param.num_shards = 4;
+	param.cfg = &cfg;
+
+	inc = rte_acl_inc_create(&param);
+	if (inc == NULL) {
+		printf("Line %i: Error creating incremental ACL!\n", __LINE__);
+		return -1;
+	}
+
+	/* nothing committed yet */
+	rc = test_inc_classify(inc, acl_test_data, RTE_DIM(acl_test_data), 0);
+	if (rc != 0)
+		goto exit;
+
+	for (i = 0; i != RTE_DIM(acl_test_rules); i++) {
+		memset(&r, 0, sizeof(r));
+		convert_rule(acl_test_rules + i, &r);
+		rc = rte_acl_inc_add_rules(inc, (struct rte_acl_rule *)&r, 1);
+		if (rc != 0) {
+			printf("Line %i: Adding rule %u failed: %d\n",
+				__LINE__, i, rc);
+			goto exit;
+		}
+	}
+
+	/* no room left */
+	rc = rte_acl_inc_add_rules(inc, (struct rte_acl_rule *)&r, 1);
+	if (rc != -ENOMEM) {
+		printf("Line %i: Adding rule over the limit didn't fail!\n",
+			__LINE__);
+		rc = -1;
+		goto exit;
+	}
+
+	rc = rte_acl_inc_commit(inc);
+	if (rc != 0) {
+		printf("Line %i: Commit failed: %d\n", __LINE__, rc);
+		goto exit;
+	}
+
+	rc = test_inc_classify(inc, acl_test_data, RTE_DIM(acl_test_data), 1);
+	if (rc != 0)
+		goto exit;
+
+	rc = rte_acl_inc_get_stats(inc, &stats);
+	if (rc != 0 || stats.num_rules != RTE_DIM(acl_test_rules) ||
+			stats.num_dirty != 0 || stats.mem_size == 0) {
+		printf("Line %i: Invalid incremental ACL stats!\n", __LINE__);
+		rc = -1;
+		goto exit;
+	}
+
+	/* delete all rules, in two commits */
+	half = RTE_DIM(acl_test_rules) / 2;
+	for (i = 0; i != RTE_DIM(acl_test_rules); i++) {
+		memset(&r, 0, sizeof(r));
+		convert_rule(acl_test_rules + i, &r);
+		rc = rte_acl_inc_del_rules(inc, (struct rte_acl_rule *)&r, 1);
+		if (rc != 0) {
+			printf("Line %i: Deleting rule %u failed: %d\n",
+				__LINE__, i, rc);
+			goto exit;
+		}
+		if (i == half) {
+			rc = rte_acl_inc_commit(inc);
+			if (rc != 0) {
+				printf("Line %i: Commit failed: %d\n",
+					__LINE__, rc);
+				goto exit;
+			}
+		}
+	}
+
+	/* deleted rule is not found anymore */
+	rc = rte_acl_inc_del_rules(inc, (struct rte_acl_rule *)&r, 1);
+	if (rc != -ENOENT) {
+		printf("Line %i: Deleting missing rule didn't fail!\n",
+			__LINE__);
+		rc = -1;
+		goto exit;
+	}
+
+	rc = rte_acl_inc_commit(inc);
+	if (rc != 0) {
+		printf("Line %i: Commit failed: %d\n", __LINE__, rc);
+		goto exit;
+	}
+
+	rc = test_inc_classify(inc, acl_test_data, RTE_DIM(acl_test_data), 0);
+	if (rc != 0)
+		goto exit;
+
+	/* add rules back in reverse order */
+	for (i = RTE_DIM(acl_test_rules); i != 0; i--) {
+		memset(&r, 0, sizeof(r));
+		convert_rule(acl_test_rules + i - 1, &r);
+		rc = rte_acl_inc_add_rules(inc, (struct rte_acl_rule *)&r, 1);
+		if (rc != 0) {
+			printf("Line %i: Adding rule %u failed: %d\n",
+				__LINE__, i - 1, rc);
+			goto exit;
+		}
+	}
+
+	rc = rte_acl_inc_commit(inc);
+	if (rc != 0) {
+		printf("Line %i: Commit failed: %d\n", __LINE__, rc);
+		goto exit;
+	}
+
+	rc = test_inc_classify(inc, acl_test_data, RTE_DIM(acl_test_data), 1);
+
+exit:
+	rte_acl_inc_free(inc);
+	return rc;
+}
+
 static int
 test_acl(void)
 {
@@ -1743,6 +1926,8 @@ test_acl(void)
 		return -1;
 	if (test_u32_range() < 0)
 		return -1;
+	if (test_incremental() < 0)
+		return -1;
 
 	return 0;
 }
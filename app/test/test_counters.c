@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_counters.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+
+#include "test.h"
+
+#define COUNTERS_ITER	10000
+
+static const char * const counter_names[] = { "packets", "bytes" };
+
+static struct rte_counters *test_set;
+
+static int
+counters_worker(void *arg __rte_unused)
+{
+	unsigned int i;
+
+	for (i = 0; i < COUNTERS_ITER; i++) {
+		rte_counters_inc(test_set, 0);
+		rte_counters_add(test_set, 1, 64);
+	}
+	return 0;
+}
+
+static int
+test_counters_create(void)
+{
+	static const char * const bad_names[] = { "ok", NULL };
+	char long_name[RTE_COUNTERS_NAMESIZE + 1];
+
+	RTE_TEST_ASSERT_NULL(rte_counters_create(NULL, counter_names, 2),
+			"created without name");
+	RTE_TEST_ASSERT_NULL(rte_counters_create("test_bad", counter_names, 0),
+			"created without counter");
+	RTE_TEST_ASSERT_NULL(rte_counters_create("test_bad", bad_names, 2),
+			"created with a NULL counter name");
+	memset(long_name, 'a', sizeof(long_name) - 1);
+	long_name[sizeof(long_name) - 1] = '\0';
+	RTE_TEST_ASSERT_NULL(rte_counters_create(long_name, counter_names, 2),
+			"created with a too long name");
+	RTE_TEST_ASSERT_EQUAL(rte_errno, EINVAL, "wrong errno");
+
+	if (test_set == NULL)
+		test_set = rte_counters_create("test_counters", counter_names,
+				RTE_DIM(counter_names));
+	RTE_TEST_ASSERT_NOT_NULL(test_set, "cannot create counter set");
+	RTE_TEST_ASSERT_NULL(rte_counters_create("test_counters",
+			counter_names, 1), "created a duplicate");
+	RTE_TEST_ASSERT_EQUAL(rte_errno, EEXIST, "wrong errno");
+
+	RTE_TEST_ASSERT_EQUAL(rte_counters_lookup("test_counters"), test_set,
+			"lookup failed");
+	RTE_TEST_ASSERT_NULL(rte_counters_lookup("test_none"),
+			"found an unknown counter set");
+	RTE_TEST_ASSERT_EQUAL(rte_counters_count(test_set), 2, "wrong count");
+	RTE_TEST_ASSERT_EQUAL(strcmp(rte_counters_name(test_set, 1), "bytes"),
+			0, "wrong name");
+	RTE_TEST_ASSERT_NULL(rte_counters_name(test_set, 2),
+			"name of an invalid counter");
+	return 0;
+}
+
+static int
+test_counters_sum(void)
+{
+	unsigned int lcore_id, nb_lcores = 1;
+	uint64_t values[3];
+
+	rte_counters_reset(test_set);
+	RTE_TEST_ASSERT_EQUAL(rte_counters_read(test_set, 0), 0,
+			"counter not reset");
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_eal_remote_launch(counters_worker, NULL, lcore_id) == 0)
+			nb_lcores++;
+	}
+	counters_worker(NULL);
+	rte_eal_mp_wait_lcore();
+
+	RTE_TEST_ASSERT_EQUAL(rte_counters_read(test_set, 0),
+			(uint64_t)nb_lcores * COUNTERS_ITER, "wrong sum");
+	RTE_TEST_ASSERT_EQUAL(rte_counters_read_all(test_set, values,
+			RTE_DIM(values)), 2, "wrong number of values");
+	RTE_TEST_ASSERT_EQUAL(values[0], (uint64_t)nb_lcores * COUNTERS_ITER,
+			"wrong packets");
+	RTE_TEST_ASSERT_EQUAL(values[1],
+			(uint64_t)nb_lcores * COUNTERS_ITER * 64, "wrong bytes");
+
+	rte_counters_reset(test_set);
+	rte_counters_add(test_set, 1, 10);
+	RTE_TEST_ASSERT_EQUAL(rte_counters_read(test_set, 0), 0,
+			"counter not reset");
+	RTE_TEST_ASSERT_EQUAL(rte_counters_read(test_set, 1), 10,
+			"counter not updated after reset");
+	return 0;
+}
+
+static int
+test_counters(void)
+{
+	if (test_counters_create() < 0)
+		return -1;
+	if (test_counters_sum() < 0)
+		return -1;
+	return 0;
+}
+
+REGISTER_FAST_TEST(counters_autotest, true, true, test_counters);
@@ -1079,6 +1079,26 @@ test_misc_flags(void)
 	const char * const argv28[] = {prgname, prefix, mp_flag,
 				       "--log-color=invalid" };
 
+	/* Try running with --huge-prefault-threads=2 */
+	const char * const argv29[] = {prgname, "-m", DEFAULT_MEM_SIZE,
+				       "--file-prefix=prefault",
+				       "--huge-prefault-threads=2" };
+
+	/* Try running with invalid --huge-prefault-threads */
+	const char * const argv30[] = {prgname, "-m", DEFAULT_MEM_SIZE,
+				       "--file-prefix=prefault",
+				       "--huge-prefault-threads=0" };
+
+	/* Try running with --huge-zero-reserve=64 */
+	const char * const argv31[] = {prgname, "-m", DEFAULT_MEM_SIZE,
+				       "--file-prefix=zero",
+				       "--huge-zero-reserve=64" };
+
+	/* Try running with invalid --huge-zero-reserve */
+	const char * const argv32[] = {prgname, "-m", DEFAULT_MEM_SIZE,
+				       "--file-prefix=zero",
+				       "--huge-zero-reserve=invalid" };
+
 	/* run all tests also applicable to FreeBSD first */
 
 	if (launch_proc(argv0) == 0) {
@@ -1210,6 +1230,22 @@ test_misc_flags(void)
 		printf("Error - process did run ok with --log-timestamp=invalid parameter\n");
 		goto fail;
 	}
+	if (launch_proc(argv29) != 0) {
+		printf("Error - process did not run ok with --huge-prefault-threads parameter\n");
+		goto fail;
+	}
+	if (launch_proc(argv30) == 0) {
+		printf("Error - process did run ok with --huge-prefault-threads=0 parameter\n");
+		goto fail;
+	}
+	if (launch_proc(argv31) != 0) {
+		printf("Error - process did not run ok with --huge-zero-reserve parameter\n");
+		goto fail;
+	}
+	if (launch_proc(argv32) == 0) {
+		printf("Error - process did run ok with --huge-zero-reserve=invalid parameter\n");
+		goto fail;
+	}
 
 	rmdir(hugepath_dir3);
 	rmdir(hugepath_dir2);
@@ -20,6 +20,9 @@ test_efd(void)
 #include <rte_random.h>
 #include <rte_debug.h>
 #include <rte_ip.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_rcu_qsbr.h>
 
 #define EFD_TEST_KEY_LEN 8
 #define TABLE_SIZE (1 << 21)
@@ -325,6 +328,185 @@ static int test_five_keys(void)
 	return 0;
 }
 
+#define BULK_NUM_KEYS 4096
+#define BULK_BATCH 256
+#define MW_MAX_WRITERS 4
+
+static uint8_t bulk_keys[BULK_NUM_KEYS][EFD_TEST_KEY_LEN];
+static efd_value_t bulk_values[BULK_NUM_KEYS];
+
+static void
+bulk_keys_init(void)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < BULK_NUM_KEYS; i++) {
+		/* the key index makes every key unique */
+		memcpy(bulk_keys[i], &i, sizeof(i));
+		for (j = sizeof(i); j < EFD_TEST_KEY_LEN; j++)
+			bulk_keys[i][j] = rte_rand() & 0xFF;
+		bulk_values[i] = rte_rand() & VALUE_BITMASK;
+	}
+}
+
+static int
+bulk_keys_check(struct rte_efd_table *handle, unsigned int first,
+		unsigned int num)
+{
+	unsigned int i;
+
+	for (i = first; i < first + num; i++)
+		TEST_ASSERT_EQUAL(rte_efd_lookup(handle, test_socket_id,
+				bulk_keys[i]), bulk_values[i],
+				"key %u: wrong value", i);
+
+	return 0;
+}
+
+/*
+ * Insert and then modify keys in batches with rte_efd_update_bulk,
+ * with the table protected by RCU.
+ */
+static int test_update_bulk(void)
+{
+	struct rte_efd_table *handle;
+	struct rte_efd_rcu_config rcu_cfg = {0};
+	struct rte_rcu_qsbr *qsv;
+	const void *key_list[BULK_BATCH];
+	int status[BULK_BATCH];
+	unsigned int i, j, round;
+	int ret;
+
+	printf("Entering %s\n", __func__);
+
+	handle = rte_efd_create("test_update_bulk", 2 * BULK_NUM_KEYS,
+			EFD_TEST_KEY_LEN, efd_get_all_sockets_bitmask(),
+			test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	qsv = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(1),
+			RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_NOT_NULL(qsv, "Error allocating the QSBR variable\n");
+	rte_rcu_qsbr_init(qsv, 1);
+
+	rcu_cfg.v = qsv;
+	TEST_ASSERT_SUCCESS(rte_efd_rcu_qsbr_add(handle, &rcu_cfg),
+			"Error adding the QSBR variable");
+	TEST_ASSERT_EQUAL(rte_efd_rcu_qsbr_add(handle, &rcu_cfg), -EEXIST,
+			"QSBR variable added twice");
+
+	TEST_ASSERT_EQUAL(rte_efd_update_bulk(handle, test_socket_id, -1,
+			key_list, bulk_values, NULL), -EINVAL,
+			"Bulk update with negative number of keys");
+
+	bulk_keys_init();
+
+	/* Insert, then modify all values */
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < BULK_NUM_KEYS; i += BULK_BATCH) {
+			for (j = 0; j < BULK_BATCH; j++)
+				key_list[j] = bulk_keys[i + j];
+
+			ret = rte_efd_update_bulk(handle, test_socket_id,
+					BULK_BATCH, key_list, &bulk_values[i],
+					status);
+			TEST_ASSERT_EQUAL(ret, 0, "Bulk update failed for %d keys",
+					ret);
+			for (j = 0; j < BULK_BATCH; j++)
+				TEST_ASSERT(status[j] != RTE_EFD_UPDATE_FAILED,
+						"key %u: bulk update failed", i + j);
+		}
+
+		if (bulk_keys_check(handle, 0, BULK_NUM_KEYS) != 0)
+			return -1;
+
+		for (i = 0; i < BULK_NUM_KEYS; i++)
+			bulk_values[i] = (bulk_values[i] + 1) & VALUE_BITMASK;
+	}
+
+	rte_efd_free(handle);
+	rte_free(qsv);
+
+	return 0;
+}
+
+struct mw_writer_args {
+	struct rte_efd_table *handle;
+	unsigned int first;
+	unsigned int num;
+	unsigned int failed;
+};
+
+static int
+test_multi_writer_worker(void *arg)
+{
+	struct mw_writer_args *args = arg;
+	unsigned int i;
+
+	for (i = args->first; i < args->first + args->num; i++)
+		if (rte_efd_update(args->handle, test_socket_id, bulk_keys[i],
+				bulk_values[i]) == RTE_EFD_UPDATE_FAILED)
+			args->failed++;
+
+	return 0;
+}
+
+/*
+ * Insert disjoint sets of keys from several lcores at the same time.
+ */
+static int test_multi_writer(void)
+{
+	struct mw_writer_args args[MW_MAX_WRITERS];
+	struct rte_efd_table *handle;
+	unsigned int lcore_id, i, num_writers = 0;
+
+	printf("Entering %s\n", __func__);
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough lcores for multi-writer test, skipping\n");
+		return 0;
+	}
+
+	handle = rte_efd_create("test_multi_writer", 2 * BULK_NUM_KEYS,
+			EFD_TEST_KEY_LEN, efd_get_all_sockets_bitmask(),
+			test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	bulk_keys_init();
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (num_writers == MW_MAX_WRITERS)
+			break;
+		num_writers++;
+	}
+
+	i = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (i == num_writers)
+			break;
+		args[i].handle = handle;
+		args[i].num = BULK_NUM_KEYS / num_writers;
+		args[i].first = i * args[i].num;
+		args[i].failed = 0;
+		rte_eal_remote_launch(test_multi_writer_worker, &args[i],
+				lcore_id);
+		i++;
+	}
+	rte_eal_mp_wait_lcore();
+
+	for (i = 0; i < num_writers; i++) {
+		TEST_ASSERT_EQUAL(args[i].failed, 0,
+				"writer %u: %u updates failed", i,
+				args[i].failed);
+		if (bulk_keys_check(handle, args[i].first, args[i].num) != 0)
+			return -1;
+	}
+
+	rte_efd_free(handle);
+
+	return 0;
+}
+
 /*
  * Test to see the average table utilization (entries added/max entries)
  * before hitting a random entry that cannot be added
@@ -463,6 +645,10 @@ test_efd(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_update_bulk() < 0)
+		return -1;
+	if (test_multi_writer() < 0)
+		return -1;
 	if (test_efd_creation_with_bad_parameters() < 0)
 		return -1;
 	if (test_average_table_utilization() < 0)
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include <rte_ip.h>
 #include <rte_log.h>
@@ -24,6 +25,7 @@ static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
+static int32_t test_snapshot(void);
 
 #define MAX_ROUTES	(1 << 16)
 #define MAX_TBL8	(1 << 15)
@@ -588,6 +590,88 @@ test_fib_rcu_sync_rw(void)
 	return status == 0 ? TEST_SUCCESS : TEST_FAILED;
 }
 
+/*
+ * Save a FIB with routes of all depths, restore it in an empty FIB and
+ * check the lookups, then delete all routes from the restored FIB.
+ */
+static int32_t
+test_snapshot(void)
+{
+	struct rte_fib *fib, *restored;
+	struct rte_fib_conf config = { 0 };
+	char path[PATH_MAX];
+	uint64_t def_nh = 100;
+	uint32_t ip_arr[RTE_FIB_MAXDEPTH];
+	uint32_t ip_add = RTE_IPV4(128, 0, 0, 0);
+	uint32_t i, ip_missing = RTE_IPV4(127, 255, 255, 255);
+	int ret;
+
+	snprintf(path, sizeof(path), "%s/test_fib_snapshot",
+		rte_eal_get_runtime_dir());
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH; i++)
+		ip_arr[i] = ip_add + (1ULL << i) - 1;
+
+	config.max_routes = MAX_ROUTES;
+	config.rib_ext_sz = 0;
+	config.default_nh = def_nh;
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = 127;
+
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	for (i = 1; i <= RTE_FIB_MAXDEPTH; i++) {
+		ret = rte_fib_add(fib, ip_add, i, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+	}
+	ret = rte_fib_snapshot_save(fib, path);
+	RTE_TEST_ASSERT(ret == 0, "Failed to save FIB\n");
+
+	/* the FIB to restore must be empty */
+	ret = rte_fib_snapshot_load(fib, path);
+	RTE_TEST_ASSERT(ret == -EEXIST, "Snapshot loaded in a non empty FIB\n");
+	rte_fib_free(fib);
+
+	/* and must have the same configuration */
+	config.default_nh = def_nh + 1;
+	restored = rte_fib_create("test_snapshot_restored", SOCKET_ID_ANY,
+		&config);
+	RTE_TEST_ASSERT(restored != NULL, "Failed to create FIB\n");
+	ret = rte_fib_snapshot_load(restored, path);
+	RTE_TEST_ASSERT(ret == -EINVAL,
+		"Snapshot loaded with another default next hop\n");
+	rte_fib_free(restored);
+
+	config.default_nh = def_nh;
+	restored = rte_fib_create("test_snapshot_restored", SOCKET_ID_ANY,
+		&config);
+	RTE_TEST_ASSERT(restored != NULL, "Failed to create FIB\n");
+	ret = rte_fib_snapshot_load(restored, path);
+	remove(path);
+	RTE_TEST_ASSERT(ret == 0, "Failed to load FIB snapshot\n");
+
+	ret = lookup_and_check_asc(restored, ip_arr, ip_missing, def_nh,
+		RTE_FIB_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	for (i = RTE_FIB_MAXDEPTH; i > 1; i--) {
+		ret = rte_fib_delete(restored, ip_add, i);
+		RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+		ret = lookup_and_check_asc(restored, ip_arr, ip_missing,
+			def_nh, i - 1);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+	}
+	ret = rte_fib_delete(restored, ip_add, i);
+	RTE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+	ret = lookup_and_check_desc(restored, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	rte_fib_free(restored);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite fib_fast_tests = {
 	.suite_name = "fib autotest",
 	.setup = NULL,
@@ -600,6 +684,7 @@ static struct unit_test_suite fib_fast_tests = {
 	TEST_CASE(test_lookup),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
+	TEST_CASE(test_snapshot),
 	TEST_CASES_END()
 	}
 };
@@ -9,6 +9,7 @@
 
 #include <rte_cycles.h>
 #include <rte_random.h>
+#include <rte_malloc.h>
 #include <rte_memory.h>
 #include <rte_fib6.h>
 
@@ -26,6 +27,21 @@
 #define ITERATIONS (1 << 10)
 #define BATCH_SIZE 100000
 #define NUMBER_TBL8S                                           (1 << 16)
+#define RCU_ITERATIONS 100
+#define BULK_SIZE 32
+
+/* Report quiescent state interval every 1024 lookups. Larger critical
+ * sections in reader will result in writer polling multiple times.
+ */
+#define QSBR_REPORTING_INTERVAL 1024
+
+static struct rte_fib6 *g_fib;
+static struct rte_rcu_qsbr *g_rv;
+static volatile uint8_t writer_done;
+static RTE_ATOMIC(uint32_t) thr_id;
+static RTE_ATOMIC(uint64_t) glookups;
+static RTE_ATOMIC(uint64_t) glookup_cycles;
+static struct rte_ipv6_addr g_ip_batch[NUM_IPS_ENTRIES];
 
 static void
 print_route_distribution(const struct rules_tbl_entry *table, uint32_t n)
@@ -63,6 +79,210 @@ get_max_nh(uint8_t nh_sz)
 	return ((1ULL << (bits_in_nh(nh_sz) - 1)) - 1);
 }
 
+static uint32_t
+alloc_thread_id(void)
+{
+	return rte_atomic_fetch_add_explicit(&thr_id, 1,
+		rte_memory_order_relaxed);
+}
+
+/*
+ * Reader thread, keeps looking up the IPs table in bursts of BULK_SIZE.
+ * Reports quiescent state after every QSBR_REPORTING_INTERVAL lookups
+ * if RCU is used.
+ */
+static int
+test_fib6_rcu_qsbr_reader(void *arg)
+{
+	uint32_t i, n, pos;
+	uint32_t thread_id = alloc_thread_id();
+	uint64_t begin, cycles, lookups;
+	uint64_t next_hops[BULK_SIZE];
+
+	RTE_SET_USED(arg);
+	if (g_rv != NULL) {
+		/* Register this thread to report quiescent state */
+		rte_rcu_qsbr_thread_register(g_rv, thread_id);
+		rte_rcu_qsbr_thread_online(g_rv, thread_id);
+	}
+
+	pos = 0;
+	lookups = 0;
+	cycles = 0;
+	do {
+		begin = rte_rdtsc_precise();
+		for (i = 0; i < QSBR_REPORTING_INTERVAL; i += n) {
+			n = RTE_MIN((uint32_t)BULK_SIZE,
+				(uint32_t)NUM_IPS_ENTRIES - pos);
+			rte_fib6_lookup_bulk(g_fib, &g_ip_batch[pos],
+				next_hops, n);
+			pos = (pos + n) % NUM_IPS_ENTRIES;
+		}
+		cycles += rte_rdtsc_precise() - begin;
+		lookups += i;
+
+		/* Update quiescent state */
+		if (g_rv != NULL)
+			rte_rcu_qsbr_quiescent(g_rv, thread_id);
+	} while (!writer_done);
+
+	if (g_rv != NULL) {
+		rte_rcu_qsbr_thread_offline(g_rv, thread_id);
+		rte_rcu_qsbr_thread_unregister(g_rv, thread_id);
+	}
+
+	rte_atomic_fetch_add_explicit(&glookups, lookups,
+		rte_memory_order_relaxed);
+	rte_atomic_fetch_add_explicit(&glookup_cycles, cycles,
+		rte_memory_order_relaxed);
+
+	return 0;
+}
+
+/*
+ * Writer, replays a BGP-like update stream: every round withdraws all
+ * the routes and announces them back with a new next hop.
+ */
+static int
+test_fib6_rcu_writer(uint64_t *write_cycles)
+{
+	unsigned int i, j;
+	uint64_t begin;
+	int ret;
+
+	begin = rte_rdtsc_precise();
+	for (i = 0; i < RCU_ITERATIONS; i++) {
+		for (j = 0; j < NUM_ROUTE_ENTRIES; j++) {
+			/* the table may contain duplicate prefixes */
+			ret = rte_fib6_delete(g_fib, &large_route_table[j].ip,
+				large_route_table[j].depth);
+			if (ret != 0 && ret != -ENOENT) {
+				printf("Failed to delete iteration %u, route# %u\n",
+					i, j);
+				return -1;
+			}
+		}
+
+		for (j = 0; j < NUM_ROUTE_ENTRIES; j++) {
+			if (rte_fib6_add(g_fib, &large_route_table[j].ip,
+					large_route_table[j].depth,
+					((i + j) & ((1 << 14) - 1)) + 1) != 0) {
+				printf("Failed to add iteration %u, route# %u\n",
+					i, j);
+				return -1;
+			}
+		}
+	}
+	*write_cycles = rte_rdtsc_precise() - begin;
+
+	return 0;
+}
+
+/*
+ * Lookup throughput on all worker lcores, while the main lcore
+ * keeps updating the FIB, without RCU and with both RCU modes.
+ */
+static int
+test_fib6_rcu_perf(struct rte_fib6_conf *conf)
+{
+	static const struct {
+		const char *name;
+		int use_rcu;
+		enum rte_fib6_qsbr_mode mode;
+	} tests[] = {
+		{ "no RCU", 0, RTE_FIB6_QSBR_MODE_DQ },
+		{ "RCU sync mode", 1, RTE_FIB6_QSBR_MODE_SYNC },
+		{ "RCU defer queue mode", 1, RTE_FIB6_QSBR_MODE_DQ },
+	};
+	struct rte_fib6_rcu_config rcu_cfg = {0};
+	uint64_t write_cycles, lookups;
+	unsigned int i, j, num_readers;
+	size_t sz;
+	int status;
+
+	num_readers = rte_lcore_count() - 1;
+	if (num_readers == 0) {
+		printf("Not enough cores for %s, expecting at least 2\n",
+			__func__);
+		return 0;
+	}
+
+	for (i = 0; i < NUM_IPS_ENTRIES; i++)
+		g_ip_batch[i] = large_ips_table[i].ip;
+
+	for (i = 0; i < RTE_DIM(tests); i++) {
+		printf("\nPerf test: 1 writer, %u reader(s), %s\n",
+			num_readers, tests[i].name);
+
+		g_fib = rte_fib6_create(__func__, SOCKET_ID_ANY, conf);
+		TEST_FIB_ASSERT(g_fib != NULL);
+
+		for (j = 0; j < NUM_ROUTE_ENTRIES; j++)
+			rte_fib6_add(g_fib, &large_route_table[j].ip,
+				large_route_table[j].depth, j + 1);
+
+		g_rv = NULL;
+		if (tests[i].use_rcu) {
+			sz = rte_rcu_qsbr_get_memsize(num_readers);
+			g_rv = rte_zmalloc("rcu0", sz, RTE_CACHE_LINE_SIZE);
+			TEST_FIB_ASSERT(g_rv != NULL);
+			rte_rcu_qsbr_init(g_rv, num_readers);
+
+			rcu_cfg.v = g_rv;
+			rcu_cfg.mode = tests[i].mode;
+			if (rte_fib6_rcu_qsbr_add(g_fib, &rcu_cfg) != 0) {
+				printf("RCU variable assignment failed\n");
+				rte_fib6_free(g_fib);
+				rte_free(g_rv);
+				return -1;
+			}
+		}
+
+		writer_done = 0;
+		rte_atomic_store_explicit(&thr_id, 0, rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&glookups, 0,
+			rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&glookup_cycles, 0,
+			rte_memory_order_relaxed);
+
+		rte_eal_mp_remote_launch(test_fib6_rcu_qsbr_reader, NULL,
+			SKIP_MAIN);
+
+		status = test_fib6_rcu_writer(&write_cycles);
+
+		writer_done = 1;
+		/* Wait until all readers have exited */
+		rte_eal_mp_wait_lcore();
+
+		rte_fib6_free(g_fib);
+		rte_free(g_rv);
+		g_fib = NULL;
+		g_rv = NULL;
+
+		if (status != 0)
+			return -1;
+
+		lookups = rte_atomic_load_explicit(&glookups,
+			rte_memory_order_relaxed);
+		printf("Total FIB6 Adds: %u\n",
+			RCU_ITERATIONS * (unsigned int)NUM_ROUTE_ENTRIES);
+		printf("Total FIB6 Deletes: %u\n",
+			RCU_ITERATIONS * (unsigned int)NUM_ROUTE_ENTRIES);
+		printf("Average FIB6 Add/Del: %"PRIu64" cycles\n",
+			write_cycles /
+			(RCU_ITERATIONS * 2 * (uint64_t)NUM_ROUTE_ENTRIES));
+		printf("Total lookups: %"PRIu64", %.2f Mlookups/sec\n",
+			lookups, (double)lookups * rte_get_tsc_hz() /
+			write_cycles / 1e6);
+		printf("Average lookup: %.1f cycles\n",
+			lookups == 0 ? 0 : (double)rte_atomic_load_explicit(
+				&glookup_cycles, rte_memory_order_relaxed) /
+			lookups);
+	}
+
+	return 0;
+}
+
 static int
 test_fib6_perf(void)
 {
@@ -151,7 +371,7 @@ test_fib6_perf(void)
 
 	rte_fib6_free(fib);
 
-	return 0;
+	return test_fib6_rcu_perf(&conf);
 }
 
 REGISTER_PERF_TEST(fib6_perf_autotest, test_fib6_perf);
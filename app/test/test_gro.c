@@ -0,0 +1,416 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <string.h>
+
+#include <rte_ether.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#define NUM_MBUFS 128
+#define PAYLOAD_LEN 64
+#define INNER_HDR_LEN (sizeof(struct rte_udp_hdr) + \
+	sizeof(struct rte_vxlan_hdr) + sizeof(struct rte_ether_hdr))
+
+static struct rte_mempool *pkt_pool;
+
+static const struct rte_ipv6_addr outer_ip6_src =
+	RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1);
+static const struct rte_ipv6_addr outer_ip6_dst =
+	RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 2);
+
+static const struct rte_gro_param gro_param_base = {
+	.max_flow_num = 4,
+	.max_item_per_flow = 32,
+};
+
+/* Write an Ethernet header followed by an IPv4 or IPv6 header. */
+static void *
+gro_test_push_l2_l3(uint8_t *p, uint8_t is_ipv6, uint8_t proto,
+		uint16_t l4_len, uint8_t src_id)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)p;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+
+	memset(eth, 0, sizeof(*eth));
+	eth->src_addr.addr_bytes[5] = src_id;
+	eth->dst_addr.addr_bytes[5] = 0xff;
+	eth->ether_type = rte_cpu_to_be_16(is_ipv6 ?
+		RTE_ETHER_TYPE_IPV6 : RTE_ETHER_TYPE_IPV4);
+
+	if (is_ipv6) {
+		ip6 = (struct rte_ipv6_hdr *)(eth + 1);
+		memset(ip6, 0, sizeof(*ip6));
+		ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip6->payload_len = rte_cpu_to_be_16(l4_len);
+		ip6->proto = proto;
+		ip6->hop_limits = 64;
+		ip6->src_addr = outer_ip6_src;
+		ip6->src_addr.a[15] = src_id;
+		ip6->dst_addr = outer_ip6_dst;
+		return ip6 + 1;
+	}
+
+	ip4 = (struct rte_ipv4_hdr *)(eth + 1);
+	memset(ip4, 0, sizeof(*ip4));
+	ip4->version_ihl = RTE_IPV4_VHL_DEF;
+	ip4->total_length = rte_cpu_to_be_16(sizeof(*ip4) + l4_len);
+	ip4->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip4->time_to_live = 64;
+	ip4->next_proto_id = proto;
+	ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(192, 168, 0, src_id));
+	ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(192, 168, 0, 254));
+	return ip4 + 1;
+}
+
+/*
+ * Build a VxLAN packet with an outer IPv4 or IPv6 header. The inner packet
+ * is a TCP/IPv4 segment at 'off' in the stream, or if 'is_udp' is set,
+ * an IPv4 fragment at 'off' in a UDP datagram.
+ */
+static struct rte_mbuf *
+gro_test_vxlan_pkt(uint8_t outer_ipv6, uint8_t src_id, uint8_t is_udp,
+		uint16_t off, uint8_t more_frags)
+{
+	uint16_t outer_l3_len = outer_ipv6 ? sizeof(struct rte_ipv6_hdr) :
+		sizeof(struct rte_ipv4_hdr);
+	uint16_t l4_len = is_udp ? 0 : sizeof(struct rte_tcp_hdr);
+	uint16_t inner_len = sizeof(struct rte_ipv4_hdr) + l4_len + PAYLOAD_LEN;
+	struct rte_vxlan_hdr *vxlan;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_udp_hdr *udp;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+	uint8_t *p;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+	p = (uint8_t *)rte_pktmbuf_append(m, sizeof(struct rte_ether_hdr) +
+		outer_l3_len + INNER_HDR_LEN + inner_len);
+	if (p == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+
+	udp = gro_test_push_l2_l3(p, outer_ipv6, IPPROTO_UDP,
+		INNER_HDR_LEN + inner_len, src_id);
+	udp->src_port = rte_cpu_to_be_16(1000);
+	udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+	udp->dgram_len = rte_cpu_to_be_16(INNER_HDR_LEN + inner_len);
+	udp->dgram_cksum = 0;
+	vxlan = (struct rte_vxlan_hdr *)(udp + 1);
+	vxlan->vx_flags = rte_cpu_to_be_32(0x08000000);
+	vxlan->vx_vni = rte_cpu_to_be_32(100 << 8);
+
+	ip4 = gro_test_push_l2_l3((uint8_t *)(vxlan + 1), 0,
+		is_udp ? IPPROTO_UDP : IPPROTO_TCP, l4_len + PAYLOAD_LEN, 1);
+	ip4--;
+	if (is_udp) {
+		ip4->packet_id = rte_cpu_to_be_16(0x1234);
+		ip4->fragment_offset = rte_cpu_to_be_16((off >> 3) |
+			(more_frags ? RTE_IPV4_HDR_MF_FLAG : 0));
+	} else {
+		tcp = (struct rte_tcp_hdr *)(ip4 + 1);
+		memset(tcp, 0, sizeof(*tcp));
+		tcp->src_port = rte_cpu_to_be_16(5000);
+		tcp->dst_port = rte_cpu_to_be_16(80);
+		tcp->sent_seq = rte_cpu_to_be_32(1 + off);
+		tcp->recv_ack = rte_cpu_to_be_32(1);
+		tcp->data_off = sizeof(*tcp) << 2;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+	}
+
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L4_UDP |
+		(outer_ipv6 ? RTE_PTYPE_L3_IPV6 : RTE_PTYPE_L3_IPV4) |
+		RTE_PTYPE_TUNNEL_VXLAN | RTE_PTYPE_INNER_L2_ETHER |
+		RTE_PTYPE_INNER_L3_IPV4 |
+		(is_udp ? RTE_PTYPE_INNER_L4_FRAG : RTE_PTYPE_INNER_L4_TCP);
+	m->outer_l2_len = sizeof(struct rte_ether_hdr);
+	m->outer_l3_len = outer_l3_len;
+	m->l2_len = INNER_HDR_LEN;
+	m->l3_len = sizeof(struct rte_ipv4_hdr);
+	m->l4_len = l4_len;
+	return m;
+}
+
+/* Build an IPv6 fragment at 'off' in a UDP datagram. */
+static struct rte_mbuf *
+gro_test_udp6_frag(uint16_t off, uint8_t more_frags)
+{
+	struct rte_ipv6_fragment_ext *frag;
+	struct rte_mbuf *m;
+	uint8_t *p;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+	p = (uint8_t *)rte_pktmbuf_append(m, sizeof(struct rte_ether_hdr) +
+		sizeof(struct rte_ipv6_hdr) + RTE_IPV6_FRAG_HDR_SIZE +
+		PAYLOAD_LEN);
+	if (p == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+
+	frag = gro_test_push_l2_l3(p, 1, IPPROTO_FRAGMENT,
+		RTE_IPV6_FRAG_HDR_SIZE + PAYLOAD_LEN, 1);
+	frag->next_header = IPPROTO_UDP;
+	frag->reserved = 0;
+	frag->frag_data = rte_cpu_to_be_16(RTE_IPV6_SET_FRAG_DATA(off,
+		more_frags));
+	frag->id = rte_cpu_to_be_32(0xabcd);
+
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6_EXT |
+		RTE_PTYPE_L4_FRAG;
+	m->l2_len = sizeof(struct rte_ether_hdr);
+	m->l3_len = sizeof(struct rte_ipv6_hdr) + RTE_IPV6_FRAG_HDR_SIZE;
+	return m;
+}
+
+/* Check the lengths in the outer and inner headers of a merged VxLAN packet. */
+static int
+gro_test_check_vxlan_lengths(struct rte_mbuf *m)
+{
+	uint16_t len = m->pkt_len - m->outer_l2_len;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_udp_hdr *udp;
+
+	if (RTE_ETH_IS_IPV6_HDR(m->packet_type)) {
+		ip6 = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+			m->outer_l2_len);
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+			len - sizeof(*ip6), "Wrong outer IPv6 payload length");
+	} else {
+		ip4 = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *,
+			m->outer_l2_len);
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip4->total_length), len,
+			"Wrong outer IPv4 total length");
+	}
+	len -= m->outer_l3_len;
+	udp = rte_pktmbuf_mtod_offset(m, struct rte_udp_hdr *,
+		m->outer_l2_len + m->outer_l3_len);
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_16(udp->dgram_len), len,
+		"Wrong outer UDP length");
+	len -= m->l2_len;
+	ip4 = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *,
+		m->outer_l2_len + m->outer_l3_len + m->l2_len);
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip4->total_length), len,
+		"Wrong inner IPv4 total length");
+	return TEST_SUCCESS;
+}
+
+static void
+gro_test_free(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	rte_pktmbuf_free_bulk(pkts, nb_pkts);
+}
+
+/* Segments of an inner TCP flow over an outer IPv6 header are merged. */
+static int
+test_gro_ipv6_vxlan_tcp4(void)
+{
+	struct rte_gro_param param = gro_param_base;
+	struct rte_mbuf *pkts[4];
+	uint16_t nb, i;
+
+	param.gro_types = RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	/* the first segment is prepended, the third one appended */
+	pkts[0] = gro_test_vxlan_pkt(1, 1, 0, PAYLOAD_LEN, 0);
+	pkts[1] = gro_test_vxlan_pkt(1, 1, 0, 0, 0);
+	pkts[2] = gro_test_vxlan_pkt(1, 1, 0, 2 * PAYLOAD_LEN, 0);
+	/* another outer source address is another flow */
+	pkts[3] = gro_test_vxlan_pkt(1, 2, 0, 3 * PAYLOAD_LEN, 0);
+	for (i = 0; i < RTE_DIM(pkts); i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Cannot build packet %u", i);
+
+	nb = rte_gro_reassemble_burst(pkts, RTE_DIM(pkts), &param);
+	TEST_ASSERT_EQUAL(nb, 2, "Expected 2 packets after GRO, got %u", nb);
+	TEST_ASSERT_EQUAL(pkts[0]->nb_segs, 3, "Segments not merged");
+	TEST_ASSERT_EQUAL(pkts[0]->pkt_len,
+		pkts[1]->pkt_len + 2 * PAYLOAD_LEN, "Wrong merged length");
+	TEST_ASSERT_SUCCESS(gro_test_check_vxlan_lengths(pkts[0]),
+		"Wrong merged headers");
+	gro_test_free(pkts, nb);
+	return TEST_SUCCESS;
+}
+
+/* Inner IPv4 fragments over an outer IPv6 header are merged. */
+static int
+test_gro_ipv6_vxlan_udp4(void)
+{
+	struct rte_gro_param param = gro_param_base;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_mbuf *pkts[3];
+	uint16_t nb, i;
+
+	param.gro_types = RTE_GRO_IPV6_VXLAN_UDP_IPV4;
+	pkts[0] = gro_test_vxlan_pkt(1, 1, 1, PAYLOAD_LEN, 1);
+	pkts[1] = gro_test_vxlan_pkt(1, 1, 1, 2 * PAYLOAD_LEN, 0);
+	pkts[2] = gro_test_vxlan_pkt(1, 1, 1, 0, 1);
+	for (i = 0; i < RTE_DIM(pkts); i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Cannot build packet %u", i);
+
+	nb = rte_gro_reassemble_burst(pkts, RTE_DIM(pkts), &param);
+	TEST_ASSERT_EQUAL(nb, 1, "Expected 1 packet after GRO, got %u", nb);
+	TEST_ASSERT_EQUAL(pkts[0]->nb_segs, 3, "Fragments not merged");
+	TEST_ASSERT_SUCCESS(gro_test_check_vxlan_lengths(pkts[0]),
+		"Wrong merged headers");
+	ip4 = rte_pktmbuf_mtod_offset(pkts[0], struct rte_ipv4_hdr *,
+		pkts[0]->outer_l2_len + pkts[0]->outer_l3_len +
+		pkts[0]->l2_len);
+	TEST_ASSERT_EQUAL((rte_be_to_cpu_16(ip4->fragment_offset) &
+		(RTE_IPV4_HDR_MF_FLAG | RTE_IPV4_HDR_OFFSET_MASK)), 0,
+		"Merged datagram is still a fragment");
+	gro_test_free(pkts, nb);
+	return TEST_SUCCESS;
+}
+
+/* The same inner flow over outer IPv4 and IPv6 headers is not merged. */
+static int
+test_gro_vxlan_outer_family(void)
+{
+	struct rte_gro_param param = gro_param_base;
+	struct rte_mbuf *pkts[4];
+	uint16_t nb, i;
+
+	param.gro_types = RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
+		RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	pkts[0] = gro_test_vxlan_pkt(0, 1, 0, 0, 0);
+	pkts[1] = gro_test_vxlan_pkt(1, 1, 0, PAYLOAD_LEN, 0);
+	pkts[2] = gro_test_vxlan_pkt(0, 1, 0, PAYLOAD_LEN, 0);
+	pkts[3] = gro_test_vxlan_pkt(1, 1, 0, 0, 0);
+	for (i = 0; i < RTE_DIM(pkts); i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Cannot build packet %u", i);
+
+	nb = rte_gro_reassemble_burst(pkts, RTE_DIM(pkts), &param);
+	TEST_ASSERT_EQUAL(nb, 2, "Expected 2 packets after GRO, got %u", nb);
+	for (i = 0; i < nb; i++) {
+		TEST_ASSERT_EQUAL(pkts[i]->nb_segs, 2, "Segments not merged");
+		TEST_ASSERT_SUCCESS(gro_test_check_vxlan_lengths(pkts[i]),
+			"Wrong merged headers");
+	}
+	TEST_ASSERT(RTE_ETH_IS_IPV6_HDR(pkts[0]->packet_type) !=
+		RTE_ETH_IS_IPV6_HDR(pkts[1]->packet_type),
+		"Outer IPv4 and IPv6 packets merged together");
+	gro_test_free(pkts, nb);
+	return TEST_SUCCESS;
+}
+
+/* IPv6 fragments of a UDP datagram are merged. */
+static int
+test_gro_udp6(void)
+{
+	struct rte_gro_param param = gro_param_base;
+	struct rte_ipv6_fragment_ext *frag;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_mbuf *pkts[3];
+	uint16_t nb, i;
+
+	param.gro_types = RTE_GRO_UDP_IPV6;
+	pkts[0] = gro_test_udp6_frag(PAYLOAD_LEN, 1);
+	pkts[1] = gro_test_udp6_frag(0, 1);
+	pkts[2] = gro_test_udp6_frag(2 * PAYLOAD_LEN, 0);
+	for (i = 0; i < RTE_DIM(pkts); i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Cannot build packet %u", i);
+
+	nb = rte_gro_reassemble_burst(pkts, RTE_DIM(pkts), &param);
+	TEST_ASSERT_EQUAL(nb, 1, "Expected 1 packet after GRO, got %u", nb);
+	TEST_ASSERT_EQUAL(pkts[0]->nb_segs, 3, "Fragments not merged");
+	ip6 = rte_pktmbuf_mtod_offset(pkts[0], struct rte_ipv6_hdr *,
+		pkts[0]->l2_len);
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+		RTE_IPV6_FRAG_HDR_SIZE + 3 * PAYLOAD_LEN,
+		"Wrong merged IPv6 payload length");
+	frag = (struct rte_ipv6_fragment_ext *)(ip6 + 1);
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_16(frag->frag_data), 0,
+		"Merged datagram is still a fragment");
+	gro_test_free(pkts, nb);
+	return TEST_SUCCESS;
+}
+
+/* The context API keeps outer IPv6 VxLAN packets until they are flushed. */
+static int
+test_gro_ctx_ipv6_vxlan_tcp4(void)
+{
+	struct rte_gro_param param = gro_param_base;
+	struct rte_mbuf *pkts[2], *out[2];
+	uint16_t nb, i;
+	void *ctx;
+
+	param.gro_types = RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	param.socket_id = SOCKET_ID_ANY;
+	ctx = rte_gro_ctx_create(&param);
+	TEST_ASSERT_NOT_NULL(ctx, "Cannot create GRO context");
+
+	pkts[0] = gro_test_vxlan_pkt(1, 1, 0, 0, 0);
+	pkts[1] = gro_test_vxlan_pkt(1, 1, 0, PAYLOAD_LEN, 0);
+	for (i = 0; i < RTE_DIM(pkts); i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Cannot build packet %u", i);
+
+	nb = rte_gro_reassemble(pkts, RTE_DIM(pkts), ctx);
+	TEST_ASSERT_EQUAL(nb, 0, "Packets not kept in the context");
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(ctx), 1,
+		"Wrong number of packets in the context");
+
+	nb = rte_gro_timeout_flush(ctx, 0, RTE_GRO_IPV6_VXLAN_TCP_IPV4,
+		out, RTE_DIM(out));
+	TEST_ASSERT_EQUAL(nb, 1, "Expected 1 flushed packet, got %u", nb);
+	TEST_ASSERT_EQUAL(out[0]->nb_segs, 2, "Segments not merged");
+	TEST_ASSERT_SUCCESS(gro_test_check_vxlan_lengths(out[0]),
+		"Wrong merged headers");
+	gro_test_free(out, nb);
+	rte_gro_ctx_destroy(ctx);
+	return TEST_SUCCESS;
+}
+
+static int
+testsuite_setup(void)
+{
+	pkt_pool = rte_pktmbuf_pool_create("GRO_MBUF_POOL", NUM_MBUFS, 0, 0,
+		RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("%s: Error creating pkt mempool\n", __func__);
+		return TEST_FAILED;
+	}
+	return TEST_SUCCESS;
+}
+
+static void
+testsuite_teardown(void)
+{
+	rte_mempool_free(pkt_pool);
+	pkt_pool = NULL;
+}
+
+static struct unit_test_suite gro_testsuite = {
+	.suite_name = "GRO Unit Test Suite",
+	.setup = testsuite_setup,
+	.teardown = testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_gro_ipv6_vxlan_tcp4),
+		TEST_CASE(test_gro_ipv6_vxlan_udp4),
+		TEST_CASE(test_gro_vxlan_outer_family),
+		TEST_CASE(test_gro_udp6),
+		TEST_CASE(test_gro_ctx_ipv6_vxlan_tcp4),
+
+		TEST_CASES_END() /**< NULL terminate unit test array */
+	}
+};
+
+static int
+test_gro(void)
+{
+	return unit_test_suite_runner(&gro_testsuite);
+}
+
+REGISTER_FAST_TEST(gro_autotest, true, true, test_gro);
@@ -0,0 +1,540 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <string.h>
+
+#include <rte_ether.h>
+#include <rte_ethdev.h>
+#include <rte_geneve.h>
+#include <rte_gso.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#define NUM_MBUFS 128
+#define PAYLOAD_LEN 1000
+#define GSO_SIZE 400
+#define MAX_SEGS 16
+#define NB_SEGS(len, unit) (((len) + (unit) - 1) / (unit))
+/* destination options header of 8 bytes, padded with a PadN option */
+#define EXT_HDR_LEN 8
+#define L3_LEN (sizeof(struct rte_ipv6_hdr) + EXT_HDR_LEN)
+#define TUNNEL_HDR_LEN (sizeof(struct rte_udp_hdr) + \
+	sizeof(struct rte_vxlan_hdr) + sizeof(struct rte_ether_hdr))
+
+static struct rte_mempool *pkt_pool;
+
+static const struct rte_ipv6_addr ip6_src =
+	RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1);
+static const struct rte_ipv6_addr ip6_dst =
+	RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 2);
+
+/*
+ * Write an Ethernet header followed by an IPv4 or IPv6 header,
+ * with a destination options header if 'ext' is set.
+ */
+static void *
+gso_test_push_l2_l3(uint8_t *p, uint8_t is_ipv6, uint8_t ext, uint8_t proto,
+		uint16_t l4_len)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)p;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	uint8_t *opt;
+
+	memset(eth, 0, sizeof(*eth));
+	eth->dst_addr.addr_bytes[5] = 0xff;
+	eth->ether_type = rte_cpu_to_be_16(is_ipv6 ?
+		RTE_ETHER_TYPE_IPV6 : RTE_ETHER_TYPE_IPV4);
+
+	if (is_ipv6) {
+		ip6 = (struct rte_ipv6_hdr *)(eth + 1);
+		memset(ip6, 0, sizeof(*ip6));
+		ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip6->payload_len = rte_cpu_to_be_16(l4_len +
+			(ext ? EXT_HDR_LEN : 0));
+		ip6->proto = ext ? IPPROTO_DSTOPTS : proto;
+		ip6->hop_limits = 64;
+		ip6->src_addr = ip6_src;
+		ip6->dst_addr = ip6_dst;
+		if (!ext)
+			return ip6 + 1;
+		opt = (uint8_t *)(ip6 + 1);
+		memset(opt, 0, EXT_HDR_LEN);
+		opt[0] = proto;
+		opt[2] = 1; /* PadN */
+		opt[3] = EXT_HDR_LEN - 4;
+		return opt + EXT_HDR_LEN;
+	}
+
+	ip4 = (struct rte_ipv4_hdr *)(eth + 1);
+	memset(ip4, 0, sizeof(*ip4));
+	ip4->version_ihl = RTE_IPV4_VHL_DEF;
+	ip4->total_length = rte_cpu_to_be_16(sizeof(*ip4) + l4_len);
+	ip4->packet_id = rte_cpu_to_be_16(1);
+	ip4->time_to_live = 64;
+	ip4->next_proto_id = proto;
+	ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(192, 168, 0, 1));
+	ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(192, 168, 0, 2));
+	return ip4 + 1;
+}
+
+static void
+gso_test_push_tcp(struct rte_tcp_hdr *tcp)
+{
+	memset(tcp, 0, sizeof(*tcp));
+	tcp->src_port = rte_cpu_to_be_16(5000);
+	tcp->dst_port = rte_cpu_to_be_16(80);
+	tcp->sent_seq = rte_cpu_to_be_32(1);
+	tcp->recv_ack = rte_cpu_to_be_32(1);
+	tcp->data_off = sizeof(*tcp) << 2;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG;
+}
+
+/* Allocate a packet of 'hdr_len' bytes of headers and a numbered payload. */
+static struct rte_mbuf *
+gso_test_alloc(uint16_t hdr_len, uint8_t **hdr)
+{
+	struct rte_mbuf *m;
+	uint8_t *p;
+	uint16_t i;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+	p = (uint8_t *)rte_pktmbuf_append(m, hdr_len + PAYLOAD_LEN);
+	if (p == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	for (i = 0; i < PAYLOAD_LEN; i++)
+		p[hdr_len + i] = i;
+	*hdr = p;
+	return m;
+}
+
+/* Build a TCP/IPv6 or UDP/IPv6 packet with an extension header. */
+static struct rte_mbuf *
+gso_test_ipv6_pkt(uint8_t is_udp)
+{
+	uint16_t l4_len = is_udp ? sizeof(struct rte_udp_hdr) :
+		sizeof(struct rte_tcp_hdr);
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+	uint8_t *p;
+	void *l4;
+
+	m = gso_test_alloc(sizeof(struct rte_ether_hdr) + L3_LEN + l4_len, &p);
+	if (m == NULL)
+		return NULL;
+
+	l4 = gso_test_push_l2_l3(p, 1, 1, is_udp ? IPPROTO_UDP : IPPROTO_TCP,
+		l4_len + PAYLOAD_LEN);
+	if (is_udp) {
+		udp = l4;
+		udp->src_port = rte_cpu_to_be_16(5000);
+		udp->dst_port = rte_cpu_to_be_16(5001);
+		udp->dgram_len = rte_cpu_to_be_16(l4_len + PAYLOAD_LEN);
+		udp->dgram_cksum = 0;
+		m->ol_flags = RTE_MBUF_F_TX_IPV6 | RTE_MBUF_F_TX_UDP_SEG;
+	} else {
+		gso_test_push_tcp(l4);
+		m->ol_flags = RTE_MBUF_F_TX_IPV6 | RTE_MBUF_F_TX_TCP_SEG;
+	}
+
+	m->l2_len = sizeof(struct rte_ether_hdr);
+	m->l3_len = L3_LEN;
+	m->l4_len = l4_len;
+	return m;
+}
+
+/* Build a VxLAN or GENEVE packet carrying a TCP segment. */
+static struct rte_mbuf *
+gso_test_tunnel_pkt(uint8_t outer_ipv6, uint8_t inner_ipv6, uint8_t geneve)
+{
+	uint16_t outer_l3_len = outer_ipv6 ? sizeof(struct rte_ipv6_hdr) :
+		sizeof(struct rte_ipv4_hdr);
+	uint16_t l3_len = inner_ipv6 ? L3_LEN : sizeof(struct rte_ipv4_hdr);
+	uint16_t inner_len = l3_len + sizeof(struct rte_tcp_hdr) + PAYLOAD_LEN;
+	struct rte_geneve_hdr *gnv;
+	struct rte_vxlan_hdr *vxlan;
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+	uint8_t *p;
+
+	m = gso_test_alloc(sizeof(struct rte_ether_hdr) + outer_l3_len +
+		TUNNEL_HDR_LEN + inner_len - PAYLOAD_LEN, &p);
+	if (m == NULL)
+		return NULL;
+
+	udp = gso_test_push_l2_l3(p, outer_ipv6, 0, IPPROTO_UDP,
+		TUNNEL_HDR_LEN + inner_len);
+	udp->src_port = rte_cpu_to_be_16(1000);
+	udp->dgram_len = rte_cpu_to_be_16(TUNNEL_HDR_LEN + inner_len);
+	udp->dgram_cksum = 0;
+	if (geneve) {
+		udp->dst_port = rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT);
+		gnv = (struct rte_geneve_hdr *)(udp + 1);
+		memset(gnv, 0, sizeof(*gnv));
+		gnv->proto = rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH);
+		gnv->vni[2] = 100;
+	} else {
+		udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+		vxlan = (struct rte_vxlan_hdr *)(udp + 1);
+		vxlan->vx_flags = rte_cpu_to_be_32(0x08000000);
+		vxlan->vx_vni = rte_cpu_to_be_32(100 << 8);
+	}
+
+	gso_test_push_tcp(gso_test_push_l2_l3(p + sizeof(struct rte_ether_hdr) +
+		outer_l3_len + sizeof(*udp) + sizeof(*vxlan), inner_ipv6,
+		inner_ipv6, IPPROTO_TCP, sizeof(struct rte_tcp_hdr) +
+		PAYLOAD_LEN));
+
+	m->ol_flags = RTE_MBUF_F_TX_TCP_SEG |
+		(outer_ipv6 ? RTE_MBUF_F_TX_OUTER_IPV6 :
+			RTE_MBUF_F_TX_OUTER_IPV4) |
+		(inner_ipv6 ? RTE_MBUF_F_TX_IPV6 : RTE_MBUF_F_TX_IPV4) |
+		(geneve ? RTE_MBUF_F_TX_TUNNEL_GENEVE :
+			RTE_MBUF_F_TX_TUNNEL_VXLAN);
+	m->outer_l2_len = sizeof(struct rte_ether_hdr);
+	m->outer_l3_len = outer_l3_len;
+	m->l2_len = TUNNEL_HDR_LEN;
+	m->l3_len = l3_len;
+	m->l4_len = sizeof(struct rte_tcp_hdr);
+	return m;
+}
+
+static struct rte_gso_ctx
+gso_test_ctx(uint32_t gso_types)
+{
+	struct rte_gso_ctx ctx = {
+		.direct_pool = pkt_pool,
+		.indirect_pool = pkt_pool,
+		.flag = 0,
+		.gso_types = gso_types,
+		.gso_size = GSO_SIZE,
+	};
+
+	return ctx;
+}
+
+/*
+ * Check that the payloads of the segments, after their 'out_hdr_len'
+ * bytes of headers, follow each other in the payload of the packet,
+ * after its 'in_hdr_len' bytes of headers.
+ */
+static int
+gso_test_check_payload(struct rte_mbuf *pkt, struct rte_mbuf **segs,
+		uint16_t nb_segs, uint16_t in_hdr_len, uint16_t out_hdr_len)
+{
+	uint8_t in_buf[GSO_SIZE], out_buf[GSO_SIZE];
+	const void *in, *out;
+	uint32_t pos = in_hdr_len, len;
+	uint16_t i;
+
+	for (i = 0; i < nb_segs; i++) {
+		TEST_ASSERT(segs[i]->pkt_len <= GSO_SIZE,
+			"Segment %u of %u bytes too long", i, segs[i]->pkt_len);
+		len = segs[i]->pkt_len - out_hdr_len;
+		out = rte_pktmbuf_read(segs[i], out_hdr_len, len, out_buf);
+		in = rte_pktmbuf_read(pkt, pos, len, in_buf);
+		TEST_ASSERT(in != NULL && out != NULL,
+			"Cannot read payload of segment %u", i);
+		TEST_ASSERT_BUFFERS_ARE_EQUAL(in, out, len,
+			"Wrong payload in segment %u", i);
+		pos += len;
+	}
+	TEST_ASSERT_EQUAL(pos, pkt->pkt_len, "Payload not fully segmented");
+	return TEST_SUCCESS;
+}
+
+/* Check the TCP header of a segment of a stream starting at sequence 1. */
+static int
+gso_test_check_tcp(struct rte_mbuf *seg, uint16_t tcp_offset,
+		uint32_t pyld_offset, uint8_t last)
+{
+	struct rte_tcp_hdr *tcp;
+
+	tcp = rte_pktmbuf_mtod_offset(seg, struct rte_tcp_hdr *, tcp_offset);
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_32(tcp->sent_seq), 1 + pyld_offset,
+		"Wrong sequence number");
+	TEST_ASSERT_EQUAL(((tcp->tcp_flags & RTE_TCP_PSH_FLAG) != 0), last,
+		"PSH flag must be kept on the last segment only");
+	return TEST_SUCCESS;
+}
+
+static void
+gso_test_free(struct rte_mbuf *pkt, struct rte_mbuf **segs, int nb_segs)
+{
+	if (nb_segs > 0)
+		rte_pktmbuf_free_bulk(segs, nb_segs);
+	rte_pktmbuf_free(pkt);
+}
+
+/* A TCP/IPv6 packet with an extension header is segmented. */
+static int
+test_gso_tcp6(void)
+{
+	struct rte_gso_ctx ctx = gso_test_ctx(RTE_ETH_TX_OFFLOAD_TCP_TSO);
+	uint16_t hdr_len = sizeof(struct rte_ether_hdr) + L3_LEN +
+		sizeof(struct rte_tcp_hdr);
+	uint16_t pyld_unit = GSO_SIZE - hdr_len;
+	struct rte_mbuf *pkt, *segs[MAX_SEGS];
+	struct rte_ipv6_hdr *ip6;
+	uint8_t *opt;
+	int nb, i;
+
+	pkt = gso_test_ipv6_pkt(0);
+	TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+
+	nb = rte_gso_segment(pkt, &ctx, segs, RTE_DIM(segs));
+	TEST_ASSERT_EQUAL(nb, NB_SEGS(PAYLOAD_LEN, pyld_unit),
+		"Wrong number of segments %d", nb);
+	for (i = 0; i < nb; i++) {
+		ip6 = rte_pktmbuf_mtod_offset(segs[i], struct rte_ipv6_hdr *,
+			segs[i]->l2_len);
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+			segs[i]->pkt_len - segs[i]->l2_len - sizeof(*ip6),
+			"Wrong IPv6 payload length in segment %d", i);
+		opt = (uint8_t *)(ip6 + 1);
+		TEST_ASSERT(ip6->proto == IPPROTO_DSTOPTS &&
+			opt[0] == IPPROTO_TCP,
+			"Extension header not kept in segment %d", i);
+		TEST_ASSERT_SUCCESS(gso_test_check_tcp(segs[i],
+			segs[i]->l2_len + segs[i]->l3_len, i * pyld_unit,
+			i == nb - 1), "Wrong TCP header in segment %d", i);
+	}
+	TEST_ASSERT_SUCCESS(gso_test_check_payload(pkt, segs, nb, hdr_len,
+		hdr_len), "Wrong segment payloads");
+
+	gso_test_free(pkt, segs, nb);
+	return TEST_SUCCESS;
+}
+
+/*
+ * A UDP/IPv6 datagram with an extension header is fragmented:
+ * a fragment header is inserted after the extension header.
+ */
+static int
+test_gso_udp6(void)
+{
+	struct rte_gso_ctx ctx = gso_test_ctx(RTE_ETH_TX_OFFLOAD_UDP_TSO);
+	uint16_t hdr_len = sizeof(struct rte_ether_hdr) + L3_LEN;
+	uint16_t frag_unit = (GSO_SIZE - hdr_len - RTE_IPV6_FRAG_HDR_SIZE) &
+		~(RTE_IPV6_EHDR_FO_ALIGN - 1);
+	struct rte_mbuf *pkt, *segs[MAX_SEGS];
+	struct rte_ipv6_fragment_ext *frag;
+	struct rte_ipv6_hdr *ip6;
+	uint32_t frag_id = 0;
+	uint16_t frag_data;
+	uint8_t *opt;
+	int nb, i;
+
+	pkt = gso_test_ipv6_pkt(1);
+	TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+
+	nb = rte_gso_segment(pkt, &ctx, segs, RTE_DIM(segs));
+	TEST_ASSERT_EQUAL(nb, NB_SEGS(sizeof(struct rte_udp_hdr) +
+		PAYLOAD_LEN, frag_unit), "Wrong number of fragments %d", nb);
+	for (i = 0; i < nb; i++) {
+		TEST_ASSERT_EQUAL(segs[i]->l3_len,
+			L3_LEN + RTE_IPV6_FRAG_HDR_SIZE,
+			"Wrong L3 length of fragment %d", i);
+		ip6 = rte_pktmbuf_mtod_offset(segs[i], struct rte_ipv6_hdr *,
+			segs[i]->l2_len);
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+			segs[i]->pkt_len - segs[i]->l2_len - sizeof(*ip6),
+			"Wrong IPv6 payload length in fragment %d", i);
+		opt = (uint8_t *)(ip6 + 1);
+		TEST_ASSERT(ip6->proto == IPPROTO_DSTOPTS &&
+			opt[0] == IPPROTO_FRAGMENT,
+			"Fragment header not after the extension header in %d",
+			i);
+
+		frag = (struct rte_ipv6_fragment_ext *)(opt + EXT_HDR_LEN);
+		frag_data = rte_be_to_cpu_16(frag->frag_data);
+		TEST_ASSERT_EQUAL(frag->next_header, IPPROTO_UDP,
+			"Wrong next header in fragment %d", i);
+		TEST_ASSERT_EQUAL(RTE_IPV6_GET_FO(frag_data) *
+			RTE_IPV6_EHDR_FO_ALIGN, i * frag_unit,
+			"Wrong offset of fragment %d", i);
+		TEST_ASSERT_EQUAL((RTE_IPV6_GET_MF(frag_data) != 0), (i < nb - 1),
+			"Wrong MF flag in fragment %d", i);
+		if (i == 0)
+			frag_id = frag->id;
+		TEST_ASSERT_EQUAL(frag->id, frag_id,
+			"Wrong identification in fragment %d", i);
+	}
+	TEST_ASSERT_SUCCESS(gso_test_check_payload(pkt, segs, nb, hdr_len,
+		hdr_len + RTE_IPV6_FRAG_HDR_SIZE), "Wrong fragment payloads");
+
+	gso_test_free(pkt, segs, nb);
+	return TEST_SUCCESS;
+}
+
+/* Segment a tunneled TCP packet and check the headers of each segment. */
+static int
+gso_test_tunnel(uint8_t outer_ipv6, uint8_t inner_ipv6, uint8_t geneve)
+{
+	struct rte_gso_ctx ctx = gso_test_ctx(geneve ?
+		RTE_ETH_TX_OFFLOAD_GENEVE_TNL_TSO :
+		RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO);
+	struct rte_mbuf *pkt, *segs[MAX_SEGS];
+	uint16_t hdr_len, udp_offset, inner_l3_offset, pyld_unit;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_udp_hdr *udp;
+	int nb, i;
+
+	pkt = gso_test_tunnel_pkt(outer_ipv6, inner_ipv6, geneve);
+	TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+	udp_offset = pkt->outer_l2_len + pkt->outer_l3_len;
+	inner_l3_offset = udp_offset + pkt->l2_len;
+	hdr_len = inner_l3_offset + pkt->l3_len + pkt->l4_len;
+	pyld_unit = GSO_SIZE - hdr_len;
+
+	nb = rte_gso_segment(pkt, &ctx, segs, RTE_DIM(segs));
+	TEST_ASSERT_EQUAL(nb, NB_SEGS(PAYLOAD_LEN, pyld_unit),
+		"Wrong number of segments %d", nb);
+	for (i = 0; i < nb; i++) {
+		if (outer_ipv6) {
+			ip6 = rte_pktmbuf_mtod_offset(segs[i],
+				struct rte_ipv6_hdr *, segs[i]->outer_l2_len);
+			TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+				segs[i]->pkt_len - udp_offset,
+				"Wrong outer IPv6 payload length in %d", i);
+		} else {
+			ip4 = rte_pktmbuf_mtod_offset(segs[i],
+				struct rte_ipv4_hdr *, segs[i]->outer_l2_len);
+			TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip4->total_length),
+				segs[i]->pkt_len - segs[i]->outer_l2_len,
+				"Wrong outer IPv4 total length in %d", i);
+		}
+		udp = rte_pktmbuf_mtod_offset(segs[i], struct rte_udp_hdr *,
+			udp_offset);
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(udp->dgram_len),
+			segs[i]->pkt_len - udp_offset,
+			"Wrong outer UDP length in segment %d", i);
+		if (inner_ipv6) {
+			ip6 = rte_pktmbuf_mtod_offset(segs[i],
+				struct rte_ipv6_hdr *, inner_l3_offset);
+			TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip6->payload_len),
+				segs[i]->pkt_len - inner_l3_offset -
+				sizeof(*ip6),
+				"Wrong inner IPv6 payload length in %d", i);
+		} else {
+			ip4 = rte_pktmbuf_mtod_offset(segs[i],
+				struct rte_ipv4_hdr *, inner_l3_offset);
+			TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip4->total_length),
+				segs[i]->pkt_len - inner_l3_offset,
+				"Wrong inner IPv4 total length in %d", i);
+		}
+		TEST_ASSERT_SUCCESS(gso_test_check_tcp(segs[i],
+			inner_l3_offset + segs[i]->l3_len, i * pyld_unit,
+			i == nb - 1), "Wrong TCP header in segment %d", i);
+	}
+	TEST_ASSERT_SUCCESS(gso_test_check_payload(pkt, segs, nb, hdr_len,
+		hdr_len), "Wrong segment payloads");
+
+	gso_test_free(pkt, segs, nb);
+	return TEST_SUCCESS;
+}
+
+/* TCP/IPv6 in VxLAN over IPv6. */
+static int
+test_gso_ipv6_vxlan_tcp6(void)
+{
+	return gso_test_tunnel(1, 1, 0);
+}
+
+/* TCP/IPv4 in VxLAN over IPv6. */
+static int
+test_gso_ipv6_vxlan_tcp4(void)
+{
+	return gso_test_tunnel(1, 0, 0);
+}
+
+/* TCP/IPv6, with an extension header, in GENEVE over IPv4. */
+static int
+test_gso_ipv4_geneve_tcp6(void)
+{
+	return gso_test_tunnel(0, 1, 1);
+}
+
+/* TCP/IPv6 in GENEVE over IPv6. */
+static int
+test_gso_ipv6_geneve_tcp6(void)
+{
+	return gso_test_tunnel(1, 1, 1);
+}
+
+/* A tunneled packet without the outer IP version is not segmented. */
+static int
+test_gso_tunnel_no_outer_ip(void)
+{
+	struct rte_gso_ctx ctx = gso_test_ctx(RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO);
+	struct rte_mbuf *pkt, *segs[MAX_SEGS];
+	uint64_t ol_flags;
+	int nb;
+
+	pkt = gso_test_tunnel_pkt(1, 1, 0);
+	TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+	pkt->ol_flags &= ~RTE_MBUF_F_TX_OUTER_IPV6;
+	ol_flags = pkt->ol_flags;
+
+	nb = rte_gso_segment(pkt, &ctx, segs, RTE_DIM(segs));
+	TEST_ASSERT_EQUAL(nb, -ENOTSUP, "Segmented without outer IP flag");
+	TEST_ASSERT_EQUAL(pkt->ol_flags, ol_flags, "Offload flags changed");
+
+	gso_test_free(pkt, segs, 0);
+	return TEST_SUCCESS;
+}
+
+static int
+testsuite_setup(void)
+{
+	pkt_pool = rte_pktmbuf_pool_create("GSO_MBUF_POOL", NUM_MBUFS, 0, 0,
+		RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("%s: Error creating pkt mempool\n", __func__);
+		return TEST_FAILED;
+	}
+	return TEST_SUCCESS;
+}
+
+static void
+testsuite_teardown(void)
+{
+	rte_mempool_free(pkt_pool);
+	pkt_pool = NULL;
+}
+
+static struct unit_test_suite gso_testsuite = {
+	.suite_name = "GSO Unit Test Suite",
+	.setup = testsuite_setup,
+	.teardown = testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_gso_tcp6),
+		TEST_CASE(test_gso_udp6),
+		TEST_CASE(test_gso_ipv6_vxlan_tcp6),
+		TEST_CASE(test_gso_ipv6_vxlan_tcp4),
+		TEST_CASE(test_gso_ipv4_geneve_tcp6),
+		TEST_CASE(test_gso_ipv6_geneve_tcp6),
+		TEST_CASE(test_gso_tunnel_no_outer_ip),
+
+		TEST_CASES_END() /**< NULL terminate unit test array */
+	}
+};
+
+static int
+test_gso(void)
+{
+	return unit_test_suite_runner(&gso_testsuite);
+}
+
+REGISTER_FAST_TEST(gso_autotest, true, true, test_gso);
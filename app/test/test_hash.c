@@ -943,6 +943,96 @@ static int test_full_bucket(void)
 	return 0;
 }
 
+/*
+ * Add and delete keys in bursts, all of them landing in the same bucket:
+ *	- bulk add the 9 keys: 9 OK, the 9th one pushing an existing item
+ *	- lookup the 9 keys: 9 hits
+ *	- bulk add the 9 keys again: 9 OK, same positions
+ *	- bulk delete the 9 keys: 9 OK, same positions
+ *	- lookup the 9 keys: 9 misses
+ *	- bulk delete the 9 keys again: 9 misses
+ */
+static int test_bulk_add_delete(void)
+{
+	struct rte_hash_parameters params_pseudo_hash = {
+		.name = "test_bulk",
+		.entries = 64,
+		.key_len = sizeof(struct flow_key),
+		.hash_func = pseudo_hash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+	};
+	const void *key_array[KEY_PER_BUCKET+1] = {0};
+	struct rte_hash *handle;
+	int32_t pos[KEY_PER_BUCKET+1];
+	int32_t expected_pos[KEY_PER_BUCKET+1];
+	unsigned int i;
+	int ret;
+
+	handle = rte_hash_create(&params_pseudo_hash);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < KEY_PER_BUCKET+1; i++)
+		key_array[i] = &keys[i];
+
+	/* Bulk add, last key needs to push an item out of the full bucket */
+	ret = rte_hash_add_key_bulk(handle, key_array, KEY_PER_BUCKET+1, pos);
+	RETURN_IF_ERROR(ret != KEY_PER_BUCKET+1,
+			"failed to bulk add keys (ret=%d)", ret);
+	for (i = 0; i < KEY_PER_BUCKET+1; i++) {
+		print_key_info("Add", key_array[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] < 0,
+			"failed to add key (pos[%u]=%d)", i, pos[i]);
+		expected_pos[i] = pos[i];
+	}
+
+	/* Lookup */
+	for (i = 0; i < KEY_PER_BUCKET+1; i++) {
+		pos[i] = rte_hash_lookup(handle, &keys[i]);
+		print_key_info("Lkp", &keys[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+			"failed to find key (pos[%u]=%d)", i, pos[i]);
+	}
+
+	/* Bulk add - update */
+	ret = rte_hash_add_key_bulk(handle, key_array, KEY_PER_BUCKET+1, pos);
+	RETURN_IF_ERROR(ret != KEY_PER_BUCKET+1,
+			"failed to bulk update keys (ret=%d)", ret);
+	for (i = 0; i < KEY_PER_BUCKET+1; i++)
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+			"failed to update key (pos[%u]=%d)", i, pos[i]);
+
+	/* Bulk delete */
+	ret = rte_hash_del_key_bulk(handle, key_array, KEY_PER_BUCKET+1, pos);
+	RETURN_IF_ERROR(ret != KEY_PER_BUCKET+1,
+			"failed to bulk delete keys (ret=%d)", ret);
+	for (i = 0; i < KEY_PER_BUCKET+1; i++) {
+		print_key_info("Del", key_array[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+			"failed to delete key (pos[%u]=%d)", i, pos[i]);
+	}
+
+	/* Lookup */
+	for (i = 0; i < KEY_PER_BUCKET+1; i++) {
+		pos[i] = rte_hash_lookup(handle, &keys[i]);
+		print_key_info("Lkp", &keys[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] != -ENOENT,
+			"found non-existent key (pos[%u]=%d)", i, pos[i]);
+	}
+
+	/* Bulk delete of missing keys */
+	ret = rte_hash_del_key_bulk(handle, key_array, KEY_PER_BUCKET+1, pos);
+	RETURN_IF_ERROR(ret != 0,
+			"deleted non-existent keys (ret=%d)", ret);
+	for (i = 0; i < KEY_PER_BUCKET+1; i++)
+		RETURN_IF_ERROR(pos[i] != -ENOENT,
+			"deleted non-existent key (pos[%u]=%d)", i, pos[i]);
+
+	rte_hash_free(handle);
+
+	return 0;
+}
+
 /*
  * Similar to the test above (full bucket test), but for extendable buckets.
  */
@@ -1648,6 +1738,115 @@ static int test_hash_iteration(uint32_t ext_table)
 	return -1;
 }
 
+/*
+ * Save a table to a file and restore it in another table, check the keys
+ * and data are found, and that the restored table can still be updated.
+ * A snapshot must be rejected by a table with another hash function.
+ */
+static int test_hash_snapshot(uint32_t ext_table)
+{
+	struct rte_hash *handle, *restored = NULL;
+	char path[PATH_MAX];
+	unsigned int i;
+	uint8_t keys[NUM_ENTRIES][MAX_KEYSIZE];
+	uintptr_t data[NUM_ENTRIES];
+	void *next_data;
+	unsigned int added_keys;
+	int ret;
+
+	snprintf(path, sizeof(path), "%s/test_hash_snapshot",
+		rte_eal_get_runtime_dir());
+
+	ut_params.entries = NUM_ENTRIES;
+	ut_params.name = "test_hash_snapshot";
+	ut_params.hash_func = rte_jhash;
+	ut_params.key_len = 16;
+	if (ext_table)
+		ut_params.extra_flag |= RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+	else
+		ut_params.extra_flag &= ~RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+	handle = rte_hash_create(&ut_params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (added_keys = 0; added_keys < NUM_ENTRIES; added_keys++) {
+		data[added_keys] = (uintptr_t)rte_rand();
+		for (i = 0; i < ut_params.key_len; i++)
+			keys[added_keys][i] = rte_rand() % 255;
+		if (rte_hash_add_key_data(handle, keys[added_keys],
+				(void *)data[added_keys]) < 0)
+			break;
+	}
+
+	ret = rte_hash_snapshot_save(handle, path);
+	rte_hash_free(handle);
+	RETURN_IF_ERROR(ret != 0, "snapshot save failed: %d", ret);
+
+	/* a table with another hash function must reject the snapshot */
+	ut_params.name = "test_hash_snapshot_crc";
+	ut_params.hash_func = rte_hash_crc;
+	restored = rte_hash_create(&ut_params);
+	if (restored == NULL) {
+		printf("hash creation failed\n");
+		goto err;
+	}
+	if (rte_hash_snapshot_load(restored, path) != -EINVAL) {
+		printf("snapshot of another hash function was loaded\n");
+		goto err;
+	}
+	rte_hash_free(restored);
+
+	ut_params.name = "test_hash_snapshot_restored";
+	ut_params.hash_func = rte_jhash;
+	restored = rte_hash_create(&ut_params);
+	if (restored == NULL) {
+		printf("hash creation failed\n");
+		goto err;
+	}
+	ret = rte_hash_snapshot_load(restored, path);
+	if (ret != 0) {
+		printf("snapshot load failed: %d\n", ret);
+		goto err;
+	}
+
+	if (rte_hash_count(restored) != (int32_t)added_keys) {
+		printf("restored table has %d keys instead of %u\n",
+			rte_hash_count(restored), added_keys);
+		goto err;
+	}
+	for (i = 0; i < added_keys; i++) {
+		if (rte_hash_lookup_data(restored, keys[i], &next_data) < 0 ||
+				(uintptr_t)next_data != data[i]) {
+			printf("key %u not restored\n", i);
+			goto err;
+		}
+	}
+
+	/* free slots were rebuilt: delete and add again all the keys */
+	for (i = 0; i < added_keys; i++) {
+		if (rte_hash_del_key(restored, keys[i]) < 0) {
+			printf("cannot delete restored key %u\n", i);
+			goto err;
+		}
+	}
+	for (i = 0; i < added_keys; i++) {
+		if (rte_hash_add_key_data(restored, keys[i],
+				(void *)data[i]) < 0) {
+			printf("cannot add key %u to restored table\n", i);
+			goto err;
+		}
+	}
+
+	rte_hash_free(restored);
+	remove(path);
+	return 0;
+
+err:
+	rte_hash_free(restored);
+	remove(path);
+	return -1;
+}
+
 static uint8_t key[16] = {0x00, 0x01, 0x02, 0x03,
 			0x04, 0x05, 0x06, 0x07,
 			0x08, 0x09, 0x0a, 0x0b,
@@ -2355,6 +2554,8 @@ test_hash(void)
 		return -1;
 	if (test_full_bucket() < 0)
 		return -1;
+	if (test_bulk_add_delete() < 0)
+		return -1;
 	if (test_extendable_bucket() < 0)
 		return -1;
 
@@ -2372,12 +2573,16 @@ test_hash(void)
 		return -1;
 	if (test_hash_iteration(0) < 0)
 		return -1;
+	if (test_hash_snapshot(0) < 0)
+		return -1;
 
 	/* ext table enabled */
 	if (test_average_table_utilization(1) < 0)
 		return -1;
 	if (test_hash_iteration(1) < 0)
 		return -1;
+	if (test_hash_snapshot(1) < 0)
+		return -1;
 
 	run_hash_func_tests();
 
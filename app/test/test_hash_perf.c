@@ -37,6 +37,12 @@ enum operations {
 	NUM_OPERATIONS
 };
 
+enum bulk_operations {
+	OP_ADD_BULK = 0,
+	OP_DELETE_BULK,
+	NUM_BULK_OPERATIONS
+};
+
 static uint32_t hashtest_key_lens[] = {
 	/* standard key sizes */
 	4, 8, 16, 32, 48, 64,
@@ -58,6 +64,9 @@ static uint8_t slot_taken[MAX_ENTRIES];
 /* Array to store number of cycles per operation */
 static uint64_t cycles[NUM_KEYSIZES][NUM_OPERATIONS][2][2];
 
+/* Array to store number of cycles per key for bulk add/delete operations */
+static uint64_t bulk_cycles[NUM_KEYSIZES][NUM_BULK_OPERATIONS][2];
+
 /* Array to store all input keys */
 static uint8_t keys[KEYS_TO_ADD][MAX_KEYSIZE];
 
@@ -559,6 +568,100 @@ timed_deletes(unsigned int with_hash, unsigned int with_data,
 	return 0;
 }
 
+static int
+timed_adds_bulk(unsigned int with_data, unsigned int table_index,
+		unsigned int ext)
+{
+	unsigned int i, j;
+	const void *keys_burst[BURST_SIZE];
+	void *data_burst[BURST_SIZE];
+	int32_t pos_burst[BURST_SIZE];
+	unsigned int keys_to_add, burst;
+	int ret;
+
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add; i += burst) {
+		burst = RTE_MIN((unsigned int)BURST_SIZE, keys_to_add - i);
+		for (j = 0; j < burst; j++) {
+			keys_burst[j] = keys[i + j];
+			data_burst[j] = (void *) ((uintptr_t) signatures[i + j]);
+		}
+
+		if (with_data)
+			ret = rte_hash_add_key_bulk_data(h[table_index],
+					keys_burst, data_burst, burst,
+					pos_burst);
+		else
+			ret = rte_hash_add_key_bulk(h[table_index],
+					keys_burst, burst, pos_burst);
+		if (ret != (int)burst) {
+			printf("Failed to bulk add keys from number %u\n", i);
+			return -1;
+		}
+		for (j = 0; j < burst; j++)
+			positions[i + j] = pos_burst[j];
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	bulk_cycles[table_index][OP_ADD_BULK][with_data] =
+			time_taken/keys_to_add;
+
+	return 0;
+}
+
+static int
+timed_deletes_bulk(unsigned int with_data, unsigned int table_index,
+		unsigned int ext)
+{
+	unsigned int i, j;
+	const void *keys_burst[BURST_SIZE];
+	int32_t pos_burst[BURST_SIZE];
+	unsigned int keys_to_add, burst;
+	int ret;
+
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add; i += burst) {
+		burst = RTE_MIN((unsigned int)BURST_SIZE, keys_to_add - i);
+		for (j = 0; j < burst; j++)
+			keys_burst[j] = keys[i + j];
+
+		ret = rte_hash_del_key_bulk(h[table_index], keys_burst, burst,
+				pos_burst);
+		if (ret != (int)burst) {
+			printf("Failed to bulk delete keys from number %u\n", i);
+			return -1;
+		}
+		for (j = 0; j < burst; j++)
+			if (pos_burst[j] != positions[i + j]) {
+				printf("Unexpected position for key number %u\n",
+					i + j);
+				return -1;
+			}
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	bulk_cycles[table_index][OP_DELETE_BULK][with_data] =
+			time_taken/keys_to_add;
+
+	return 0;
+}
+
 static void
 free_table(unsigned table_index)
 {
@@ -610,6 +713,14 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 
 				reset_table(i);
 			}
+
+			if (timed_adds_bulk(with_data, i, ext) < 0)
+				return -1;
+
+			if (timed_deletes_bulk(with_data, i, ext) < 0)
+				return -1;
+
+			reset_table(i);
 			free_table(i);
 		}
 	}
@@ -636,6 +747,16 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 				printf("\n");
 			}
 		}
+
+		printf("\nBulk operations (%u keys per burst)\n", BURST_SIZE);
+		printf("\n%-18s%-18s%-18s\n", "Keysize", "Add_bulk",
+			"Delete_bulk");
+		for (i = 0; i < NUM_KEYSIZES; i++) {
+			printf("%-18d", hashtest_key_lens[i]);
+			for (j = 0; j < NUM_BULK_OPERATIONS; j++)
+				printf("%-18"PRIu64, bulk_cycles[i][j][with_data]);
+			printf("\n");
+		}
 	}
 	return 0;
 }
@@ -825,6 +825,69 @@ test_zero_aligned_alloc(void)
 	return -1;
 }
 
+static unsigned int
+malloc_alloc_count(void)
+{
+	struct rte_malloc_socket_stats stats;
+	unsigned int i, count = 0;
+
+	for (i = 0; i < rte_socket_count(); i++)
+		if (rte_malloc_get_socket_stats(rte_socket_id_by_idx(i),
+				&stats) == 0)
+			count += stats.alloc_count;
+	return count;
+}
+
+static int
+test_malloc_cache(void)
+{
+	unsigned int alloc_count;
+	char *p, *q;
+	int i, ret;
+
+	alloc_count = malloc_alloc_count();
+
+	ret = rte_malloc_cache_enable();
+	if (ret == -ENOTSUP) {
+		printf("malloc cache not supported\n");
+		return 0;
+	}
+	if (ret < 0)
+		return -1;
+
+	/* a freed block is reused for the next allocation of its class */
+	p = rte_malloc(NULL, 200, 0);
+	if (p == NULL)
+		goto err_return;
+	memset(p, 0xa5, 200);
+	rte_free(p);
+	q = rte_zmalloc(NULL, 150, 0);
+	if (q != p) {
+		printf("cached block not reused\n");
+		rte_free(q);
+		goto err_return;
+	}
+	for (i = 0; i < 150; i++)
+		if (q[i] != 0) {
+			printf("cached block not zeroed\n");
+			rte_free(q);
+			goto err_return;
+		}
+	rte_free(q);
+
+	/* all blocks are back to the heap after a flush */
+	rte_malloc_cache_disable();
+	if (malloc_alloc_count() != alloc_count) {
+		printf("cached blocks not returned to the heap\n");
+		return -1;
+	}
+	return 0;
+
+err_return:
+	rte_malloc_cache_disable();
+	return -1;
+}
+
 static int
 test_malloc_bad_params(void)
 {
@@ -988,6 +1051,218 @@ test_alloc_socket(void)
 	return 0;
 }
 
+#if defined(RTE_EXEC_ENV_LINUX) && !defined(RTE_MALLOC_ASAN)
+
+#include "process.h"
+
+#define launch_proc(ARGV) process_dup(ARGV, RTE_DIM(ARGV), __func__)
+
+#define ZERO_RESERVE_MB 16
+#define ZERO_RESERVE ((size_t)ZERO_RESERVE_MB << 20)
+/* big enough to be cleared in background, and cleared on free */
+#define ZERO_BIG_SIZE (512 * 1024)
+#define ZERO_SMALL_SIZE 4096
+#define ZERO_HELD 4
+#define ZERO_ITERATIONS 256
+#define ZERO_WAIT_MS 5000
+
+static int
+check_zeroed(const void *ptr, size_t len)
+{
+	const uint64_t *word = ptr;
+	size_t i;
+
+	for (i = 0; i < len / sizeof(*word); i++)
+		if (word[i] != 0)
+			return -1;
+	return 0;
+}
+
+/* wait until the freed elements queued for clearing are freed */
+static int
+wait_zero_drained(int socket, unsigned int alloc_count)
+{
+	struct rte_malloc_socket_stats stats;
+	unsigned int ms;
+
+	for (ms = 0; ms < ZERO_WAIT_MS; ms++) {
+		if (rte_malloc_get_socket_stats(socket, &stats) < 0)
+			return -1;
+		if (stats.alloc_count <= alloc_count)
+			return 0;
+		rte_delay_ms(1);
+	}
+	printf("%u elements still waiting to be cleared\n",
+		stats.alloc_count - alloc_count);
+	return -1;
+}
+
+/* zeroed allocations and frees, big ones being cleared in background */
+static int
+test_zero_reserve_per_lcore(void *arg)
+{
+	int socket = *(int *)arg;
+	void *held[ZERO_HELD] = { NULL };
+	size_t size;
+	unsigned int i, slot;
+	int ret = 0;
+
+	for (i = 0; i < ZERO_ITERATIONS && ret == 0; i++) {
+		slot = i % ZERO_HELD;
+		rte_free(held[slot]);
+		size = (i & 1) ? ZERO_BIG_SIZE : ZERO_SMALL_SIZE;
+		held[slot] = rte_zmalloc_socket("zero_reserve", size, 0, socket);
+		if (held[slot] == NULL) {
+			printf("%s(): cannot allocate %zu bytes\n",
+				__func__, size);
+			ret = -1;
+		} else if (check_zeroed(held[slot], size) < 0) {
+			printf("%s(): memory of %zu bytes at %p not zeroed\n",
+				__func__, size, held[slot]);
+			ret = -1;
+		} else {
+			memset(held[slot], 0xa5, size);
+		}
+	}
+	for (slot = 0; slot < ZERO_HELD; slot++)
+		rte_free(held[slot]);
+	return ret;
+}
+
+/*
+ * Run in a process started with --huge-zero-reserve: check that memory
+ * cleared in background is zeroed when rte_zmalloc() returns it, and that
+ * the heap keeps cleared memory up to the reserve only.
+ */
+int
+test_malloc_zero_reserve(void)
+{
+	const struct rte_memseg_list *msl;
+	struct rte_malloc_socket_stats stats;
+	void *ptrs[2 * ZERO_RESERVE / ZERO_BIG_SIZE];
+	int socket = rte_socket_id();
+	unsigned int alloc_count, lcore_id, i;
+	size_t free_sz, page_sz;
+	int ret = 0;
+
+	if (socket == SOCKET_ID_ANY)
+		socket = 0;
+	if (rte_malloc_get_socket_stats(socket, &stats) < 0)
+		return -1;
+	alloc_count = stats.alloc_count;
+
+	/* a big block is freed by the background thread once cleared */
+	ptrs[0] = rte_malloc_socket("zero_reserve", ZERO_BIG_SIZE, 0, socket);
+	if (ptrs[0] == NULL)
+		return -1;
+	msl = rte_mem_virt2memseg_list(ptrs[0]);
+	if (msl == NULL) {
+		rte_free(ptrs[0]);
+		return -1;
+	}
+	page_sz = msl->page_sz;
+	memset(ptrs[0], 0xa5, ZERO_BIG_SIZE);
+	rte_free(ptrs[0]);
+	if (wait_zero_drained(socket, alloc_count) < 0) {
+		printf("Freed memory not cleared in background\n");
+		return -1;
+	}
+	ptrs[0] = rte_zmalloc_socket("zero_reserve", ZERO_BIG_SIZE, 0, socket);
+	if (ptrs[0] == NULL)
+		return -1;
+	ret = check_zeroed(ptrs[0], ZERO_BIG_SIZE);
+	rte_free(ptrs[0]);
+	if (ret < 0) {
+		printf("Memory cleared in background not zeroed\n");
+		return -1;
+	}
+
+	/* allocations and frees racing with the background thread */
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		rte_eal_remote_launch(test_zero_reserve_per_lcore, &socket,
+			lcore_id);
+	}
+	ret = test_zero_reserve_per_lcore(&socket);
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_eal_wait_lcore(lcore_id) < 0)
+			ret = -1;
+	}
+	if (ret < 0)
+		return -1;
+	if (wait_zero_drained(socket, alloc_count) < 0) {
+		printf("Freed memory not cleared after concurrent frees\n");
+		return -1;
+	}
+	if (rte_malloc_get_socket_stats(socket, &stats) < 0)
+		return -1;
+	if (stats.heap_freesz_bytes < ZERO_BIG_SIZE) {
+		printf("Cleared memory not kept in the heap\n");
+		return -1;
+	}
+	free_sz = stats.heap_freesz_bytes;
+
+	/* memory freed beyond the reserve is given back to the system */
+	for (i = 0; i < RTE_DIM(ptrs); i++) {
+		ptrs[i] = rte_malloc_socket("zero_reserve", ZERO_BIG_SIZE, 0,
+			socket);
+		if (ptrs[i] == NULL)
+			break;
+	}
+	while (i-- > 0)
+		rte_free(ptrs[i]);
+	if (wait_zero_drained(socket, alloc_count) < 0) {
+		printf("Freed memory not cleared beyond the reserve\n");
+		return -1;
+	}
+	if (rte_malloc_get_socket_stats(socket, &stats) < 0)
+		return -1;
+	/* the pages released must be fully free, with hugepages in the way */
+	if (page_sz <= ZERO_RESERVE && stats.heap_freesz_bytes >
+			RTE_MAX(free_sz, ZERO_RESERVE) + ZERO_BIG_SIZE +
+			4 * page_sz) {
+		printf("%zu bytes kept free in the heap, reserve is %zu\n",
+			stats.heap_freesz_bytes, ZERO_RESERVE);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+malloc_zero_reserve_spawn(void)
+{
+	const char * const argv[] = {
+		prgname,
+		"--file-prefix=malloc_zero",
+		"--huge-zero-reserve=" RTE_STR(ZERO_RESERVE_MB),
+	};
+
+	if (!rte_eal_has_hugepages()) {
+		printf("Background clearing needs hugepages, skipping test\n");
+		return TEST_SKIPPED;
+	}
+	if (launch_proc(argv) != 0)
+		return -1;
+	return 0;
+}
+
+#else
+
+int
+test_malloc_zero_reserve(void)
+{
+	return TEST_SKIPPED;
+}
+
+static int
+malloc_zero_reserve_spawn(void)
+{
+	printf("Background clearing not supported, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#endif
+
 static int
 test_malloc(void)
 {
@@ -1018,6 +1293,13 @@ test_malloc(void)
 	}
 	else printf("test_realloc() passed\n");
 
+	if (test_malloc_cache() < 0) {
+		printf("test_malloc_cache() failed\n");
+		return -1;
+	}
+	else
+		printf("test_malloc_cache() passed\n");
+
 	/*----------------------------*/
 	RTE_LCORE_FOREACH_WORKER(lcore_id) {
 		rte_eal_remote_launch(test_align_overlap_per_lcore, NULL, lcore_id);
@@ -1086,6 +1368,14 @@ test_malloc(void)
 	else
 		printf("test_multi_alloc_statistics() passed\n");
 
+	ret = malloc_zero_reserve_spawn();
+	if (ret < 0) {
+		printf("test_malloc_zero_reserve() failed\n");
+		return ret;
+	}
+	else if (ret == 0)
+		printf("test_malloc_zero_reserve() passed\n");
+
 	return 0;
 }
 
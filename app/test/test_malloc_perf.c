@@ -6,6 +6,8 @@
 #include <string.h>
 #include <rte_cycles.h>
 #include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_memzone.h>
 
@@ -147,6 +149,106 @@ memzone_free(void *addr)
 	rte_memzone_free((struct rte_memzone *)addr);
 }
 
+/* alloc/free churn of small blocks, as done by control path threads */
+struct churn_arg {
+	size_t size;
+	uint64_t tsc[RTE_MAX_LCORE];
+	bool failed;
+};
+
+#define CHURN_BURST	16
+#define CHURN_RUNS	20000
+
+static int
+churn_lcore(void *arg)
+{
+	struct churn_arg *ca = arg;
+	unsigned int lcore_id = rte_lcore_id();
+	void *ptrs[CHURN_BURST];
+	uint64_t tsc;
+	size_t i, j;
+
+	tsc = rte_rdtsc_precise();
+	for (i = 0; i < CHURN_RUNS; i++) {
+		for (j = 0; j < CHURN_BURST; j++) {
+			ptrs[j] = rte_zmalloc(NULL, ca->size, 0);
+			if (ptrs[j] == NULL) {
+				ca->failed = true;
+				break;
+			}
+		}
+		while (j != 0)
+			rte_free(ptrs[--j]);
+	}
+	ca->tsc[lcore_id] = rte_rdtsc_precise() - tsc;
+
+	/* give the cached blocks back before the next size */
+	rte_malloc_cache_flush();
+	return 0;
+}
+
+static int
+test_churn_perf(const char *name)
+{
+	static const size_t SIZES[] = { 1 << 6, 200, 1 << 10, 1 << 12 };
+
+	struct churn_arg ca;
+	unsigned int lcore_id, nb_lcores;
+	uint64_t tsc;
+	size_t i;
+
+	TEST_LOG(INFO, "Performance: %s, %u lcores\n", name, rte_lcore_count());
+	TEST_LOG(INFO, "%12s%8s%20s\n", "Size (B)", "Runs",
+			"Alloc+free (us)");
+
+	for (i = 0; i < RTE_DIM(SIZES); i++) {
+		memset(&ca, 0, sizeof(ca));
+		ca.size = SIZES[i];
+
+		rte_eal_mp_remote_launch(churn_lcore, &ca, CALL_MAIN);
+		rte_eal_mp_wait_lcore();
+		if (ca.failed) {
+			TEST_LOG(ERR, "%12zu Interrupted: out of memory.\n",
+					ca.size);
+			return -1;
+		}
+
+		tsc = 0;
+		nb_lcores = 0;
+		RTE_LCORE_FOREACH(lcore_id) {
+			tsc += ca.tsc[lcore_id];
+			nb_lcores++;
+		}
+		TEST_LOG(INFO, "%12zu%8u%20.3f\n", ca.size,
+				CHURN_RUNS * CHURN_BURST,
+				tsc_to_us(tsc / nb_lcores,
+					CHURN_RUNS * CHURN_BURST));
+	}
+
+	TEST_LOG(INFO, "\n");
+	return 0;
+}
+
+static int
+test_malloc_cache_perf(void)
+{
+	int ret;
+
+	if (test_churn_perf("rte_zmalloc churn") < 0)
+		return -1;
+
+	ret = rte_malloc_cache_enable();
+	if (ret == -ENOTSUP) {
+		TEST_LOG(INFO, "Malloc cache not supported\n\n");
+		return 0;
+	}
+	if (ret < 0)
+		return -1;
+	ret = test_churn_perf("rte_zmalloc churn with malloc cache");
+	rte_malloc_cache_disable();
+	return ret;
+}
+
 static int
 test_malloc_perf(void)
 {
@@ -168,6 +270,9 @@ test_malloc_perf(void)
 			NULL, memset_us_gb, rte_memzone_max_get() - 1) < 0)
 		return -1;
 
+	if (test_malloc_cache_perf() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -30,6 +30,8 @@ struct rte_member_setsum *setsum_ht;
 struct rte_member_setsum *setsum_cache;
 struct rte_member_setsum *setsum_vbf;
 struct rte_member_setsum *setsum_sketch;
+struct rte_member_setsum *setsum_cf;
+struct rte_member_setsum *setsum_cbf;
 
 /* 5-tuple key type */
 struct __rte_packed_begin flow_key {
@@ -692,12 +694,126 @@ test_member_loadfactor(void)
 	return 0;
 }
 
+/*
+ * Sequence of operations for the single set filters (CF and CBF)
+ *
+ *  - add, lookup and delete sample keys
+ *  - fill the cuckoo filter until no space is left
+ *  - check that no key added before it got full is missing
+ *  - delete all added keys
+ */
+static int
+test_member_filters(void)
+{
+	const void *key_array[NUM_SAMPLES];
+	member_set_t set_ids[NUM_SAMPLES];
+	struct rte_member_setsum *filters[2];
+	unsigned int added_keys, i, j;
+	member_set_t set_id;
+	int ret;
+
+	params.key_len = sizeof(struct flow_key);
+	params.name = "test_member_cf";
+	params.type = RTE_MEMBER_TYPE_CF;
+	params.num_keys = MAX_ENTRIES;
+	setsum_cf = rte_member_create(&params);
+
+	params.name = "test_member_cbf";
+	params.type = RTE_MEMBER_TYPE_CBF;
+	params.false_positive_rate = 0.03;
+	setsum_cbf = rte_member_create(&params);
+
+	if (setsum_cf == NULL || setsum_cbf == NULL) {
+		printf("Creation of filters fail\n");
+		return -1;
+	}
+	filters[0] = setsum_cf;
+	filters[1] = setsum_cbf;
+
+	for (i = 0; i < NUM_SAMPLES; i++)
+		key_array[i] = &keys[i];
+
+	for (j = 0; j < RTE_DIM(filters); j++) {
+		TEST_ASSERT(rte_member_add(filters[j], &keys[0], 2) == -EINVAL,
+				"filter accepted a set id other than 1");
+
+		for (i = 0; i < NUM_SAMPLES; i++) {
+			ret = rte_member_add(filters[j], &keys[i], 1);
+			TEST_ASSERT(ret >= 0, "filter add error");
+		}
+
+		for (i = 0; i < NUM_SAMPLES; i++) {
+			ret = rte_member_lookup(filters[j], &keys[i], &set_id);
+			TEST_ASSERT(ret == 1 && set_id == 1,
+					"filter lookup error");
+		}
+
+		/* Delete half of the keys */
+		for (i = 0; i < NUM_SAMPLES / 2; i++) {
+			ret = rte_member_delete(filters[j], &keys[i], 1);
+			TEST_ASSERT(ret == 0, "filter delete error");
+		}
+
+		ret = rte_member_lookup_bulk(filters[j], key_array,
+				NUM_SAMPLES, set_ids);
+		TEST_ASSERT(ret == NUM_SAMPLES - NUM_SAMPLES / 2,
+				"filter bulk lookup error");
+		for (i = 0; i < NUM_SAMPLES; i++) {
+			TEST_ASSERT(set_ids[i] == (i < NUM_SAMPLES / 2 ?
+					RTE_MEMBER_NO_MATCH : 1),
+					"filter bulk lookup result error");
+		}
+
+		rte_member_reset(filters[j]);
+		for (i = 0; i < NUM_SAMPLES; i++) {
+			ret = rte_member_lookup(filters[j], &keys[i], &set_id);
+			TEST_ASSERT(ret == 0 && set_id == RTE_MEMBER_NO_MATCH,
+					"filter reset error");
+		}
+	}
+
+	/* A cuckoo filter must not lose keys when it becomes full */
+	params.key_len = KEY_SIZE;
+	rte_member_free(setsum_cf);
+	params.name = "test_member_cf";
+	params.type = RTE_MEMBER_TYPE_CF;
+	setsum_cf = rte_member_create(&params);
+	if (setsum_cf == NULL) {
+		printf("Creation of cuckoo filter fail\n");
+		return -1;
+	}
+
+	ret = 0;
+	for (added_keys = 0; added_keys < MAX_ENTRIES; added_keys++) {
+		ret = rte_member_add(setsum_cf, &generated_keys[added_keys], 1);
+		if (ret < 0)
+			break;
+	}
+	TEST_ASSERT(ret == -ENOSPC, "Unexpected error when adding keys");
+
+	for (i = 0; i < added_keys; i++) {
+		ret = rte_member_lookup(setsum_cf, &generated_keys[i], &set_id);
+		TEST_ASSERT(ret == 1, "cuckoo filter false negative");
+	}
+	for (i = 0; i < added_keys; i++) {
+		ret = rte_member_delete(setsum_cf, &generated_keys[i], 1);
+		TEST_ASSERT(ret == 0, "cuckoo filter delete error");
+	}
+
+	printf("\nKeys inserted when no space(cuckoo filter) = %.2f%% (%u/%u)\n",
+		((double)added_keys / params.num_keys * 100),
+		added_keys, params.num_keys);
+	return 0;
+}
+
 static void
 perform_free(void)
 {
 	rte_member_free(setsum_ht);
 	rte_member_free(setsum_cache);
 	rte_member_free(setsum_vbf);
+	rte_member_free(setsum_cf);
+	rte_member_free(setsum_cbf);
 }
 
 static void
@@ -985,6 +1101,10 @@ test_member(void)
 		rte_member_free(setsum_cache);
 		return -1;
 	}
+	if (test_member_filters() < 0) {
+		perform_free();
+		return -1;
+	}
 
 	if (test_member_sketch() < 0) {
 		perform_free();
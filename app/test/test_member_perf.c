@@ -51,6 +51,8 @@ enum sstype {
 	HT = 0,
 	CACHE,
 	VBF,
+	CF,
+	CBF,
 	SKETCH,
 	SKETCH_BOUNDED,
 	SKETCH_BYTE,
@@ -168,6 +170,8 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 
 		data[HT][i] = data[CACHE][i] = (rte_rand() & 0x7FFE) + 1;
 		data[VBF][i] = rte_rand() % VBF_SET_CNT + 1;
+		/* cuckoo filter and counting bloom filter have a single set */
+		data[CF][i] = data[CBF][i] = 1;
 	}
 
 	/* Remove duplicates from the keys array */
@@ -242,6 +246,19 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 	if (params->setsum[VBF] == NULL)
 		fprintf(stderr, "VBF create fail\n");
 
+	member_params.name = "test_member_cbf";
+	member_params.type = RTE_MEMBER_TYPE_CBF;
+	params->setsum[CBF] = rte_member_create(&member_params);
+	if (params->setsum[CBF] == NULL)
+		fprintf(stderr, "CBF create fail\n");
+
+	member_params.name = "test_member_cf";
+	member_params.type = RTE_MEMBER_TYPE_CF;
+	member_params.num_keys = entry_cnt;
+	params->setsum[CF] = rte_member_create(&member_params);
+	if (params->setsum[CF] == NULL)
+		fprintf(stderr, "CF create fail\n");
+
 	member_params.name = "test_member_sketch";
 	member_params.key_len = params->key_size;
 	member_params.type = RTE_MEMBER_TYPE_SKETCH;
@@ -366,8 +383,10 @@ timed_lookups(struct member_perf_params *params, int type)
 				printf("lookup wrong internally");
 				return -1;
 			}
-			if (type == HT && result == RTE_MEMBER_NO_MATCH) {
-				printf("HT mode shouldn't have false negative");
+			if ((type == HT || type == CF || type == CBF) &&
+					result == RTE_MEMBER_NO_MATCH) {
+				printf("type %d shouldn't have false negative",
+					type);
 				return -1;
 			}
 			if (result != data[type][j])
@@ -440,10 +459,10 @@ timed_lookups_bulk(struct member_perf_params *params, int type)
 			}
 			for (k = 0; k < BURST_SIZE; k++) {
 				uint32_t data_idx = j * BURST_SIZE + k;
-				if (type == HT && result[k] ==
-						RTE_MEMBER_NO_MATCH) {
-					printf("HT mode shouldn't have "
-						"false negative");
+				if ((type == HT || type == CF || type == CBF) &&
+						result[k] == RTE_MEMBER_NO_MATCH) {
+					printf("type %d shouldn't have "
+						"false negative", type);
 					return -1;
 				}
 				if (result[k] != data[type][data_idx])
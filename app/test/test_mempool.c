@@ -491,6 +491,61 @@ test_mp_mem_init(struct rte_mempool *mp,
 	data->ret = 0;
 }
 
+struct mp_locality_data {
+	bool anon;
+	int ret;
+};
+
+static void
+test_mp_mem_locality(struct rte_mempool *mp __rte_unused, void *opaque,
+		struct rte_mempool_memhdr *memhdr,
+		unsigned int mem_idx __rte_unused)
+{
+	struct mp_locality_data *data = opaque;
+	struct rte_mempool_mem_locality loc;
+
+	if (rte_mempool_mem_locality_get(memhdr, &loc) < 0 ||
+			loc.page_sz == 0 || loc.nb_pages == 0 ||
+			(loc.socket_id == SOCKET_ID_ANY) != data->anon) {
+		printf("wrong locality of chunk %p: socket %d, page size %"
+			PRIu64 ", %u pages\n", memhdr->addr, loc.socket_id,
+			loc.page_sz, loc.nb_pages);
+		data->ret = -1;
+	}
+}
+
+/* check the locality of the chunks of a mempool, and of its objects */
+static int
+test_mempool_locality(struct rte_mempool *mp, bool anon)
+{
+	struct mp_locality_data data = { .anon = anon, .ret = 0 };
+	uint64_t samples, remote;
+	void *obj;
+	int ret;
+
+	if (rte_mempool_mem_iter(mp, test_mp_mem_locality, &data) == 0 ||
+			data.ret < 0)
+		RET_ERR();
+	if (rte_mempool_mem_locality_get(NULL, NULL) != -EINVAL)
+		RET_ERR();
+
+	ret = rte_mempool_locality_stats_get(mp, &samples, &remote);
+	if (ret == -ENOTSUP)
+		return 0;
+	if (ret < 0 || remote > samples)
+		RET_ERR();
+
+	/* objects outside of DPDK memory are never sampled */
+	if (rte_mempool_get(mp, &obj) < 0)
+		RET_ERR();
+	rte_mempool_put(mp, obj);
+	ret = rte_mempool_locality_stats_get(mp, &samples, &remote);
+	if (ret < 0 || (anon && samples != 0))
+		RET_ERR();
+
+	return 0;
+}
+
 struct test_mempool_events_data {
 	struct rte_mempool *mp;
 	enum rte_mempool_event event;
@@ -1081,6 +1136,12 @@ test_mempool(void)
 	if (test_mempool_basic(mp_stack, 1) < 0)
 		GOTO_ERR(ret, err);
 
+	/* test the memory locality of mempools */
+	if (test_mempool_locality(mp_cache, false) < 0)
+		GOTO_ERR(ret, err);
+	if (test_mempool_locality(mp_stack_anon, true) < 0)
+		GOTO_ERR(ret, err);
+
 	if (test_mempool_basic(default_pool, 1) < 0)
 		GOTO_ERR(ret, err);
 
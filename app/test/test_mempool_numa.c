@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mempool.h>
+#include <rte_mempool_numa.h>
+
+#include "test.h"
+
+#define MEMPOOL_ELT_SIZE 2048
+#define MEMPOOL_SIZE 1023
+#define MEMPOOL_CACHE_SIZE 32
+
+static struct rte_mempool *
+numa_mempool_create(const char *name, unsigned int cache_size)
+{
+	struct rte_mempool *mp;
+
+	mp = rte_mempool_create_empty(name, MEMPOOL_SIZE, MEMPOOL_ELT_SIZE,
+		cache_size, 0, SOCKET_ID_ANY, 0);
+	if (mp == NULL)
+		return NULL;
+	if (rte_mempool_set_ops_byname(mp, RTE_MEMPOOL_NUMA_OPS_NAME,
+			NULL) < 0 ||
+			rte_mempool_numa_populate(mp) != (int)mp->size) {
+		rte_mempool_free(mp);
+		return NULL;
+	}
+	return mp;
+}
+
+/* Get all the objects from the pool, then put them back. */
+static int
+test_mempool_numa_get_all(void)
+{
+	struct rte_mempool *mp;
+	unsigned int nb_objs = 0;
+	void **objs;
+	void *obj;
+	int ret = TEST_FAILED;
+
+	mp = numa_mempool_create("test_numa_cache", MEMPOOL_CACHE_SIZE);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create NUMA mempool");
+	objs = rte_calloc(__func__, MEMPOOL_SIZE, sizeof(void *), 0);
+	if (objs == NULL) {
+		printf("Cannot allocate object table\n");
+		goto exit;
+	}
+
+	if (rte_mempool_numa_populate(mp) != -EEXIST) {
+		printf("NUMA mempool populated twice\n");
+		goto exit;
+	}
+
+	for (nb_objs = 0; nb_objs < MEMPOOL_SIZE; nb_objs++) {
+		if (rte_mempool_get(mp, &objs[nb_objs]) < 0) {
+			printf("Cannot get object %u\n", nb_objs);
+			goto exit;
+		}
+	}
+	if (rte_mempool_get(mp, &obj) == 0) {
+		printf("Got an object from an empty mempool\n");
+		rte_mempool_put(mp, obj);
+		goto exit;
+	}
+	if (rte_mempool_empty(mp) != 1) {
+		printf("Mempool should be empty\n");
+		goto exit;
+	}
+
+	rte_mempool_put_bulk(mp, objs, nb_objs);
+	nb_objs = 0;
+	if (rte_mempool_full(mp) != 1) {
+		printf("Mempool should be full\n");
+		goto exit;
+	}
+	ret = TEST_SUCCESS;
+
+exit:
+	if (nb_objs != 0)
+		rte_mempool_put_bulk(mp, objs, nb_objs);
+	rte_free(objs);
+	rte_mempool_free(mp);
+	return ret;
+}
+
+/* Without cache, every get and put is counted by the driver. */
+static int
+test_mempool_numa_stats(void)
+{
+	struct rte_mempool_numa_stats stats;
+	struct rte_mempool *mp;
+	void *obj;
+	int ret = TEST_FAILED;
+
+	mp = numa_mempool_create("test_numa_nocache", 0);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create NUMA mempool");
+
+	if (rte_mempool_numa_stats_reset(mp) < 0) {
+		printf("Cannot reset stats\n");
+		goto exit;
+	}
+	if (rte_mempool_get(mp, &obj) < 0) {
+		printf("Cannot get object\n");
+		goto exit;
+	}
+	rte_mempool_put(mp, obj);
+	if (rte_mempool_numa_stats_get(mp, SOCKET_ID_ANY, &stats) < 0) {
+		printf("Cannot get stats\n");
+		goto exit;
+	}
+	if (stats.alloc_local + stats.alloc_remote != 1 ||
+			stats.free_local + stats.free_remote != 1) {
+		printf("Wrong stats: alloc %"PRIu64"/%"PRIu64
+			" free %"PRIu64"/%"PRIu64"\n",
+			stats.alloc_local, stats.alloc_remote,
+			stats.free_local, stats.free_remote);
+		goto exit;
+	}
+	if (rte_mempool_avail_count(mp) != mp->size) {
+		printf("Object not returned to the mempool\n");
+		goto exit;
+	}
+
+	/* stats of an invalid mempool */
+	if (rte_mempool_numa_stats_get(NULL, SOCKET_ID_ANY, &stats) !=
+			-EINVAL) {
+		printf("Got stats of an invalid mempool\n");
+		goto exit;
+	}
+	ret = TEST_SUCCESS;
+
+exit:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+static struct unit_test_suite mempool_numa_testsuite = {
+	.suite_name = "NUMA mempool driver unit test suite",
+	.unit_test_cases = {
+		TEST_CASE(test_mempool_numa_get_all),
+		TEST_CASE(test_mempool_numa_stats),
+
+		TEST_CASES_END() /**< NULL terminate unit test array */
+	}
+};
+
+static int
+test_mempool_numa(void)
+{
+	return unit_test_suite_runner(&mempool_numa_testsuite);
+}
+
+REGISTER_FAST_TEST(mempool_numa_autotest, false, true, test_mempool_numa);
@@ -26,6 +26,7 @@
 #include <rte_spinlock.h>
 #include <rte_malloc.h>
 #include <rte_mbuf_pool_ops.h>
+#include <rte_ring.h>
 
 #include "test.h"
 
@@ -66,6 +67,12 @@
  *      - 2048
  *      - 8192
  *      - 32768
+ *
+ *    An asymmetric test is also done with two cores: the main core only
+ *    gets objects and passes them through a ring to a worker core, which
+ *    only puts them back. It is done with the default cache, with an
+ *    adaptive cache, and with the cache of the worker core paired to the
+ *    cache of the main core.
  */
 
 #define TIME_S 1
@@ -112,6 +119,10 @@ struct __rte_cache_aligned mempool_test_stats {
 
 static struct mempool_test_stats stats[RTE_MAX_LCORE];
 
+/* ring between the allocating and the freeing core of the asymmetric test */
+static struct rte_ring *asym_ring;
+static RTE_ATOMIC(uint32_t) asym_stop;
+
 /*
  * save the object number in the first 4 bytes of object data. All
  * other bytes are set to 0.
@@ -435,6 +446,153 @@ do_all_mempool_perf_tests(unsigned int cores)
 	return ret;
 }
 
+/* freeing side of the asymmetric test: put back all objects received */
+static int
+asym_free_lcore(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	void *obj_table[RTE_MEMPOOL_CACHE_MAX_SIZE];
+	unsigned int n;
+
+	while (rte_atomic_load_explicit(&synchro, rte_memory_order_relaxed) == 0)
+		rte_pause();
+
+	for (;;) {
+		n = rte_ring_sc_dequeue_burst(asym_ring, obj_table,
+				RTE_DIM(obj_table), NULL);
+		if (n != 0)
+			rte_mempool_put_bulk(mp, obj_table, n);
+		else if (rte_atomic_load_explicit(&asym_stop,
+				rte_memory_order_acquire) != 0)
+			break;
+	}
+
+	return 0;
+}
+
+/* allocating side of the asymmetric test, on the main core */
+static int
+asym_alloc_lcore(struct rte_mempool *mp, unsigned int n_bulk)
+{
+	void *obj_table[RTE_MEMPOOL_CACHE_MAX_SIZE];
+	uint64_t start_cycles, time_diff = 0;
+	uint64_t hz = rte_get_timer_hz();
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int i, n;
+
+	start_cycles = rte_get_timer_cycles();
+	while (time_diff / hz < TIME_S) {
+		for (i = 0; i < 1024; i++) {
+			while (rte_mempool_get_bulk(mp, obj_table, n_bulk) < 0)
+				rte_pause();
+			n = 0;
+			while (n < n_bulk)
+				n += rte_ring_sp_enqueue_burst(asym_ring,
+						&obj_table[n], n_bulk - n, NULL);
+		}
+		stats[lcore_id].enq_count += 1024 * n_bulk;
+		time_diff = rte_get_timer_cycles() - start_cycles;
+	}
+	stats[lcore_id].duration_cycles = time_diff;
+
+	return 0;
+}
+
+static int
+do_one_asym_mempool_test(struct rte_mempool *mp, unsigned int free_lcore,
+			 const char *mode)
+{
+	unsigned int bulk_tab[] = { 1, CACHE_LINE_BURST, 32, 64, 256, 0 };
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int *bulk_ptr;
+	uint64_t rate;
+	int ret = 0;
+
+	for (bulk_ptr = bulk_tab; *bulk_ptr; bulk_ptr++) {
+		memset(stats, 0, sizeof(stats));
+		rte_atomic_store_explicit(&synchro, 0, rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&asym_stop, 0, rte_memory_order_relaxed);
+
+		printf("mempool_autotest asymmetric cache=%u mode=%s n_bulk=%u ",
+		       mp->cache_size, mode, *bulk_ptr);
+
+		rte_eal_remote_launch(asym_free_lcore, mp, free_lcore);
+		rte_atomic_store_explicit(&synchro, 1, rte_memory_order_relaxed);
+		asym_alloc_lcore(mp, *bulk_ptr);
+		rte_atomic_store_explicit(&asym_stop, 1, rte_memory_order_release);
+		if (rte_eal_wait_lcore(free_lcore) < 0)
+			ret = -1;
+
+		rate = (double)stats[lcore_id].enq_count * rte_get_timer_hz() /
+			(double)stats[lcore_id].duration_cycles;
+		printf("rate_persec=%" PRIu64 "\n", rate);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int
+do_asym_mempool_perf_tests(void)
+{
+	struct rte_mempool *mp;
+	unsigned int free_lcore;
+	int ret = -1;
+
+	free_lcore = rte_get_next_lcore(-1, 1, 0);
+	if (free_lcore >= RTE_MAX_LCORE) {
+		printf("not enough lcores\n");
+		return -1;
+	}
+
+	asym_ring = rte_ring_create("perf_test_asym", 4096, SOCKET_ID_ANY,
+				    RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (asym_ring == NULL) {
+		printf("cannot allocate ring\n");
+		return -1;
+	}
+
+	/* a fresh mempool per mode, as pairing cannot be undone */
+	mp = rte_mempool_create("perf_test_asym", MEMPOOL_SIZE,
+				MEMPOOL_ELT_SIZE, 256, 0, NULL, NULL,
+				my_obj_init, NULL, SOCKET_ID_ANY, 0);
+	if (mp == NULL)
+		GOTO_ERR(ret, err);
+	printf("start asymmetric performance test (default cache)\n");
+	if (do_one_asym_mempool_test(mp, free_lcore, "default") < 0)
+		GOTO_ERR(ret, err);
+	rte_mempool_free(mp);
+
+	mp = rte_mempool_create("perf_test_asym", MEMPOOL_SIZE,
+				MEMPOOL_ELT_SIZE, 256, 0, NULL, NULL,
+				my_obj_init, NULL, SOCKET_ID_ANY, 0);
+	if (mp == NULL || rte_mempool_cache_adaptive_enable(mp) < 0)
+		GOTO_ERR(ret, err);
+	printf("start asymmetric performance test (adaptive cache)\n");
+	if (do_one_asym_mempool_test(mp, free_lcore, "adaptive") < 0)
+		GOTO_ERR(ret, err);
+	rte_mempool_free(mp);
+
+	mp = rte_mempool_create("perf_test_asym", MEMPOOL_SIZE,
+				MEMPOOL_ELT_SIZE, 256, 0, NULL, NULL,
+				my_obj_init, NULL, SOCKET_ID_ANY, 0);
+	if (mp == NULL ||
+	    rte_mempool_cache_pair(mp, free_lcore, rte_lcore_id()) < 0)
+		GOTO_ERR(ret, err);
+	printf("start asymmetric performance test (paired caches)\n");
+	if (do_one_asym_mempool_test(mp, free_lcore, "paired") < 0)
+		GOTO_ERR(ret, err);
+
+	ret = 0;
+
+err:
+	rte_mempool_free(mp);
+	rte_ring_free(asym_ring);
+	asym_ring = NULL;
+	return ret;
+}
+
 static int
 test_mempool_perf_1core(void)
 {
@@ -448,7 +606,19 @@ test_mempool_perf_2cores(void)
 		printf("not enough lcores\n");
 		return -1;
 	}
-	return do_all_mempool_perf_tests(2);
+	if (do_all_mempool_perf_tests(2) < 0)
+		return -1;
+	return do_asym_mempool_perf_tests();
+}
+
+static int
+test_mempool_perf_asymmetric(void)
+{
+	if (rte_lcore_count() < 2) {
+		printf("not enough lcores\n");
+		return -1;
+	}
+	return do_asym_mempool_perf_tests();
 }
 
 static int
@@ -470,6 +640,8 @@ test_mempool_perf(void)
 
 	if (do_all_mempool_perf_tests(2) < 0)
 		goto err;
+	if (do_asym_mempool_perf_tests() < 0)
+		goto err;
 	if (rte_lcore_count() == 2)
 		goto done;
 
@@ -487,3 +659,4 @@ REGISTER_PERF_TEST(mempool_perf_autotest, test_mempool_perf);
 REGISTER_PERF_TEST(mempool_perf_autotest_1core, test_mempool_perf_1core);
 REGISTER_PERF_TEST(mempool_perf_autotest_2cores, test_mempool_perf_2cores);
 REGISTER_PERF_TEST(mempool_perf_autotest_allcores, test_mempool_perf_allcores);
+REGISTER_PERF_TEST(mempool_perf_autotest_asymmetric, test_mempool_perf_asymmetric);
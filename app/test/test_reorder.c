@@ -489,6 +489,112 @@ test_reorder_set_seqn(void)
 	return ret;
 }
 
+static int
+test_reorder_multi_window(void)
+{
+#define MW_NUM_WINDOWS 4u
+#define MW_NUM_BUFS 32u
+
+	struct rte_mempool *p = test_params->p;
+	struct rte_reorder_mw *mw = NULL;
+	struct rte_mbuf *bufs[MW_NUM_BUFS] = { NULL };
+	struct rte_mbuf *pkts[MW_NUM_BUFS];
+	struct rte_mbuf *robufs[MW_NUM_BUFS];
+	const unsigned int size = 8;
+	unsigned int i, w, cnt;
+	int ret = 0;
+
+	mw = rte_reorder_mw_create(NULL, rte_socket_id(), MW_NUM_WINDOWS, size);
+	TEST_ASSERT((mw == NULL) && (rte_errno == EINVAL),
+			"No error on create() with NULL name");
+	mw = rte_reorder_mw_create("test_mw", rte_socket_id(), 3, size);
+	TEST_ASSERT((mw == NULL) && (rte_errno == EINVAL),
+			"No error on create() with invalid number of windows");
+	mw = rte_reorder_mw_create("test_mw", rte_socket_id(), MW_NUM_WINDOWS,
+			REORDER_BUFFER_SIZE_INVALID);
+	TEST_ASSERT((mw == NULL) && (rte_errno == EINVAL),
+			"No error on create() with invalid buffer size");
+
+	mw = rte_reorder_mw_create("test_mw", rte_socket_id(), MW_NUM_WINDOWS, size);
+	TEST_ASSERT_NOT_NULL(mw, "Failed to create multi-window reorder object");
+	TEST_ASSERT_EQUAL(rte_reorder_mw_window_count(mw), MW_NUM_WINDOWS,
+			"Wrong number of windows");
+
+	for (i = 0; i < MW_NUM_BUFS; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		if (bufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			ret = -1;
+			goto exit;
+		}
+		bufs[i]->hash.rss = i;
+		pkts[i] = bufs[i];
+	}
+
+	/* each window gets its own sequence space: 0, 1, 2, ... */
+	rte_reorder_mw_seqn_assign(mw, bufs, MW_NUM_BUFS);
+	for (i = 0; i < MW_NUM_BUFS; i++) {
+		if (*rte_reorder_seqn(bufs[i]) != i / MW_NUM_WINDOWS) {
+			printf("%s:%d: Wrong sequence number %u for packet %u\n",
+					__func__, __LINE__,
+					*rte_reorder_seqn(bufs[i]), i);
+			ret = -1;
+			goto exit;
+		}
+	}
+
+	/* first packet of each window, then the others in reverse order */
+	for (i = 0; i < MW_NUM_WINDOWS; i++) {
+		ret = rte_reorder_mw_insert(mw, bufs[i]);
+		if (ret != 0) {
+			printf("%s:%d: Error inserting packet %u\n",
+					__func__, __LINE__, i);
+			goto exit;
+		}
+		bufs[i] = NULL;
+	}
+	for (i = MW_NUM_BUFS - 1; i >= MW_NUM_WINDOWS; i--) {
+		ret = rte_reorder_mw_insert(mw, bufs[i]);
+		if (ret != 0) {
+			printf("%s:%d: Error inserting packet %u\n",
+					__func__, __LINE__, i);
+			goto exit;
+		}
+		bufs[i] = NULL;
+	}
+
+	/* every window returns its own flow in order */
+	for (w = 0; w < MW_NUM_WINDOWS; w++) {
+		cnt = rte_reorder_mw_drain(mw, w, robufs, MW_NUM_BUFS);
+		if (cnt != MW_NUM_BUFS / MW_NUM_WINDOWS) {
+			printf("%s:%d: drained %u packets from window %u\n",
+					__func__, __LINE__, cnt, w);
+			ret = -1;
+			goto exit;
+		}
+		for (i = 0; i < cnt; i++) {
+			if (robufs[i] != pkts[i * MW_NUM_WINDOWS + w]) {
+				printf("%s:%d: Packet %u of window %u out of order\n",
+						__func__, __LINE__, i, w);
+				ret = -1;
+				break;
+			}
+		}
+		rte_pktmbuf_free_bulk(robufs, cnt);
+		if (ret != 0)
+			goto exit;
+	}
+
+	ret = 0;
+exit:
+	/* mbufs still held by the windows are freed with the object */
+	rte_reorder_mw_free(mw);
+	for (i = 0; i < MW_NUM_BUFS; i++)
+		rte_pktmbuf_free(bufs[i]);
+
+	return ret;
+}
+
 static int
 test_setup(void)
 {
@@ -541,6 +647,7 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_drain),
 		TEST_CASE(test_reorder_drain_up_to_seqn),
 		TEST_CASE(test_reorder_set_seqn),
+		TEST_CASE(test_reorder_multi_window),
 		TEST_CASES_END()
 	}
 };
@@ -0,0 +1,259 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_reorder.h>
+
+#include "test.h"
+
+/*
+ * Compare the single sequence space reorder buffer, which has to be
+ * drained by one lcore, with the multi-window reorder object serviced by
+ * an increasing number of lcores. Packets of NB_FLOWS flows arrive
+ * slightly out of order and are inserted and drained in blocks.
+ */
+
+#define NB_PKTS (1 << 16)
+#define NB_FLOWS 4096
+#define NB_WINDOWS 64
+#define BLOCK_SIZE 256
+#define MAX_DISPLACEMENT 16
+#define ITERATIONS 16
+#define SINGLE_SIZE 1024
+#define WINDOW_SIZE 256
+
+static struct rte_mempool *pool;
+/* packets in their original order */
+static struct rte_mbuf *orig[NB_PKTS];
+/* packets in their arrival order */
+static struct rte_mbuf *arrival[NB_PKTS];
+
+struct __rte_cache_aligned reorder_perf_lcore {
+	struct rte_reorder_mw *mw;
+	/* the part of 'arrival' that belongs to the windows of this lcore */
+	struct rte_mbuf **pkts;
+	unsigned int nb_pkts;
+	unsigned int id;
+	unsigned int nb_lcores;
+	uint64_t cycles;
+	uint64_t drained;
+	uint64_t failed;
+};
+
+static struct reorder_perf_lcore lcore_args[RTE_MAX_LCORE];
+
+static void
+reorder_perf_shuffle(void)
+{
+	struct rte_mbuf *m;
+	unsigned int i, j;
+
+	for (i = 0; i < NB_PKTS; i++)
+		arrival[i] = orig[i];
+
+	/* move every packet at most MAX_DISPLACEMENT positions later */
+	for (i = 0; i < NB_PKTS - MAX_DISPLACEMENT; i++) {
+		j = i + rte_rand_max(MAX_DISPLACEMENT);
+		m = arrival[i];
+		arrival[i] = arrival[j];
+		arrival[j] = m;
+	}
+}
+
+static int
+reorder_perf_single(void)
+{
+	struct rte_reorder_buffer *b;
+	struct rte_mbuf *out[BLOCK_SIZE];
+	uint64_t cycles = 0, drained = 0, failed = 0, start;
+	unsigned int i, j, n, it;
+
+	b = rte_reorder_create("reorder_perf", rte_socket_id(), SINGLE_SIZE);
+	if (b == NULL) {
+		printf("Cannot create reorder buffer\n");
+		return -1;
+	}
+
+	for (i = 0; i < NB_PKTS; i++)
+		*rte_reorder_seqn(orig[i]) = i;
+
+	for (it = 0; it < ITERATIONS; it++) {
+		rte_reorder_reset(b);
+		rte_reorder_min_seqn_set(b, 0);
+
+		start = rte_rdtsc_precise();
+		for (i = 0; i < NB_PKTS; i += BLOCK_SIZE) {
+			for (j = i; j < i + BLOCK_SIZE; j++)
+				failed += rte_reorder_insert(b, arrival[j]) != 0;
+			do {
+				n = rte_reorder_drain(b, out, BLOCK_SIZE);
+				drained += n;
+			} while (n != 0);
+		}
+		cycles += rte_rdtsc_precise() - start;
+	}
+
+	/* the buffer only holds packets left behind by failed inserts */
+	if (failed == 0)
+		rte_reorder_free(b);
+
+	printf("single window, 1 lcore: %.2f cycles/pkt, %"PRIu64" drained, %"PRIu64" failed\n",
+			(double)cycles / ((uint64_t)NB_PKTS * ITERATIONS),
+			drained, failed);
+
+	return failed == 0 && drained == (uint64_t)NB_PKTS * ITERATIONS ? 0 : -1;
+}
+
+static int
+reorder_perf_mw_lcore(void *arg)
+{
+	struct reorder_perf_lcore *la = arg;
+	struct rte_mbuf *out[BLOCK_SIZE];
+	unsigned int i, j, w, n, end;
+	uint64_t start;
+
+	start = rte_rdtsc_precise();
+	for (i = 0; i < la->nb_pkts; i += BLOCK_SIZE) {
+		end = RTE_MIN(i + BLOCK_SIZE, la->nb_pkts);
+		for (j = i; j < end; j++)
+			la->failed += rte_reorder_mw_insert(la->mw, la->pkts[j]) != 0;
+		for (w = la->id; w < NB_WINDOWS; w += la->nb_lcores) {
+			do {
+				n = rte_reorder_mw_drain(la->mw, w, out, BLOCK_SIZE);
+				la->drained += n;
+			} while (n != 0);
+		}
+	}
+	la->cycles += rte_rdtsc_precise() - start;
+
+	return 0;
+}
+
+static int
+reorder_perf_mw(struct rte_reorder_mw *mw, unsigned int nb_lcores)
+{
+	struct rte_mbuf **pkts;
+	uint64_t cycles = 0, drained = 0, failed = 0, max_cycles;
+	unsigned int i, j, k, lcore_id, it;
+
+	pkts = rte_malloc(NULL, sizeof(pkts[0]) * NB_PKTS, 0);
+	if (pkts == NULL)
+		return -1;
+
+	/* split the arrival order between lcores by window ownership */
+	memset(lcore_args, 0, sizeof(lcore_args));
+	for (i = 0, k = 0; k < nb_lcores; k++) {
+		lcore_args[k].mw = mw;
+		lcore_args[k].pkts = &pkts[i];
+		lcore_args[k].id = k;
+		lcore_args[k].nb_lcores = nb_lcores;
+		for (j = 0; j < NB_PKTS; j++) {
+			if (rte_reorder_mw_window(mw, arrival[j]) % nb_lcores == k)
+				pkts[i++] = arrival[j];
+		}
+		lcore_args[k].nb_pkts = &pkts[i] - lcore_args[k].pkts;
+	}
+
+	for (it = 0; it < ITERATIONS; it++) {
+		rte_reorder_mw_reset(mw);
+		rte_reorder_mw_seqn_assign(mw, orig, NB_PKTS);
+
+		k = 1;
+		RTE_LCORE_FOREACH_WORKER(lcore_id) {
+			if (k == nb_lcores)
+				break;
+			rte_eal_remote_launch(reorder_perf_mw_lcore,
+					&lcore_args[k++], lcore_id);
+		}
+		reorder_perf_mw_lcore(&lcore_args[0]);
+		rte_eal_mp_wait_lcore();
+	}
+
+	max_cycles = 0;
+	for (k = 0; k < nb_lcores; k++) {
+		max_cycles = RTE_MAX(max_cycles, lcore_args[k].cycles);
+		cycles += lcore_args[k].cycles;
+		drained += lcore_args[k].drained;
+		failed += lcore_args[k].failed;
+	}
+	rte_free(pkts);
+
+	printf("%u windows, %u lcore(s): %.2f cycles/pkt (%.2f per lcore), %"PRIu64" drained, %"PRIu64" failed\n",
+			NB_WINDOWS, nb_lcores,
+			(double)max_cycles / ((uint64_t)NB_PKTS * ITERATIONS),
+			(double)cycles / ((uint64_t)NB_PKTS * ITERATIONS),
+			drained, failed);
+
+	return failed == 0 && drained == (uint64_t)NB_PKTS * ITERATIONS ? 0 : -1;
+}
+
+static int
+test_reorder_perf(void)
+{
+	struct rte_reorder_mw *mw = NULL;
+	uint32_t flows[NB_FLOWS];
+	unsigned int i, nb_lcores;
+	int ret = -1;
+
+	pool = rte_pktmbuf_pool_create("reorder_perf_pool", NB_PKTS, 0, 0, 0,
+			rte_socket_id());
+	if (pool == NULL) {
+		printf("Cannot create mbuf pool\n");
+		return -1;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(pool, orig, NB_PKTS) != 0) {
+		printf("Cannot allocate mbufs\n");
+		goto exit;
+	}
+
+	for (i = 0; i < NB_FLOWS; i++)
+		flows[i] = (uint32_t)rte_rand();
+	for (i = 0; i < NB_PKTS; i++)
+		orig[i]->hash.rss = flows[rte_rand_max(NB_FLOWS)];
+	reorder_perf_shuffle();
+
+	printf("\n### reorder: %u packets, %u flows, max displacement %u ###\n",
+			NB_PKTS, NB_FLOWS, MAX_DISPLACEMENT);
+
+	if (reorder_perf_single() != 0)
+		goto exit;
+
+	mw = rte_reorder_mw_create("reorder_perf_mw", rte_socket_id(),
+			NB_WINDOWS, WINDOW_SIZE);
+	if (mw == NULL) {
+		printf("Cannot create multi-window reorder object\n");
+		goto exit;
+	}
+
+	for (nb_lcores = 1; nb_lcores <= rte_lcore_count() &&
+			nb_lcores <= NB_WINDOWS; nb_lcores <<= 1) {
+		if (reorder_perf_mw(mw, nb_lcores) != 0) {
+			/* windows may still hold packets owned by 'orig' */
+			mw = NULL;
+			goto exit;
+		}
+	}
+
+	ret = 0;
+exit:
+	rte_reorder_mw_free(mw);
+	if (ret == 0)
+		rte_pktmbuf_free_bulk(orig, NB_PKTS);
+	rte_mempool_free(pool);
+	pool = NULL;
+
+	return ret;
+}
+
+REGISTER_PERF_TEST(reorder_perf_autotest, test_reorder_perf);
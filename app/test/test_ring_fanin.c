@@ -0,0 +1,192 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_ring_fanin.h>
+
+#include "test.h"
+
+#define FANIN_RINGS	70	/* more than one bitmap word */
+#define FANIN_ELEMS	16
+
+static struct rte_ring_fanin *
+fanin_create(uint32_t nb_rings, uint32_t quantum)
+{
+	struct rte_ring_fanin_param prm = {
+		.name = "test_fanin",
+		.nb_rings = nb_rings,
+		.elems = FANIN_ELEMS,
+		.elem_size = sizeof(uint32_t),
+		.quantum = quantum,
+	};
+	struct rte_ring_fanin *f;
+	ssize_t sz;
+
+	sz = rte_ring_fanin_get_memsize(&prm);
+	if (sz < 0)
+		return NULL;
+	f = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (f == NULL)
+		return NULL;
+	if (rte_ring_fanin_init(f, &prm) != 0) {
+		rte_free(f);
+		return NULL;
+	}
+	return f;
+}
+
+static int
+test_ring_fanin_param(void)
+{
+	struct rte_ring_fanin_param prm = {
+		.name = "test_fanin",
+		.nb_rings = 4,
+		.elems = FANIN_ELEMS,
+		.elem_size = sizeof(uint32_t),
+	};
+	struct rte_ring_fanin *f;
+	int ret;
+
+	RTE_TEST_ASSERT(rte_ring_fanin_get_memsize(&prm) > 0,
+			"failed to calculate size");
+
+	f = rte_zmalloc(NULL, rte_ring_fanin_get_memsize(&prm),
+			RTE_CACHE_LINE_SIZE);
+	RTE_TEST_ASSERT_NOT_NULL(f, "cannot allocate fan-in");
+	prm.name = NULL;
+	ret = rte_ring_fanin_init(f, &prm);
+	rte_free(f);
+	RTE_TEST_ASSERT_EQUAL(ret, -EINVAL, "initialized without name");
+	prm.name = "test_fanin";
+
+	prm.nb_rings = 0;
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_get_memsize(&prm), -EINVAL,
+			"calculated size with no ring");
+
+	prm.nb_rings = 4;
+	prm.elem_size = 6;
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_get_memsize(&prm), -EINVAL,
+			"calculated size with esize not multiple of 4");
+
+	return 0;
+}
+
+/* all rings are drained in round-robin order, one quantum at a time */
+static int
+test_ring_fanin_fair(void)
+{
+	uint32_t objs[FANIN_ELEMS], out[FANIN_RINGS * FANIN_ELEMS];
+	struct rte_ring_fanin *f;
+	uint32_t i, j, n;
+
+	f = fanin_create(FANIN_RINGS, 2);
+	RTE_TEST_ASSERT_NOT_NULL(f, "cannot create fan-in");
+
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_dequeue_burst(f, out, 8), 0,
+			"dequeued from an empty fan-in");
+
+	/* ring i holds 4 objects: i * 100 + 0..3 */
+	for (i = 0; i < FANIN_RINGS; i++) {
+		for (j = 0; j < 4; j++)
+			objs[j] = i * 100 + j;
+		RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_enqueue_bulk(f, i, objs,
+				4, NULL), 4, "enqueue to ring %u failed", i);
+	}
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_count(f), FANIN_RINGS * 4,
+			"wrong count");
+
+	/* first round, two rings per call */
+	for (n = 0; n < FANIN_RINGS * 2; n += 4)
+		RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_dequeue_burst(f, out + n,
+				4), 4, "first round");
+	for (i = 0; i < FANIN_RINGS; i++) {
+		RTE_TEST_ASSERT_EQUAL(out[2 * i], i * 100,
+				"object %u is %u", 2 * i, out[2 * i]);
+		RTE_TEST_ASSERT_EQUAL(out[2 * i + 1], i * 100 + 1,
+				"object %u is %u", 2 * i + 1, out[2 * i + 1]);
+	}
+
+	/* second round in one call, which stops when all rings are empty */
+	n = rte_ring_fanin_dequeue_burst(f, out, RTE_DIM(out));
+	RTE_TEST_ASSERT_EQUAL(n, FANIN_RINGS * 2, "second round");
+	for (i = 0; i < FANIN_RINGS; i++) {
+		RTE_TEST_ASSERT_EQUAL(out[2 * i], i * 100 + 2,
+				"object %u is %u", 2 * i, out[2 * i]);
+		RTE_TEST_ASSERT_EQUAL(out[2 * i + 1], i * 100 + 3,
+				"object %u is %u", 2 * i + 1, out[2 * i + 1]);
+	}
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_dequeue_burst(f, out, 8), 0,
+			"fan-in not empty");
+
+	/* a full ring rejects a bulk, the others are not affected */
+	for (j = 0; j < FANIN_ELEMS; j++)
+		objs[j] = j;
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_enqueue_bulk(f, 69, objs,
+			FANIN_ELEMS, NULL), FANIN_ELEMS, "fill ring");
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_enqueue_bulk(f, 69, objs, 1,
+			NULL), 0, "enqueued to a full ring");
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_enqueue_burst(f, 0, objs, 1,
+			NULL), 1, "enqueue to ring 0");
+	n = rte_ring_fanin_dequeue_burst(f, out, RTE_DIM(out));
+	RTE_TEST_ASSERT_EQUAL(n, FANIN_ELEMS + 1, "drain all");
+
+	rte_ring_fanin_dump(stdout, f);
+	rte_free(f);
+	return 0;
+}
+
+/* a ring with a bigger quantum gets a bigger share */
+static int
+test_ring_fanin_weighted(void)
+{
+	uint32_t objs[FANIN_ELEMS], out[FANIN_ELEMS];
+	uint32_t i, n, from0 = 0;
+	struct rte_ring_fanin *f;
+
+	f = fanin_create(2, 1);
+	RTE_TEST_ASSERT_NOT_NULL(f, "cannot create fan-in");
+	RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_set_quantum(f, 0, 3), 0,
+			"set quantum");
+	RTE_TEST_ASSERT_FAIL(rte_ring_fanin_set_quantum(f, 2, 3),
+			"set quantum of an invalid ring");
+	RTE_TEST_ASSERT_FAIL(rte_ring_fanin_set_quantum(f, 1, 0),
+			"set a null quantum");
+
+	for (i = 0; i < FANIN_ELEMS; i++)
+		objs[i] = i;
+	for (i = 0; i < 2; i++)
+		RTE_TEST_ASSERT_EQUAL(rte_ring_fanin_enqueue_bulk(f, i, objs,
+				FANIN_ELEMS, NULL), FANIN_ELEMS, "enqueue");
+
+	n = rte_ring_fanin_dequeue_burst(f, out, 8);
+	RTE_TEST_ASSERT_EQUAL(n, 8, "dequeue");
+	/* 3 from ring 0, 1 from ring 1, 3 from ring 0, 1 from ring 1 */
+	for (i = 0; i < n; i++)
+		from0 += (i % 4) < 3;
+	RTE_TEST_ASSERT_EQUAL(from0, 6, "ring 0 share");
+	RTE_TEST_ASSERT_EQUAL(out[3], 0, "first object of ring 1");
+	RTE_TEST_ASSERT_EQUAL(out[4], 3, "fourth object of ring 0");
+
+	rte_free(f);
+	return 0;
+}
+
+static int
+test_ring_fanin(void)
+{
+	if (test_ring_fanin_param() < 0)
+		return -1;
+	if (test_ring_fanin_fair() < 0)
+		return -1;
+	if (test_ring_fanin_weighted() < 0)
+		return -1;
+	return 0;
+}
+
+REGISTER_FAST_TEST(ring_fanin_autotest, true, true, test_ring_fanin);
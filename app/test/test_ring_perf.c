@@ -7,6 +7,8 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include <rte_ring.h>
+#include <rte_ring_fanin.h>
+#include <rte_malloc.h>
 #include <rte_cycles.h>
 #include <rte_launch.h>
 #include <rte_pause.h>
@@ -668,6 +670,127 @@ test_ring_perf_compression(void)
 	return ret;
 }
 
+/*
+ * Fan-in of many producers to one consumer: compare a single MP/SC ring
+ * with a fan-in of one SP/SC ring per producer. The workers produce,
+ * the main lcore consumes and measures its dequeue rate.
+ */
+static struct rte_ring *fanin_mp_ring;
+static struct rte_ring_fanin *fanin;
+static RTE_ATOMIC(uint32_t) fanin_stop;
+static unsigned int fanin_bsz;
+static unsigned int fanin_idx[RTE_MAX_LCORE];
+
+static int
+fanin_producer(void *arg)
+{
+	const int use_fanin = (uintptr_t)arg;
+	const unsigned int idx = fanin_idx[rte_lcore_id()];
+	void *burst[MAX_BURST] = { NULL };
+
+	rte_wait_until_equal_32((uint32_t *)(uintptr_t)&synchro, 1,
+			rte_memory_order_relaxed);
+
+	while (rte_atomic_load_explicit(&fanin_stop,
+			rte_memory_order_relaxed) == 0) {
+		if (use_fanin)
+			rte_ring_fanin_enqueue_burst(fanin, idx, burst,
+					fanin_bsz, NULL);
+		else
+			rte_ring_mp_enqueue_burst(fanin_mp_ring, burst,
+					fanin_bsz, NULL);
+	}
+
+	return 0;
+}
+
+static unsigned int
+fanin_consume(int use_fanin, void **burst)
+{
+	if (use_fanin)
+		return rte_ring_fanin_dequeue_burst(fanin, burst, MAX_BURST);
+	return rte_ring_sc_dequeue_burst(fanin_mp_ring, burst, MAX_BURST,
+			NULL);
+}
+
+static void
+fanin_run(int use_fanin, unsigned int nb_producers)
+{
+	const uint64_t hz = rte_get_timer_hz();
+	void *burst[MAX_BURST];
+	uint64_t begin, cycles, count = 0;
+
+	rte_atomic_store_explicit(&synchro, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&fanin_stop, 0, rte_memory_order_relaxed);
+	rte_eal_mp_remote_launch(fanin_producer, (void *)(uintptr_t)use_fanin,
+			SKIP_MAIN);
+	rte_atomic_store_explicit(&synchro, 1, rte_memory_order_relaxed);
+
+	begin = rte_get_timer_cycles();
+	do {
+		count += fanin_consume(use_fanin, burst);
+		cycles = rte_get_timer_cycles() - begin;
+	} while (cycles < hz * TIME_MS / 1000);
+
+	rte_atomic_store_explicit(&fanin_stop, 1, rte_memory_order_relaxed);
+	rte_eal_mp_wait_lcore();
+	while (fanin_consume(use_fanin, burst) != 0)
+		;
+
+	printf("%s - %u producers - burst (n:%-3u) - Mobjs/s: %.3F\n",
+			use_fanin ? "fan-in SP/SC rings" : "MP/SC ring",
+			nb_producers, fanin_bsz,
+			(double)count * hz / cycles / 1e6);
+}
+
+static int
+test_ring_perf_fanin(void)
+{
+	struct rte_ring_fanin_param prm = {
+		.name = "FANIN_PERF",
+		.elems = RING_SIZE - 1,
+		.elem_size = sizeof(void *),
+	};
+	unsigned int lcore_id, i, nb_producers = 0;
+	ssize_t sz;
+	int ret = -1;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id)
+		fanin_idx[lcore_id] = nb_producers++;
+	if (nb_producers == 0) {
+		printf("Skipping fan-in test, not enough lcores\n");
+		return 0;
+	}
+
+	printf("\n### Fan-in of %u producers to one consumer ###\n",
+			nb_producers);
+
+	fanin_mp_ring = rte_ring_create(RING_NAME, RING_SIZE, rte_socket_id(),
+			RING_F_SC_DEQ);
+	prm.nb_rings = nb_producers;
+	sz = rte_ring_fanin_get_memsize(&prm);
+	if (fanin_mp_ring == NULL || sz < 0)
+		goto out;
+	fanin = rte_zmalloc_socket(NULL, sz, RTE_CACHE_LINE_SIZE,
+			rte_socket_id());
+	if (fanin == NULL || rte_ring_fanin_init(fanin, &prm) != 0)
+		goto out;
+
+	for (i = 0; i < RTE_DIM(bulk_sizes); i++) {
+		fanin_bsz = bulk_sizes[i];
+		fanin_run(0, nb_producers);
+		fanin_run(1, nb_producers);
+	}
+	ret = 0;
+
+out:
+	rte_free(fanin);
+	fanin = NULL;
+	rte_ring_free(fanin_mp_ring);
+	fanin_mp_ring = NULL;
+	return ret;
+}
+
 static int
 test_ring_perf(void)
 {
@@ -682,6 +805,10 @@ test_ring_perf(void)
 	if (test_ring_perf_compression() == -1)
 		return -1;
 
+	/* Test fan-in from all workers against a MP ring */
+	if (test_ring_perf_fanin() == -1)
+		return -1;
+
 	return 0;
 }
 
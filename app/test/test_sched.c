@@ -140,6 +140,7 @@ test_sched(void)
 {
 	struct rte_mempool *mp = NULL;
 	struct rte_sched_port *port = NULL;
+	struct rte_sched_lane *lane = NULL;
 	uint32_t pipe;
 	struct rte_mbuf *in_mbufs[10];
 	struct rte_mbuf *out_mbufs[10];
@@ -208,6 +209,36 @@ test_sched(void)
 	TEST_ASSERT_EQUAL(queue_stats.n_pkts, 10, "Wrong queue stats\n");
 #endif
 
+	/* Same traffic through a lane owning the subport */
+	lane = rte_sched_lane_create(port, SUBPORT, 2);
+	TEST_ASSERT_NULL(lane, "Lane created beyond the last subport\n");
+
+	lane = rte_sched_lane_create(port, SUBPORT, 1);
+	TEST_ASSERT_NOT_NULL(lane, "Error creating sched lane\n");
+
+	err = rte_sched_subport_config(port, SUBPORT, subport_param, 0);
+	TEST_ASSERT_EQUAL(err, -EBUSY, "Subport configured under a lane\n");
+
+	for (i = 0; i < 10; i++)
+		in_mbufs[i] = out_mbufs[i];
+
+	err = rte_sched_lane_enqueue(lane, in_mbufs, 10);
+	TEST_ASSERT_EQUAL(err, 10, "Wrong lane enqueue, err=%d\n", err);
+
+	err = rte_sched_lane_dequeue(lane, out_mbufs, 10);
+	TEST_ASSERT_EQUAL(err, 10, "Wrong lane dequeue, err=%d\n", err);
+
+	for (i = 0; i < 10; i++) {
+		uint32_t subport, traffic_class, queue;
+
+		rte_sched_port_pkt_read_tree_path(port, out_mbufs[i],
+				&subport, &pipe, &traffic_class, &queue);
+
+		TEST_ASSERT_EQUAL(subport, SUBPORT, "Wrong lane subport\n");
+		TEST_ASSERT_EQUAL(pipe, PIPE, "Wrong lane pipe\n");
+	}
+
+	rte_sched_lane_free(lane);
 	rte_sched_port_free(port);
 
 	return 0;
@@ -408,6 +408,103 @@ test_soring_acquire_release(void)
 	return 0;
 }
 
+static int
+test_soring_acquire_release_zc(void)
+{
+	struct rte_soring *sor = NULL;
+	struct rte_soring_param prm;
+	struct rte_ring_zc_data zcd, mzcd;
+	uint32_t queue_objs[6];
+	uint32_t out_objs[6];
+	uint32_t out_rcs[6];
+	uint32_t *obj, *rc;
+	uint32_t n, ftoken;
+	size_t sz;
+	int rc_init, i;
+
+	memset(&prm, 0, sizeof(prm));
+	for (i = 0; i < 6; i++)
+		queue_objs[i] = i + 5;
+
+	/* 7 elems give a ring of 8 entries, to test the wrap-around */
+	set_soring_init_param(&prm, "test_acquire_release_zc",
+			sizeof(uint32_t), 7, 2, sizeof(uint32_t),
+			RTE_RING_SYNC_MT, RTE_RING_SYNC_MT);
+	sz = rte_soring_get_memsize(&prm);
+	sor = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (sor == NULL) {
+		printf("%s: alloc(%zu) for FIFO with %u elems failed",
+			__func__, sz, prm.elems);
+		return -ENOMEM;
+	}
+
+	rc_init = rte_soring_init(sor, &prm);
+	RTE_TEST_ASSERT_SUCCESS(rc_init, "failed to init soring");
+
+	/* move the ring head to index 5 */
+	n = rte_soring_enqueue_bulk(sor, queue_objs, 5, NULL);
+	SORING_TEST_ASSERT(n, 5);
+	n = rte_soring_acquire_zc_bulk(sor, &zcd, 0, 5, &ftoken, NULL);
+	SORING_TEST_ASSERT(n, 5);
+	RTE_TEST_ASSERT_EQUAL(zcd.n1, 5, "unexpected wrap-around");
+	RTE_TEST_ASSERT_NULL(zcd.ptr2, "unexpected second part");
+	obj = zcd.ptr1;
+	for (i = 0; i < 5; i++)
+		RTE_TEST_ASSERT_EQUAL(obj[i], queue_objs[i],
+				"acquired obj[%d]: %u != enqueued obj %u",
+				i, obj[i], queue_objs[i]);
+	rte_soring_release_zc(sor, 0, n, ftoken);
+	RTE_TEST_ASSERT_SUCCESS(move_forward_stage(sor, 5, 1),
+			"cannot move to the last stage");
+	n = rte_soring_dequeue_bulk(sor, out_objs, 5, NULL);
+	SORING_TEST_ASSERT(n, 5);
+
+	/* these objects wrap around the end of the ring */
+	n = rte_soring_enqueue_bulk(sor, queue_objs, 6, NULL);
+	SORING_TEST_ASSERT(n, 6);
+
+	/* bulk fails when not enough objects, burst does not */
+	n = rte_soring_acquirx_zc_bulk(sor, &zcd, &mzcd, 0, 7, &ftoken, NULL);
+	SORING_TEST_ASSERT(n, 0);
+	n = rte_soring_acquirx_zc_burst(sor, &zcd, &mzcd, 0, 7, &ftoken,
+			NULL);
+	SORING_TEST_ASSERT(n, 6);
+	SORING_TEST_ASSERT(zcd.n1, 3);
+	SORING_TEST_ASSERT(mzcd.n1, 3);
+	RTE_TEST_ASSERT_NOT_NULL(zcd.ptr2, "no second part for objects");
+	RTE_TEST_ASSERT_NOT_NULL(mzcd.ptr2, "no second part for metadata");
+
+	/* update objects and metadata in place */
+	for (i = 0; i < 6; i++) {
+		obj = (uint32_t *)(i < 3 ? zcd.ptr1 : zcd.ptr2) + i % 3;
+		rc = (uint32_t *)(i < 3 ? mzcd.ptr1 : mzcd.ptr2) + i % 3;
+		RTE_TEST_ASSERT_EQUAL(*obj, queue_objs[i],
+				"acquired obj[%d]: %u != enqueued obj %u",
+				i, *obj, queue_objs[i]);
+		*obj += 100;
+		*rc = i + 10;
+	}
+	rte_soring_release_zc(sor, 0, n, ftoken);
+
+	/* next stage sees the updates */
+	n = rte_soring_acquirx_burst(sor, out_objs, out_rcs, 1, 6, &ftoken,
+			NULL);
+	SORING_TEST_ASSERT(n, 6);
+	for (i = 0; i < 6; i++) {
+		RTE_TEST_ASSERT_EQUAL(out_objs[i], queue_objs[i] + 100,
+				"acquired obj[%d]: %u not updated", i, out_objs[i]);
+		RTE_TEST_ASSERT_EQUAL(out_rcs[i], (uint32_t)i + 10,
+				"acquired rc[%d]: %u not updated", i, out_rcs[i]);
+	}
+	rte_soring_release(sor, NULL, 1, n, ftoken);
+
+	n = rte_soring_dequeue_bulk(sor, out_objs, 6, NULL);
+	SORING_TEST_ASSERT(n, 6);
+
+	rte_free(sor);
+	return 0;
+}
+
 static int
 test_soring(void)
 {
@@ -428,6 +525,10 @@ test_soring(void)
 	if (test_soring_acquire_release() < 0)
 		goto test_fail;
 
+	/* Zero-copy acquire/release */
+	if (test_soring_acquire_release_zc() < 0)
+		goto test_fail;
+
 	/* Test large number of stages */
 	if (test_soring_stages() < 0)
 		goto test_fail;
@@ -0,0 +1,581 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_memory.h>
+#include <rte_memzone.h>
+#include <rte_mempool.h>
+#include <rte_ring.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+
+#include "rte_mempool_numa.h"
+
+/*
+ * Each socket has two rings, both located on the socket and sized to hold
+ * all the objects of the mempool:
+ * - the sub-pool, where the lcores of the socket put the objects whose
+ *   memory is on the socket, and get objects from;
+ * - the return ring, where the lcores of the other sockets put back
+ *   the objects whose memory is on the socket.
+ * The return ring is drained by the lcores of the socket when the sub-pool
+ * runs short, so the cache lines of the sub-pool ring stay on the socket.
+ *
+ * The home socket of an object is found from the memory chunks the mempool
+ * was populated with, which are recorded with their socket.
+ */
+
+RTE_LOG_REGISTER_DEFAULT(numa_mempool_logtype, NOTICE);
+#define RTE_LOGTYPE_NUMA_MEMPOOL numa_mempool_logtype
+#define NUMA_MEMPOOL_LOG(level, ...) \
+	RTE_LOG_LINE(level, NUMA_MEMPOOL, __VA_ARGS__)
+
+#define NUMA_MAX_CHUNKS	64
+/* Objects are sorted by home socket per burst on enqueue. */
+#define NUMA_BURST	32
+#define NUMA_NO_IDX	UINT8_MAX
+
+struct numa_chunk {
+	uintptr_t start;
+	size_t len;
+	unsigned int idx;
+};
+
+struct numa_socket {
+	struct rte_ring *pool;
+	struct rte_ring *ret;
+	int socket_id;
+};
+
+struct __rte_cache_aligned numa_lcore_stats {
+	struct rte_mempool_numa_stats s;
+};
+
+struct numa_pool {
+	unsigned int nb_sockets;
+	unsigned int default_idx;
+	unsigned int nb_chunks;
+	struct numa_chunk chunks[NUMA_MAX_CHUNKS];
+	uint8_t sock_idx[RTE_MAX_NUMA_NODES]; /* socket id to index */
+	struct numa_lcore_stats stats[RTE_MAX_LCORE];
+	struct numa_socket sock[];
+};
+
+static inline unsigned int
+numa_socket_idx(const struct numa_pool *np, int socket_id)
+{
+	if (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES ||
+			np->sock_idx[socket_id] == NUMA_NO_IDX)
+		return NUMA_NO_IDX;
+	return np->sock_idx[socket_id];
+}
+
+static inline unsigned int
+numa_obj_idx(const struct numa_pool *np, const void *obj)
+{
+	uintptr_t addr = (uintptr_t)obj;
+	unsigned int i;
+
+	for (i = 0; i < np->nb_chunks; i++) {
+		if (addr - np->chunks[i].start < np->chunks[i].len)
+			return np->chunks[i].idx;
+	}
+	return np->default_idx;
+}
+
+static inline int
+numa_put(const struct numa_pool *np, unsigned int home, unsigned int local,
+	void * const *obj_table, unsigned int n)
+{
+	struct rte_ring *r;
+
+	if (home == local || local == NUMA_NO_IDX)
+		r = np->sock[home].pool;
+	else
+		r = np->sock[home].ret;
+
+	return rte_ring_mp_enqueue_bulk(r, obj_table, n, NULL) == 0 ?
+		-ENOBUFS : 0;
+}
+
+/* Put objects back to their home socket, return the number of remote ones. */
+static int
+numa_route(const struct numa_pool *np, unsigned int local,
+	void * const *obj_table, unsigned int n)
+{
+	void *buf[RTE_MAX_NUMA_NODES][NUMA_BURST];
+	unsigned int len[RTE_MAX_NUMA_NODES] = { 0 };
+	unsigned int i, home, nb_remote = 0;
+	int ret;
+
+	for (i = 0; i < n; i++) {
+		home = numa_obj_idx(np, obj_table[i]);
+		if (home != local)
+			nb_remote++;
+		buf[home][len[home]++] = obj_table[i];
+		if (len[home] == NUMA_BURST) {
+			ret = numa_put(np, home, local, buf[home], NUMA_BURST);
+			if (ret < 0)
+				return ret;
+			len[home] = 0;
+		}
+	}
+
+	for (home = 0; home < np->nb_sockets; home++) {
+		if (len[home] == 0)
+			continue;
+		ret = numa_put(np, home, local, buf[home], len[home]);
+		if (ret < 0)
+			return ret;
+	}
+
+	return nb_remote;
+}
+
+static int
+numa_enqueue(struct rte_mempool *mp, void * const *obj_table, unsigned int n)
+{
+	struct numa_pool *np = mp->pool_data;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int local;
+	int nb_remote;
+
+	local = numa_socket_idx(np, rte_socket_id());
+
+	/* fast path: a single socket, no remote object */
+	if (np->nb_sockets == 1) {
+		if (rte_ring_mp_enqueue_bulk(np->sock[0].pool, obj_table, n,
+				NULL) == 0)
+			return -ENOBUFS;
+		nb_remote = 0;
+	} else {
+		nb_remote = numa_route(np, local, obj_table, n);
+		if (nb_remote < 0)
+			return nb_remote;
+	}
+
+	if (lcore_id < RTE_MAX_LCORE) {
+		struct rte_mempool_numa_stats *s = &np->stats[lcore_id].s;
+
+		if (local == NUMA_NO_IDX) {
+			s->free_remote += n;
+		} else {
+			s->free_local += n - nb_remote;
+			s->free_remote += nb_remote;
+		}
+	}
+
+	return 0;
+}
+
+static inline unsigned int
+numa_get_from(const struct numa_socket *sock, void **obj_table, unsigned int n)
+{
+	unsigned int got;
+
+	got = rte_ring_mc_dequeue_burst(sock->pool, obj_table, n, NULL);
+	if (got < n)
+		got += rte_ring_mc_dequeue_burst(sock->ret, obj_table + got,
+				n - got, NULL);
+	return got;
+}
+
+static int
+numa_dequeue(struct rte_mempool *mp, void **obj_table, unsigned int n)
+{
+	struct numa_pool *np = mp->pool_data;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int local, idx, i;
+	unsigned int got, nb_local;
+
+	local = numa_socket_idx(np, rte_socket_id());
+	idx = local == NUMA_NO_IDX ? np->default_idx : local;
+
+	got = numa_get_from(&np->sock[idx], obj_table, n);
+	nb_local = local == NUMA_NO_IDX ? 0 : got;
+
+	/* then from the other sockets, starting with the next one */
+	for (i = 1; got < n && i < np->nb_sockets; i++) {
+		idx = (idx + 1) % np->nb_sockets;
+		got += numa_get_from(&np->sock[idx], obj_table + got, n - got);
+	}
+
+	if (unlikely(got < n)) {
+		if (got != 0)
+			numa_route(np, NUMA_NO_IDX, obj_table, got);
+		return -ENOBUFS;
+	}
+
+	if (lcore_id < RTE_MAX_LCORE) {
+		struct rte_mempool_numa_stats *s = &np->stats[lcore_id].s;
+
+		s->alloc_local += nb_local;
+		s->alloc_remote += n - nb_local;
+	}
+
+	return 0;
+}
+
+static unsigned int
+numa_get_count(const struct rte_mempool *mp)
+{
+	const struct numa_pool *np = mp->pool_data;
+	unsigned int i, count = 0;
+
+	for (i = 0; i < np->nb_sockets; i++)
+		count += rte_ring_count(np->sock[i].pool) +
+			rte_ring_count(np->sock[i].ret);
+	return count;
+}
+
+static void
+numa_free(struct rte_mempool *mp)
+{
+	struct numa_pool *np = mp->pool_data;
+	unsigned int i;
+
+	if (np == NULL)
+		return;
+
+	for (i = 0; i < np->nb_sockets; i++) {
+		rte_ring_free(np->sock[i].pool);
+		rte_ring_free(np->sock[i].ret);
+	}
+	rte_free(np);
+}
+
+static int
+numa_alloc(struct rte_mempool *mp)
+{
+	char rg_name[RTE_RING_NAMESIZE];
+	unsigned int nb_sockets, i;
+	struct numa_pool *np;
+	uint32_t ring_size;
+	int socket_id, ret;
+
+	nb_sockets = rte_socket_count();
+	np = rte_zmalloc_socket("MEMPOOL_NUMA",
+		sizeof(*np) + nb_sockets * sizeof(np->sock[0]),
+		RTE_CACHE_LINE_SIZE, mp->socket_id);
+	if (np == NULL)
+		return -ENOMEM;
+
+	memset(np->sock_idx, NUMA_NO_IDX, sizeof(np->sock_idx));
+	np->nb_sockets = nb_sockets;
+	mp->pool_data = np;
+
+	/* the split of the objects between the sockets is not known yet */
+	ring_size = rte_align32pow2(mp->size + 1);
+	for (i = 0; i < nb_sockets; i++) {
+		socket_id = rte_socket_id_by_idx(i);
+		np->sock[i].socket_id = socket_id;
+		if (socket_id >= 0 && socket_id < RTE_MAX_NUMA_NODES)
+			np->sock_idx[socket_id] = i;
+
+		ret = snprintf(rg_name, sizeof(rg_name), "MPS_%s_%u",
+			mp->name, i);
+		if (ret < 0 || ret >= (int)sizeof(rg_name)) {
+			rte_errno = ENAMETOOLONG;
+			goto error;
+		}
+		np->sock[i].pool = rte_ring_create(rg_name, ring_size,
+			socket_id, 0);
+		if (np->sock[i].pool == NULL)
+			goto error;
+
+		ret = snprintf(rg_name, sizeof(rg_name), "MPR_%s_%u",
+			mp->name, i);
+		if (ret < 0 || ret >= (int)sizeof(rg_name)) {
+			rte_errno = ENAMETOOLONG;
+			goto error;
+		}
+		np->sock[i].ret = rte_ring_create(rg_name, ring_size,
+			socket_id, 0);
+		if (np->sock[i].ret == NULL)
+			goto error;
+	}
+
+	np->default_idx = numa_socket_idx(np, mp->socket_id);
+	if (np->default_idx == NUMA_NO_IDX)
+		np->default_idx = 0;
+
+	return 0;
+
+error:
+	ret = -rte_errno;
+	numa_free(mp);
+	mp->pool_data = NULL;
+	return ret;
+}
+
+static int
+numa_add_chunk(struct numa_pool *np, void *vaddr, size_t len, unsigned int idx)
+{
+	struct numa_chunk *c;
+
+	/* chunks of rte_mempool_populate_virt() are virtually contiguous */
+	if (np->nb_chunks != 0) {
+		c = &np->chunks[np->nb_chunks - 1];
+		if (c->idx == idx && c->start + c->len == (uintptr_t)vaddr) {
+			c->len += len;
+			return 0;
+		}
+	}
+
+	if (np->nb_chunks == NUMA_MAX_CHUNKS) {
+		NUMA_MEMPOOL_LOG(ERR, "Too many memory chunks");
+		return -ENOSPC;
+	}
+
+	c = &np->chunks[np->nb_chunks];
+	c->start = (uintptr_t)vaddr;
+	c->len = len;
+	c->idx = idx;
+	np->nb_chunks++;
+	return 0;
+}
+
+static int
+numa_populate(struct rte_mempool *mp, unsigned int max_objs, void *vaddr,
+	rte_iova_t iova, size_t len, rte_mempool_populate_obj_cb_t *obj_cb,
+	void *obj_cb_arg)
+{
+	struct numa_pool *np = mp->pool_data;
+	const struct rte_memseg_list *msl;
+	struct rte_mempool_numa_stats saved;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int idx;
+	int ret;
+
+	/* anonymous or unregistered external memory goes to the default */
+	msl = rte_mem_virt2memseg_list(vaddr);
+	idx = msl != NULL ? numa_socket_idx(np, msl->socket_id) : NUMA_NO_IDX;
+	if (idx == NUMA_NO_IDX)
+		idx = np->default_idx;
+
+	ret = numa_add_chunk(np, vaddr, len, idx);
+	if (ret < 0)
+		return ret;
+
+	/* objects are enqueued by the helper, they are not counted as frees */
+	if (lcore_id < RTE_MAX_LCORE)
+		saved = np->stats[lcore_id].s;
+	ret = rte_mempool_op_populate_helper(mp, 0, max_objs, vaddr, iova,
+		len, obj_cb, obj_cb_arg);
+	if (lcore_id < RTE_MAX_LCORE)
+		np->stats[lcore_id].s = saved;
+
+	return ret;
+}
+
+static const struct rte_mempool_ops ops_numa = {
+	.name = RTE_MEMPOOL_NUMA_OPS_NAME,
+	.alloc = numa_alloc,
+	.free = numa_free,
+	.enqueue = numa_enqueue,
+	.dequeue = numa_dequeue,
+	.get_count = numa_get_count,
+	.populate = numa_populate,
+};
+
+RTE_MEMPOOL_REGISTER_OPS(ops_numa);
+
+static bool
+mempool_is_numa(const struct rte_mempool *mp)
+{
+	return mp != NULL && mp->ops_index >= 0 &&
+		strcmp(rte_mempool_get_ops(mp->ops_index)->name,
+			RTE_MEMPOOL_NUMA_OPS_NAME) == 0;
+}
+
+static void
+numa_memchunk_free(__rte_unused struct rte_mempool_memhdr *memhdr,
+	void *opaque)
+{
+	rte_memzone_free(opaque);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_numa_populate, 25.07)
+int
+rte_mempool_numa_populate(struct rte_mempool *mp)
+{
+	unsigned int mz_flags, nb_sockets, i, n;
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+	const struct rte_memzone *mz;
+	size_t align, min_chunk_size;
+	size_t pg_sz, pg_shift = 0;
+	bool need_iova_contig_obj;
+	ssize_t mem_size;
+	rte_iova_t iova;
+	int socket_id;
+	int ret;
+
+	if (!mempool_is_numa(mp))
+		return -EINVAL;
+	if (mp->nb_mem_chunks != 0)
+		return -EEXIST;
+
+	need_iova_contig_obj = !(mp->flags & RTE_MEMPOOL_F_NO_IOVA_CONTIG);
+	ret = rte_mempool_get_page_size(mp, &pg_sz);
+	if (ret < 0)
+		return ret;
+	if (pg_sz != 0)
+		pg_shift = rte_bsf32(pg_sz);
+
+	nb_sockets = rte_socket_count();
+	for (i = 0; i < nb_sockets && mp->populated_size < mp->size; i++) {
+		socket_id = rte_socket_id_by_idx(i);
+		/* share of the objects left, for this socket and the next ones */
+		n = mp->size - mp->populated_size;
+		n = (n + nb_sockets - i - 1) / (nb_sockets - i);
+
+		mem_size = rte_mempool_ops_calc_mem_size(mp, n, pg_shift,
+			&min_chunk_size, &align);
+		if (mem_size < 0)
+			return mem_size;
+
+		ret = snprintf(mz_name, sizeof(mz_name),
+			RTE_MEMPOOL_MZ_FORMAT "_s%d", mp->name, socket_id);
+		if (ret < 0 || ret >= (int)sizeof(mz_name))
+			return -ENAMETOOLONG;
+
+		mz_flags = RTE_MEMZONE_1GB | RTE_MEMZONE_SIZE_HINT_ONLY;
+		if (min_chunk_size == (size_t)mem_size)
+			mz_flags |= RTE_MEMZONE_IOVA_CONTIG;
+
+		mz = rte_memzone_reserve_aligned(mz_name, mem_size, socket_id,
+			mz_flags, align);
+		if (mz == NULL) {
+			NUMA_MEMPOOL_LOG(INFO,
+				"No memory for %u objects of %s on socket %d",
+				n, mp->name, socket_id);
+			continue;
+		}
+
+		iova = need_iova_contig_obj ? mz->iova : RTE_BAD_IOVA;
+		if (pg_sz == 0 || (mz_flags & RTE_MEMZONE_IOVA_CONTIG))
+			ret = rte_mempool_populate_iova(mp, mz->addr, iova,
+				mz->len, numa_memchunk_free,
+				(void *)(uintptr_t)mz);
+		else
+			ret = rte_mempool_populate_virt(mp, mz->addr, mz->len,
+				pg_sz, numa_memchunk_free,
+				(void *)(uintptr_t)mz);
+		if (ret <= 0) {
+			rte_memzone_free(mz);
+			return ret == 0 ? -ENOBUFS : ret;
+		}
+	}
+
+	if (mp->populated_size < mp->size)
+		return -ENOMEM;
+
+	return mp->size;
+}
+
+static void
+numa_stats_sum(const struct numa_pool *np, int socket_id,
+	struct rte_mempool_numa_stats *stats)
+{
+	const struct rte_mempool_numa_stats *s;
+	unsigned int lcore_id;
+
+	memset(stats, 0, sizeof(*stats));
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (socket_id != SOCKET_ID_ANY &&
+				(int)rte_lcore_to_socket_id(lcore_id) != socket_id)
+			continue;
+		s = &np->stats[lcore_id].s;
+		stats->free_local += s->free_local;
+		stats->free_remote += s->free_remote;
+		stats->alloc_local += s->alloc_local;
+		stats->alloc_remote += s->alloc_remote;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_numa_stats_get, 25.07)
+int
+rte_mempool_numa_stats_get(const struct rte_mempool *mp, int socket_id,
+	struct rte_mempool_numa_stats *stats)
+{
+	if (!mempool_is_numa(mp) || mp->pool_data == NULL || stats == NULL)
+		return -EINVAL;
+
+	numa_stats_sum(mp->pool_data, socket_id, stats);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_numa_stats_reset, 25.07)
+int
+rte_mempool_numa_stats_reset(struct rte_mempool *mp)
+{
+	struct numa_pool *np;
+
+	if (!mempool_is_numa(mp) || mp->pool_data == NULL)
+		return -EINVAL;
+
+	np = mp->pool_data;
+	memset(np->stats, 0, sizeof(np->stats));
+	return 0;
+}
+
+static int
+numa_tel_handle_stats(const char *cmd __rte_unused, const char *params,
+	struct rte_tel_data *d)
+{
+	struct rte_mempool_numa_stats stats;
+	struct rte_tel_data *sd;
+	struct rte_mempool *mp;
+	struct numa_pool *np;
+	char name[32];
+	unsigned int i;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	mp = rte_mempool_lookup(params);
+	if (!mempool_is_numa(mp) || mp->pool_data == NULL)
+		return -EINVAL;
+	np = mp->pool_data;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_string(d, "name", mp->name);
+	for (i = 0; i < np->nb_sockets; i++) {
+		sd = rte_tel_data_alloc();
+		if (sd == NULL)
+			return -ENOMEM;
+		numa_stats_sum(np, np->sock[i].socket_id, &stats);
+		rte_tel_data_start_dict(sd);
+		rte_tel_data_add_dict_uint(sd, "free_local", stats.free_local);
+		rte_tel_data_add_dict_uint(sd, "free_remote",
+			stats.free_remote);
+		rte_tel_data_add_dict_uint(sd, "alloc_local",
+			stats.alloc_local);
+		rte_tel_data_add_dict_uint(sd, "alloc_remote",
+			stats.alloc_remote);
+		rte_tel_data_add_dict_uint(sd, "pool_count",
+			rte_ring_count(np->sock[i].pool));
+		rte_tel_data_add_dict_uint(sd, "return_count",
+			rte_ring_count(np->sock[i].ret));
+		snprintf(name, sizeof(name), "socket_%d", np->sock[i].socket_id);
+		rte_tel_data_add_dict_container(d, name, sd, 0);
+	}
+
+	return 0;
+}
+
+RTE_INIT(numa_mempool_init_telemetry)
+{
+	rte_telemetry_register_cmd("/mempool/numa/stats",
+		numa_tel_handle_stats,
+		"Returns per-socket stats of a NUMA mempool. Parameters: pool_name");
+}
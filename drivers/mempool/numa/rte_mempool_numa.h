@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_MEMPOOL_NUMA_H_
+#define _RTE_MEMPOOL_NUMA_H_
+
+/**
+ * @file
+ * NUMA mempool driver specific API.
+ *
+ * The "numa" mempool driver keeps one sub-pool per NUMA socket.
+ * An object always goes back to the sub-pool of the socket its memory
+ * is on (its home socket). Objects freed by lcores of another socket are
+ * enqueued in bulk to a return ring of the home socket, so that they do
+ * not contend with the local lcores on the sub-pool ring.
+ * Objects are allocated from the sub-pool of the calling lcore socket
+ * first, then from the other sockets.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+#include <rte_mempool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Name of the NUMA mempool ops. */
+#define RTE_MEMPOOL_NUMA_OPS_NAME "numa"
+
+/**
+ * Objects moved through the NUMA mempool driver.
+ *
+ * Objects are counted when they are enqueued to or dequeued from the
+ * driver, that is after going through the per-lcore caches.
+ * Only the operations done by lcores are counted.
+ */
+struct rte_mempool_numa_stats {
+	uint64_t free_local;   /**< Objects freed on their home socket. */
+	uint64_t free_remote;  /**< Objects freed from another socket. */
+	uint64_t alloc_local;  /**< Objects allocated on their home socket. */
+	uint64_t alloc_remote; /**< Objects allocated from another socket. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Populate a NUMA mempool with memory from all the sockets.
+ *
+ * This function is used instead of rte_mempool_populate_default().
+ * The objects are spread evenly on the sockets having memory.
+ * If the memory of a socket is exhausted, its share is taken from
+ * the next sockets.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, using the NUMA mempool ops.
+ * @return
+ *   The number of objects added on success.
+ *   On error, the mempool may be partially populated, and a negative value:
+ *   - -EINVAL: the mempool does not use the NUMA mempool ops.
+ *   - -EEXIST: the mempool is already populated.
+ *   - -ENOMEM: not enough memory.
+ */
+__rte_experimental
+int
+rte_mempool_numa_populate(struct rte_mempool *mp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the statistics of a NUMA mempool.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, using the NUMA mempool ops.
+ * @param socket_id
+ *   The socket of the lcores doing the operations,
+ *   or SOCKET_ID_ANY for all the lcores.
+ * @param stats
+ *   A pointer to the structure to fill.
+ * @return
+ *   0 on success, -EINVAL if the mempool does not use the NUMA mempool ops.
+ */
+__rte_experimental
+int
+rte_mempool_numa_stats_get(const struct rte_mempool *mp, int socket_id,
+	struct rte_mempool_numa_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset the statistics of a NUMA mempool.
+ *
+ * The counters of the lcores using the mempool meanwhile may not be
+ * fully reset.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, using the NUMA mempool ops.
+ * @return
+ *   0 on success, -EINVAL if the mempool does not use the NUMA mempool ops.
+ */
+__rte_experimental
+int
+rte_mempool_numa_stats_reset(struct rte_mempool *mp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMPOOL_NUMA_H_ */
@@ -37,6 +37,8 @@
 #define ETH_AF_PACKET_FRAMECOUNT_ARG	"framecnt"
 #define ETH_AF_PACKET_QDISC_BYPASS_ARG	"qdisc_bypass"
 #define ETH_AF_PACKET_FANOUT_MODE_ARG	"fanout_mode"
+#define ETH_AF_PACKET_TPACKET_V3_ARG	"tpacket_v3"
+#define ETH_AF_PACKET_BLOCK_TIMEOUT_ARG	"block_timeout"
 
 #define DFLT_FRAME_SIZE		(1 << 11)
 #define DFLT_FRAME_COUNT	(1 << 9)
@@ -47,11 +49,18 @@ static int timestamp_dynfield_offset = -1;
 struct __rte_cache_aligned pkt_rx_queue {
 	int sockfd;
 
+	/* frames with TPACKET_V2, blocks with TPACKET_V3 */
 	struct iovec *rd;
 	uint8_t *map;
 	unsigned int framecount;
 	unsigned int framenum;
 
+	/* next frame and frames left in the current block with TPACKET_V3 */
+	struct tpacket3_hdr *frame;
+	uint32_t frames_left;
+	/* space for data in an mbuf, a TPACKET_V3 frame may be larger */
+	uint32_t buf_size;
+
 	struct rte_mempool *mb_pool;
 	uint16_t in_port;
 	uint8_t vlan_strip;
@@ -66,6 +75,9 @@ struct __rte_cache_aligned pkt_rx_queue {
 struct __rte_cache_aligned pkt_tx_queue {
 	int sockfd;
 	unsigned int frame_data_size;
+	/* offset of the data in a frame, after the TPACKET header */
+	unsigned int frame_data_off;
+	uint8_t tpacket_v3;
 
 	struct iovec *rd;
 	uint8_t *map;
@@ -84,7 +96,9 @@ struct pmd_internals {
 	char *if_name;
 	struct rte_ether_addr eth_addr;
 
-	struct tpacket_req req;
+	/* the first fields are the ones of struct tpacket_req for TPACKET_V2 */
+	struct tpacket_req3 req;
+	int tpver;
 
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
@@ -100,6 +114,8 @@ static const char *valid_arguments[] = {
 	ETH_AF_PACKET_FRAMECOUNT_ARG,
 	ETH_AF_PACKET_QDISC_BYPASS_ARG,
 	ETH_AF_PACKET_FANOUT_MODE_ARG,
+	ETH_AF_PACKET_TPACKET_V3_ARG,
+	ETH_AF_PACKET_BLOCK_TIMEOUT_ARG,
 	NULL
 };
 
@@ -195,6 +211,113 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
+/*
+ * Give a block of the TPACKET_V3 ring back to the kernel
+ * and advance to the next one.
+ */
+static inline void
+rx_v3_release_block(struct pkt_rx_queue *pkt_q,
+		struct tpacket_block_desc *pbd)
+{
+	/* the frames must be read before the kernel may overwrite them */
+	rte_smp_mb();
+	pbd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+	if (++pkt_q->framenum >= pkt_q->framecount)
+		pkt_q->framenum = 0;
+}
+
+/*
+ * With TPACKET_V3, the kernel fills whole blocks of variable sized frames
+ * and hands them over when full or when the block timeout expires.
+ * The blocks are walked frame by frame, a block being given back
+ * to the kernel once all its frames are received.
+ */
+static uint16_t
+eth_af_packet_rx_v3(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pkt_rx_queue *pkt_q = queue;
+	struct tpacket_block_desc *pbd;
+	struct tpacket3_hdr *ppd;
+	struct rte_mbuf *mbuf;
+	uint8_t *pbuf;
+	uint16_t num_rx = 0;
+	unsigned long num_rx_bytes = 0;
+
+	while (num_rx < nb_pkts) {
+		pbd = (struct tpacket_block_desc *)
+			pkt_q->rd[pkt_q->framenum].iov_base;
+
+		/* start the next block if it has been retired by the kernel */
+		if (pkt_q->frames_left == 0) {
+			if ((pbd->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+				break;
+			rte_smp_rmb();
+			pkt_q->frames_left = pbd->hdr.bh1.num_pkts;
+			pkt_q->frame = (struct tpacket3_hdr *)((uint8_t *)pbd +
+				pbd->hdr.bh1.offset_to_first_pkt);
+			if (unlikely(pkt_q->frames_left == 0)) {
+				rx_v3_release_block(pkt_q, pbd);
+				continue;
+			}
+		}
+
+		ppd = pkt_q->frame;
+
+		/* frames are bounded by the block size, not the frame size */
+		if (unlikely(ppd->tp_snaplen > pkt_q->buf_size)) {
+			pkt_q->rx_dropped_pkts++;
+			pkt_q->frame = (struct tpacket3_hdr *)((uint8_t *)ppd +
+				ppd->tp_next_offset);
+			if (--pkt_q->frames_left == 0)
+				rx_v3_release_block(pkt_q, pbd);
+			continue;
+		}
+
+		/* allocate the next mbuf */
+		mbuf = rte_pktmbuf_alloc(pkt_q->mb_pool);
+		if (unlikely(mbuf == NULL)) {
+			pkt_q->rx_nombuf++;
+			break;
+		}
+
+		rte_pktmbuf_pkt_len(mbuf) = rte_pktmbuf_data_len(mbuf) = ppd->tp_snaplen;
+		pbuf = (uint8_t *) ppd + ppd->tp_mac;
+		memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf, rte_pktmbuf_data_len(mbuf));
+
+		/* check for vlan info */
+		if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
+			mbuf->vlan_tci = ppd->hv1.tp_vlan_tci;
+			mbuf->ol_flags |= (RTE_MBUF_F_RX_VLAN | RTE_MBUF_F_RX_VLAN_STRIPPED);
+
+			if (!pkt_q->vlan_strip && rte_vlan_insert(&mbuf))
+				PMD_LOG(ERR, "Failed to reinsert VLAN tag");
+		}
+
+		/* add kernel provided timestamp when offloading is enabled */
+		if (pkt_q->timestamp_offloading) {
+			*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
+				rte_mbuf_timestamp_t *) =
+					(uint64_t)ppd->tp_sec * 1000000000 + ppd->tp_nsec;
+
+			mbuf->ol_flags |= timestamp_dynflag;
+		}
+
+		/* advance in the block, release it after its last frame */
+		pkt_q->frame = (struct tpacket3_hdr *)((uint8_t *)ppd +
+			ppd->tp_next_offset);
+		if (--pkt_q->frames_left == 0)
+			rx_v3_release_block(pkt_q, pbd);
+		mbuf->port = pkt_q->in_port;
+
+		/* account for the receive frame */
+		bufs[num_rx++] = mbuf;
+		num_rx_bytes += mbuf->pkt_len;
+	}
+	pkt_q->rx_pkts += num_rx;
+	pkt_q->rx_bytes += num_rx_bytes;
+	return num_rx;
+}
+
 /*
  * Check if there is an available frame in the ring
  */
@@ -215,13 +338,37 @@ tx_ring_status_available(uint32_t tp_status)
 	return tp_status == TP_STATUS_AVAILABLE;
 }
 
+/*
+ * Tx frames have a TPACKET_V2 or TPACKET_V3 header,
+ * depending on the version of the socket.
+ */
+static inline uint32_t *
+tx_frame_status(const struct pkt_tx_queue *pkt_q, void *ppd)
+{
+	if (pkt_q->tpacket_v3)
+		return &((struct tpacket3_hdr *)ppd)->tp_status;
+	return &((struct tpacket2_hdr *)ppd)->tp_status;
+}
+
+static inline void
+tx_frame_set_len(const struct pkt_tx_queue *pkt_q, void *ppd, uint32_t len)
+{
+	if (pkt_q->tpacket_v3) {
+		((struct tpacket3_hdr *)ppd)->tp_len = len;
+		((struct tpacket3_hdr *)ppd)->tp_snaplen = len;
+	} else {
+		((struct tpacket2_hdr *)ppd)->tp_len = len;
+		((struct tpacket2_hdr *)ppd)->tp_snaplen = len;
+	}
+}
+
 /*
  * Callback to handle sending packets through a real NIC.
  */
 static uint16_t
 eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
-	struct tpacket2_hdr *ppd;
+	void *ppd;
 	struct rte_mbuf *mbuf;
 	uint8_t *pbuf;
 	unsigned int framecount, framenum;
@@ -241,7 +388,7 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 	framecount = pkt_q->framecount;
 	framenum = pkt_q->framenum;
-	ppd = (struct tpacket2_hdr *) pkt_q->rd[framenum].iov_base;
+	ppd = pkt_q->rd[framenum].iov_base;
 	for (i = 0; i < nb_pkts; i++) {
 		mbuf = *bufs++;
 
@@ -260,7 +407,7 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		}
 
 		/* point at the next incoming frame */
-		if (!tx_ring_status_available(ppd->tp_status)) {
+		if (!tx_ring_status_available(*tx_frame_status(pkt_q, ppd))) {
 			if (poll(&pfd, 1, -1) < 0)
 				break;
 
@@ -283,12 +430,11 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		 *
 		 * This results in poll() returning POLLOUT.
 		 */
-		if (!tx_ring_status_available(ppd->tp_status))
+		if (!tx_ring_status_available(*tx_frame_status(pkt_q, ppd)))
 			break;
 
 		/* copy the tx frame data */
-		pbuf = (uint8_t *) ppd + TPACKET2_HDRLEN -
-			sizeof(struct sockaddr_ll);
+		pbuf = (uint8_t *) ppd + pkt_q->frame_data_off;
 
 		struct rte_mbuf *tmp_mbuf = mbuf;
 		while (tmp_mbuf) {
@@ -298,14 +444,13 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			tmp_mbuf = tmp_mbuf->next;
 		}
 
-		ppd->tp_len = mbuf->pkt_len;
-		ppd->tp_snaplen = mbuf->pkt_len;
+		tx_frame_set_len(pkt_q, ppd, mbuf->pkt_len);
 
 		/* release incoming frame and advance ring buffer */
-		ppd->tp_status = TP_STATUS_SEND_REQUEST;
+		*tx_frame_status(pkt_q, ppd) = TP_STATUS_SEND_REQUEST;
 		if (++framenum >= framecount)
 			framenum = 0;
-		ppd = (struct tpacket2_hdr *) pkt_q->rd[framenum].iov_base;
+		ppd = pkt_q->rd[framenum].iov_base;
 
 		num_tx++;
 		num_tx_bytes += mbuf->pkt_len;
@@ -493,7 +638,7 @@ static int
 eth_dev_close(struct rte_eth_dev *dev)
 {
 	struct pmd_internals *internals;
-	struct tpacket_req *req;
+	struct tpacket_req3 *req;
 	unsigned int q;
 	int sockfd;
 
@@ -572,7 +717,8 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	buf_size = rte_pktmbuf_data_room_size(pkt_q->mb_pool) -
 		RTE_PKTMBUF_HEADROOM;
 	data_size = internals->req.tp_frame_size;
-	data_size -= TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+	data_size -= (internals->tpver == TPACKET_V3 ? TPACKET3_HDRLEN :
+		TPACKET2_HDRLEN) - sizeof(struct sockaddr_ll);
 
 	if (data_size > buf_size) {
 		PMD_LOG(ERR,
@@ -581,6 +727,21 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 		return -ENOMEM;
 	}
 
+	/*
+	 * With TPACKET_V3, the kernel caps a frame with the space left
+	 * in a block, not with the frame size: larger frames are dropped.
+	 */
+	pkt_q->buf_size = buf_size;
+	if (internals->tpver == TPACKET_V3) {
+		data_size = internals->req.tp_block_size -
+			RTE_ALIGN_CEIL(sizeof(struct tpacket_block_desc), 8) -
+			TPACKET3_HDRLEN + sizeof(struct sockaddr_ll);
+		if (data_size > buf_size)
+			PMD_LOG(NOTICE,
+				"%s: frames above %u bytes are dropped, up to %u bytes may be received",
+				dev->device->name, buf_size, data_size);
+	}
+
 	dev->data->rx_queues[rx_queue_id] = pkt_q;
 	pkt_q->in_port = dev->data->port_id;
 	pkt_q->vlan_strip = internals->vlan_strip;
@@ -611,7 +772,8 @@ eth_dev_mtu_set(struct rte_eth_dev *dev, uint16_t mtu)
 	int ret;
 	int s;
 	unsigned int data_size = internals->req.tp_frame_size -
-				 TPACKET2_HDRLEN;
+				 (internals->tpver == TPACKET_V3 ?
+				  TPACKET3_HDRLEN : TPACKET2_HDRLEN);
 
 	if (mtu > data_size)
 		return -EINVAL;
@@ -793,6 +955,8 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
                        unsigned int framecnt,
 		       unsigned int qdisc_bypass,
 		       const char *fanout_mode,
+		       int tpver,
+		       unsigned int block_timeout,
                        struct pmd_internals **internals,
                        struct rte_eth_dev **eth_dev,
                        struct rte_kvargs *kvlist)
@@ -805,12 +969,13 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	size_t ifnamelen;
 	unsigned k_idx;
 	struct sockaddr_ll sockaddr;
-	struct tpacket_req *req;
+	struct tpacket_req3 *req, tx_req;
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
-	int rc, tpver, discard;
+	int rc, discard;
 	int qsockfd = -1;
 	unsigned int i, q, rdsize;
+	socklen_t req_len;
 	int fanout_arg;
 
 	for (k_idx = 0; k_idx < kvlist->count; k_idx++) {
@@ -860,6 +1025,20 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	req->tp_block_nr = blockcnt;
 	req->tp_frame_size = framesize;
 	req->tp_frame_nr = framecnt;
+	(*internals)->tpver = tpver;
+
+	/*
+	 * With TPACKET_V3, the Rx ring is made of blocks retired on timeout,
+	 * the Tx ring is still made of frames and takes no block parameter.
+	 */
+	if (tpver == TPACKET_V3) {
+		req->tp_retire_blk_tov = block_timeout;
+		req_len = sizeof(*req);
+	} else {
+		req_len = sizeof(struct tpacket_req);
+	}
+	tx_req = *req;
+	tx_req.tp_retire_blk_tov = 0;
 
 	ifnamelen = strlen(pair->value);
 	if (ifnamelen < sizeof(ifr.ifr_name)) {
@@ -907,7 +1086,6 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		tpver = TPACKET_V2;
 		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_VERSION,
 				&tpver, sizeof(tpver));
 		if (rc == -1) {
@@ -940,7 +1118,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 #endif
 		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, sizeof(*req));
+		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, req_len);
 		if (rc == -1) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
@@ -948,7 +1126,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, req, sizeof(*req));
+		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, &tx_req, req_len);
 		if (rc == -1) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: could not set PACKET_TX_RING on AF_PACKET "
@@ -957,7 +1135,6 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		}
 
 		rx_queue = &((*internals)->rx_queue[q]);
-		rx_queue->framecount = req->tp_frame_nr;
 
 		rx_queue->map = mmap(NULL, 2 * req->tp_block_size * req->tp_block_nr,
 				    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
@@ -969,26 +1146,42 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		/* rdsize is same for both Tx and Rx */
-		rdsize = req->tp_frame_nr * sizeof(*(rx_queue->rd));
-
-		rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
-		if (rx_queue->rd == NULL)
-			goto error;
-		for (i = 0; i < req->tp_frame_nr; ++i) {
-			rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
-			rx_queue->rd[i].iov_len = req->tp_frame_size;
+		/* Rx walks the blocks with TPACKET_V3, the frames otherwise */
+		if (tpver == TPACKET_V3) {
+			rx_queue->framecount = req->tp_block_nr;
+			rdsize = req->tp_block_nr * sizeof(*(rx_queue->rd));
+			rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
+			if (rx_queue->rd == NULL)
+				goto error;
+			for (i = 0; i < req->tp_block_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * blocksize);
+				rx_queue->rd[i].iov_len = req->tp_block_size;
+			}
+		} else {
+			rx_queue->framecount = req->tp_frame_nr;
+			rdsize = req->tp_frame_nr * sizeof(*(rx_queue->rd));
+			rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
+			if (rx_queue->rd == NULL)
+				goto error;
+			for (i = 0; i < req->tp_frame_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
+				rx_queue->rd[i].iov_len = req->tp_frame_size;
+			}
 		}
 		rx_queue->sockfd = qsockfd;
 
 		tx_queue = &((*internals)->tx_queue[q]);
 		tx_queue->framecount = req->tp_frame_nr;
-		tx_queue->frame_data_size = req->tp_frame_size;
-		tx_queue->frame_data_size -= TPACKET2_HDRLEN -
+		tx_queue->tpacket_v3 = tpver == TPACKET_V3;
+		tx_queue->frame_data_off = (tpver == TPACKET_V3 ?
+			TPACKET3_HDRLEN : TPACKET2_HDRLEN) -
 			sizeof(struct sockaddr_ll);
+		tx_queue->frame_data_size = req->tp_frame_size -
+			tx_queue->frame_data_off;
 
 		tx_queue->map = rx_queue->map + req->tp_block_size * req->tp_block_nr;
 
+		rdsize = req->tp_frame_nr * sizeof(*(tx_queue->rd));
 		tx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
 		if (tx_queue->rd == NULL)
 			goto error;
@@ -1085,6 +1278,8 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	unsigned int qpairs = 1;
 	unsigned int qdisc_bypass = 1;
 	const char *fanout_mode = NULL;
+	unsigned int tpacket_v3 = 0;
+	unsigned int block_timeout = 0;
 
 	/* do some parameter checking */
 	if (*sockfd < 0)
@@ -1151,6 +1346,26 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 			fanout_mode = pair->value;
 			continue;
 		}
+		if (strstr(pair->key, ETH_AF_PACKET_TPACKET_V3_ARG) != NULL) {
+			tpacket_v3 = atoi(pair->value);
+			if (tpacket_v3 > 1) {
+				PMD_LOG(ERR,
+					"%s: invalid tpacket_v3 value",
+					name);
+				return -1;
+			}
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_BLOCK_TIMEOUT_ARG) != NULL) {
+			if (atoi(pair->value) < 0) {
+				PMD_LOG(ERR,
+					"%s: invalid block_timeout value",
+					name);
+				return -1;
+			}
+			block_timeout = atoi(pair->value);
+			continue;
+		}
 	}
 
 	if (framesize > blocksize) {
@@ -1172,17 +1387,24 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	PMD_LOG(INFO, "%s:\tblock count %d", name, blockcount);
 	PMD_LOG(INFO, "%s:\tframe size %d", name, framesize);
 	PMD_LOG(INFO, "%s:\tframe count %d", name, framecount);
+	if (tpacket_v3)
+		PMD_LOG(INFO, "%s:\tTPACKET_V3 Rx, block timeout %u ms%s",
+			name, block_timeout,
+			block_timeout == 0 ? " (kernel default)" : "");
 
 	if (rte_pmd_init_internals(dev, *sockfd, qpairs,
 				   blocksize, blockcount,
 				   framesize, framecount,
 				   qdisc_bypass,
 				   fanout_mode,
+				   tpacket_v3 ? TPACKET_V3 : TPACKET_V2,
+				   block_timeout,
 				   &internals, &eth_dev,
 				   kvlist) < 0)
 		return -1;
 
-	eth_dev->rx_pkt_burst = eth_af_packet_rx;
+	eth_dev->rx_pkt_burst = tpacket_v3 ? eth_af_packet_rx_v3 :
+		eth_af_packet_rx;
 	eth_dev->tx_pkt_burst = eth_af_packet_tx;
 
 	rte_eth_dev_probing_finish(eth_dev);
@@ -1274,4 +1496,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_af_packet,
 	"blocksz=<int> "
 	"framesz=<int> "
 	"framecnt=<int> "
-	"qdisc_bypass=<0|1>");
+	"qdisc_bypass=<0|1> "
+	"tpacket_v3=<0|1> "
+	"block_timeout=<int>");
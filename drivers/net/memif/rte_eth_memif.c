@@ -24,6 +24,7 @@
 #include <bus_vdev_driver.h>
 #include <rte_string_fns.h>
 #include <rte_errno.h>
+#include <rte_eal_paging.h>
 #include <rte_memory.h>
 #include <rte_memzone.h>
 #include <rte_eal_memconfig.h>
@@ -251,6 +252,61 @@ memif_get_buffer(struct pmd_process_private *proc_private, memif_desc_t *d)
 	return ((uint8_t *)proc_private->regions[d->region]->addr + d->offset);
 }
 
+/*
+ * Check that a descriptor given by the peer is in a mapped region
+ * and that its buffer fits in an mbuf.
+ */
+static inline bool
+memif_desc_valid(struct pmd_process_private *proc_private,
+		 const memif_desc_t *d)
+{
+	struct memif_region *r;
+
+	if (unlikely(d->region >= proc_private->regions_num))
+		return false;
+	r = proc_private->regions[d->region];
+	return r != NULL && d->length <= UINT16_MAX &&
+		(memif_region_size_t)d->offset + d->length <= r->region_size;
+}
+
+/*
+ * Get the region of a buffer exposed by a zero-copy client,
+ * or -1 if the buffer is not in the exposed memory.
+ */
+static inline int
+memif_get_buffer_region(struct pmd_process_private *proc_private,
+			struct memif_queue *mq, const void *buf,
+			memif_region_offset_t *offset)
+{
+	struct memif_region *r;
+	uintptr_t off;
+	uint16_t i;
+
+	/* buffers of a queue usually come from the same region */
+	r = proc_private->regions[mq->buf_region];
+	if (likely(r != NULL)) {
+		off = (uintptr_t)buf - (uintptr_t)r->addr;
+		if (likely(off < r->region_size && off <= UINT32_MAX)) {
+			*offset = off;
+			return mq->buf_region;
+		}
+	}
+
+	/* region 0 contains the rings only */
+	for (i = 1; i < proc_private->regions_num; i++) {
+		r = proc_private->regions[i];
+		off = (uintptr_t)buf - (uintptr_t)r->addr;
+		if (off < r->region_size) {
+			if (off > UINT32_MAX)
+				return -1;
+			mq->buf_region = i;
+			*offset = off;
+			return i;
+		}
+	}
+	return -1;
+}
+
 /* Free mbufs received by server */
 static void
 memif_free_stored_mbufs(struct pmd_process_private *proc_private, struct memif_queue *mq)
@@ -512,6 +568,7 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	memif_ring_t *ring = memif_get_ring_from_queue(proc_private, mq);
 	uint16_t cur_slot, last_slot, n_slots, ring_size, mask, s0, head;
 	uint16_t n_rx_pkts = 0;
+	memif_region_offset_t offset;
 	memif_desc_t *d0;
 	struct rte_mbuf *mbuf, *mbuf_tail;
 	struct rte_mbuf *mbuf_head = NULL;
@@ -611,18 +668,28 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	}
 
 	while (n_slots--) {
-		s0 = head++ & mask;
+		s0 = head & mask;
 		if (n_slots > 0)
-			rte_prefetch0(mq->buffers[head & mask]);
+			rte_prefetch0(mq->buffers[(head + 1) & mask]);
 		d0 = &ring->desc[s0];
 		/* store buffer header */
 		mbuf = mq->buffers[s0];
 		/* populate descriptor */
+		ret = memif_get_buffer_region(proc_private, mq,
+			rte_pktmbuf_mtod(mbuf, void *), &offset);
+		if (unlikely(ret < 0)) {
+			/* mempool outside of the memory exposed to the server */
+			s0 = head;
+			do {
+				rte_pktmbuf_free(mq->buffers[s0++ & mask]);
+			} while (n_slots--);
+			break;
+		}
 		d0->length = rte_pktmbuf_data_room_size(mq->mempool) -
 				RTE_PKTMBUF_HEADROOM;
-		d0->region = 1;
-		d0->offset = rte_pktmbuf_mtod(mbuf, uint8_t *) -
-			(uint8_t *)proc_private->regions[d0->region]->addr;
+		d0->region = ret;
+		d0->offset = offset;
+		head++;
 	}
 no_free_mbufs:
 	/* The ring->head acts as a guard variable between Tx and Rx
@@ -636,6 +703,171 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return n_rx_pkts;
 }
 
+/* Mbuf attached to a buffer received by a zero-copy server is freed */
+static void
+memif_zc_slot_free_cb(void *addr __rte_unused, void *opaque)
+{
+	struct memif_zc_slot *zs = opaque;
+
+	rte_atomic_store_explicit(&zs->busy, 0, rte_memory_order_release);
+}
+
+/* Give back to the client the slots whose mbufs are freed, in ring order */
+static void
+memif_zc_slots_release(memif_ring_t *ring, struct memif_queue *mq,
+		       uint16_t mask)
+{
+	uint16_t slot = mq->last_tail;
+
+	/* load-acquire: the application is done with the buffer */
+	while (slot != mq->last_head &&
+	       rte_atomic_load_explicit(&mq->zc_slots[slot & mask].busy,
+					rte_memory_order_acquire) == 0)
+		slot++;
+
+	if (slot == mq->last_tail)
+		return;
+	/* The ring->tail acts as a guard variable between Tx and Rx
+	 * threads, so using store-release pairs with load-acquire
+	 * in function eth_memif_tx for C2S rings.
+	 */
+	rte_atomic_store_explicit(&ring->tail, slot, rte_memory_order_release);
+	mq->last_tail = slot;
+}
+
+static uint16_t
+eth_memif_rx_zc_server(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct memif_queue *mq = queue;
+	struct pmd_internals *pmd = rte_eth_devices[mq->in_port].data->dev_private;
+	struct pmd_process_private *proc_private =
+		rte_eth_devices[mq->in_port].process_private;
+	memif_ring_t *ring = memif_get_ring_from_queue(proc_private, mq);
+	uint16_t cur_slot, pkt_slot, last_slot, n_slots, mask, s0;
+	uint16_t n_rx_pkts = 0, n_mbufs = 0, i = 0;
+	struct rte_mbuf *mbufs[MAX_PKT_BURST];
+	struct rte_mbuf *mbuf, *mbuf_head, *mbuf_tail = NULL;
+	struct memif_zc_slot *zs;
+	memif_desc_t *d0;
+	struct rte_eth_link link;
+	bool bad_pkt;
+	void *buf;
+	int ret;
+
+	if (unlikely((pmd->flags & ETH_MEMIF_FLAG_CONNECTED) == 0))
+		return 0;
+	if (unlikely(ring == NULL || mq->zc_slots == NULL)) {
+		/* Secondary process will attempt to request regions. */
+		ret = rte_eth_link_get(mq->in_port, &link);
+		if (ret < 0)
+			MIF_LOG(ERR, "Failed to get port %u link info: %s",
+				mq->in_port, rte_strerror(-ret));
+		return 0;
+	}
+
+	/* consume interrupt */
+	if ((rte_intr_fd_get(mq->intr_handle) >= 0) &&
+	    ((ring->flags & MEMIF_RING_FLAG_MASK_INT) == 0)) {
+		uint64_t b;
+		ssize_t size __rte_unused;
+		size = read(rte_intr_fd_get(mq->intr_handle), &b,
+			    sizeof(b));
+	}
+
+	mask = (1 << mq->log2_ring_size) - 1;
+
+	memif_zc_slots_release(ring, mq, mask);
+
+	/* ring type always MEMIF_RING_C2S */
+	cur_slot = mq->last_head;
+	last_slot = rte_atomic_load_explicit(&ring->head, rte_memory_order_acquire);
+	n_slots = last_slot - cur_slot;
+
+	while (n_slots && n_rx_pkts < nb_pkts) {
+		pkt_slot = cur_slot;
+		mbuf_head = NULL;
+		bad_pkt = false;
+
+		/* one mbuf per descriptor, the buffers are attached in place */
+		do {
+			s0 = cur_slot & mask;
+			d0 = &ring->desc[s0];
+
+			/*
+			 * The descriptors come from the peer: a packet with
+			 * a buffer out of the regions is dropped, its slots
+			 * are left free to be released.
+			 */
+			if (unlikely(bad_pkt ||
+					!memif_desc_valid(proc_private, d0))) {
+				bad_pkt = true;
+				cur_slot++;
+				n_slots--;
+				continue;
+			}
+
+			if (i == n_mbufs) {
+				n_mbufs = RTE_MIN(n_slots, MAX_PKT_BURST);
+				i = 0;
+				ret = rte_pktmbuf_alloc_bulk(mq->mempool, mbufs, n_mbufs);
+				if (unlikely(ret < 0)) {
+					n_mbufs = 0;
+					rte_pktmbuf_free(mbuf_head);
+					cur_slot = pkt_slot;
+					goto no_free_bufs;
+				}
+			}
+			mbuf = mbufs[i++];
+			zs = &mq->zc_slots[s0];
+
+			rte_atomic_store_explicit(&zs->busy, 1, rte_memory_order_relaxed);
+			rte_mbuf_ext_refcnt_set(&zs->shinfo, 1);
+			buf = memif_get_buffer(proc_private, d0);
+			rte_pktmbuf_attach_extbuf(mbuf, buf,
+				proc_private->regions[d0->region]->extmem ?
+				(rte_iova_t)(uintptr_t)buf : RTE_BAD_IOVA,
+				d0->length, &zs->shinfo);
+			rte_pktmbuf_data_len(mbuf) = d0->length;
+			rte_pktmbuf_pkt_len(mbuf) = d0->length;
+			mbuf->port = mq->in_port;
+
+			if (mbuf_head == NULL) {
+				mbuf_head = mbuf;
+			} else if (unlikely(memif_pktmbuf_chain(mbuf_head,
+					mbuf_tail, mbuf) < 0)) {
+				MIF_LOG(ERR, "number-of-segments-overflow");
+				rte_pktmbuf_free(mbuf);
+				rte_pktmbuf_free(mbuf_head);
+				cur_slot = pkt_slot;
+				goto no_free_bufs;
+			}
+			mbuf_tail = mbuf;
+
+			cur_slot++;
+			n_slots--;
+		} while ((d0->flags & MEMIF_DESC_FLAG_NEXT) && n_slots);
+
+		if (unlikely(bad_pkt)) {
+			/* detaching the buffers frees their slots */
+			rte_pktmbuf_free(mbuf_head);
+			mq->n_err++;
+			continue;
+		}
+		mq->n_bytes += rte_pktmbuf_pkt_len(mbuf_head);
+		*bufs++ = mbuf_head;
+		n_rx_pkts++;
+	}
+
+no_free_bufs:
+	if (i < n_mbufs)
+		rte_pktmbuf_free_bulk(&mbufs[i], n_mbufs - i);
+	mq->last_head = cur_slot;
+
+	mq->n_pkts += n_rx_pkts;
+
+	return n_rx_pkts;
+}
+
 static uint16_t
 eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -820,26 +1052,34 @@ eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return n_tx_pkts;
 }
 
+/*
+ * Fill the descriptors of a packet sent by a zero-copy client.
+ * Return the number of used slots, 0 if there are not enough free slots,
+ * or -1 if a buffer is outside of the memory exposed to the server.
+ */
 static int
 memif_tx_one_zc(struct pmd_process_private *proc_private, struct memif_queue *mq,
 		memif_ring_t *ring, struct rte_mbuf *mbuf, const uint16_t mask,
 		uint16_t slot, uint16_t n_free)
 {
 	memif_desc_t *d0;
+	memif_region_offset_t offset;
 	uint16_t nb_segs = mbuf->nb_segs;
 	int used_slots = 1;
+	int region;
 
 next_in_chain:
+	region = memif_get_buffer_region(proc_private, mq,
+		rte_pktmbuf_mtod(mbuf, void *), &offset);
+	if (unlikely(region < 0))
+		return -1;
 	/* store pointer to mbuf to free it later */
 	mq->buffers[slot & mask] = mbuf;
 	/* populate descriptor */
 	d0 = &ring->desc[slot & mask];
 	d0->length = rte_pktmbuf_data_len(mbuf);
-	mq->n_bytes += rte_pktmbuf_data_len(mbuf);
-	/* FIXME: get region index */
-	d0->region = 1;
-	d0->offset = rte_pktmbuf_mtod(mbuf, uint8_t *) -
-		(uint8_t *)proc_private->regions[d0->region]->addr;
+	d0->region = region;
+	d0->offset = offset;
 	d0->flags = 0;
 
 	/* check if buffer is chained */
@@ -902,49 +1142,21 @@ eth_memif_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	int used_slots;
 
 	while (n_free && (n_tx_pkts < nb_pkts)) {
-		while ((n_free > 4) && ((nb_pkts - n_tx_pkts) > 4)) {
-			if ((nb_pkts - n_tx_pkts) > 8) {
-				rte_prefetch0(*bufs + 4);
-				rte_prefetch0(*bufs + 5);
-				rte_prefetch0(*bufs + 6);
-				rte_prefetch0(*bufs + 7);
-			}
-			used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs++,
-				mask, slot, n_free);
-			if (unlikely(used_slots < 1))
-				goto no_free_slots;
-			n_tx_pkts++;
-			slot += used_slots;
-			n_free -= used_slots;
-
-			used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs++,
-				mask, slot, n_free);
-			if (unlikely(used_slots < 1))
-				goto no_free_slots;
-			n_tx_pkts++;
-			slot += used_slots;
-			n_free -= used_slots;
-
-			used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs++,
-				mask, slot, n_free);
-			if (unlikely(used_slots < 1))
-				goto no_free_slots;
-			n_tx_pkts++;
-			slot += used_slots;
-			n_free -= used_slots;
-
-			used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs++,
-				mask, slot, n_free);
-			if (unlikely(used_slots < 1))
-				goto no_free_slots;
-			n_tx_pkts++;
-			slot += used_slots;
-			n_free -= used_slots;
-		}
-		used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs++,
+		if ((nb_pkts - n_tx_pkts) > 4)
+			rte_prefetch0(bufs[4]);
+		used_slots = memif_tx_one_zc(proc_private, mq, ring, *bufs,
 			mask, slot, n_free);
-		if (unlikely(used_slots < 1))
+		if (unlikely(used_slots == 0))
 			goto no_free_slots;
+		if (unlikely(used_slots < 0)) {
+			/* cannot be described to the server, drop */
+			rte_pktmbuf_free(*bufs);
+			mq->n_err++;
+			used_slots = 0;
+		} else {
+			mq->n_bytes += rte_pktmbuf_pkt_len(*bufs);
+		}
+		bufs++;
 		n_tx_pkts++;
 		slot += used_slots;
 		n_free -= used_slots;
@@ -978,14 +1190,130 @@ eth_memif_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return n_tx_pkts;
 }
 
+/* Check if received mbufs of a zero-copy server are still attached */
+static bool
+memif_zc_slots_busy(const struct memif_queue *mq)
+{
+	uint32_t i;
+
+	if (mq == NULL || mq->zc_slots == NULL)
+		return false;
+	for (i = 0; i < mq->zc_nb_slots; i++)
+		if (rte_atomic_load_explicit(&mq->zc_slots[i].busy,
+					     rte_memory_order_acquire) != 0)
+			return true;
+	return false;
+}
+
+/* Allocate the slots of the rx queues of a zero-copy server */
+static int
+memif_zc_slots_init(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *pmd = dev->data->dev_private;
+	struct memif_queue *mq;
+	struct memif_zc_slot *zs;
+	uint32_t i, nb_slots;
+	int q;
+
+	for (q = 0; q < pmd->run.num_c2s_rings; q++) {
+		mq = dev->data->rx_queues[q];
+		nb_slots = 1 << mq->log2_ring_size;
+
+		if (memif_zc_slots_busy(mq)) {
+			/* freed later mbufs must not release the new slots */
+			MIF_LOG(WARNING, "Rx queue %d: mbufs of the previous connection are not freed",
+				q);
+			mq->zc_slots = NULL;
+		} else if (mq->zc_nb_slots != nb_slots) {
+			rte_free(mq->zc_slots);
+			mq->zc_slots = NULL;
+		}
+		if (mq->zc_slots == NULL) {
+			mq->zc_slots = rte_zmalloc_socket("zc-slots",
+				sizeof(*mq->zc_slots) * nb_slots, RTE_CACHE_LINE_SIZE,
+				dev->data->numa_node);
+			if (mq->zc_slots == NULL)
+				return -ENOMEM;
+			mq->zc_nb_slots = nb_slots;
+		}
+		for (i = 0; i < nb_slots; i++) {
+			zs = &mq->zc_slots[i];
+			zs->shinfo.free_cb = memif_zc_slot_free_cb;
+			zs->shinfo.fcb_opaque = zs;
+			rte_mbuf_ext_refcnt_set(&zs->shinfo, 1);
+			rte_atomic_store_explicit(&zs->busy, 0, rte_memory_order_relaxed);
+		}
+	}
+	return 0;
+}
+
+/*
+ * In IOVA as VA mode, register a client region received by a zero-copy
+ * server as external memory and DMA map it for the other ports,
+ * so that the received mbufs can be transmitted by these devices.
+ */
+static void
+memif_region_dma_map(struct rte_eth_dev *dev, struct memif_region *r)
+{
+	size_t len = RTE_ALIGN_CEIL(r->region_size, rte_mem_page_size());
+	uint16_t port_id;
+
+	if (rte_eal_iova_mode() != RTE_IOVA_VA)
+		return;
+	if (rte_extmem_register(r->addr, len, NULL, 0,
+			rte_mem_page_size()) != 0) {
+		MIF_LOG(NOTICE, "Failed to register region: %s, no IOVA",
+			rte_strerror(rte_errno));
+		return;
+	}
+	r->extmem = true;
+
+	RTE_ETH_FOREACH_DEV(port_id) {
+		if (port_id == dev->data->port_id)
+			continue;
+		if (rte_dev_dma_map(rte_eth_devices[port_id].device, r->addr,
+				(uintptr_t)r->addr, len) == 0)
+			r->dma_ports[r->nb_dma_ports++] = port_id;
+		else if (rte_errno != ENOTSUP)
+			MIF_LOG(NOTICE, "Failed to DMA map region for port %u: %s",
+				port_id, rte_strerror(rte_errno));
+	}
+}
+
+static void
+memif_region_dma_unmap(struct memif_region *r)
+{
+	size_t len = RTE_ALIGN_CEIL(r->region_size, rte_mem_page_size());
+	uint16_t i, port_id;
+
+	for (i = 0; i < r->nb_dma_ports; i++) {
+		port_id = r->dma_ports[i];
+		if (rte_eth_dev_is_valid_port(port_id))
+			rte_dev_dma_unmap(rte_eth_devices[port_id].device,
+				r->addr, (uintptr_t)r->addr, len);
+	}
+	r->nb_dma_ports = 0;
+	if (r->extmem)
+		rte_extmem_unregister(r->addr, len);
+	r->extmem = false;
+}
+
 void
 memif_free_regions(struct rte_eth_dev *dev)
 {
 	struct pmd_process_private *proc_private = dev->process_private;
 	struct pmd_internals *pmd = dev->data->dev_private;
+	bool busy = false;
 	int i;
 	struct memif_region *r;
 
+	if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY_RX) {
+		for (i = 0; i < dev->data->nb_rx_queues; i++)
+			busy |= memif_zc_slots_busy(dev->data->rx_queues[i]);
+		if (busy)
+			MIF_LOG(WARNING, "Received mbufs are not freed, keeping regions mapped");
+	}
+
 	/* regions are allocated contiguously, so it's
 	 * enough to loop until 'proc_private->regions_num'
 	 */
@@ -999,7 +1327,10 @@ memif_free_regions(struct rte_eth_dev *dev)
 					close(r->fd);
 			}
 			if (r->addr != NULL) {
-				munmap(r->addr, r->region_size);
+				if (!busy) {
+					memif_region_dma_unmap(r);
+					munmap(r->addr, r->region_size);
+				}
 				if (r->fd > 0) {
 					close(r->fd);
 					r->fd = -1;
@@ -1012,41 +1343,65 @@ memif_free_regions(struct rte_eth_dev *dev)
 	proc_private->regions_num = 0;
 }
 
+/*
+ * Expose the memory of a zero-copy client: one region per file backing
+ * memory segments, starting at the beginning of the file.
+ */
 static int
-memif_region_init_zc(const struct rte_memseg_list *msl, const struct rte_memseg *ms,
-		     void *arg)
+memif_region_init_zc(const struct rte_memseg_list *msl __rte_unused,
+		     const struct rte_memseg *ms, void *arg)
 {
 	struct pmd_process_private *proc_private = (struct pmd_process_private *)arg;
 	struct memif_region *r;
+	size_t fd_offset;
+	uint8_t *base;
+	int fd;
 
 	if (proc_private->regions_num < 1) {
 		MIF_LOG(ERR, "Missing descriptor region");
 		return -1;
 	}
 
+	fd = rte_memseg_get_fd_thread_unsafe(ms);
+	if (fd < 0 || rte_memseg_get_fd_offset_thread_unsafe(ms, &fd_offset) < 0) {
+		MIF_LOG(ERR, "Failed to get memseg file: %s", rte_strerror(rte_errno));
+		return -1;
+	}
+	/* address of the start of the file */
+	base = RTE_PTR_SUB(ms->addr, fd_offset);
+
+	/* the segment is in the file of the last region */
 	r = proc_private->regions[proc_private->regions_num - 1];
+	if (proc_private->regions_num > 1 && r->addr == base) {
+		r->region_size = RTE_MAX(r->region_size,
+			RTE_PTR_DIFF(RTE_PTR_ADD(ms->addr, ms->len), base));
+		return 0;
+	}
 
-	if (r->addr != msl->base_va)
-		r = proc_private->regions[++proc_private->regions_num - 1];
+	if (proc_private->regions_num >= ETH_MEMIF_MAX_REGION_NUM) {
+		MIF_LOG(WARNING, "Too many regions, memory from %p is not exposed",
+			ms->addr);
+		return 1;
+	}
 
+	r = rte_zmalloc("region", sizeof(struct memif_region), 0);
 	if (r == NULL) {
-		r = rte_zmalloc("region", sizeof(struct memif_region), 0);
-		if (r == NULL) {
-			MIF_LOG(ERR, "Failed to alloc memif region.");
-			return -ENOMEM;
-		}
-
-		r->addr = msl->base_va;
-		r->region_size = ms->len;
-		r->fd = rte_memseg_get_fd(ms);
-		if (r->fd < 0)
-			return -1;
-		r->pkt_buffer_offset = 0;
+		MIF_LOG(ERR, "Failed to alloc memif region.");
+		return -ENOMEM;
+	}
 
-		proc_private->regions[proc_private->regions_num - 1] = r;
-	} else {
-		r->region_size += ms->len;
+	/* own descriptor, closed once sent to the server */
+	r->fd = dup(fd);
+	if (r->fd < 0) {
+		MIF_LOG(ERR, "Failed to dup memseg file: %s", strerror(errno));
+		rte_free(r);
+		return -1;
 	}
+	r->addr = base;
+	r->region_size = RTE_PTR_DIFF(RTE_PTR_ADD(ms->addr, ms->len), base);
+	r->pkt_buffer_offset = 0;
+
+	proc_private->regions[proc_private->regions_num++] = r;
 
 	return 0;
 }
@@ -1225,6 +1580,7 @@ memif_init_queues(struct rte_eth_dev *dev)
 		mq->ring_offset = memif_get_ring_offset(dev, mq, MEMIF_RING_C2S, i);
 		mq->last_head = 0;
 		mq->last_tail = 0;
+		mq->buf_region = 1;
 		if (rte_intr_fd_set(mq->intr_handle, eventfd(0, EFD_NONBLOCK)))
 			return -rte_errno;
 
@@ -1250,6 +1606,7 @@ memif_init_queues(struct rte_eth_dev *dev)
 		mq->ring_offset = memif_get_ring_offset(dev, mq, MEMIF_RING_S2C, i);
 		mq->last_head = 0;
 		mq->last_tail = 0;
+		mq->buf_region = 1;
 		if (rte_intr_fd_set(mq->intr_handle, eventfd(0, EFD_NONBLOCK)))
 			return -rte_errno;
 		if (rte_intr_fd_get(mq->intr_handle) < 0) {
@@ -1314,6 +1671,9 @@ memif_connect(struct rte_eth_dev *dev)
 						strerror(errno));
 					return -1;
 				}
+				if ((pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY_RX) &&
+				    rte_eal_process_type() == RTE_PROC_PRIMARY)
+					memif_region_dma_map(dev, mr);
 			}
 			if (i > 0 && (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY)) {
 				/* close memseg file */
@@ -1340,6 +1700,12 @@ memif_connect(struct rte_eth_dev *dev)
 			if (pmd->role == MEMIF_ROLE_SERVER)
 				ring->flags = MEMIF_RING_FLAG_MASK_INT;
 		}
+		if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY_RX) {
+			if (memif_zc_slots_init(dev) < 0) {
+				MIF_LOG(ERR, "Failed to alloc zero-copy slots");
+				return -1;
+			}
+		}
 		for (i = 0; i < pmd->run.num_s2c_rings; i++) {
 			mq = (pmd->role == MEMIF_ROLE_CLIENT) ?
 			    dev->data->rx_queues[i] : dev->data->tx_queues[i];
@@ -1543,6 +1909,10 @@ memif_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 	if (!mq)
 		return;
 
+	if (memif_zc_slots_busy(mq))
+		MIF_LOG(WARNING, "Rx queue %u: received mbufs are not freed", qid);
+	else
+		rte_free(mq->zc_slots);
 	rte_intr_instance_free(mq->intr_handle);
 	rte_free(mq);
 }
@@ -1589,6 +1959,7 @@ memif_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 	stats->ibytes = 0;
 	stats->opackets = 0;
 	stats->obytes = 0;
+	stats->oerrors = 0;
 
 	tmp = (pmd->role == MEMIF_ROLE_CLIENT) ? pmd->run.num_s2c_rings :
 	    pmd->run.num_c2s_rings;
@@ -1602,6 +1973,7 @@ memif_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 		stats->q_ibytes[i] = mq->n_bytes;
 		stats->ipackets += mq->n_pkts;
 		stats->ibytes += mq->n_bytes;
+		stats->ierrors += mq->n_err;
 	}
 
 	tmp = (pmd->role == MEMIF_ROLE_CLIENT) ? pmd->run.num_c2s_rings :
@@ -1616,6 +1988,7 @@ memif_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 		stats->q_obytes[i] = mq->n_bytes;
 		stats->opackets += mq->n_pkts;
 		stats->obytes += mq->n_bytes;
+		stats->oerrors += mq->n_err;
 	}
 	return 0;
 }
@@ -1632,12 +2005,14 @@ memif_stats_reset(struct rte_eth_dev *dev)
 		    dev->data->rx_queues[i];
 		mq->n_pkts = 0;
 		mq->n_bytes = 0;
+		mq->n_err = 0;
 	}
 	for (i = 0; i < pmd->run.num_s2c_rings; i++) {
 		mq = (pmd->role == MEMIF_ROLE_CLIENT) ? dev->data->rx_queues[i] :
 		    dev->data->tx_queues[i];
 		mq->n_pkts = 0;
 		mq->n_bytes = 0;
+		mq->n_err = 0;
 	}
 
 	return 0;
@@ -1697,9 +2072,15 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	pmd->flags = flags;
 	pmd->flags |= ETH_MEMIF_FLAG_DISABLED;
 	pmd->role = role;
-	/* Zero-copy flag irelevant to server. */
-	if (pmd->role == MEMIF_ROLE_SERVER)
+	/*
+	 * Zero-copy server does not expose memory,
+	 * it receives in the client buffers and sends by copy.
+	 */
+	if (pmd->role == MEMIF_ROLE_SERVER &&
+	    (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY)) {
 		pmd->flags &= ~ETH_MEMIF_FLAG_ZERO_COPY;
+		pmd->flags |= ETH_MEMIF_FLAG_ZERO_COPY_RX;
+	}
 	pmd->owner_uid = owner_uid;
 	pmd->owner_gid = owner_gid;
 
@@ -1732,6 +2113,9 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY) {
 		eth_dev->rx_pkt_burst = eth_memif_rx_zc;
 		eth_dev->tx_pkt_burst = eth_memif_tx_zc;
+	} else if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY_RX) {
+		eth_dev->rx_pkt_burst = eth_memif_rx_zc_server;
+		eth_dev->tx_pkt_burst = eth_memif_tx;
 	} else {
 		eth_dev->rx_pkt_burst = eth_memif_rx;
 		eth_dev->tx_pkt_burst = eth_memif_tx;
@@ -44,6 +44,15 @@ struct memif_region {
 	int fd;					/**< shared memory file descriptor */
 	uint32_t pkt_buffer_offset;
 	/**< offset from 'addr' to first packet buffer */
+	bool extmem;				/**< registered as external memory */
+	uint16_t nb_dma_ports;			/**< ports it is DMA mapped for */
+	uint16_t dma_ports[RTE_MAX_ETHPORTS];
+};
+
+/** Ring slot received in place by a zero-copy server. */
+struct memif_zc_slot {
+	struct rte_mbuf_ext_shared_info shinfo;	/**< of the attached buffer */
+	RTE_ATOMIC(uint8_t) busy;		/**< attached mbuf not freed yet */
 };
 
 struct memif_queue {
@@ -66,9 +75,19 @@ struct memif_queue {
 	 * mbufs to free them once server has received them.
 	 */
 
+	struct memif_zc_slot *zc_slots;
+	/**< Slots of zero-copy server rx. The ring tail is moved past a slot
+	 * once the mbuf attached to its buffer is freed.
+	 */
+	uint32_t zc_nb_slots;			/**< number of zc_slots */
+
+	memif_region_index_t buf_region;
+	/**< Region of the last buffer of a zero-copy client. */
+
 	/* rx/tx info */
 	uint64_t n_pkts;			/**< number of rx/tx packets */
 	uint64_t n_bytes;			/**< number of rx/tx bytes */
+	uint64_t n_err;				/**< number of dropped packets */
 
 	struct rte_intr_handle *intr_handle;	/**< interrupt handle */
 
@@ -89,6 +108,8 @@ struct pmd_internals {
 /**< device has not been configured and can not accept connection requests */
 #define ETH_MEMIF_FLAG_SOCKET_ABSTRACT	(1 << 4)
 /**< use abstract socket address */
+#define ETH_MEMIF_FLAG_ZERO_COPY_RX		(1 << 5)
+/**< server receives in the client buffers, without copy */
 
 	char *socket_filename;			/**< pointer to socket filename */
 	uid_t owner_uid;			/**< socket owner uid */
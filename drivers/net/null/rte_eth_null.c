@@ -3,32 +3,110 @@
  *  All rights reserved.
  */
 
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <rte_mbuf.h>
 #include <ethdev_driver.h>
 #include <ethdev_vdev.h>
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
+#include <rte_memzone.h>
 #include <bus_vdev_driver.h>
 #include <rte_kvargs.h>
 #include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+#include <rte_ether.h>
+#include <rte_ip4.h>
+#include <rte_ip6.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
 
 #define ETH_NULL_PACKET_SIZE_ARG	"size"
 #define ETH_NULL_PACKET_COPY_ARG	"copy"
 #define ETH_NULL_PACKET_NO_RX_ARG	"no-rx"
+#define ETH_NULL_GEN_ARG		"gen"
+#define ETH_NULL_GEN_L3_ARG		"gen_l3"
+#define ETH_NULL_GEN_L4_ARG		"gen_l4"
+#define ETH_NULL_GEN_DST_MAC_ARG	"gen_dst_mac"
+#define ETH_NULL_GEN_SRC_IP_ARG		"gen_src_ip"
+#define ETH_NULL_GEN_DST_IP_ARG		"gen_dst_ip"
+#define ETH_NULL_GEN_SRC_PORT_ARG	"gen_src_port"
+#define ETH_NULL_GEN_DST_PORT_ARG	"gen_dst_port"
+#define ETH_NULL_GEN_SIZES_ARG		"gen_sizes"
+#define ETH_NULL_GEN_FLOWS_ARG		"gen_flows"
+#define ETH_NULL_GEN_ZIPF_ARG		"gen_zipf"
+#define ETH_NULL_GEN_RING_ARG		"gen_ring"
+
+#define NULL_GEN_MAX_SIZES	8
+#define NULL_GEN_MAX_PKT_LEN	RTE_ETHER_MAX_JUMBO_FRAME_LEN
+#define NULL_GEN_MAX_FLOWS	(1U << 20)
+#define NULL_GEN_MIN_RING	64
+#define NULL_GEN_MAX_RING	(1U << 20)
+#define NULL_GEN_DEFAULT_RING	4096
 
 static unsigned int default_packet_size = 64;
 static unsigned int default_packet_copy;
 static unsigned int default_no_rx;
+/* the packets of a freed queue may be kept, each ring has its own memzone */
+static RTE_ATOMIC(uint32_t) null_gen_id;
 
 static const char *valid_arguments[] = {
 	ETH_NULL_PACKET_SIZE_ARG,
 	ETH_NULL_PACKET_COPY_ARG,
 	ETH_NULL_PACKET_NO_RX_ARG,
+	ETH_NULL_GEN_ARG,
+	ETH_NULL_GEN_L3_ARG,
+	ETH_NULL_GEN_L4_ARG,
+	ETH_NULL_GEN_DST_MAC_ARG,
+	ETH_NULL_GEN_SRC_IP_ARG,
+	ETH_NULL_GEN_DST_IP_ARG,
+	ETH_NULL_GEN_SRC_PORT_ARG,
+	ETH_NULL_GEN_DST_PORT_ARG,
+	ETH_NULL_GEN_SIZES_ARG,
+	ETH_NULL_GEN_FLOWS_ARG,
+	ETH_NULL_GEN_ZIPF_ARG,
+	ETH_NULL_GEN_RING_ARG,
 	NULL
 };
 
+/* packet template and flow mix of the traffic generator */
+struct null_gen_conf {
+	unsigned int ipv6;
+	unsigned int proto;		/* IPPROTO_UDP or IPPROTO_TCP */
+	struct rte_ether_addr dst_mac;
+	uint32_t src_ip4;		/* host order */
+	uint32_t dst_ip4;
+	struct rte_ipv6_addr src_ip6;
+	struct rte_ipv6_addr dst_ip6;
+	uint16_t src_port;
+	uint16_t dst_port;
+	unsigned int nb_sizes;
+	uint16_t sizes[NULL_GEN_MAX_SIZES];
+	unsigned int weights[NULL_GEN_MAX_SIZES];
+	unsigned int nb_flows;
+	double zipf;			/* 0 for uniform flows */
+	unsigned int ring_size;
+};
+
+/* a precomputed packet, attached to the received mbufs */
+struct null_gen_pkt {
+	struct rte_mbuf_ext_shared_info shinfo;
+	void *data;
+	rte_iova_t iova;
+	uint16_t len;
+};
+
+/* ring of precomputed packets of an Rx queue */
+struct null_gen {
+	unsigned int next;
+	unsigned int nb_pkts;
+	uint32_t packet_type;
+	const struct rte_memzone *mz;
+	struct null_gen_pkt pkts[];
+};
+
 struct pmd_internals;
 
 struct null_queue {
@@ -36,6 +114,7 @@ struct null_queue {
 
 	struct rte_mempool *mb_pool;
 	struct rte_mbuf *dummy_packet;
+	struct null_gen *gen;
 
 	RTE_ATOMIC(uint64_t) rx_pkts;
 	RTE_ATOMIC(uint64_t) tx_pkts;
@@ -45,12 +124,16 @@ struct pmd_options {
 	unsigned int packet_copy;
 	unsigned int packet_size;
 	unsigned int no_rx;
+	unsigned int gen;
+	struct null_gen_conf gen_conf;
 };
 
 struct pmd_internals {
 	unsigned int packet_size;
 	unsigned int packet_copy;
 	unsigned int no_rx;
+	unsigned int gen;
+	struct null_gen_conf gen_conf;
 	uint16_t port_id;
 
 	struct null_queue rx_null_queues[RTE_MAX_QUEUES_PER_PORT];
@@ -142,6 +225,46 @@ eth_null_no_rx(void *q __rte_unused, struct rte_mbuf **bufs __rte_unused,
 	return 0;
 }
 
+static uint16_t
+eth_null_gen_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	int i;
+	struct null_queue *h = q;
+	struct null_gen *gen;
+	struct null_gen_pkt *pkt;
+	unsigned int next;
+
+	if ((q == NULL) || (bufs == NULL))
+		return 0;
+
+	gen = h->gen;
+	if (rte_pktmbuf_alloc_bulk(h->mb_pool, bufs, nb_bufs) != 0)
+		return 0;
+
+	/* only the mbufs are written, the packet data is shared */
+	next = gen->next;
+	for (i = 0; i < nb_bufs; i++) {
+		pkt = &gen->pkts[next];
+		rte_mbuf_ext_refcnt_update(&pkt->shinfo, 1);
+		rte_pktmbuf_attach_extbuf(bufs[i], pkt->data, pkt->iova,
+				pkt->len, &pkt->shinfo);
+		bufs[i]->data_len = pkt->len;
+		bufs[i]->pkt_len = pkt->len;
+		bufs[i]->port = h->internals->port_id;
+		bufs[i]->packet_type = gen->packet_type;
+		bufs[i]->ol_flags |= RTE_MBUF_F_RX_IP_CKSUM_GOOD |
+				RTE_MBUF_F_RX_L4_CKSUM_GOOD;
+		if (++next == gen->nb_pkts)
+			next = 0;
+	}
+	gen->next = next;
+
+	/* NOTE: review for potential ordering optimization */
+	rte_atomic_fetch_add_explicit(&h->rx_pkts, i, rte_memory_order_seq_cst);
+
+	return i;
+}
+
 static uint16_t
 eth_null_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
@@ -225,6 +348,279 @@ eth_dev_stop(struct rte_eth_dev *dev)
 	return 0;
 }
 
+static void
+null_gen_free_cb(void *addr __rte_unused, void *opaque __rte_unused)
+{
+	/* the queue keeps a reference, the packets are freed with the queue */
+}
+
+/* xorshift64*, seeded per queue so that the packet rings are reproducible */
+static uint64_t
+null_gen_rand(uint64_t *state)
+{
+	uint64_t x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+/* uniform in [0, 1) */
+static double
+null_gen_rand_double(uint64_t *state)
+{
+	return (double)(null_gen_rand(state) >> 11) /
+		(double)(UINT64_C(1) << 53);
+}
+
+static unsigned int
+null_gen_hdr_len(const struct null_gen_conf *conf)
+{
+	unsigned int len = sizeof(struct rte_ether_hdr);
+
+	len += conf->ipv6 ? sizeof(struct rte_ipv6_hdr) :
+		sizeof(struct rte_ipv4_hdr);
+	len += conf->proto == IPPROTO_TCP ? sizeof(struct rte_tcp_hdr) :
+		sizeof(struct rte_udp_hdr);
+	return len;
+}
+
+/* cumulative distribution of the Zipf law of exponent s over n flows */
+static double *
+null_gen_zipf_cdf(unsigned int n, double s)
+{
+	double *cdf, sum = 0;
+	unsigned int k;
+
+	cdf = malloc(n * sizeof(*cdf));
+	if (cdf == NULL)
+		return NULL;
+
+	for (k = 0; k < n; k++) {
+		sum += 1.0 / pow(k + 1, s);
+		cdf[k] = sum;
+	}
+	for (k = 0; k < n; k++)
+		cdf[k] /= sum;
+
+	return cdf;
+}
+
+static uint32_t
+null_gen_zipf_flow(const double *cdf, unsigned int n, double u)
+{
+	unsigned int lo = 0, hi = n - 1, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (cdf[mid] > u)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return lo;
+}
+
+/* add the flow index to the last 32 bits of an IPv6 address */
+static void
+null_gen_ip6_add(struct rte_ipv6_addr *ip, uint32_t flow)
+{
+	rte_be32_t a;
+
+	memcpy(&a, &ip->a[RTE_IPV6_ADDR_SIZE - sizeof(a)], sizeof(a));
+	a = rte_cpu_to_be_32(rte_be_to_cpu_32(a) + flow);
+	memcpy(&ip->a[RTE_IPV6_ADDR_SIZE - sizeof(a)], &a, sizeof(a));
+}
+
+/* write the headers of a packet of the flow, the payload is left zeroed */
+static void
+null_gen_build(const struct null_gen_conf *conf,
+		const struct rte_ether_addr *src_mac, uint32_t flow,
+		void *data, uint16_t len)
+{
+	struct rte_ether_hdr *eth = data;
+	struct rte_ipv4_hdr *ip4 = NULL;
+	struct rte_ipv6_hdr *ip6 = NULL;
+	struct rte_tcp_hdr *tcp;
+	struct rte_udp_hdr *udp;
+	uint16_t l4_len, cksum;
+	void *l4;
+
+	rte_ether_addr_copy(&conf->dst_mac, &eth->dst_addr);
+	rte_ether_addr_copy(src_mac, &eth->src_addr);
+
+	if (conf->ipv6) {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		ip6 = (struct rte_ipv6_hdr *)(eth + 1);
+		l4 = ip6 + 1;
+		l4_len = len - sizeof(*eth) - sizeof(*ip6);
+		ip6->vtc_flow = rte_cpu_to_be_32(UINT32_C(6) << 28);
+		ip6->payload_len = rte_cpu_to_be_16(l4_len);
+		ip6->proto = conf->proto;
+		ip6->hop_limits = 64;
+		ip6->src_addr = conf->src_ip6;
+		ip6->dst_addr = conf->dst_ip6;
+		null_gen_ip6_add(&ip6->src_addr, flow);
+		null_gen_ip6_add(&ip6->dst_addr, flow);
+	} else {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		ip4 = (struct rte_ipv4_hdr *)(eth + 1);
+		l4 = ip4 + 1;
+		l4_len = len - sizeof(*eth) - sizeof(*ip4);
+		ip4->version_ihl = RTE_IPV4_VHL_DEF;
+		ip4->total_length = rte_cpu_to_be_16(len - sizeof(*eth));
+		ip4->time_to_live = 64;
+		ip4->next_proto_id = conf->proto;
+		ip4->src_addr = rte_cpu_to_be_32(conf->src_ip4 + flow);
+		ip4->dst_addr = rte_cpu_to_be_32(conf->dst_ip4 + flow);
+		ip4->hdr_checksum = rte_ipv4_cksum(ip4);
+	}
+
+	tcp = l4;
+	udp = l4;
+	if (conf->proto == IPPROTO_TCP) {
+		tcp->src_port = rte_cpu_to_be_16(conf->src_port);
+		tcp->dst_port = rte_cpu_to_be_16(conf->dst_port);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+		tcp->rx_win = rte_cpu_to_be_16(UINT16_MAX);
+	} else {
+		udp->src_port = rte_cpu_to_be_16(conf->src_port);
+		udp->dst_port = rte_cpu_to_be_16(conf->dst_port);
+		udp->dgram_len = rte_cpu_to_be_16(l4_len);
+	}
+
+	cksum = conf->ipv6 ? rte_ipv6_udptcp_cksum(ip6, l4) :
+		rte_ipv4_udptcp_cksum(ip4, l4);
+	if (conf->proto == IPPROTO_TCP)
+		tcp->cksum = cksum;
+	else
+		udp->dgram_cksum = cksum;
+}
+
+/* precompute the packet ring of an Rx queue */
+static int
+null_gen_create(struct rte_eth_dev *dev, uint16_t queue_id,
+		struct rte_mempool *mb_pool)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	const struct null_gen_conf *conf = &internals->gen_conf;
+	char name[RTE_MEMZONE_NAMESIZE];
+	struct null_gen_pkt *pkt;
+	struct null_gen *gen;
+	uint64_t state, total_weight = 0, w;
+	uint32_t *flows = NULL;
+	double *cdf = NULL;
+	size_t size = 0;
+	unsigned int i, j;
+
+	/* the packets are taken in turn, each one has a 16-bit refcnt */
+	if (mb_pool->size / conf->ring_size >= UINT16_MAX) {
+		PMD_LOG(ERR, "Ring of %u packets too small for %u mbufs",
+			conf->ring_size, mb_pool->size);
+		return -EINVAL;
+	}
+
+	gen = rte_zmalloc_socket(NULL,
+			sizeof(*gen) + conf->ring_size * sizeof(gen->pkts[0]),
+			RTE_CACHE_LINE_SIZE, dev->data->numa_node);
+	flows = malloc(conf->ring_size * sizeof(*flows));
+	if (gen == NULL || flows == NULL)
+		goto error;
+	if (conf->zipf != 0 && conf->nb_flows > 1) {
+		cdf = null_gen_zipf_cdf(conf->nb_flows, conf->zipf);
+		if (cdf == NULL)
+			goto error;
+	}
+
+	for (j = 0; j < conf->nb_sizes; j++)
+		total_weight += conf->weights[j];
+
+	/* draw the size and the flow of each packet */
+	state = UINT64_C(0x9E3779B97F4A7C15) * (queue_id + 1);
+	for (i = 0; i < conf->ring_size; i++) {
+		w = null_gen_rand(&state) % total_weight;
+		for (j = 0; w >= conf->weights[j]; j++)
+			w -= conf->weights[j];
+		gen->pkts[i].len = conf->sizes[j];
+
+		if (cdf != NULL)
+			flows[i] = null_gen_zipf_flow(cdf, conf->nb_flows,
+					null_gen_rand_double(&state));
+		else
+			flows[i] = null_gen_rand(&state) % conf->nb_flows;
+
+		size += RTE_ALIGN_CEIL(gen->pkts[i].len, RTE_CACHE_LINE_SIZE);
+	}
+
+	/* contiguous in IOVA, the packets can be sent by a real device */
+	snprintf(name, sizeof(name), "null_gen_%u_%u_%u",
+		dev->data->port_id, queue_id,
+		rte_atomic_fetch_add_explicit(&null_gen_id, 1,
+			rte_memory_order_relaxed));
+	gen->mz = rte_memzone_reserve_aligned(name, size, dev->data->numa_node,
+			RTE_MEMZONE_IOVA_CONTIG, RTE_CACHE_LINE_SIZE);
+	if (gen->mz == NULL) {
+		PMD_LOG(ERR, "Couldn't reserve %zu bytes of packets: %s",
+			size, rte_strerror(rte_errno));
+		goto error;
+	}
+	memset(gen->mz->addr, 0, size);
+
+	size = 0;
+	for (i = 0; i < conf->ring_size; i++) {
+		pkt = &gen->pkts[i];
+		pkt->data = RTE_PTR_ADD(gen->mz->addr, size);
+		pkt->iova = gen->mz->iova + size;
+		null_gen_build(conf, &internals->eth_addr, flows[i],
+			pkt->data, pkt->len);
+		pkt->shinfo.free_cb = null_gen_free_cb;
+		rte_mbuf_ext_refcnt_set(&pkt->shinfo, 1);
+		size += RTE_ALIGN_CEIL(pkt->len, RTE_CACHE_LINE_SIZE);
+	}
+	gen->nb_pkts = conf->ring_size;
+	gen->packet_type = RTE_PTYPE_L2_ETHER |
+		(conf->ipv6 ? RTE_PTYPE_L3_IPV6 : RTE_PTYPE_L3_IPV4) |
+		(conf->proto == IPPROTO_TCP ? RTE_PTYPE_L4_TCP :
+			RTE_PTYPE_L4_UDP);
+
+	free(cdf);
+	free(flows);
+	internals->rx_null_queues[queue_id].gen = gen;
+
+	return 0;
+
+error:
+	free(cdf);
+	free(flows);
+	rte_free(gen);
+	return -ENOMEM;
+}
+
+static void
+null_gen_free(struct null_queue *nq)
+{
+	struct null_gen *gen = nq->gen;
+	unsigned int i;
+
+	if (gen == NULL)
+		return;
+	nq->gen = NULL;
+
+	for (i = 0; i < gen->nb_pkts; i++) {
+		if (rte_mbuf_ext_refcnt_read(&gen->pkts[i].shinfo) != 1) {
+			/* freeing would leave these mbufs pointing to nothing */
+			PMD_LOG(WARNING,
+				"mbufs are still attached, not freeing the packets");
+			return;
+		}
+	}
+	rte_memzone_free(gen->mz);
+	rte_free(gen);
+}
+
 static int
 eth_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
 		uint16_t nb_rx_desc __rte_unused,
@@ -257,6 +653,9 @@ eth_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
 	internals->rx_null_queues[rx_queue_id].internals = internals;
 	internals->rx_null_queues[rx_queue_id].dummy_packet = dummy_packet;
 
+	if (internals->gen)
+		return null_gen_create(dev, rx_queue_id, mb_pool);
+
 	return 0;
 }
 
@@ -293,6 +692,26 @@ eth_tx_queue_setup(struct rte_eth_dev *dev, uint16_t tx_queue_id,
 	return 0;
 }
 
+static const uint32_t *
+eth_dev_supported_ptypes_get(struct rte_eth_dev *dev, size_t *no_of_elements)
+{
+	static const uint32_t ptypes[] = {
+		RTE_PTYPE_L2_ETHER,
+		RTE_PTYPE_L3_IPV4,
+		RTE_PTYPE_L3_IPV6,
+		RTE_PTYPE_L4_TCP,
+		RTE_PTYPE_L4_UDP,
+	};
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	/* only the generated packets have a type */
+	if (!internals->gen)
+		return NULL;
+
+	*no_of_elements = RTE_DIM(ptypes);
+	return ptypes;
+}
+
 static int
 eth_mtu_set(struct rte_eth_dev *dev __rte_unused, uint16_t mtu __rte_unused)
 {
@@ -387,6 +806,7 @@ eth_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	rte_free(nq->dummy_packet);
+	null_gen_free(nq);
 }
 
 static void
@@ -521,6 +941,7 @@ static const struct eth_dev_ops ops = {
 	.tx_queue_setup = eth_tx_queue_setup,
 	.rx_queue_release = eth_rx_queue_release,
 	.tx_queue_release = eth_tx_queue_release,
+	.dev_supported_ptypes_get = eth_dev_supported_ptypes_get,
 	.mtu_set = eth_mtu_set,
 	.link_update = eth_link_update,
 	.mac_addr_set = eth_mac_address_set,
@@ -571,6 +992,8 @@ eth_dev_null_create(struct rte_vdev_device *dev, struct pmd_options *args)
 	internals->packet_size = args->packet_size;
 	internals->packet_copy = args->packet_copy;
 	internals->no_rx = args->no_rx;
+	internals->gen = args->gen;
+	internals->gen_conf = args->gen_conf;
 	internals->port_id = eth_dev->data->port_id;
 	rte_eth_random_addr(internals->eth_addr.addr_bytes);
 
@@ -597,6 +1020,9 @@ eth_dev_null_create(struct rte_vdev_device *dev, struct pmd_options *args)
 	} else if (internals->no_rx) {
 		eth_dev->rx_pkt_burst = eth_null_no_rx;
 		eth_dev->tx_pkt_burst = eth_null_tx;
+	} else if (internals->gen) {
+		eth_dev->rx_pkt_burst = eth_null_gen_rx;
+		eth_dev->tx_pkt_burst = eth_null_tx;
 	} else {
 		eth_dev->rx_pkt_burst = eth_null_rx;
 		eth_dev->tx_pkt_burst = eth_null_tx;
@@ -658,6 +1084,217 @@ get_packet_no_rx_arg(const char *key __rte_unused,
 	return 0;
 }
 
+static int
+get_gen_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	const char *a = value;
+	unsigned int gen;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	gen = (unsigned int)strtoul(a, NULL, 0);
+	if (gen != 0 && gen != 1)
+		return -1;
+
+	*(unsigned int *)extra_args = gen;
+	return 0;
+}
+
+static int
+get_gen_l3_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	struct null_gen_conf *conf = extra_args;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	if (strcmp(value, "ipv4") == 0)
+		conf->ipv6 = 0;
+	else if (strcmp(value, "ipv6") == 0)
+		conf->ipv6 = 1;
+	else
+		return -1;
+
+	return 0;
+}
+
+static int
+get_gen_l4_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	struct null_gen_conf *conf = extra_args;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	if (strcmp(value, "udp") == 0)
+		conf->proto = IPPROTO_UDP;
+	else if (strcmp(value, "tcp") == 0)
+		conf->proto = IPPROTO_TCP;
+	else
+		return -1;
+
+	return 0;
+}
+
+static int
+get_gen_mac_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	return rte_ether_unformat_addr(value, extra_args);
+}
+
+/* the address family follows gen_l3, which must be parsed before */
+static int
+get_gen_ip_arg(const char *key, const char *value, void *extra_args)
+{
+	struct null_gen_conf *conf = extra_args;
+	bool src = strcmp(key, ETH_NULL_GEN_SRC_IP_ARG) == 0;
+	rte_be32_t ip4;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	if (conf->ipv6) {
+		if (inet_pton(AF_INET6, value,
+				src ? &conf->src_ip6 : &conf->dst_ip6) != 1)
+			return -1;
+		return 0;
+	}
+
+	if (inet_pton(AF_INET, value, &ip4) != 1)
+		return -1;
+	if (src)
+		conf->src_ip4 = rte_be_to_cpu_32(ip4);
+	else
+		conf->dst_ip4 = rte_be_to_cpu_32(ip4);
+
+	return 0;
+}
+
+static int
+get_gen_port_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	unsigned long port;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	port = strtoul(value, &end, 0);
+	if (*value == '\0' || *end != '\0' || port > UINT16_MAX)
+		return -1;
+
+	*(uint16_t *)extra_args = port;
+	return 0;
+}
+
+/* list of lengths with their weights: <len>[:<weight>][/<len>[:<weight>]]... */
+static int
+get_gen_sizes_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	struct null_gen_conf *conf = extra_args;
+	unsigned long len, weight;
+	const char *a = value;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	/* simple IMIX */
+	if (strcmp(value, "imix") == 0)
+		a = "64:7/570:4/1518:1";
+
+	conf->nb_sizes = 0;
+	do {
+		if (conf->nb_sizes == NULL_GEN_MAX_SIZES)
+			return -1;
+
+		len = strtoul(a, &end, 0);
+		if (end == a || len > NULL_GEN_MAX_PKT_LEN)
+			return -1;
+		weight = 1;
+		if (*end == ':') {
+			a = end + 1;
+			weight = strtoul(a, &end, 0);
+			if (end == a || weight == 0 || weight > UINT16_MAX)
+				return -1;
+		}
+		if (*end != '\0' && *end != '/')
+			return -1;
+
+		conf->sizes[conf->nb_sizes] = len;
+		conf->weights[conf->nb_sizes] = weight;
+		conf->nb_sizes++;
+		a = end + 1;
+	} while (*end == '/');
+
+	return 0;
+}
+
+static int
+get_gen_flows_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	unsigned long flows;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	flows = strtoul(value, &end, 0);
+	if (*end != '\0' || flows == 0 || flows > NULL_GEN_MAX_FLOWS)
+		return -1;
+
+	*(unsigned int *)extra_args = flows;
+	return 0;
+}
+
+static int
+get_gen_zipf_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	double zipf;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	zipf = strtod(value, &end);
+	if (end == value || *end != '\0' || !isfinite(zipf) || zipf < 0)
+		return -1;
+
+	*(double *)extra_args = zipf;
+	return 0;
+}
+
+static int
+get_gen_ring_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	unsigned long ring_size;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	ring_size = strtoul(value, &end, 0);
+	if (*end != '\0' || ring_size < NULL_GEN_MIN_RING ||
+			ring_size > NULL_GEN_MAX_RING)
+		return -1;
+
+	*(unsigned int *)extra_args = ring_size;
+	return 0;
+}
+
 static int
 rte_pmd_null_probe(struct rte_vdev_device *dev)
 {
@@ -666,6 +1303,20 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 		.packet_copy = default_packet_copy,
 		.packet_size = default_packet_size,
 		.no_rx = default_no_rx,
+		.gen_conf = {
+			.proto = IPPROTO_UDP,
+			/* locally administered */
+			.dst_mac = {{ 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 }},
+			/* benchmarking ranges of RFC 2544 and RFC 5180 */
+			.src_ip4 = RTE_IPV4(198, 18, 0, 1),
+			.dst_ip4 = RTE_IPV4(198, 19, 0, 1),
+			.src_ip6 = RTE_IPV6(0x2001, 0x2, 0, 0, 0, 0, 0, 1),
+			.dst_ip6 = RTE_IPV6(0x2001, 0x2, 0, 1, 0, 0, 0, 1),
+			.src_port = 1024,
+			.dst_port = 1024,
+			.nb_flows = 1,
+			.ring_size = NULL_GEN_DEFAULT_RING,
+		},
 	};
 	struct rte_kvargs *kvlist = NULL;
 	struct rte_eth_dev *eth_dev;
@@ -695,6 +1346,9 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 		} else if (internals->no_rx) {
 			eth_dev->rx_pkt_burst = eth_null_no_rx;
 			eth_dev->tx_pkt_burst = eth_null_tx;
+		} else if (internals->gen) {
+			eth_dev->rx_pkt_burst = eth_null_gen_rx;
+			eth_dev->tx_pkt_burst = eth_null_tx;
 		} else {
 			eth_dev->rx_pkt_burst = eth_null_rx;
 			eth_dev->tx_pkt_burst = eth_null_tx;
@@ -734,6 +1388,93 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 				ETH_NULL_PACKET_NO_RX_ARG);
 			goto free_kvlist;
 		}
+
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_ARG,
+				&get_gen_arg, &args.gen);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_L3_ARG,
+				&get_gen_l3_arg, &args.gen_conf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_L4_ARG,
+				&get_gen_l4_arg, &args.gen_conf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_DST_MAC_ARG,
+				&get_gen_mac_arg, &args.gen_conf.dst_mac);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_SRC_IP_ARG,
+				&get_gen_ip_arg, &args.gen_conf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_DST_IP_ARG,
+				&get_gen_ip_arg, &args.gen_conf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_SRC_PORT_ARG,
+				&get_gen_port_arg, &args.gen_conf.src_port);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_DST_PORT_ARG,
+				&get_gen_port_arg, &args.gen_conf.dst_port);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_SIZES_ARG,
+				&get_gen_sizes_arg, &args.gen_conf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_FLOWS_ARG,
+				&get_gen_flows_arg, &args.gen_conf.nb_flows);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_ZIPF_ARG,
+				&get_gen_zipf_arg, &args.gen_conf.zipf);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_RING_ARG,
+				&get_gen_ring_arg, &args.gen_conf.ring_size);
+		if (ret < 0)
+			goto free_kvlist;
+
+		if (args.gen && (args.no_rx || args.packet_copy)) {
+			PMD_LOG(ERR,
+				"%s argument not supported with %s or %s",
+				ETH_NULL_GEN_ARG, ETH_NULL_PACKET_COPY_ARG,
+				ETH_NULL_PACKET_NO_RX_ARG);
+			ret = -EINVAL;
+			goto free_kvlist;
+		}
+	}
+
+	if (args.gen) {
+		struct null_gen_conf *conf = &args.gen_conf;
+		unsigned int i;
+
+		/* without a list, all packets have the size of the size argument */
+		if (conf->nb_sizes == 0) {
+			if (args.packet_size > NULL_GEN_MAX_PKT_LEN) {
+				PMD_LOG(ERR, "Packet size %u above %u",
+					args.packet_size, NULL_GEN_MAX_PKT_LEN);
+				ret = -EINVAL;
+				goto free_kvlist;
+			}
+			conf->sizes[0] = args.packet_size;
+			conf->weights[0] = 1;
+			conf->nb_sizes = 1;
+		}
+		for (i = 0; i < conf->nb_sizes; i++) {
+			if (conf->sizes[i] < null_gen_hdr_len(conf)) {
+				PMD_LOG(ERR, "Packet size %u below headers length %u",
+					conf->sizes[i], null_gen_hdr_len(conf));
+				ret = -EINVAL;
+				goto free_kvlist;
+			}
+		}
+		PMD_LOG(INFO, "Configure pmd_null: generating %u flows of %s/%s",
+			conf->nb_flows, conf->ipv6 ? "IPv6" : "IPv4",
+			conf->proto == IPPROTO_TCP ? "TCP" : "UDP");
 	}
 
 	PMD_LOG(INFO, "Configure pmd_null: packet size is %d, "
@@ -776,4 +1517,16 @@ RTE_PMD_REGISTER_ALIAS(net_null, eth_null);
 RTE_PMD_REGISTER_PARAM_STRING(net_null,
 	"size=<int> "
 	"copy=<int> "
-	ETH_NULL_PACKET_NO_RX_ARG "=0|1");
+	ETH_NULL_PACKET_NO_RX_ARG "=0|1 "
+	ETH_NULL_GEN_ARG "=0|1 "
+	ETH_NULL_GEN_L3_ARG "=ipv4|ipv6 "
+	ETH_NULL_GEN_L4_ARG "=udp|tcp "
+	ETH_NULL_GEN_DST_MAC_ARG "=<mac> "
+	ETH_NULL_GEN_SRC_IP_ARG "=<ip> "
+	ETH_NULL_GEN_DST_IP_ARG "=<ip> "
+	ETH_NULL_GEN_SRC_PORT_ARG "=<int> "
+	ETH_NULL_GEN_DST_PORT_ARG "=<int> "
+	ETH_NULL_GEN_SIZES_ARG "=<len>[:<weight>][/<len>[:<weight>]...]|imix "
+	ETH_NULL_GEN_FLOWS_ARG "=<int> "
+	ETH_NULL_GEN_ZIPF_ARG "=<float> "
+	ETH_NULL_GEN_RING_ARG "=<int>");
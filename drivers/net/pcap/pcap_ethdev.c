@@ -4,12 +4,23 @@
  * All rights reserved.
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <time.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <unistd.h>
+#endif
 
 #include <pcap.h>
 
+#include <rte_byteorder.h>
 #include <rte_cycles.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
 #include <ethdev_driver.h>
 #include <ethdev_vdev.h>
 #include <rte_kvargs.h>
@@ -34,6 +45,8 @@
 #define ETH_PCAP_IFACE_ARG    "iface"
 #define ETH_PCAP_PHY_MAC_ARG  "phy_mac"
 #define ETH_PCAP_INFINITE_RX_ARG  "infinite_rx"
+#define ETH_PCAP_REPLAY_ARG   "replay"
+#define ETH_PCAP_REPLAY_SPEED_ARG "replay_speed"
 
 #define ETH_PCAP_ARG_MAXLEN	64
 
@@ -55,6 +68,45 @@ struct queue_stat {
 	volatile unsigned long rx_nombuf;
 };
 
+enum pcap_replay_mode {
+	PCAP_REPLAY_NONE = 0,
+	PCAP_REPLAY_FAST, /* as fast as possible */
+	PCAP_REPLAY_TIMED, /* capture timing, scaled by replay_speed */
+};
+
+/* pcapng interfaces whose timestamp resolution is tracked */
+#define PCAP_REPLAY_MAX_IF 32
+/* default pcapng timestamp resolution: microseconds */
+#define PCAP_REPLAY_TSRESOL_US 6
+
+/* rx_pcap file mapped in memory for the replay mode */
+struct pcap_replay {
+	uint8_t *map;
+	size_t size;
+	size_t map_len; /* size rounded up to the page size */
+	bool extmem; /* map is registered as external memory */
+	bool iova_va; /* packet IOVA is their virtual address */
+	/* ports the map is DMA mapped for */
+	uint16_t nb_dma_ports;
+	uint16_t dma_ports[RTE_MAX_ETHPORTS];
+	size_t first; /* offset of the first record */
+	size_t pos; /* offset of the next record */
+	bool pcapng;
+	bool swap; /* records are not in host byte order */
+	bool nsec; /* pcap timestamps are in nanoseconds */
+	bool started; /* pacing time base is set */
+	uint32_t nb_if; /* interfaces of the current pcapng section */
+	uint8_t tsresol[PCAP_REPLAY_MAX_IF];
+	uint64_t last_ts; /* in ns, for pcapng simple packet blocks */
+	uint64_t loop_pkts; /* packets read since the last rewind */
+	/* pacing time base */
+	uint64_t first_ts;
+	uint64_t start_cycles;
+	double cycles_per_ns;
+	/* one reference for the queue, one for each mbuf attached to the map */
+	struct rte_mbuf_ext_shared_info shinfo;
+};
+
 struct queue_missed_stat {
 	/* last value retrieved from pcap */
 	unsigned int pcap;
@@ -75,6 +127,9 @@ struct pcap_rx_queue {
 
 	/* Contains pre-generated packets to be looped through */
 	struct rte_ring *pkts;
+	/* Mapped rx_pcap file in replay mode */
+	struct pcap_replay *replay;
+	unsigned int replay_loop;
 };
 
 struct pcap_tx_queue {
@@ -94,6 +149,8 @@ struct pmd_internals {
 	int single_iface;
 	int phy_mac;
 	unsigned int infinite_rx;
+	enum pcap_replay_mode replay;
+	double replay_speed;
 };
 
 struct pmd_process_private {
@@ -122,6 +179,8 @@ struct pmd_devargs_all {
 	unsigned int is_rx_pcap;
 	unsigned int is_rx_iface;
 	unsigned int infinite_rx;
+	enum pcap_replay_mode replay;
+	double replay_speed;
 };
 
 static const char *valid_arguments[] = {
@@ -133,6 +192,8 @@ static const char *valid_arguments[] = {
 	ETH_PCAP_IFACE_ARG,
 	ETH_PCAP_PHY_MAC_ARG,
 	ETH_PCAP_INFINITE_RX_ARG,
+	ETH_PCAP_REPLAY_ARG,
+	ETH_PCAP_REPLAY_SPEED_ARG,
 	NULL
 };
 
@@ -339,6 +400,455 @@ eth_pcap_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
+/* pcap and pcapng file formats */
+#define PCAP_MAGIC_US 0xa1b2c3d4
+#define PCAP_MAGIC_NS 0xa1b23c4d
+#define PCAP_FILE_HDR_LEN 24
+#define PCAP_REC_HDR_LEN 16
+#define PCAPNG_BLOCK_SHB 0x0a0d0d0a
+#define PCAPNG_BLOCK_IDB 0x00000001
+#define PCAPNG_BLOCK_SPB 0x00000003
+#define PCAPNG_BLOCK_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1a2b3c4d
+#define PCAPNG_OPT_END 0
+#define PCAPNG_OPT_TSRESOL 9
+
+/* max packets parsed by a replay burst */
+#define PCAP_REPLAY_BURST 64
+
+static inline uint16_t
+replay_read16(const struct pcap_replay *r, const uint8_t *p)
+{
+	uint16_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return r->swap ? rte_bswap16(v) : v;
+}
+
+static inline uint32_t
+replay_read32(const struct pcap_replay *r, const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return r->swap ? rte_bswap32(v) : v;
+}
+
+/* convert a pcapng timestamp to nanoseconds */
+static uint64_t
+replay_ts_ns(uint64_t ts, uint8_t tsresol)
+{
+	static const uint64_t pow10[] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+		100000000, 1000000000, 10000000000, 100000000000,
+		1000000000000, 10000000000000, 100000000000000,
+		1000000000000000, 10000000000000000, 100000000000000000,
+		1000000000000000000, 10000000000000000000u,
+	};
+	unsigned int exp = tsresol & 0x7f;
+
+	if (tsresol & 0x80) {
+		/* negative power of 2, keep the product of the fraction in 64 bits */
+		if (exp > 32) {
+			if (exp - 32 >= 64)
+				return 0;
+			ts >>= exp - 32;
+			exp = 32;
+		}
+		return (ts >> exp) * NS_PER_S +
+			(((ts & ((UINT64_C(1) << exp) - 1)) * NS_PER_S) >> exp);
+	}
+	/* negative power of 10 */
+	if (exp <= 9)
+		return ts * pow10[9 - exp];
+	if (exp - 9 < RTE_DIM(pow10))
+		return ts / pow10[exp - 9];
+	return 0;
+}
+
+/* find the if_tsresol option of a pcapng interface description block */
+static uint8_t
+replay_idb_tsresol(const struct pcap_replay *r, const uint8_t *opt,
+		uint32_t len)
+{
+	uint32_t code, opt_len;
+
+	while (len >= 4) {
+		code = replay_read16(r, opt);
+		opt_len = RTE_ALIGN_CEIL(replay_read16(r, opt + 2), 4u);
+		if (code == PCAPNG_OPT_END || opt_len > len - 4)
+			break;
+		if (code == PCAPNG_OPT_TSRESOL && replay_read16(r, opt + 2) == 1)
+			return opt[4];
+		opt += 4 + opt_len;
+		len -= 4 + opt_len;
+	}
+	return PCAP_REPLAY_TSRESOL_US;
+}
+
+/*
+ * Get the next packet of the mapped file, pointing into the map,
+ * and the offset of its record.
+ * Return 1 on success, 0 at end of file, -1 if the file is malformed.
+ */
+static int
+pcap_replay_next(struct pcap_replay *r, uint8_t **data, uint32_t *caplen,
+		uint64_t *ts, size_t *rec)
+{
+	uint32_t type, len, ifid, bom;
+	uint8_t tsresol;
+	uint8_t *p;
+	size_t left;
+
+	if (!r->pcapng) {
+		left = r->size - r->pos;
+		if (left == 0)
+			return 0;
+		if (left < PCAP_REC_HDR_LEN)
+			return -1;
+		p = r->map + r->pos;
+		*rec = r->pos;
+		*caplen = replay_read32(r, p + 8);
+		if (*caplen > left - PCAP_REC_HDR_LEN)
+			return -1;
+		*ts = (uint64_t)replay_read32(r, p) * NS_PER_S +
+			(uint64_t)replay_read32(r, p + 4) * (r->nsec ? 1 : 1000);
+		*data = p + PCAP_REC_HDR_LEN;
+		r->pos += PCAP_REC_HDR_LEN + *caplen;
+		return 1;
+	}
+
+	for (;;) {
+		left = r->size - r->pos;
+		if (left == 0)
+			return 0;
+		if (left < 12)
+			return -1;
+		p = r->map + r->pos;
+		type = replay_read32(r, p);
+		if (type == PCAPNG_BLOCK_SHB) {
+			/* new section, possibly in another byte order */
+			memcpy(&bom, p + 8, sizeof(bom));
+			if (bom == PCAPNG_BYTE_ORDER_MAGIC)
+				r->swap = false;
+			else if (bom == RTE_STATIC_BSWAP32(PCAPNG_BYTE_ORDER_MAGIC))
+				r->swap = true;
+			else
+				return -1;
+			r->nb_if = 0;
+		}
+		len = replay_read32(r, p + 4);
+		if (len < 12 || len % 4 != 0 || len > left)
+			return -1;
+		*rec = r->pos;
+		r->pos += len;
+
+		switch (type) {
+		case PCAPNG_BLOCK_IDB:
+			if (len < 20)
+				return -1;
+			if (r->nb_if < PCAP_REPLAY_MAX_IF)
+				r->tsresol[r->nb_if] =
+					replay_idb_tsresol(r, p + 16, len - 20);
+			r->nb_if++;
+			break;
+		case PCAPNG_BLOCK_EPB:
+			if (len < 32)
+				return -1;
+			*caplen = replay_read32(r, p + 20);
+			if (*caplen > len - 32)
+				return -1;
+			ifid = replay_read32(r, p + 8);
+			tsresol = ifid < RTE_MIN(r->nb_if, PCAP_REPLAY_MAX_IF) ?
+				r->tsresol[ifid] : PCAP_REPLAY_TSRESOL_US;
+			*ts = replay_ts_ns((uint64_t)replay_read32(r, p + 12) << 32 |
+				replay_read32(r, p + 16), tsresol);
+			r->last_ts = *ts;
+			*data = p + 28;
+			return 1;
+		case PCAPNG_BLOCK_SPB:
+			if (len < 16)
+				return -1;
+			/* no timestamp, sent along with the previous packet */
+			*caplen = RTE_MIN(replay_read32(r, p + 8), len - 16);
+			*ts = r->last_ts;
+			*data = p + 12;
+			return 1;
+		default:
+			/* statistics, name resolution, custom blocks... */
+			break;
+		}
+	}
+}
+
+static void
+pcap_replay_rewind(struct pcap_replay *r)
+{
+	r->pos = r->first;
+	r->started = false;
+	r->loop_pkts = 0;
+	r->last_ts = 0;
+}
+
+static void
+pcap_replay_free_cb(void *addr __rte_unused, void *opaque __rte_unused)
+{
+	/* the queue keeps a reference, the map is released with the queue */
+}
+
+/*
+ * In IOVA as VA mode, register the map as external memory and DMA map it
+ * for the other ports, so that the replayed mbufs can be transmitted
+ * by devices without copy. Otherwise they get no IOVA.
+ */
+static void
+pcap_replay_dma_map(struct pcap_rx_queue *pcap_q, struct pcap_replay *r)
+{
+	uint16_t port_id;
+	int ret;
+
+	if (rte_eal_iova_mode() != RTE_IOVA_VA)
+		return;
+	if (rte_extmem_register(r->map, r->map_len, NULL, 0,
+			rte_mem_page_size()) != 0) {
+		PMD_LOG(NOTICE, "%s: cannot register the map: %s, no IOVA",
+			pcap_q->name, rte_strerror(rte_errno));
+		return;
+	}
+	r->extmem = true;
+	r->iova_va = true;
+
+	RTE_ETH_FOREACH_DEV(port_id) {
+		if (port_id == pcap_q->port_id)
+			continue;
+		ret = rte_dev_dma_map(rte_eth_devices[port_id].device, r->map,
+			(uintptr_t)r->map, r->map_len);
+		if (ret == 0)
+			r->dma_ports[r->nb_dma_ports++] = port_id;
+		else if (rte_errno != ENOTSUP)
+			PMD_LOG(NOTICE, "%s: cannot DMA map for port %u: %s",
+				pcap_q->name, port_id, rte_strerror(rte_errno));
+	}
+}
+
+static void
+pcap_replay_dma_unmap(struct pcap_replay *r)
+{
+	uint16_t i, port_id;
+
+	for (i = 0; i < r->nb_dma_ports; i++) {
+		port_id = r->dma_ports[i];
+		if (rte_eth_dev_is_valid_port(port_id))
+			rte_dev_dma_unmap(rte_eth_devices[port_id].device,
+				r->map, (uintptr_t)r->map, r->map_len);
+	}
+	r->nb_dma_ports = 0;
+	if (r->extmem)
+		rte_extmem_unregister(r->map, r->map_len);
+	r->extmem = false;
+}
+
+static int
+pcap_replay_open(struct pcap_rx_queue *pcap_q, enum pcap_replay_mode mode,
+		double speed)
+{
+	struct pcap_replay *r;
+	struct stat st;
+	uint32_t magic;
+	int fd;
+
+	r = rte_zmalloc_socket(NULL, sizeof(*r), RTE_CACHE_LINE_SIZE,
+			pcap_q->mb_pool->socket_id);
+	if (r == NULL)
+		return -ENOMEM;
+
+	fd = open(pcap_q->name, O_RDONLY);
+	if (fd < 0) {
+		PMD_LOG(ERR, "Couldn't open %s: %s", pcap_q->name,
+			strerror(errno));
+		goto error;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < PCAP_FILE_HDR_LEN) {
+		PMD_LOG(ERR, "%s is not a pcap or pcapng file", pcap_q->name);
+		close(fd);
+		goto error;
+	}
+	/*
+	 * Read-only mapping: with infinite_rx, the same packet data is
+	 * received again while the mbufs of the previous loop may still be
+	 * in use, so it must not be modified.
+	 */
+	r->size = st.st_size;
+	r->map_len = RTE_ALIGN_CEIL(r->size, rte_mem_page_size());
+	r->map = rte_mem_map(NULL, r->size, RTE_PROT_READ,
+			RTE_MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (r->map == NULL) {
+		PMD_LOG(ERR, "Couldn't map %s: %s", pcap_q->name,
+			rte_strerror(rte_errno));
+		goto error;
+	}
+
+	memcpy(&magic, r->map, sizeof(magic));
+	switch (magic) {
+	case PCAP_MAGIC_US:
+		break;
+	case PCAP_MAGIC_NS:
+		r->nsec = true;
+		break;
+	case RTE_STATIC_BSWAP32(PCAP_MAGIC_US):
+		r->swap = true;
+		break;
+	case RTE_STATIC_BSWAP32(PCAP_MAGIC_NS):
+		r->swap = true;
+		r->nsec = true;
+		break;
+	case PCAPNG_BLOCK_SHB:
+		r->pcapng = true;
+		break;
+	default:
+		PMD_LOG(ERR, "%s is not a pcap or pcapng file", pcap_q->name);
+		rte_mem_unmap(r->map, r->size);
+		goto error;
+	}
+
+	r->first = r->pcapng ? 0 : PCAP_FILE_HDR_LEN;
+	pcap_replay_rewind(r);
+	if (mode == PCAP_REPLAY_TIMED)
+		r->cycles_per_ns = (double)hz / NS_PER_S / speed;
+	r->shinfo.free_cb = pcap_replay_free_cb;
+	rte_mbuf_ext_refcnt_set(&r->shinfo, 1);
+	pcap_replay_dma_map(pcap_q, r);
+
+	pcap_q->replay = r;
+	return 0;
+
+error:
+	rte_free(r);
+	return -EINVAL;
+}
+
+static void
+pcap_replay_close(struct pcap_rx_queue *pcap_q)
+{
+	struct pcap_replay *r = pcap_q->replay;
+
+	if (r == NULL)
+		return;
+	pcap_q->replay = NULL;
+
+	if (rte_mbuf_ext_refcnt_read(&r->shinfo) != 1) {
+		/* unmapping would leave these mbufs pointing to nothing */
+		PMD_LOG(WARNING, "%s: mbufs are still attached, not unmapping",
+			pcap_q->name);
+		return;
+	}
+	pcap_replay_dma_unmap(r);
+	rte_mem_unmap(r->map, r->size);
+	rte_free(r);
+}
+
+static uint16_t
+eth_pcap_rx_replay(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pcap_rx_queue *pcap_q = queue;
+	struct pcap_replay *r = pcap_q->replay;
+	uint8_t *data[PCAP_REPLAY_BURST];
+	uint32_t caplen[PCAP_REPLAY_BURST];
+	uint64_t us[PCAP_REPLAY_BURST];
+	uint64_t ts, due, now = 0;
+	unsigned int i, n = 0;
+	uint32_t rx_bytes = 0;
+	size_t rec;
+	int ret;
+
+	if (unlikely(r == NULL || nb_pkts == 0))
+		return 0;
+
+	/* each attached mbuf holds a reference of the 16-bit refcnt */
+	nb_pkts = RTE_MIN(nb_pkts, PCAP_REPLAY_BURST);
+	nb_pkts = RTE_MIN(nb_pkts,
+		UINT16_MAX - rte_mbuf_ext_refcnt_read(&r->shinfo));
+	if (unlikely(nb_pkts == 0)) {
+		pcap_q->rx_stat.rx_nombuf++;
+		return 0;
+	}
+
+	if (r->cycles_per_ns != 0)
+		now = rte_get_timer_cycles();
+
+	while (n < nb_pkts) {
+		ret = pcap_replay_next(r, &data[n], &caplen[n], &ts, &rec);
+		if (unlikely(ret < 0)) {
+			/* ignore the truncated or malformed end of the file */
+			pcap_q->rx_stat.err_pkts++;
+			r->pos = r->size;
+			ret = 0;
+		}
+		if (ret == 0) {
+			if (!pcap_q->replay_loop || r->loop_pkts == 0)
+				break;
+			pcap_replay_rewind(r);
+			continue;
+		}
+		if (unlikely(caplen[n] > UINT16_MAX)) {
+			/* does not fit in the 16-bit mbuf buffer length */
+			pcap_q->rx_stat.err_pkts++;
+			continue;
+		}
+
+		if (r->cycles_per_ns != 0) {
+			if (!r->started) {
+				r->first_ts = ts;
+				r->start_cycles = now;
+				r->started = true;
+			}
+			due = r->start_cycles;
+			if (ts > r->first_ts)
+				due += (uint64_t)((double)(ts - r->first_ts) *
+					r->cycles_per_ns);
+			if ((int64_t)(now - due) < 0) {
+				/* not yet, read it again in the next burst */
+				r->pos = rec;
+				break;
+			}
+		}
+
+		us[n] = ts / 1000;
+		r->loop_pkts++;
+		n++;
+	}
+	if (n == 0)
+		return 0;
+
+	if (unlikely(rte_pktmbuf_alloc_bulk(pcap_q->mb_pool, bufs, n) != 0)) {
+		/* dropped, as a NIC running out of mbufs would do */
+		pcap_q->rx_stat.rx_nombuf++;
+		return 0;
+	}
+
+	for (i = 0; i < n; i++) {
+		struct rte_mbuf *mbuf = bufs[i];
+
+		rte_pktmbuf_attach_extbuf(mbuf, data[i], r->iova_va ?
+				(rte_iova_t)(uintptr_t)data[i] : RTE_BAD_IOVA,
+				caplen[i], &r->shinfo);
+		mbuf->data_len = caplen[i];
+		mbuf->pkt_len = caplen[i];
+		*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
+				rte_mbuf_timestamp_t *) = us[i];
+		mbuf->ol_flags |= timestamp_rx_dynflag;
+		mbuf->port = pcap_q->port_id;
+		rx_bytes += caplen[i];
+	}
+	rte_mbuf_ext_refcnt_update(&r->shinfo, n);
+
+	pcap_q->rx_stat.pkts += n;
+	pcap_q->rx_stat.bytes += rx_bytes;
+
+	return n;
+}
+
 static uint16_t
 eth_null_rx(void *queue __rte_unused,
 		struct rte_mbuf **bufs __rte_unused,
@@ -648,6 +1158,10 @@ eth_dev_start(struct rte_eth_dev *dev)
 	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		rx = &internals->rx_queue[i];
 
+		/* Replay restarts from the beginning of the file */
+		if (rx->replay != NULL)
+			pcap_replay_rewind(rx->replay);
+
 		if (pp->rx_pcap[i] != NULL)
 			continue;
 
@@ -842,6 +1356,9 @@ eth_dev_close(struct rte_eth_dev *dev)
 	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
 		return 0;
 
+	for (i = 0; i < dev->data->nb_rx_queues; i++)
+		pcap_replay_close(&internals->rx_queue[i]);
+
 	/* Device wide flag, but cleanup must be performed per queue. */
 	if (internals->infinite_rx) {
 		for (i = 0; i < dev->data->nb_rx_queues; i++) {
@@ -888,6 +1405,14 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pcap_q->queue_id = rx_queue_id;
 	dev->data->rx_queues[rx_queue_id] = pcap_q;
 
+	if (internals->replay != PCAP_REPLAY_NONE) {
+		pcap_replay_close(pcap_q);
+		/* infinite_rx loops over the mapped file */
+		pcap_q->replay_loop = internals->infinite_rx;
+		return pcap_replay_open(pcap_q, internals->replay,
+				internals->replay_speed);
+	}
+
 	if (internals->infinite_rx) {
 		struct pmd_process_private *pp;
 		char ring_name[RTE_RING_NAMESIZE];
@@ -1194,6 +1719,35 @@ get_infinite_rx_arg(const char *key __rte_unused,
 	return 0;
 }
 
+static int
+get_replay_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	enum pcap_replay_mode *replay = extra_args;
+
+	if (strcmp(value, "fast") == 0)
+		*replay = PCAP_REPLAY_FAST;
+	else if (strcmp(value, "timed") == 0)
+		*replay = PCAP_REPLAY_TIMED;
+	else
+		return -1;
+	return 0;
+}
+
+static int
+get_replay_speed_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	double *speed = extra_args;
+	char *end;
+
+	errno = 0;
+	*speed = strtod(value, &end);
+	if (errno != 0 || *end != '\0' || !(*speed > 0))
+		return -1;
+	return 0;
+}
+
 static int
 pmd_init_internals(struct rte_vdev_device *vdev,
 		const unsigned int nb_rx_queues,
@@ -1353,8 +1907,12 @@ eth_from_pcaps(struct rte_vdev_device *vdev,
 	}
 
 	internals->infinite_rx = infinite_rx;
+	internals->replay = devargs_all->replay;
+	internals->replay_speed = devargs_all->replay_speed;
 	/* Assign rx ops. */
-	if (infinite_rx)
+	if (internals->replay != PCAP_REPLAY_NONE)
+		eth_dev->rx_pkt_burst = eth_pcap_rx_replay;
+	else if (infinite_rx)
 		eth_dev->rx_pkt_burst = eth_pcap_rx_infinite;
 	else if (devargs_all->is_rx_pcap || devargs_all->is_rx_iface ||
 			single_iface)
@@ -1417,6 +1975,8 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 		.is_tx_pcap = 0,
 		.is_tx_iface = 0,
 		.infinite_rx = 0,
+		.replay = PCAP_REPLAY_NONE,
+		.replay_speed = 1.0,
 	};
 
 	name = rte_vdev_device_name(dev);
@@ -1520,6 +2080,28 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 					"for %s", name);
 		}
 
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_ARG,
+				&get_replay_arg, &devargs_all.replay);
+		if (ret < 0) {
+			PMD_LOG(ERR, "Invalid %s value for %s, expected fast or timed",
+				ETH_PCAP_REPLAY_ARG, name);
+			goto free_kvlist;
+		}
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_SPEED_ARG,
+				&get_replay_speed_arg, &devargs_all.replay_speed);
+		if (ret < 0) {
+			PMD_LOG(ERR, "Invalid %s value for %s, expected a positive number",
+				ETH_PCAP_REPLAY_SPEED_ARG, name);
+			goto free_kvlist;
+		}
+		if (devargs_all.replay != PCAP_REPLAY_NONE &&
+				rte_eal_process_type() == RTE_PROC_SECONDARY) {
+			PMD_LOG(ERR, "%s is not supported in secondary process",
+				ETH_PCAP_REPLAY_ARG);
+			ret = -ENOTSUP;
+			goto free_kvlist;
+		}
+
 		ret = rte_kvargs_process(kvlist, ETH_PCAP_RX_PCAP_ARG,
 				&open_rx_pcap, &pcaps);
 	} else if (devargs_all.is_rx_iface) {
@@ -1660,4 +2242,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_pcap,
 	ETH_PCAP_TX_IFACE_ARG "=<ifc> "
 	ETH_PCAP_IFACE_ARG "=<ifc> "
 	ETH_PCAP_PHY_MAC_ARG "=<int>"
-	ETH_PCAP_INFINITE_RX_ARG "=<0|1>");
+	ETH_PCAP_INFINITE_RX_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_ARG "=<fast|timed> "
+	ETH_PCAP_REPLAY_SPEED_ARG "=<float>");
@@ -0,0 +1,1185 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <bus_vdev_driver.h>
+#include <ethdev_driver.h>
+#include <ethdev_vdev.h>
+#include <rte_alarm.h>
+#include <rte_bitops.h>
+#include <rte_eal_paging.h>
+#include <rte_kvargs.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_memory.h>
+#include <rte_ring_elem.h>
+#include <rte_ring_peek.h>
+#include <rte_string_fns.h>
+
+#define ETH_SHMRING_SOCKET_ARG	"socket"
+#define ETH_SHMRING_ROLE_ARG	"role"
+#define ETH_SHMRING_SLOTS_ARG	"slots"
+#define ETH_SHMRING_BUFSIZE_ARG	"bufsize"
+
+static const char *valid_arguments[] = {
+	ETH_SHMRING_SOCKET_ARG,
+	ETH_SHMRING_ROLE_ARG,
+	ETH_SHMRING_SLOTS_ARG,
+	ETH_SHMRING_BUFSIZE_ARG,
+	NULL
+};
+
+#define SHMRING_MAGIC		0x53484d52 /* "SHMR" */
+#define SHMRING_VERSION		1
+#define SHMRING_SLOTS_DEF	4096
+#define SHMRING_SLOTS_MAX	(1 << 20)
+#define SHMRING_BUFSIZE_DEF	RTE_MBUF_DEFAULT_DATAROOM
+#define SHMRING_SLOT_MAX	(UINT16_MAX + 1)
+#define SHMRING_POLL_US		(100 * 1000)
+#define SHMRING_BURST_MAX	64
+
+/* a packet descriptor holds the slot index, data offset and length */
+#define SHMRING_DESC(slot, off, len) \
+	((uint64_t)(slot) << 32 | (uint64_t)(off) << 16 | (len))
+#define SHMRING_DESC_SLOT(d)	((uint32_t)((d) >> 32))
+#define SHMRING_DESC_OFF(d)	((uint16_t)((d) >> 16))
+#define SHMRING_DESC_LEN(d)	((uint16_t)(d))
+
+enum shmring_ring_id {
+	SHMRING_S2C,	/* packets from server to client */
+	SHMRING_C2S,	/* packets from client to server */
+	SHMRING_FREE,	/* free slots */
+	SHMRING_NB_RINGS
+};
+
+/* header of the region shared by the two processes */
+struct shmring_hdr {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint32_t nb_slots;
+	uint32_t slot_size;
+	uint64_t ring_off[SHMRING_NB_RINGS];
+	uint64_t slots_off;
+};
+
+/* message sent by the server with the region file descriptor */
+struct shmring_msg {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+};
+
+/*
+ * Mapping of the shared region in this process.
+ * It is referenced by the port while connected and by each mbuf attached
+ * to a slot, and unmapped with its last reference.
+ */
+struct shmring_region {
+	RTE_ATOMIC(uint32_t) refcnt;
+	struct shmring_hdr *hdr; /* NULL if not mapped */
+	size_t size;
+	int fd;
+	struct rte_ring *tx_ring;
+	struct rte_ring *rx_ring;
+	struct rte_ring *free_ring;
+	char *slots;
+	uint32_t nb_slots;
+	uint32_t slot_size;
+	uint16_t buf_len;
+	rte_iova_t *iova; /* IOVA of each slot in PA mode, NULL in VA mode */
+	/*
+	 * Shared info of the slots attached to mbufs, in process memory:
+	 * the peer must not be able to change the free callback.
+	 * The refcnt of a slot is 0 while the slot is not owned by an mbuf.
+	 */
+	struct rte_mbuf_ext_shared_info *shinfo;
+};
+
+struct pmd_internals;
+
+struct shmring_queue {
+	struct pmd_internals *internals;
+	struct rte_mempool *mb_pool;
+
+	uint64_t pkts;
+	uint64_t bytes;
+	uint64_t errs;
+	uint64_t nombuf;
+	uint64_t bad_slots; /* invalid free slots from the peer on Tx */
+};
+
+struct pmd_internals {
+	char socket_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+	bool server;
+	uint32_t nb_slots;
+	uint32_t bufsize;
+	uint16_t port_id;
+
+	int listen_fd;
+	int conn_fd;
+	RTE_ATOMIC(bool) connected;
+	/* valid while connected, kept for a poll period after a disconnection */
+	struct shmring_region *region;
+
+	struct shmring_queue rxq;
+	struct shmring_queue txq;
+
+	struct rte_ether_addr eth_addr;
+};
+
+static struct rte_eth_link pmd_link = {
+	.link_speed = RTE_ETH_SPEED_NUM_10G,
+	.link_duplex = RTE_ETH_LINK_FULL_DUPLEX,
+	.link_status = RTE_ETH_LINK_DOWN,
+	.link_autoneg = RTE_ETH_LINK_FIXED,
+};
+
+RTE_LOG_REGISTER_DEFAULT(eth_shmring_logtype, NOTICE);
+#define RTE_LOGTYPE_ETH_SHMRING eth_shmring_logtype
+
+#define PMD_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, ETH_SHMRING, "%s(): ", __func__, __VA_ARGS__)
+
+static void
+shmring_region_put(struct shmring_region *region, uint32_t n)
+{
+	if (rte_atomic_fetch_sub_explicit(&region->refcnt, n,
+			rte_memory_order_acq_rel) != n)
+		return;
+
+	/* last reference, no mbuf points to the region anymore */
+	if (region->hdr != NULL)
+		munmap(region->hdr, region->size);
+	if (region->fd >= 0)
+		close(region->fd);
+	rte_free(region->iova);
+	rte_free(region->shinfo);
+	rte_free(region);
+}
+
+static void
+shmring_slot_free(void *addr, void *opaque)
+{
+	struct shmring_region *region = opaque;
+	uint32_t slot;
+
+	/* the address was set by this process, it is a valid slot */
+	slot = RTE_PTR_DIFF(addr, region->slots) / region->slot_size;
+	rte_ring_enqueue_elem(region->free_ring, &slot, sizeof(slot));
+	shmring_region_put(region, 1);
+}
+
+static inline void *
+shmring_slot_buf(const struct shmring_region *region, uint32_t slot)
+{
+	return region->slots + (size_t)slot * region->slot_size;
+}
+
+static inline rte_iova_t
+shmring_slot_iova(const struct shmring_region *region, uint32_t slot,
+		void *buf)
+{
+	if (region->iova == NULL)
+		return (uintptr_t)buf;
+	return region->iova[slot];
+}
+
+/* the slot indexes come from the peer, they are checked before use */
+static inline bool
+shmring_slot_valid(const struct shmring_region *region, uint32_t slot)
+{
+	return slot < region->nb_slots &&
+		rte_mbuf_ext_refcnt_read(&region->shinfo[slot]) == 0;
+}
+
+/* true if the only reference to the mbuf data is a slot of the region */
+static inline bool
+shmring_mbuf_is_slot(const struct shmring_region *region,
+		const struct rte_mbuf *m)
+{
+	return RTE_MBUF_HAS_EXTBUF(m) && m->nb_segs == 1 &&
+		m->shinfo->free_cb == shmring_slot_free &&
+		m->shinfo->fcb_opaque == region &&
+		rte_mbuf_refcnt_read(m) == 1 &&
+		rte_mbuf_ext_refcnt_read(m->shinfo) == 1;
+}
+
+/*
+ * Give back an mbuf whose slot was passed to the peer,
+ * without giving the slot back to the free ring.
+ * The refcnt of the slot was reset when passing it.
+ */
+static inline void
+shmring_mbuf_release(struct shmring_region *region, struct rte_mbuf *m)
+{
+	struct rte_mempool *mp = m->pool;
+	uint32_t mbuf_size;
+
+	mbuf_size = sizeof(struct rte_mbuf) + rte_pktmbuf_priv_size(mp);
+	m->buf_addr = (char *)m + mbuf_size;
+	rte_mbuf_iova_set(m, rte_mempool_virt2iova(m) + mbuf_size);
+	m->buf_len = (uint16_t)rte_pktmbuf_data_room_size(mp);
+	m->ol_flags = 0;
+	rte_pktmbuf_free(m);
+	shmring_region_put(region, 1);
+}
+
+static uint16_t
+eth_shmring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct shmring_queue *rxq = q;
+	struct pmd_internals *internals = rxq->internals;
+	struct shmring_region *region;
+	struct rte_mbuf_ext_shared_info *shinfo;
+	uint64_t descs[SHMRING_BURST_MAX];
+	uint64_t bytes = 0;
+	struct rte_mbuf *m;
+	uint32_t slot, off, len;
+	unsigned int i, n, nb_rx;
+	void *buf;
+
+	if (unlikely(!rte_atomic_load_explicit(&internals->connected,
+			rte_memory_order_acquire)))
+		return 0;
+	region = internals->region;
+
+	n = rte_ring_dequeue_burst_elem_start(region->rx_ring, descs,
+			sizeof(descs[0]), RTE_MIN(nb_bufs, SHMRING_BURST_MAX),
+			NULL);
+	if (n == 0)
+		return 0;
+	if (rte_pktmbuf_alloc_bulk(rxq->mb_pool, bufs, n) != 0) {
+		rte_ring_dequeue_finish(region->rx_ring, 0);
+		rxq->nombuf++;
+		return 0;
+	}
+	rte_ring_dequeue_finish(region->rx_ring, n);
+
+	/* attach the slots to the mbufs, without copy */
+	nb_rx = 0;
+	for (i = 0; i < n; i++) {
+		slot = SHMRING_DESC_SLOT(descs[i]);
+		off = SHMRING_DESC_OFF(descs[i]);
+		len = SHMRING_DESC_LEN(descs[i]);
+		/* a descriptor out of the region or on a slot in use is dropped */
+		if (unlikely(!shmring_slot_valid(region, slot) ||
+				off + len > region->buf_len)) {
+			rxq->errs++;
+			continue;
+		}
+
+		m = bufs[nb_rx++];
+		shinfo = &region->shinfo[slot];
+		rte_mbuf_ext_refcnt_set(shinfo, 1);
+		buf = shmring_slot_buf(region, slot);
+		rte_pktmbuf_attach_extbuf(m, buf,
+			shmring_slot_iova(region, slot, buf),
+			region->buf_len, shinfo);
+		m->data_off = off;
+		m->data_len = len;
+		m->pkt_len = len;
+		m->port = internals->port_id;
+		bytes += len;
+	}
+	if (unlikely(nb_rx != n))
+		rte_pktmbuf_free_bulk(&bufs[nb_rx], n - nb_rx);
+	rte_atomic_fetch_add_explicit(&region->refcnt, nb_rx,
+		rte_memory_order_relaxed);
+
+	rxq->pkts += nb_rx;
+	rxq->bytes += bytes;
+	return nb_rx;
+}
+
+static uint16_t
+eth_shmring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct shmring_queue *txq = q;
+	struct pmd_internals *internals = txq->internals;
+	struct shmring_region *region;
+	uint64_t descs[SHMRING_BURST_MAX];
+	uint32_t slots[SHMRING_BURST_MAX];
+	unsigned int i, n, nb_copy, nb_slots, c;
+	uint64_t in_slot = 0, bytes = 0;
+	const struct rte_mbuf *seg;
+	struct rte_mbuf *m;
+	uint32_t off;
+	char *buf;
+
+	if (unlikely(!rte_atomic_load_explicit(&internals->connected,
+			rte_memory_order_acquire)))
+		return 0;
+	region = internals->region;
+
+	/* single producer, the free space can only grow */
+	nb_bufs = RTE_MIN(nb_bufs, SHMRING_BURST_MAX);
+	nb_bufs = RTE_MIN(nb_bufs, rte_ring_free_count(region->tx_ring));
+
+	nb_copy = 0;
+	for (i = 0; i < nb_bufs; i++) {
+		if (shmring_mbuf_is_slot(region, bufs[i]))
+			in_slot |= RTE_BIT64(i);
+		else
+			nb_copy++;
+	}
+	nb_slots = 0;
+	if (nb_copy != 0)
+		nb_slots = rte_ring_dequeue_burst_elem(region->free_ring,
+				slots, sizeof(slots[0]), nb_copy, NULL);
+
+	n = 0;
+	c = 0;
+	for (i = 0; i < nb_bufs; i++) {
+		m = bufs[i];
+		if (in_slot & RTE_BIT64(i)) {
+			/*
+			 * Pass the slot of a received packet to the peer,
+			 * which may give it back as soon as it is enqueued.
+			 */
+			rte_mbuf_ext_refcnt_set(m->shinfo, 0);
+			descs[n++] = SHMRING_DESC(m->shinfo - region->shinfo,
+				m->data_off, m->data_len);
+			bytes += m->pkt_len;
+			continue;
+		}
+		/* the free slots come from the peer too, skip the invalid ones */
+		while (c < nb_slots && unlikely(!shmring_slot_valid(region,
+				slots[c]))) {
+			txq->bad_slots++;
+			c++;
+		}
+		if (c == nb_slots)
+			break;
+		if (m->pkt_len >
+				(uint32_t)(region->buf_len - RTE_PKTMBUF_HEADROOM)) {
+			txq->errs++;
+			continue;
+		}
+
+		buf = RTE_PTR_ADD(shmring_slot_buf(region, slots[c]),
+				RTE_PKTMBUF_HEADROOM);
+		off = 0;
+		for (seg = m; seg != NULL; seg = seg->next) {
+			rte_memcpy(buf + off, rte_pktmbuf_mtod(seg, void *),
+				seg->data_len);
+			off += seg->data_len;
+		}
+		descs[n++] = SHMRING_DESC(slots[c++], RTE_PKTMBUF_HEADROOM,
+				m->pkt_len);
+		bytes += m->pkt_len;
+	}
+	nb_bufs = i;
+
+	if (c != nb_slots)
+		rte_ring_enqueue_bulk_elem(region->free_ring, &slots[c],
+			sizeof(slots[0]), nb_slots - c, NULL);
+	rte_ring_enqueue_bulk_elem(region->tx_ring, descs, sizeof(descs[0]),
+		n, NULL);
+
+	for (i = 0; i < nb_bufs; i++) {
+		if (in_slot & RTE_BIT64(i))
+			shmring_mbuf_release(region, bufs[i]);
+		else
+			rte_pktmbuf_free(bufs[i]);
+	}
+
+	txq->pkts += n;
+	txq->bytes += bytes;
+	return nb_bufs;
+}
+
+/* size of the default huge page, 0 if unknown */
+static size_t
+shmring_huge_page_size(void)
+{
+	unsigned long long size = 0;
+	char line[128];
+	FILE *f;
+
+	f = fopen("/proc/meminfo", "r");
+	if (f == NULL)
+		return 0;
+	while (fgets(line, sizeof(line), f) != NULL) {
+		if (sscanf(line, "Hugepagesize: %llu kB", &size) == 1)
+			break;
+	}
+	fclose(f);
+	return size * 1024;
+}
+
+/* layout of the region, return its size */
+static size_t
+shmring_region_layout(struct shmring_hdr *hdr, uint32_t nb_slots,
+		uint32_t slot_size)
+{
+	uint32_t count = rte_align32pow2(nb_slots + 1);
+	size_t off;
+
+	off = RTE_ALIGN_CEIL(sizeof(*hdr), RTE_CACHE_LINE_SIZE);
+	hdr->ring_off[SHMRING_S2C] = off;
+	off += rte_ring_get_memsize_elem(sizeof(uint64_t), count);
+	hdr->ring_off[SHMRING_C2S] = off;
+	off += rte_ring_get_memsize_elem(sizeof(uint64_t), count);
+	hdr->ring_off[SHMRING_FREE] = off;
+	off += rte_ring_get_memsize_elem(sizeof(uint32_t), count);
+	/* a slot never spans two pages */
+	off = RTE_ALIGN_CEIL(off, slot_size);
+	hdr->slots_off = off;
+	hdr->nb_slots = nb_slots;
+	hdr->slot_size = slot_size;
+
+	return off + (size_t)nb_slots * slot_size;
+}
+
+/* the header is a local copy, the peer may write in the shared one */
+static int
+shmring_region_init(struct shmring_region *region,
+		const struct shmring_hdr *hdr, bool server)
+{
+	struct rte_ring *rings[SHMRING_NB_RINGS];
+	uint32_t slot;
+	unsigned int i;
+
+	for (i = 0; i < SHMRING_NB_RINGS; i++)
+		rings[i] = RTE_PTR_ADD(region->hdr, hdr->ring_off[i]);
+	region->slots = RTE_PTR_ADD(region->hdr, hdr->slots_off);
+	region->nb_slots = hdr->nb_slots;
+	region->slot_size = hdr->slot_size;
+	region->buf_len = RTE_MIN(hdr->slot_size, (uint32_t)UINT16_MAX);
+	region->free_ring = rings[SHMRING_FREE];
+	region->tx_ring = server ? rings[SHMRING_S2C] : rings[SHMRING_C2S];
+	region->rx_ring = server ? rings[SHMRING_C2S] : rings[SHMRING_S2C];
+
+	region->shinfo = rte_zmalloc(NULL,
+			sizeof(*region->shinfo) * region->nb_slots, 0);
+	if (region->shinfo == NULL)
+		return -ENOMEM;
+	for (slot = 0; slot < region->nb_slots; slot++) {
+		region->shinfo[slot].free_cb = shmring_slot_free;
+		region->shinfo[slot].fcb_opaque = region;
+	}
+
+	if (server) {
+		if (rte_ring_init(rings[SHMRING_S2C], "shmring_s2c",
+				hdr->nb_slots, RING_F_SP_ENQ | RING_F_SC_DEQ |
+				RING_F_EXACT_SZ) != 0 ||
+		    rte_ring_init(rings[SHMRING_C2S], "shmring_c2s",
+				hdr->nb_slots, RING_F_SP_ENQ | RING_F_SC_DEQ |
+				RING_F_EXACT_SZ) != 0 ||
+		    rte_ring_init(rings[SHMRING_FREE], "shmring_free",
+				hdr->nb_slots, RING_F_EXACT_SZ) != 0)
+			return -EINVAL;
+		for (slot = 0; slot < hdr->nb_slots; slot++)
+			rte_ring_enqueue_elem(region->free_ring, &slot,
+				sizeof(slot));
+	}
+
+	if (rte_eal_iova_mode() == RTE_IOVA_VA)
+		return 0;
+
+	/* physical addresses of the slots, which do not span pages */
+	region->iova = rte_malloc(NULL,
+			sizeof(*region->iova) * region->nb_slots, 0);
+	if (region->iova == NULL)
+		return -ENOMEM;
+	for (slot = 0; slot < region->nb_slots; slot++)
+		region->iova[slot] = rte_mem_virt2phy(
+				shmring_slot_buf(region, slot));
+	return 0;
+}
+
+static struct shmring_region *
+shmring_region_alloc(void)
+{
+	struct shmring_region *region;
+
+	region = rte_zmalloc(NULL, sizeof(*region), 0);
+	if (region == NULL)
+		return NULL;
+	region->fd = -1;
+	/* reference of the port */
+	rte_atomic_store_explicit(&region->refcnt, 1, rte_memory_order_relaxed);
+	return region;
+}
+
+/* release the port reference of the region, if any */
+static void
+shmring_region_release(struct pmd_internals *internals)
+{
+	if (internals->region == NULL)
+		return;
+	shmring_region_put(internals->region, 1);
+	internals->region = NULL;
+}
+
+static int
+shmring_region_create(struct pmd_internals *internals)
+{
+	struct shmring_region *region;
+	struct shmring_hdr hdr;
+	size_t size, page_sz;
+	uint32_t slot_size;
+	void *addr = MAP_FAILED;
+	int fd = -1;
+	int ret;
+
+	memset(&hdr, 0, sizeof(hdr));
+	slot_size = rte_align32pow2(RTE_PKTMBUF_HEADROOM + internals->bufsize);
+	size = shmring_region_layout(&hdr, internals->nb_slots, slot_size);
+
+#ifdef MFD_HUGETLB
+	page_sz = shmring_huge_page_size();
+	if (page_sz != 0 && page_sz >= slot_size) {
+		size = RTE_ALIGN_CEIL(size, page_sz);
+		fd = memfd_create("shmring", MFD_CLOEXEC | MFD_HUGETLB);
+		if (fd >= 0 && ftruncate(fd, size) == 0)
+			addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, fd, 0);
+		if (addr == MAP_FAILED && fd >= 0) {
+			close(fd);
+			fd = -1;
+		}
+	}
+#endif
+	if (addr == MAP_FAILED) {
+		PMD_LOG(NOTICE, "No huge page available, using small pages");
+		page_sz = rte_mem_page_size();
+		size = RTE_ALIGN_CEIL(size, page_sz);
+		fd = memfd_create("shmring", MFD_CLOEXEC);
+		if (fd < 0 || ftruncate(fd, size) != 0) {
+			PMD_LOG(ERR, "Cannot create shared memory: %s",
+				strerror(errno));
+			if (fd >= 0)
+				close(fd);
+			return -errno;
+		}
+		addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, fd, 0);
+		if (addr == MAP_FAILED) {
+			PMD_LOG(ERR, "Cannot map shared memory: %s",
+				strerror(errno));
+			close(fd);
+			return -errno;
+		}
+	}
+
+	region = shmring_region_alloc();
+	if (region == NULL) {
+		munmap(addr, size);
+		close(fd);
+		return -ENOMEM;
+	}
+	hdr.magic = SHMRING_MAGIC;
+	hdr.version = SHMRING_VERSION;
+	hdr.size = size;
+	memcpy(addr, &hdr, sizeof(hdr));
+	region->hdr = addr;
+	region->size = size;
+	region->fd = fd;
+
+	ret = shmring_region_init(region, &hdr, true);
+	if (ret < 0) {
+		shmring_region_put(region, 1);
+		return ret;
+	}
+	internals->region = region;
+
+	PMD_LOG(INFO, "Created region of %zu bytes with %u slots of %u bytes",
+		size, hdr.nb_slots, hdr.slot_size);
+	return 0;
+}
+
+static int
+shmring_region_attach(struct pmd_internals *internals, int fd, size_t size)
+{
+	struct shmring_region *region;
+	struct shmring_hdr hdr, check;
+	void *addr;
+	int ret;
+
+	region = shmring_region_alloc();
+	if (region == NULL) {
+		close(fd);
+		return -ENOMEM;
+	}
+	region->fd = fd;
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, 0);
+	if (addr == MAP_FAILED) {
+		PMD_LOG(ERR, "Cannot map shared memory: %s", strerror(errno));
+		ret = -errno;
+		goto error;
+	}
+	region->hdr = addr;
+	region->size = size;
+
+	/* the layout must be the one computed from the geometry */
+	memcpy(&hdr, addr, sizeof(hdr));
+	memset(&check, 0, sizeof(check));
+	if (hdr.magic != SHMRING_MAGIC || hdr.version != SHMRING_VERSION ||
+			hdr.size != size || hdr.nb_slots == 0 ||
+			hdr.nb_slots > SHMRING_SLOTS_MAX ||
+			!rte_is_power_of_2(hdr.slot_size) ||
+			hdr.slot_size > SHMRING_SLOT_MAX ||
+			hdr.slot_size <= RTE_PKTMBUF_HEADROOM ||
+			shmring_region_layout(&check, hdr.nb_slots,
+				hdr.slot_size) > size ||
+			memcmp(check.ring_off, hdr.ring_off,
+				sizeof(hdr.ring_off)) != 0 ||
+			check.slots_off != hdr.slots_off) {
+		PMD_LOG(ERR, "Invalid shared memory region");
+		ret = -EINVAL;
+		goto error;
+	}
+
+	ret = shmring_region_init(region, &hdr, false);
+	if (ret < 0)
+		goto error;
+	internals->bufsize = region->buf_len - RTE_PKTMBUF_HEADROOM;
+	internals->region = region;
+	return 0;
+
+error:
+	shmring_region_put(region, 1);
+	return ret;
+}
+
+static int
+shmring_socket_listen(struct pmd_internals *internals)
+{
+	struct sockaddr_un sun = { .sun_family = AF_UNIX };
+	int fd;
+
+	fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -errno;
+	strlcpy(sun.sun_path, internals->socket_path, sizeof(sun.sun_path));
+	unlink(sun.sun_path);
+	if (bind(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0 ||
+			listen(fd, 1) < 0) {
+		PMD_LOG(ERR, "Cannot listen on %s: %s", sun.sun_path,
+			strerror(errno));
+		close(fd);
+		return -errno;
+	}
+	internals->listen_fd = fd;
+	return 0;
+}
+
+static void
+shmring_server_accept(struct pmd_internals *internals)
+{
+	struct shmring_msg msg = {
+		.magic = SHMRING_MAGIC,
+		.version = SHMRING_VERSION,
+	};
+	char ctl[CMSG_SPACE(sizeof(int))] = { 0 };
+	struct iovec iov = { .iov_base = &msg, .iov_len = sizeof(msg) };
+	struct msghdr mh = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = ctl,
+		.msg_controllen = sizeof(ctl),
+	};
+	struct cmsghdr *cmsg;
+	int fd;
+
+	fd = accept4(internals->listen_fd, NULL, NULL,
+			SOCK_NONBLOCK | SOCK_CLOEXEC);
+	if (fd < 0)
+		return;
+
+	/*
+	 * Each client gets a new region with all slots free,
+	 * the previous one is unmapped once its last mbuf is freed.
+	 */
+	if (shmring_region_create(internals) < 0) {
+		close(fd);
+		return;
+	}
+
+	msg.size = internals->region->size;
+	cmsg = CMSG_FIRSTHDR(&mh);
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	memcpy(CMSG_DATA(cmsg), &internals->region->fd, sizeof(int));
+	if (sendmsg(fd, &mh, 0) != sizeof(msg)) {
+		PMD_LOG(ERR, "Cannot send region to client: %s",
+			strerror(errno));
+		shmring_region_release(internals);
+		close(fd);
+		return;
+	}
+
+	PMD_LOG(INFO, "Client connected on %s", internals->socket_path);
+	internals->conn_fd = fd;
+	rte_atomic_store_explicit(&internals->connected, true,
+		rte_memory_order_release);
+}
+
+static void
+shmring_client_connect(struct pmd_internals *internals)
+{
+	struct sockaddr_un sun = { .sun_family = AF_UNIX };
+	struct timeval tv = { .tv_sec = 1 };
+	char ctl[CMSG_SPACE(sizeof(int))] = { 0 };
+	struct shmring_msg msg;
+	struct iovec iov = { .iov_base = &msg, .iov_len = sizeof(msg) };
+	struct msghdr mh = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = ctl,
+		.msg_controllen = sizeof(ctl),
+	};
+	struct cmsghdr *cmsg;
+	int fd, region_fd = -1;
+
+	fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return;
+	strlcpy(sun.sun_path, internals->socket_path, sizeof(sun.sun_path));
+	if (connect(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0) {
+		close(fd);
+		return;
+	}
+
+	/* the server sends the region once it accepted the connection */
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	if (recvmsg(fd, &mh, 0) != sizeof(msg) ||
+			msg.magic != SHMRING_MAGIC ||
+			msg.version != SHMRING_VERSION) {
+		PMD_LOG(ERR, "Invalid message from server %s",
+			internals->socket_path);
+		close(fd);
+		return;
+	}
+	for (cmsg = CMSG_FIRSTHDR(&mh); cmsg != NULL;
+			cmsg = CMSG_NXTHDR(&mh, cmsg))
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+				cmsg->cmsg_type == SCM_RIGHTS)
+			memcpy(&region_fd, CMSG_DATA(cmsg), sizeof(int));
+	if (region_fd < 0 ||
+			shmring_region_attach(internals, region_fd, msg.size) < 0) {
+		close(fd);
+		return;
+	}
+
+	PMD_LOG(INFO, "Connected to server %s", internals->socket_path);
+	internals->conn_fd = fd;
+	rte_atomic_store_explicit(&internals->connected, true,
+		rte_memory_order_release);
+}
+
+/* true if the peer closed the connection */
+static bool
+shmring_peer_closed(struct pmd_internals *internals)
+{
+	char c;
+
+	return recv(internals->conn_fd, &c, sizeof(c),
+			MSG_PEEK | MSG_DONTWAIT) == 0;
+}
+
+static void
+shmring_ctrl_poll(void *arg)
+{
+	struct rte_eth_dev *dev = arg;
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->conn_fd < 0) {
+		/*
+		 * The datapath had a poll period to see the disconnection,
+		 * the mbufs attached to the region keep it mapped.
+		 */
+		shmring_region_release(internals);
+		if (internals->server)
+			shmring_server_accept(internals);
+		else
+			shmring_client_connect(internals);
+	} else if (shmring_peer_closed(internals)) {
+		PMD_LOG(NOTICE, "Peer disconnected from %s",
+			internals->socket_path);
+		rte_atomic_store_explicit(&internals->connected, false,
+			rte_memory_order_release);
+		close(internals->conn_fd);
+		internals->conn_fd = -1;
+	}
+
+	rte_eal_alarm_set(SHMRING_POLL_US, shmring_ctrl_poll, dev);
+}
+
+static int
+eth_dev_configure(struct rte_eth_dev *dev __rte_unused)
+{
+	return 0;
+}
+
+static int
+eth_dev_start(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	shmring_ctrl_poll(dev);
+
+	dev->data->dev_link.link_status = rte_atomic_load_explicit(
+		&internals->connected, rte_memory_order_relaxed) ?
+		RTE_ETH_LINK_UP : RTE_ETH_LINK_DOWN;
+	dev->data->rx_queue_state[0] = RTE_ETH_QUEUE_STATE_STARTED;
+	dev->data->tx_queue_state[0] = RTE_ETH_QUEUE_STATE_STARTED;
+
+	return 0;
+}
+
+static int
+eth_dev_stop(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	rte_eal_alarm_cancel(shmring_ctrl_poll, dev);
+
+	rte_atomic_store_explicit(&internals->connected, false,
+		rte_memory_order_release);
+	if (internals->conn_fd >= 0) {
+		close(internals->conn_fd);
+		internals->conn_fd = -1;
+	}
+	/* the datapath is stopped, the mbufs keep the region mapped */
+	shmring_region_release(internals);
+
+	dev->data->dev_link.link_status = RTE_ETH_LINK_DOWN;
+	dev->data->rx_queue_state[0] = RTE_ETH_QUEUE_STATE_STOPPED;
+	dev->data->tx_queue_state[0] = RTE_ETH_QUEUE_STATE_STOPPED;
+
+	return 0;
+}
+
+static int
+eth_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
+		uint16_t nb_rx_desc __rte_unused,
+		unsigned int socket_id __rte_unused,
+		const struct rte_eth_rxconf *rx_conf __rte_unused,
+		struct rte_mempool *mb_pool)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (mb_pool == NULL)
+		return -EINVAL;
+
+	internals->rxq.internals = internals;
+	internals->rxq.mb_pool = mb_pool;
+	dev->data->rx_queues[rx_queue_id] = &internals->rxq;
+
+	return 0;
+}
+
+static int
+eth_tx_queue_setup(struct rte_eth_dev *dev, uint16_t tx_queue_id,
+		uint16_t nb_tx_desc __rte_unused,
+		unsigned int socket_id __rte_unused,
+		const struct rte_eth_txconf *tx_conf __rte_unused)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	internals->txq.internals = internals;
+	dev->data->tx_queues[tx_queue_id] = &internals->txq;
+
+	return 0;
+}
+
+static int
+eth_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	dev_info->max_mac_addrs = 1;
+	dev_info->max_rx_pktlen = internals->bufsize;
+	dev_info->max_rx_queues = 1;
+	dev_info->max_tx_queues = 1;
+	dev_info->min_rx_bufsize = 0;
+	dev_info->tx_offload_capa = RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+
+	return 0;
+}
+
+static int
+eth_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
+{
+	const struct pmd_internals *internals = dev->data->dev_private;
+
+	stats->ipackets = internals->rxq.pkts;
+	stats->ibytes = internals->rxq.bytes;
+	stats->rx_nombuf = internals->rxq.nombuf;
+	/* invalid descriptors and free slots given by the peer */
+	stats->ierrors = internals->rxq.errs + internals->txq.bad_slots;
+	stats->opackets = internals->txq.pkts;
+	stats->obytes = internals->txq.bytes;
+	stats->oerrors = internals->txq.errs;
+	stats->q_ipackets[0] = stats->ipackets;
+	stats->q_ibytes[0] = stats->ibytes;
+	stats->q_opackets[0] = stats->opackets;
+	stats->q_obytes[0] = stats->obytes;
+
+	return 0;
+}
+
+static int
+eth_stats_reset(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	internals->rxq.pkts = 0;
+	internals->rxq.bytes = 0;
+	internals->rxq.nombuf = 0;
+	internals->rxq.errs = 0;
+	internals->txq.pkts = 0;
+	internals->txq.bytes = 0;
+	internals->txq.errs = 0;
+	internals->txq.bad_slots = 0;
+
+	return 0;
+}
+
+static int
+eth_link_update(struct rte_eth_dev *dev, int wait_to_complete __rte_unused)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	struct rte_eth_link link = pmd_link;
+
+	if (dev->data->dev_started && rte_atomic_load_explicit(
+			&internals->connected, rte_memory_order_relaxed))
+		link.link_status = RTE_ETH_LINK_UP;
+
+	return rte_eth_linkstatus_set(dev, &link);
+}
+
+static int
+eth_dev_close(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	PMD_LOG(INFO, "Closing shmring ethdev %s", internals->socket_path);
+
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
+		return 0;
+
+	eth_dev_stop(dev);
+	if (internals->listen_fd >= 0) {
+		close(internals->listen_fd);
+		internals->listen_fd = -1;
+		unlink(internals->socket_path);
+	}
+
+	/* mac_addrs must not be freed alone because part of dev_private */
+	dev->data->mac_addrs = NULL;
+
+	return 0;
+}
+
+static const struct eth_dev_ops ops = {
+	.dev_close = eth_dev_close,
+	.dev_start = eth_dev_start,
+	.dev_stop = eth_dev_stop,
+	.dev_configure = eth_dev_configure,
+	.dev_infos_get = eth_dev_info,
+	.rx_queue_setup = eth_rx_queue_setup,
+	.tx_queue_setup = eth_tx_queue_setup,
+	.link_update = eth_link_update,
+	.stats_get = eth_stats_get,
+	.stats_reset = eth_stats_reset,
+};
+
+static int
+eth_dev_shmring_create(struct rte_vdev_device *dev,
+		struct pmd_internals *args)
+{
+	struct pmd_internals *internals;
+	struct rte_eth_dev *eth_dev;
+	struct rte_eth_dev_data *data;
+	int ret;
+
+	eth_dev = rte_eth_vdev_allocate(dev, sizeof(*internals));
+	if (eth_dev == NULL)
+		return -ENOMEM;
+
+	internals = eth_dev->data->dev_private;
+	memcpy(internals, args, sizeof(*internals));
+	internals->port_id = eth_dev->data->port_id;
+	internals->listen_fd = -1;
+	internals->conn_fd = -1;
+	internals->region = NULL;
+	rte_eth_random_addr(internals->eth_addr.addr_bytes);
+
+	if (internals->server) {
+		ret = shmring_socket_listen(internals);
+		if (ret < 0) {
+			rte_eth_dev_release_port(eth_dev);
+			return ret;
+		}
+	}
+
+	data = eth_dev->data;
+	data->nb_rx_queues = 1;
+	data->nb_tx_queues = 1;
+	data->dev_link = pmd_link;
+	data->mac_addrs = &internals->eth_addr;
+	data->promiscuous = 1;
+	data->all_multicast = 1;
+	data->dev_flags |= RTE_ETH_DEV_AUTOFILL_QUEUE_XSTATS;
+
+	eth_dev->dev_ops = &ops;
+	eth_dev->rx_pkt_burst = eth_shmring_rx;
+	eth_dev->tx_pkt_burst = eth_shmring_tx;
+
+	rte_eth_dev_probing_finish(eth_dev);
+	return 0;
+}
+
+static int
+get_socket_arg(const char *key __rte_unused, const char *value,
+		void *extra_args)
+{
+	struct pmd_internals *args = extra_args;
+
+	if (strlcpy(args->socket_path, value, sizeof(args->socket_path)) >=
+			sizeof(args->socket_path))
+		return -ENAMETOOLONG;
+	return 0;
+}
+
+static int
+get_role_arg(const char *key __rte_unused, const char *value,
+		void *extra_args)
+{
+	struct pmd_internals *args = extra_args;
+
+	if (strcmp(value, "server") == 0)
+		args->server = true;
+	else if (strcmp(value, "client") == 0)
+		args->server = false;
+	else
+		return -EINVAL;
+	return 0;
+}
+
+static int
+get_uint_arg(const char *key __rte_unused, const char *value,
+		void *extra_args)
+{
+	unsigned long val;
+	char *end;
+
+	errno = 0;
+	val = strtoul(value, &end, 0);
+	if (errno != 0 || *end != '\0' || val == 0 || val > UINT32_MAX)
+		return -EINVAL;
+	*(uint32_t *)extra_args = val;
+	return 0;
+}
+
+static int
+rte_pmd_shmring_probe(struct rte_vdev_device *dev)
+{
+	struct pmd_internals args = {
+		.server = true,
+		.nb_slots = SHMRING_SLOTS_DEF,
+		.bufsize = SHMRING_BUFSIZE_DEF,
+	};
+	struct rte_kvargs *kvlist;
+	const char *name, *params;
+	int ret;
+
+	name = rte_vdev_device_name(dev);
+	PMD_LOG(INFO, "Initializing pmd_shmring for %s", name);
+
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY) {
+		PMD_LOG(ERR, "Secondary process not supported");
+		return -ENOTSUP;
+	}
+
+	params = rte_vdev_device_args(dev);
+	if (params == NULL || params[0] == '\0') {
+		PMD_LOG(ERR, "Missing %s argument", ETH_SHMRING_SOCKET_ARG);
+		return -EINVAL;
+	}
+	kvlist = rte_kvargs_parse(params, valid_arguments);
+	if (kvlist == NULL)
+		return -EINVAL;
+
+	ret = rte_kvargs_process(kvlist, ETH_SHMRING_SOCKET_ARG,
+			&get_socket_arg, &args);
+	if (ret < 0)
+		goto free_kvlist;
+	ret = rte_kvargs_process(kvlist, ETH_SHMRING_ROLE_ARG,
+			&get_role_arg, &args);
+	if (ret < 0)
+		goto free_kvlist;
+	ret = rte_kvargs_process(kvlist, ETH_SHMRING_SLOTS_ARG,
+			&get_uint_arg, &args.nb_slots);
+	if (ret < 0)
+		goto free_kvlist;
+	ret = rte_kvargs_process(kvlist, ETH_SHMRING_BUFSIZE_ARG,
+			&get_uint_arg, &args.bufsize);
+	if (ret < 0)
+		goto free_kvlist;
+
+	if (args.socket_path[0] == '\0') {
+		PMD_LOG(ERR, "Missing %s argument", ETH_SHMRING_SOCKET_ARG);
+		ret = -EINVAL;
+		goto free_kvlist;
+	}
+	if (args.nb_slots > SHMRING_SLOTS_MAX ||
+			RTE_PKTMBUF_HEADROOM + args.bufsize > SHMRING_SLOT_MAX) {
+		PMD_LOG(ERR, "Invalid %s or %s argument",
+			ETH_SHMRING_SLOTS_ARG, ETH_SHMRING_BUFSIZE_ARG);
+		ret = -EINVAL;
+		goto free_kvlist;
+	}
+
+	PMD_LOG(INFO, "Configure pmd_shmring: %s on %s",
+		args.server ? "server" : "client", args.socket_path);
+
+	ret = eth_dev_shmring_create(dev, &args);
+
+free_kvlist:
+	rte_kvargs_free(kvlist);
+	return ret;
+}
+
+static int
+rte_pmd_shmring_remove(struct rte_vdev_device *dev)
+{
+	struct rte_eth_dev *eth_dev;
+
+	eth_dev = rte_eth_dev_allocated(rte_vdev_device_name(dev));
+	if (eth_dev == NULL)
+		return 0; /* port already released */
+
+	eth_dev_close(eth_dev);
+	rte_eth_dev_release_port(eth_dev);
+
+	return 0;
+}
+
+static struct rte_vdev_driver pmd_shmring_drv = {
+	.probe = rte_pmd_shmring_probe,
+	.remove = rte_pmd_shmring_remove,
+};
+
+RTE_PMD_REGISTER_VDEV(net_shmring, pmd_shmring_drv);
+RTE_PMD_REGISTER_PARAM_STRING(net_shmring,
+	ETH_SHMRING_SOCKET_ARG "=<path> "
+	ETH_SHMRING_ROLE_ARG "=server|client "
+	ETH_SHMRING_SLOTS_ARG "=<int> "
+	ETH_SHMRING_BUFSIZE_ARG "=<int>");
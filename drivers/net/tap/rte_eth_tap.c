@@ -56,6 +56,7 @@
 #define ETH_TAP_MAC_ARG         "mac"
 #define ETH_TAP_MAC_FIXED       "fixed"
 #define ETH_TAP_PERSIST_ARG     "persist"
+#define ETH_TAP_IO_URING_ARG    "io_uring"
 
 #define ETH_TAP_USR_MAC_FMT     "xx:xx:xx:xx:xx:xx"
 #define ETH_TAP_CMP_MAC_FMT     "0123456789ABCDEFabcdef"
@@ -97,6 +98,7 @@ static const char *valid_arguments[] = {
 	ETH_TAP_REMOTE_ARG,
 	ETH_TAP_MAC_ARG,
 	ETH_TAP_PERSIST_ARG,
+	ETH_TAP_IO_URING_ARG,
 	NULL
 };
 
@@ -318,7 +320,7 @@ tun_alloc(struct pmd_internals *pmd, int is_keepalive, int persistent)
 	return -1;
 }
 
-static void
+void
 tap_verify_csum(struct rte_mbuf *mbuf)
 {
 	uint32_t l2 = mbuf->packet_type & RTE_PTYPE_L2_MASK;
@@ -521,126 +523,147 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
-static inline int
-tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
-			struct rte_mbuf **pmbufs,
-			uint16_t *num_packets, unsigned long *num_tx_bytes)
+/*
+ * Fill the packet info and the iovecs to write a packet to the tap,
+ * computing the checksums in software if requested.
+ * A header segment may be prepended to the mbuf, updating *pmbuf.
+ * The iovecs array must have room for nb_segs + 2 entries.
+ * Return the number of iovecs, or -1 on error.
+ */
+int
+tap_tx_prepare(struct tx_queue *txq, struct rte_mbuf **pmbuf,
+		struct tun_pi *pi, struct iovec *iovecs)
 {
-	struct pmd_process_private *process_private;
-	int i;
-
-	process_private = rte_eth_devices[txq->out_port].process_private;
+	struct rte_mbuf *mbuf = *pmbuf;
+	struct rte_mbuf *seg = mbuf;
+	uint64_t l4_ol_flags;
+	int proto;
+	int j;
+	int k; /* current index in iovecs for copying segments */
+
+	pi->flags = 0;
+	pi->proto = 0x00;
+	if (txq->type == ETH_TUNTAP_TYPE_TUN) {
+		/*
+		 * TUN and TAP are created with IFF_NO_PI disabled.
+		 * For TUN PMD this mandatory as fields are used by
+		 * Kernel tun.c to determine whether its IP or non IP
+		 * packets.
+		 *
+		 * The logic fetches the first byte of data from mbuf
+		 * then compares whether its v4 or v6. If first byte
+		 * is 4 or 6, then protocol field is updated.
+		 */
+		char *buff_data = rte_pktmbuf_mtod(seg, void *);
+		proto = (*buff_data & 0xf0);
+		pi->proto = (proto == 0x40) ?
+			rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) :
+			((proto == 0x60) ?
+				rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) :
+				0x00);
+	}
+
+	k = 0;
+	iovecs[k].iov_base = pi;
+	iovecs[k].iov_len = sizeof(*pi);
+	k++;
+
+	l4_ol_flags = mbuf->ol_flags & RTE_MBUF_F_TX_L4_MASK;
+	if (txq->csum && (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM ||
+			l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM ||
+			l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)) {
+		unsigned int hdrlens = mbuf->l2_len + mbuf->l3_len;
+		uint16_t *l4_cksum;
+		void *l3_hdr;
+
+		if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM)
+			hdrlens += sizeof(struct rte_udp_hdr);
+		else if (l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)
+			hdrlens += sizeof(struct rte_tcp_hdr);
+		else if (l4_ol_flags != RTE_MBUF_F_TX_L4_NO_CKSUM)
+			return -1;
 
-	for (i = 0; i < num_mbufs; i++) {
-		struct rte_mbuf *mbuf = pmbufs[i];
-		struct iovec iovecs[mbuf->nb_segs + 2];
-		struct tun_pi pi = { .flags = 0, .proto = 0x00 };
-		struct rte_mbuf *seg = mbuf;
-		uint64_t l4_ol_flags;
-		int proto;
-		int n;
-		int j;
-		int k; /* current index in iovecs for copying segments */
+		/* Support only packets with at least layer 4
+		 * header included in the first segment
+		 */
+		if (rte_pktmbuf_data_len(mbuf) < hdrlens)
+			return -1;
 
-		if (txq->type == ETH_TUNTAP_TYPE_TUN) {
-			/*
-			 * TUN and TAP are created with IFF_NO_PI disabled.
-			 * For TUN PMD this mandatory as fields are used by
-			 * Kernel tun.c to determine whether its IP or non IP
-			 * packets.
-			 *
-			 * The logic fetches the first byte of data from mbuf
-			 * then compares whether its v4 or v6. If first byte
-			 * is 4 or 6, then protocol field is updated.
-			 */
-			char *buff_data = rte_pktmbuf_mtod(seg, void *);
-			proto = (*buff_data & 0xf0);
-			pi.proto = (proto == 0x40) ?
-				rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) :
-				((proto == 0x60) ?
-					rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) :
-					0x00);
-		}
+		/* To change checksums (considering that a mbuf can be
+		 * indirect, for example), copy l2, l3 and l4 headers
+		 * in a new segment and chain it to existing data
+		 */
+		seg = rte_pktmbuf_copy(mbuf, mbuf->pool, 0, hdrlens);
+		if (seg == NULL)
+			return -1;
+		rte_pktmbuf_adj(mbuf, hdrlens);
+		rte_pktmbuf_chain(seg, mbuf);
+		*pmbuf = mbuf = seg;
 
-		k = 0;
-		iovecs[k].iov_base = &pi;
-		iovecs[k].iov_len = sizeof(pi);
-		k++;
+		l3_hdr = rte_pktmbuf_mtod_offset(mbuf, void *, mbuf->l2_len);
+		if (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM) {
+			struct rte_ipv4_hdr *iph = l3_hdr;
 
-		l4_ol_flags = mbuf->ol_flags & RTE_MBUF_F_TX_L4_MASK;
-		if (txq->csum && (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM ||
-				l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM ||
-				l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)) {
-			unsigned int hdrlens = mbuf->l2_len + mbuf->l3_len;
-			uint16_t *l4_cksum;
-			void *l3_hdr;
-
-			if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM)
-				hdrlens += sizeof(struct rte_udp_hdr);
-			else if (l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)
-				hdrlens += sizeof(struct rte_tcp_hdr);
-			else if (l4_ol_flags != RTE_MBUF_F_TX_L4_NO_CKSUM)
-				return -1;
+			iph->hdr_checksum = 0;
+			iph->hdr_checksum = rte_ipv4_cksum(iph);
+		}
 
-			/* Support only packets with at least layer 4
-			 * header included in the first segment
-			 */
-			if (rte_pktmbuf_data_len(mbuf) < hdrlens)
-				return -1;
+		if (l4_ol_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
+			goto skip_l4_cksum;
 
-			/* To change checksums (considering that a mbuf can be
-			 * indirect, for example), copy l2, l3 and l4 headers
-			 * in a new segment and chain it to existing data
-			 */
-			seg = rte_pktmbuf_copy(mbuf, mbuf->pool, 0, hdrlens);
-			if (seg == NULL)
-				return -1;
-			rte_pktmbuf_adj(mbuf, hdrlens);
-			rte_pktmbuf_chain(seg, mbuf);
-			pmbufs[i] = mbuf = seg;
+		if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
+			struct rte_udp_hdr *udp_hdr;
 
-			l3_hdr = rte_pktmbuf_mtod_offset(mbuf, void *, mbuf->l2_len);
-			if (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM) {
-				struct rte_ipv4_hdr *iph = l3_hdr;
+			udp_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_udp_hdr *,
+				mbuf->l2_len + mbuf->l3_len);
+			l4_cksum = &udp_hdr->dgram_cksum;
+		} else {
+			struct rte_tcp_hdr *tcp_hdr;
 
-				iph->hdr_checksum = 0;
-				iph->hdr_checksum = rte_ipv4_cksum(iph);
-			}
+			tcp_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_tcp_hdr *,
+				mbuf->l2_len + mbuf->l3_len);
+			l4_cksum = &tcp_hdr->cksum;
+		}
 
-			if (l4_ol_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
-				goto skip_l4_cksum;
+		*l4_cksum = 0;
+		if (mbuf->ol_flags & RTE_MBUF_F_TX_IPV4) {
+			*l4_cksum = rte_ipv4_udptcp_cksum_mbuf(mbuf, l3_hdr,
+				mbuf->l2_len + mbuf->l3_len);
+		} else {
+			*l4_cksum = rte_ipv6_udptcp_cksum_mbuf(mbuf, l3_hdr,
+				mbuf->l2_len + mbuf->l3_len);
+		}
+	}
 
-			if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
-				struct rte_udp_hdr *udp_hdr;
+skip_l4_cksum:
+	for (j = 0; j < mbuf->nb_segs; j++) {
+		iovecs[k].iov_len = rte_pktmbuf_data_len(seg);
+		iovecs[k].iov_base = rte_pktmbuf_mtod(seg, void *);
+		k++;
+		seg = seg->next;
+	}
+	return k;
+}
 
-				udp_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_udp_hdr *,
-					mbuf->l2_len + mbuf->l3_len);
-				l4_cksum = &udp_hdr->dgram_cksum;
-			} else {
-				struct rte_tcp_hdr *tcp_hdr;
+static inline int
+tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
+			struct rte_mbuf **pmbufs,
+			uint16_t *num_packets, unsigned long *num_tx_bytes)
+{
+	struct pmd_process_private *process_private;
+	int i;
 
-				tcp_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_tcp_hdr *,
-					mbuf->l2_len + mbuf->l3_len);
-				l4_cksum = &tcp_hdr->cksum;
-			}
+	process_private = rte_eth_devices[txq->out_port].process_private;
 
-			*l4_cksum = 0;
-			if (mbuf->ol_flags & RTE_MBUF_F_TX_IPV4) {
-				*l4_cksum = rte_ipv4_udptcp_cksum_mbuf(mbuf, l3_hdr,
-					mbuf->l2_len + mbuf->l3_len);
-			} else {
-				*l4_cksum = rte_ipv6_udptcp_cksum_mbuf(mbuf, l3_hdr,
-					mbuf->l2_len + mbuf->l3_len);
-			}
-		}
+	for (i = 0; i < num_mbufs; i++) {
+		struct iovec iovecs[pmbufs[i]->nb_segs + 2];
+		struct tun_pi pi;
+		int n;
+		int k;
 
-skip_l4_cksum:
-		for (j = 0; j < mbuf->nb_segs; j++) {
-			iovecs[k].iov_len = rte_pktmbuf_data_len(seg);
-			iovecs[k].iov_base = rte_pktmbuf_mtod(seg, void *);
-			k++;
-			seg = seg->next;
-		}
+		k = tap_tx_prepare(txq, &pmbufs[i], &pi, iovecs);
+		if (k < 0)
+			return -1;
 
 		/* copy the tx frame data */
 		n = writev(process_private->fds[txq->queue_id], iovecs, k);
@@ -648,7 +671,7 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 			return -1;
 
 		(*num_packets)++;
-		(*num_tx_bytes) += rte_pktmbuf_pkt_len(mbuf);
+		(*num_tx_bytes) += rte_pktmbuf_pkt_len(pmbufs[i]);
 	}
 	return 0;
 }
@@ -959,6 +982,12 @@ tap_dev_configure(struct rte_eth_dev *dev)
 		return -1;
 	}
 
+	if (pmd->io_uring && dev->data->dev_conf.intr_conf.rxq) {
+		TAP_LOG(ERR, "%s: Rx interrupts are not supported with io_uring",
+			dev->device->name);
+		return -ENOTSUP;
+	}
+
 	TAP_LOG(INFO, "%s: %s: TX configured queues number: %u",
 		dev->device->name, pmd->name, dev->data->nb_tx_queues);
 
@@ -1015,8 +1044,13 @@ tap_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	dev_info->min_rx_bufsize = 0;
 	dev_info->speed_capa = tap_dev_speed_capa();
 	dev_info->rx_queue_offload_capa = TAP_RX_OFFLOAD;
-	dev_info->rx_offload_capa = dev_info->rx_queue_offload_capa;
 	dev_info->tx_queue_offload_capa = TAP_TX_OFFLOAD;
+	if (internals->io_uring) {
+		/* a packet is read in a single mbuf, and not segmented */
+		dev_info->rx_queue_offload_capa &= ~RTE_ETH_RX_OFFLOAD_SCATTER;
+		dev_info->tx_queue_offload_capa &= ~RTE_ETH_TX_OFFLOAD_TCP_TSO;
+	}
+	dev_info->rx_offload_capa = dev_info->rx_queue_offload_capa;
 	dev_info->tx_offload_capa = dev_info->tx_queue_offload_capa;
 	dev_info->hash_key_size = TAP_RSS_HASH_KEY_SIZE;
 	/*
@@ -1133,6 +1167,10 @@ tap_dev_close(struct rte_eth_dev *dev)
 	for (i = 0; i < RTE_PMD_TAP_MAX_QUEUES; i++) {
 		struct rx_queue *rxq = &internals->rxq[i];
 
+#ifdef HAVE_LIBURING
+		tap_uring_rxq_release(rxq);
+		tap_uring_txq_release(&internals->txq[i]);
+#endif
 		tap_queue_close(process_private, i);
 
 		tap_rxq_pool_free(rxq->pool);
@@ -1196,6 +1234,9 @@ tap_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 
 	process_private = rte_eth_devices[rxq->in_port].process_private;
 
+#ifdef HAVE_LIBURING
+	tap_uring_rxq_release(rxq);
+#endif
 	tap_rxq_pool_free(rxq->pool);
 	rte_free(rxq->iovecs);
 	rxq->pool = NULL;
@@ -1215,6 +1256,9 @@ tap_tx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	process_private = rte_eth_devices[txq->out_port].process_private;
+#ifdef HAVE_LIBURING
+	tap_uring_txq_release(txq);
+#endif
 	if (dev->data->rx_queues[qid] == NULL)
 		tap_queue_close(process_private, qid);
 }
@@ -1576,6 +1620,18 @@ tap_rx_queue_setup(struct rte_eth_dev *dev,
 		goto error;
 	}
 
+#ifdef HAVE_LIBURING
+	if (internals->io_uring) {
+		/* the mbufs are in the buffer ring of io_uring */
+		ret = tap_uring_rxq_setup(rxq, fd, nb_rx_desc, socket_id);
+		if (ret < 0)
+			goto error;
+		TAP_LOG(DEBUG, "  RX TUNTAP device name %s, qid %d on fd %d with io_uring",
+			internals->name, rx_queue_id, fd);
+		return 0;
+	}
+#endif
+
 	(*rxq->iovecs)[0].iov_len = sizeof(struct tun_pi);
 	(*rxq->iovecs)[0].iov_base = &rxq->pi;
 
@@ -1638,6 +1694,13 @@ tap_tx_queue_setup(struct rte_eth_dev *dev,
 	ret = tap_setup_queue(dev, internals, tx_queue_id, 0);
 	if (ret == -1)
 		return -1;
+#ifdef HAVE_LIBURING
+	if (internals->io_uring) {
+		ret = tap_uring_txq_setup(txq, ret, socket_id);
+		if (ret < 0)
+			return ret;
+	}
+#endif
 	TAP_LOG(DEBUG,
 		"  TX TUNTAP device name %s, qid %d on fd %d csum %s",
 		internals->name, tx_queue_id,
@@ -1906,7 +1969,7 @@ static const struct eth_dev_ops ops = {
 static int
 eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 		   char *remote_iface, struct rte_ether_addr *mac_addr,
-		   enum rte_tuntap_type type, int persist)
+		   enum rte_tuntap_type type, int persist, int io_uring)
 {
 	int numa_node = rte_socket_id();
 	struct rte_eth_dev *dev;
@@ -1939,6 +2002,7 @@ eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 	strlcpy(pmd->name, tap_name, sizeof(pmd->name));
 	pmd->type = type;
 	pmd->ka_fd = -1;
+	pmd->io_uring = io_uring;
 
 #ifdef HAVE_TCA_FLOWER
 	pmd->nlsk_fd = -1;
@@ -1976,6 +2040,12 @@ eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 	dev->dev_ops = &ops;
 	dev->rx_pkt_burst = pmd_rx_burst;
 	dev->tx_pkt_burst = pmd_tx_burst;
+#ifdef HAVE_LIBURING
+	if (io_uring) {
+		dev->rx_pkt_burst = tap_uring_rx_burst;
+		dev->tx_pkt_burst = tap_uring_tx_burst;
+	}
+#endif
 
 	rte_intr_type_set(pmd->intr_handle, RTE_INTR_HANDLE_EXT);
 	rte_intr_fd_set(pmd->intr_handle, -1);
@@ -2238,6 +2308,30 @@ set_mac_type(const char *key __rte_unused,
 	return -1;
 }
 
+static int
+set_io_uring(const char *key __rte_unused,
+	     const char *value,
+	     void *extra_args)
+{
+	int *io_uring = extra_args;
+
+	if (strcmp(value, "0") == 0) {
+		*io_uring = 0;
+	} else if (strcmp(value, "1") == 0) {
+#ifdef HAVE_LIBURING
+		*io_uring = 1;
+#else
+		TAP_LOG(ERR, "TAP io_uring support is not built, liburing is missing");
+		return -1;
+#endif
+	} else {
+		TAP_LOG(ERR, "TAP invalid io_uring value (%s), must be 0 or 1",
+			value);
+		return -1;
+	}
+	return 0;
+}
+
 /*
  * Open a TUN interface device. TUN PMD
  * 1) sets tap_type as false
@@ -2295,7 +2389,7 @@ rte_pmd_tun_probe(struct rte_vdev_device *dev)
 	TAP_LOG(DEBUG, "Initializing pmd_tun for %s", name);
 
 	ret = eth_dev_tap_create(dev, tun_name, remote_iface, 0,
-				 ETH_TUNTAP_TYPE_TUN, 0);
+				 ETH_TUNTAP_TYPE_TUN, 0, 0);
 
 leave:
 	if (ret == -1) {
@@ -2419,6 +2513,7 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 	struct rte_eth_dev *eth_dev;
 	int tap_devices_count_increased = 0;
 	int persist = 0;
+	int io_uring = 0;
 
 	name = rte_vdev_device_name(dev);
 	params = rte_vdev_device_args(dev);
@@ -2433,6 +2528,11 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 		eth_dev->device = &dev->device;
 		eth_dev->rx_pkt_burst = pmd_rx_burst;
 		eth_dev->tx_pkt_burst = pmd_tx_burst;
+		if (((struct pmd_internals *)eth_dev->data->dev_private)->io_uring) {
+			TAP_LOG(ERR, "%s: io_uring mode is not supported in secondary process",
+				name);
+			return -1;
+		}
 		if (!rte_eal_primary_proc_alive(NULL)) {
 			TAP_LOG(ERR, "Primary process is missing");
 			return -1;
@@ -2502,6 +2602,15 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 
 			if (rte_kvargs_count(kvlist, ETH_TAP_PERSIST_ARG) == 1)
 				persist = 1;
+
+			if (rte_kvargs_count(kvlist, ETH_TAP_IO_URING_ARG) == 1) {
+				ret = rte_kvargs_process(kvlist,
+							 ETH_TAP_IO_URING_ARG,
+							 &set_io_uring,
+							 &io_uring);
+				if (ret == -1)
+					goto leave;
+			}
 		}
 	}
 	pmd_link.link_speed = speed;
@@ -2520,7 +2629,7 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 	tap_devices_count++;
 	tap_devices_count_increased = 1;
 	ret = eth_dev_tap_create(dev, tap_name, remote_iface, &user_mac,
-				 ETH_TUNTAP_TYPE_TAP, persist);
+				 ETH_TUNTAP_TYPE_TAP, persist, io_uring);
 
 leave:
 	if (ret == -1) {
@@ -2573,5 +2682,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_tun,
 RTE_PMD_REGISTER_PARAM_STRING(net_tap,
 			      ETH_TAP_IFACE_ARG "=<string> "
 			      ETH_TAP_MAC_ARG "=" ETH_TAP_MAC_ARG_FMT " "
-			      ETH_TAP_REMOTE_ARG "=<string>");
+			      ETH_TAP_REMOTE_ARG "=<string> "
+			      ETH_TAP_IO_URING_ARG "=<0|1>");
 RTE_LOG_REGISTER_DEFAULT(tap_logtype, NOTICE);
@@ -54,6 +54,7 @@ struct rx_queue {
 	struct rte_mbuf *pool;          /* mbufs pool for this queue */
 	struct iovec (*iovecs)[];       /* descriptors for this queue */
 	struct tun_pi pi;               /* packet info for iovecs */
+	struct tap_uring_rxq *uring;    /* io_uring context, if enabled */
 };
 
 struct tx_queue {
@@ -64,14 +65,19 @@ struct tx_queue {
 	struct rte_gso_ctx gso_ctx;     /* GSO context */
 	uint16_t out_port;              /* Port ID */
 	uint16_t queue_id;		/* queue ID*/
+	struct tap_uring_txq *uring;    /* io_uring context, if enabled */
 };
 
+struct tap_uring_rxq;
+struct tap_uring_txq;
+
 struct pmd_internals {
 	struct rte_eth_dev *dev;          /* Ethernet device. */
 	char remote_iface[RTE_ETH_NAME_MAX_LEN]; /* Remote netdevice name */
 	char name[RTE_ETH_NAME_MAX_LEN];  /* Internal Tap device name */
 	int type;                         /* Type field - TUN|TAP */
 	int persist;			  /* 1 if keep link up, else 0 */
+	int io_uring;			  /* 1 if Rx/Tx use io_uring, else 0 */
 	struct rte_ether_addr eth_addr;   /* Mac address of the device port */
 	struct ifreq remote_initial_flags;/* Remote netdevice flags on init */
 	int remote_if_index;              /* remote netdevice IF_INDEX */
@@ -100,8 +106,26 @@ struct pmd_process_private {
 	int fds[RTE_PMD_TAP_MAX_QUEUES];
 };
 
+/* rte_eth_tap.c */
+
+void tap_verify_csum(struct rte_mbuf *mbuf);
+int tap_tx_prepare(struct tx_queue *txq, struct rte_mbuf **pmbuf,
+		struct tun_pi *pi, struct iovec *iovecs);
+
 /* tap_intr.c */
 
 int tap_rx_intr_vec_set(struct rte_eth_dev *dev, int set);
 
+/* tap_uring.c */
+
+int tap_uring_rxq_setup(struct rx_queue *rxq, int fd, uint16_t nb_desc,
+		unsigned int socket_id);
+void tap_uring_rxq_release(struct rx_queue *rxq);
+int tap_uring_txq_setup(struct tx_queue *txq, int fd, unsigned int socket_id);
+void tap_uring_txq_release(struct tx_queue *txq);
+uint16_t tap_uring_rx_burst(void *queue, struct rte_mbuf **bufs,
+		uint16_t nb_pkts);
+uint16_t tap_uring_tx_burst(void *queue, struct rte_mbuf **bufs,
+		uint16_t nb_pkts);
+
 #endif /* _RTE_ETH_TAP_H_ */
@@ -0,0 +1,404 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+/**
+ * @file
+ * io_uring based Rx and Tx for tap driver.
+ *
+ * On Rx, a multishot read stays armed on the queue file descriptor.
+ * It is submitted from the datapath thread polling the queue.
+ * It picks its buffers from a ring of provided buffers, registered
+ * to io_uring and backed by mbufs of the queue mempool,
+ * so that each received packet lands directly in an mbuf.
+ * The completions are reaped from the shared completion ring
+ * without system call, unless the kernel has pending work to flush.
+ *
+ * On Tx, a burst of packets is queued as write requests
+ * and submitted with a single system call.
+ * The mbufs are freed when their write completes.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <liburing.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_net.h>
+
+#include <rte_eth_tap.h>
+
+/* group of the provided buffers, one per ring */
+#define TAP_URING_BGID		0
+/* maximum number of Rx buffers, limit of a provided buffer ring */
+#define TAP_URING_RX_MAX_BUFS	32768
+/* Tx writes in flight per queue */
+#define TAP_URING_TX_SLOTS	256
+/* iovecs per Tx write: packet info, header copy and segments */
+#define TAP_URING_TX_MAX_IOV	16
+
+struct tap_uring_rxq {
+	struct io_uring ring;
+	struct io_uring_buf_ring *br;
+	int fd;
+	bool armed;                     /* multishot read in flight */
+	unsigned int nb_bufs;           /* power of 2 */
+	struct rte_mbuf *mbufs[];       /* mbuf of each buffer id */
+};
+
+struct tap_uring_tx_slot {
+	struct rte_mbuf *mbuf;          /* NULL if the slot is free */
+	struct tun_pi pi;
+	struct iovec iov[TAP_URING_TX_MAX_IOV];
+};
+
+struct tap_uring_txq {
+	struct io_uring ring;
+	int fd;
+	unsigned int nb_free;
+	uint16_t free[TAP_URING_TX_SLOTS];
+	struct tap_uring_tx_slot slots[TAP_URING_TX_SLOTS];
+};
+
+/*
+ * Completions are posted by task work, flushed when the task enters
+ * the kernel. With the taskrun flag, liburing enters the kernel to flush
+ * them only when some are pending, instead of the task being interrupted.
+ */
+static int
+tap_uring_init(struct io_uring *ring, unsigned int entries,
+		unsigned int cq_entries)
+{
+	struct io_uring_params p;
+	int ret;
+
+	memset(&p, 0, sizeof(p));
+	p.flags = IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+	if (cq_entries != 0) {
+		p.flags |= IORING_SETUP_CQSIZE;
+		p.cq_entries = cq_entries;
+	}
+	ret = io_uring_queue_init_params(entries, ring, &p);
+	if (ret == -EINVAL) {
+		/* kernel older than 5.19 */
+		p.flags &= ~(IORING_SETUP_COOP_TASKRUN |
+			IORING_SETUP_TASKRUN_FLAG);
+		ret = io_uring_queue_init_params(entries, ring, &p);
+	}
+	return ret;
+}
+
+static inline void
+tap_uring_rx_buf_add(struct tap_uring_rxq *u, struct rte_mbuf *mbuf,
+		uint16_t bid, int offset)
+{
+	/* the packet info is read in the headroom, before the packet data */
+	io_uring_buf_ring_add(u->br,
+		rte_pktmbuf_mtod(mbuf, char *) - sizeof(struct tun_pi),
+		mbuf->buf_len - rte_pktmbuf_headroom(mbuf) +
+			sizeof(struct tun_pi),
+		bid, io_uring_buf_ring_mask(u->nb_bufs), offset);
+}
+
+static void
+tap_uring_rx_arm(struct tap_uring_rxq *u)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = io_uring_get_sqe(&u->ring);
+	if (sqe == NULL)
+		return;
+	io_uring_prep_read_multishot(sqe, u->fd, 0, -1, TAP_URING_BGID);
+	if (io_uring_submit(&u->ring) == 1)
+		u->armed = true;
+}
+
+int
+tap_uring_rxq_setup(struct rx_queue *rxq, int fd, uint16_t nb_desc,
+		unsigned int socket_id)
+{
+	struct io_uring_probe *probe;
+	struct tap_uring_rxq *u;
+	unsigned int nb_bufs, i;
+	bool supported;
+	int ret;
+
+	probe = io_uring_get_probe();
+	supported = probe != NULL &&
+		io_uring_opcode_supported(probe, IORING_OP_READ_MULTISHOT);
+	io_uring_free_probe(probe);
+	if (!supported) {
+		TAP_LOG(ERR, "io_uring multishot read is not supported by the kernel");
+		return -ENOTSUP;
+	}
+
+	if (RTE_PKTMBUF_HEADROOM < sizeof(struct tun_pi)) {
+		TAP_LOG(ERR, "mbuf headroom too small for packet info");
+		return -EINVAL;
+	}
+
+	nb_bufs = RTE_MIN(rte_align32prevpow2(RTE_MAX(nb_desc, 1)),
+		TAP_URING_RX_MAX_BUFS);
+	u = rte_zmalloc_socket("tap_uring_rxq",
+		sizeof(*u) + nb_bufs * sizeof(u->mbufs[0]), 0, socket_id);
+	if (u == NULL)
+		return -ENOMEM;
+	u->fd = fd;
+	u->nb_bufs = nb_bufs;
+
+	ret = tap_uring_init(&u->ring, 8, nb_bufs);
+	if (ret < 0) {
+		TAP_LOG(ERR, "io_uring setup failed: %s", strerror(-ret));
+		goto free_u;
+	}
+
+	u->br = io_uring_setup_buf_ring(&u->ring, nb_bufs, TAP_URING_BGID,
+		0, &ret);
+	if (u->br == NULL) {
+		TAP_LOG(ERR, "io_uring buffer ring setup failed: %s",
+			strerror(-ret));
+		goto exit_ring;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(rxq->mp, u->mbufs, nb_bufs) != 0) {
+		TAP_LOG(ERR, "couldn't allocate %u mbufs", nb_bufs);
+		ret = -ENOMEM;
+		goto free_br;
+	}
+	for (i = 0; i < nb_bufs; i++)
+		tap_uring_rx_buf_add(u, u->mbufs[i], i, i);
+	io_uring_buf_ring_advance(u->br, nb_bufs);
+
+	/* The read is armed by the first Rx burst: with COOP_TASKRUN,
+	 * its completions are only posted while the submitting thread
+	 * enters the kernel, which must then be the polling thread.
+	 */
+	rxq->uring = u;
+	return 0;
+
+free_br:
+	io_uring_free_buf_ring(&u->ring, u->br, nb_bufs, TAP_URING_BGID);
+exit_ring:
+	io_uring_queue_exit(&u->ring);
+free_u:
+	rte_free(u);
+	return ret;
+}
+
+void
+tap_uring_rxq_release(struct rx_queue *rxq)
+{
+	struct tap_uring_rxq *u = rxq->uring;
+
+	if (u == NULL)
+		return;
+
+	/* cancel the read before giving its buffers back */
+	io_uring_queue_exit(&u->ring);
+	rte_pktmbuf_free_bulk(u->mbufs, u->nb_bufs);
+	rte_free(u);
+	rxq->uring = NULL;
+}
+
+uint16_t
+tap_uring_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct rx_queue *rxq = queue;
+	struct tap_uring_rxq *u = rxq->uring;
+	struct io_uring_cqe *cqes[nb_pkts];
+	struct rte_mbuf *mbuf, *new;
+	struct tun_pi *pi;
+	unsigned int nb_cqes, i;
+	uint16_t num_rx = 0;
+	unsigned long num_rx_bytes = 0;
+	int refill = 0;
+	uint16_t bid;
+	int len;
+
+	nb_cqes = io_uring_peek_batch_cqe(&u->ring, cqes, nb_pkts);
+	for (i = 0; i < nb_cqes; i++) {
+		if (!(cqes[i]->flags & IORING_CQE_F_MORE))
+			u->armed = false;
+		if (!(cqes[i]->flags & IORING_CQE_F_BUFFER)) {
+			/* out of buffers or error, the read is re-armed below */
+			if (cqes[i]->res != -ENOBUFS)
+				rxq->stats.ierrors++;
+			continue;
+		}
+
+		bid = cqes[i]->flags >> IORING_CQE_BUFFER_SHIFT;
+		mbuf = u->mbufs[bid];
+		len = cqes[i]->res;
+
+		/* replace the buffer, or recycle it and drop the packet */
+		new = rte_pktmbuf_alloc(rxq->mp);
+		if (unlikely(new == NULL)) {
+			rxq->stats.rx_nombuf++;
+			tap_uring_rx_buf_add(u, mbuf, bid, refill++);
+			continue;
+		}
+		u->mbufs[bid] = new;
+		tap_uring_rx_buf_add(u, new, bid, refill++);
+
+		/* Packet couldn't fit in the provided mbuf */
+		pi = rte_pktmbuf_mtod_offset(mbuf, struct tun_pi *,
+			-(int)sizeof(*pi));
+		if (unlikely(len < (int)sizeof(*pi) ||
+				(pi->flags & TUN_PKT_STRIP))) {
+			rxq->stats.ierrors++;
+			rte_pktmbuf_free(mbuf);
+			continue;
+		}
+
+		len -= sizeof(*pi);
+		mbuf->pkt_len = len;
+		mbuf->data_len = len;
+		mbuf->port = rxq->in_port;
+		mbuf->packet_type = rte_net_get_ptype(mbuf, NULL,
+						      RTE_PTYPE_ALL_MASK);
+		if (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM)
+			tap_verify_csum(mbuf);
+
+		/* account for the receive frame */
+		bufs[num_rx++] = mbuf;
+		num_rx_bytes += len;
+	}
+	io_uring_cq_advance(&u->ring, nb_cqes);
+	if (refill != 0)
+		io_uring_buf_ring_advance(u->br, refill);
+	if (unlikely(!u->armed))
+		tap_uring_rx_arm(u);
+
+	rxq->stats.ipackets += num_rx;
+	rxq->stats.ibytes += num_rx_bytes;
+	return num_rx;
+}
+
+int
+tap_uring_txq_setup(struct tx_queue *txq, int fd, unsigned int socket_id)
+{
+	struct tap_uring_txq *u;
+	unsigned int i;
+	int ret;
+
+	u = rte_zmalloc_socket("tap_uring_txq", sizeof(*u), 0, socket_id);
+	if (u == NULL)
+		return -ENOMEM;
+	u->fd = fd;
+
+	ret = tap_uring_init(&u->ring, TAP_URING_TX_SLOTS, 0);
+	if (ret < 0) {
+		TAP_LOG(ERR, "io_uring setup failed: %s", strerror(-ret));
+		rte_free(u);
+		return ret;
+	}
+
+	for (i = 0; i < TAP_URING_TX_SLOTS; i++)
+		u->free[i] = i;
+	u->nb_free = TAP_URING_TX_SLOTS;
+
+	txq->uring = u;
+	return 0;
+}
+
+void
+tap_uring_txq_release(struct tx_queue *txq)
+{
+	struct tap_uring_txq *u = txq->uring;
+	unsigned int i;
+
+	if (u == NULL)
+		return;
+
+	/* wait for the writes in flight before freeing their mbufs */
+	io_uring_queue_exit(&u->ring);
+	for (i = 0; i < TAP_URING_TX_SLOTS; i++)
+		rte_pktmbuf_free(u->slots[i].mbuf);
+	rte_free(u);
+	txq->uring = NULL;
+}
+
+/* free the mbufs of the completed writes */
+static void
+tap_uring_tx_complete(struct tx_queue *txq)
+{
+	struct tap_uring_txq *u = txq->uring;
+	struct tap_uring_tx_slot *slot;
+	struct io_uring_cqe *cqe;
+	unsigned int head, count = 0;
+	uint16_t id;
+
+	io_uring_for_each_cqe(&u->ring, head, cqe) {
+		id = io_uring_cqe_get_data64(cqe);
+		slot = &u->slots[id];
+		if (cqe->res < 0) {
+			txq->stats.errs++;
+		} else {
+			txq->stats.opackets++;
+			txq->stats.obytes += rte_pktmbuf_pkt_len(slot->mbuf);
+		}
+		rte_pktmbuf_free(slot->mbuf);
+		slot->mbuf = NULL;
+		u->free[u->nb_free++] = id;
+		count++;
+	}
+	io_uring_cq_advance(&u->ring, count);
+}
+
+uint16_t
+tap_uring_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct tx_queue *txq = queue;
+	struct tap_uring_txq *u = txq->uring;
+	struct tap_uring_tx_slot *slot;
+	struct io_uring_sqe *sqe;
+	uint32_t max_size;
+	uint16_t num_tx;
+	uint16_t id;
+	int n;
+
+	if (unlikely(nb_pkts == 0))
+		return 0;
+
+	/* make room for this burst */
+	if (u->nb_free < nb_pkts) {
+		if (io_uring_cq_ready(&u->ring) == 0)
+			io_uring_get_events(&u->ring);
+		tap_uring_tx_complete(txq);
+	}
+
+	max_size = *txq->mtu + (RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN + 4);
+	for (num_tx = 0; num_tx < nb_pkts && u->nb_free != 0; num_tx++) {
+		if (rte_pktmbuf_pkt_len(bufs[num_tx]) > max_size ||
+				bufs[num_tx]->nb_segs + 2 > TAP_URING_TX_MAX_IOV) {
+			txq->stats.errs++;
+			break;
+		}
+
+		id = u->free[u->nb_free - 1];
+		slot = &u->slots[id];
+		n = tap_tx_prepare(txq, &bufs[num_tx], &slot->pi, slot->iov);
+		if (n < 0) {
+			txq->stats.errs++;
+			break;
+		}
+
+		/* SQ and slots have the same size, an SQE is always free */
+		sqe = io_uring_get_sqe(&u->ring);
+		io_uring_prep_writev(sqe, u->fd, slot->iov, n, -1);
+		io_uring_sqe_set_data64(sqe, id);
+		slot->mbuf = bufs[num_tx];
+		u->nb_free--;
+	}
+
+	/* the writes to a tap complete inline, reap them right away */
+	if (num_tx != 0)
+		io_uring_submit(&u->ring);
+	tap_uring_tx_complete(txq);
+
+	return num_tx;
+}
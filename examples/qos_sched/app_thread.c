@@ -58,11 +58,38 @@ get_pkt_sched(struct rte_mbuf *m, uint32_t *subport, uint32_t *pipe,
 	return 0;
 }
 
+/* Send each packet to the scheduler lane owning its subport */
+static inline void
+app_rx_dispatch_lanes(struct thread_conf *conf, struct rte_mbuf **mbufs,
+		const uint32_t *subports, uint32_t nb_rx)
+{
+	struct rte_mbuf *lane_mbufs[MAX_SCHED_LANES][nb_rx];
+	uint32_t nb_lane[MAX_SCHED_LANES] = {0};
+	uint32_t i, lane;
+
+	for (i = 0; i < nb_rx; i++) {
+		lane = conf->subport_lane[subports[i]];
+		lane_mbufs[lane][nb_lane[lane]++] = mbufs[i];
+	}
+
+	for (lane = 0; lane < conf->n_lanes; lane++) {
+		if (nb_lane[lane] == 0)
+			continue;
+
+		if (unlikely(rte_ring_sp_enqueue_bulk(conf->lane_rings[lane],
+				(void **)lane_mbufs[lane], nb_lane[lane], NULL) == 0)) {
+			rte_pktmbuf_free_bulk(lane_mbufs[lane], nb_lane[lane]);
+			APP_STATS_ADD(conf->stat.nb_drop, nb_lane[lane]);
+		}
+	}
+}
+
 void
 app_rx_thread(struct thread_conf **confs)
 {
 	uint32_t i, nb_rx;
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_mbuf *rx_mbufs[burst_conf.rx_burst];
+	uint32_t rx_subports[burst_conf.rx_burst];
 	struct thread_conf *conf;
 	int conf_idx = 0;
 
@@ -87,9 +114,13 @@ app_rx_thread(struct thread_conf **confs)
 						subport, pipe,
 						traffic_class, queue,
 						(enum rte_color) color);
+				rx_subports[i] = subport;
 			}
 
-			if (unlikely(rte_ring_sp_enqueue_bulk(conf->rx_ring,
+			if (conf->n_lanes != 0)
+				app_rx_dispatch_lanes(conf, rx_mbufs,
+						rx_subports, nb_rx);
+			else if (unlikely(rte_ring_sp_enqueue_bulk(conf->rx_ring,
 					(void **)rx_mbufs, nb_rx, NULL) == 0)) {
 				for(i = 0; i < nb_rx; i++) {
 					rte_pktmbuf_free(rx_mbufs[i]);
@@ -198,3 +229,43 @@ app_mixed_thread(struct thread_conf **confs)
 			conf_idx = 0;
 	}
 }
+
+
+/*
+ * Scheduler lane of a flow scheduled by several lcores. The packets of
+ * all lanes are merged by the TX thread, which polls the single-producer
+ * single-consumer TX ring of each lane in turn.
+ */
+void
+app_lane_thread(struct thread_conf **confs)
+{
+	struct rte_mbuf *mbufs[burst_conf.ring_burst];
+	struct thread_conf *conf;
+	int conf_idx = 0;
+
+	while ((conf = confs[conf_idx])) {
+		uint32_t nb_pkt;
+
+		/* Read packet from the ring */
+		nb_pkt = rte_ring_sc_dequeue_burst(conf->rx_ring, (void **)mbufs,
+					burst_conf.ring_burst, NULL);
+		if (likely(nb_pkt)) {
+			int nb_sent = rte_sched_lane_enqueue(conf->sched_lane, mbufs,
+					nb_pkt);
+
+			APP_STATS_ADD(conf->stat.nb_drop, nb_pkt - nb_sent);
+			APP_STATS_ADD(conf->stat.nb_rx, nb_pkt);
+		}
+
+		nb_pkt = rte_sched_lane_dequeue(conf->sched_lane, mbufs,
+					burst_conf.qos_dequeue);
+		if (likely(nb_pkt > 0))
+			while (rte_ring_sp_enqueue_bulk(conf->tx_ring,
+					(void **)mbufs, nb_pkt, NULL) == 0)
+				; /* empty body */
+
+		conf_idx++;
+		if (confs[conf_idx] == NULL)
+			conf_idx = 0;
+	}
+}
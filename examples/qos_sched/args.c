@@ -65,6 +65,9 @@ static const char usage[] =
 	"           B = TX host threshold (default value is %u)                         \n"
 	"           C = TX write-back threshold (default value is %u)                   \n"
 	"    --cfg FILE : profile configuration to load                                 \n"
+	"    --mwt \"PFC, LCORE, ...\" : Multi-core scheduling of packet flow PFC       \n"
+	"           (index from 0 in --pfc order), the subports are split between the   \n"
+	"           WT lcore and the additional LCOREs, which needs a TX lcore          \n"
 ;
 
 /* display usage */
@@ -230,6 +233,38 @@ app_parse_flow_conf(const char *conf_str)
 	return 0;
 }
 
+static int
+app_parse_mwt_conf(const char *conf_str)
+{
+	int ret, i;
+	uint32_t vals[MAX_OPT_VALUES];
+	struct flow_conf *pconf;
+
+	ret = app_parse_opt_vals(conf_str, ',', MAX_OPT_VALUES, vals);
+	if (ret < 2 || ret > MAX_SCHED_LANES)
+		return -1;
+
+	if (vals[0] >= nb_pfc) {
+		RTE_LOG(ERR, APP, "mwt: invalid pfc %u index\n", vals[0]);
+		return -1;
+	}
+
+	pconf = &qos_conf[vals[0]];
+	if (pconf->n_lanes != 0) {
+		RTE_LOG(ERR, APP, "pfc %u: multi-core scheduling configured already\n",
+				vals[0]);
+		return -1;
+	}
+
+	/* lane 0 runs on the WT lcore */
+	pconf->lane_core[0] = pconf->wt_core;
+	for (i = 1; i < ret; i++)
+		pconf->lane_core[i] = vals[i];
+	pconf->n_lanes = ret;
+
+	return 0;
+}
+
 static int
 app_parse_burst_conf(const char *conf_str)
 {
@@ -265,6 +300,8 @@ enum {
 	OPT_TTH_NUM,
 #define OPT_CFG "cfg"
 	OPT_CFG_NUM,
+#define OPT_MWT "mwt"
+	OPT_MWT_NUM,
 };
 
 /*
@@ -277,7 +314,7 @@ app_parse_args(int argc, char **argv)
 	int opt, ret;
 	int option_index;
 	char *prgname = argv[0];
-	uint32_t i;
+	uint32_t i, j;
 
 	static struct option lgopts[] = {
 		{OPT_PFC, 1, NULL, OPT_PFC_NUM},
@@ -288,6 +325,7 @@ app_parse_args(int argc, char **argv)
 		{OPT_RTH, 1, NULL, OPT_RTH_NUM},
 		{OPT_TTH, 1, NULL, OPT_TTH_NUM},
 		{OPT_CFG, 1, NULL, OPT_CFG_NUM},
+		{OPT_MWT, 1, NULL, OPT_MWT_NUM},
 		{NULL,    0, 0,    0          }
 	};
 
@@ -374,6 +412,15 @@ app_parse_args(int argc, char **argv)
 				cfg_profile = optarg;
 				break;
 
+			case OPT_MWT_NUM:
+				ret = app_parse_mwt_conf(optarg);
+				if (ret) {
+					RTE_LOG(ERR, APP, "Invalid multi-core scheduling configuration %s\n",
+							optarg);
+					return -1;
+				}
+				break;
+
 			default:
 				app_usage(prgname);
 				return -1;
@@ -405,6 +452,33 @@ app_parse_args(int argc, char **argv)
 			return -1;
 		}
 		app_numa_mask |= 1 << rte_lcore_to_socket_id(qos_conf[i].rx_core);
+
+		if (qos_conf[i].n_lanes != 0 &&
+				qos_conf[i].tx_core == qos_conf[i].wt_core) {
+			RTE_LOG(ERR, APP, "pfc %u: multi-core scheduling needs a TX lcore\n",
+					i + 1);
+			return -1;
+		}
+		for (j = 1; j < qos_conf[i].n_lanes; j++) {
+			uint32_t lane_core = qos_conf[i].lane_core[j];
+
+			if (lane_core >= RTE_MAX_LCORE) {
+				RTE_LOG(ERR, APP, "pfc %u: invalid lane lcore index %u\n",
+						i + 1, lane_core);
+				return -1;
+			}
+			if (lane_core == qos_conf[i].rx_core ||
+					lane_core == qos_conf[i].tx_core) {
+				RTE_LOG(ERR, APP, "pfc %u: lane lcore %u is used by RX or TX\n",
+						i + 1, lane_core);
+				return -1;
+			}
+			if (rte_lcore_to_socket_id(lane_core) != wt_sock) {
+				RTE_LOG(ERR, APP, "pfc %u: WT and lanes must be on the same socket\n",
+						i + 1);
+				return -1;
+			}
+		}
 	}
 
 	return 0;
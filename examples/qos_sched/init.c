@@ -286,6 +286,51 @@ app_init_sched_port(uint32_t portid, uint32_t socketid)
 	return port;
 }
 
+/* Split the subports of the flow between its scheduler lanes */
+static void
+app_init_sched_lanes(uint32_t pfc, struct flow_conf *flow, uint32_t socketid)
+{
+	char ring_name[MAX_NAME_LEN];
+	uint32_t n_subports = port_params.n_subports_per_port;
+	uint32_t lane, first, last, subport;
+
+	if (flow->n_lanes > n_subports)
+		rte_exit(EXIT_FAILURE, "pfc %u: %u lanes for %u subports\n",
+			pfc, flow->n_lanes, n_subports);
+
+	for (lane = 0; lane < flow->n_lanes; lane++) {
+		first = lane * n_subports / flow->n_lanes;
+		last = (lane + 1) * n_subports / flow->n_lanes;
+
+		flow->sched_lane[lane] = rte_sched_lane_create(flow->sched_port,
+				first, last - first);
+		if (flow->sched_lane[lane] == NULL)
+			rte_exit(EXIT_FAILURE, "Unable to create sched lane %u\n",
+				lane);
+
+		for (subport = first; subport < last; subport++)
+			flow->subport_lane[subport] = lane;
+
+		snprintf(ring_name, MAX_NAME_LEN, "lane-rx-%u-%u", pfc, lane);
+		flow->lane_rx_ring[lane] = rte_ring_create(ring_name,
+			ring_conf.ring_size, socketid,
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+
+		snprintf(ring_name, MAX_NAME_LEN, "lane-tx-%u-%u", pfc, lane);
+		flow->lane_tx_ring[lane] = rte_ring_create(ring_name,
+			ring_conf.ring_size, socketid,
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+
+		if (flow->lane_rx_ring[lane] == NULL ||
+				flow->lane_tx_ring[lane] == NULL)
+			rte_exit(EXIT_FAILURE, "Cannot create rings for sched lane %u\n",
+				lane);
+
+		RTE_LOG(INFO, APP, "pfc %u: lane %u on lcore %u schedules subports %u-%u\n",
+			pfc, lane, flow->lane_core[lane], first, last - 1);
+	}
+}
+
 static int
 app_load_cfg_profile(const char *profile)
 {
@@ -386,6 +431,8 @@ int app_init(void)
 		}
 
 		qos_conf[i].sched_port = app_init_sched_port(qos_conf[i].tx_port, socket);
+		if (qos_conf[i].n_lanes != 0)
+			app_init_sched_lanes(i, &qos_conf[i], socket);
 	}
 
 	RTE_LOG(INFO, APP, "time stamp clock running at %" PRIu64 " Hz\n",
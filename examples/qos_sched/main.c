@@ -22,6 +22,7 @@
 #define APP_RX_MODE   1
 #define APP_WT_MODE   2
 #define APP_TX_MODE   4
+#define APP_LANE_MODE 8
 
 uint8_t interactive = APP_INTERACTIVE_DEFAULT;
 uint32_t qavg_period = APP_QAVG_PERIOD;
@@ -36,13 +37,16 @@ app_main_loop(__rte_unused void *dummy)
 	uint32_t rx_idx = 0;
 	uint32_t wt_idx = 0;
 	uint32_t tx_idx = 0;
+	uint32_t lane_idx = 0;
 	struct thread_conf *rx_confs[MAX_DATA_STREAMS];
 	struct thread_conf *wt_confs[MAX_DATA_STREAMS];
 	struct thread_conf *tx_confs[MAX_DATA_STREAMS];
+	struct thread_conf *lane_confs[MAX_DATA_STREAMS];
 
 	memset(rx_confs, 0, sizeof(rx_confs));
 	memset(wt_confs, 0, sizeof(wt_confs));
 	memset(tx_confs, 0, sizeof(tx_confs));
+	memset(lane_confs, 0, sizeof(lane_confs));
 
 
 	mode = APP_MODE_NONE;
@@ -56,11 +60,45 @@ app_main_loop(__rte_unused void *dummy)
 			flow->rx_thread.rx_ring =  flow->rx_ring;
 			flow->rx_thread.rx_queue = flow->rx_queue;
 			flow->rx_thread.sched_port = flow->sched_port;
+			flow->rx_thread.n_lanes = flow->n_lanes;
+			flow->rx_thread.lane_rings = flow->lane_rx_ring;
+			flow->rx_thread.subport_lane = flow->subport_lane;
 
 			rx_confs[rx_idx++] = &flow->rx_thread;
 
 			mode |= APP_RX_MODE;
 		}
+		if (flow->n_lanes != 0) {
+			uint32_t lane;
+
+			for (lane = 0; lane < flow->n_lanes; lane++) {
+				struct thread_conf *lane_tx = &flow->lane_tx_thread[lane];
+				struct thread_conf *lane_wt = &flow->lane_thread[lane];
+
+				/* TX thread merges the output of all lanes */
+				if (flow->tx_core == lcore_id) {
+					lane_tx->tx_port = flow->tx_port;
+					lane_tx->tx_ring = flow->lane_tx_ring[lane];
+					lane_tx->tx_queue = flow->tx_queue;
+
+					tx_confs[tx_idx++] = lane_tx;
+
+					mode |= APP_TX_MODE;
+				}
+				if (flow->lane_core[lane] == lcore_id) {
+					lane_wt->rx_ring = flow->lane_rx_ring[lane];
+					lane_wt->tx_ring = flow->lane_tx_ring[lane];
+					lane_wt->tx_port = flow->tx_port;
+					lane_wt->sched_port = flow->sched_port;
+					lane_wt->sched_lane = flow->sched_lane[lane];
+
+					lane_confs[lane_idx++] = lane_wt;
+
+					mode |= APP_LANE_MODE;
+				}
+			}
+			continue;
+		}
 		if (flow->tx_core == lcore_id) {
 			flow->tx_thread.tx_port = flow->tx_port;
 			flow->tx_thread.tx_ring =  flow->tx_ring;
@@ -93,6 +131,12 @@ app_main_loop(__rte_unused void *dummy)
 		return -1;
 	}
 
+	if ((mode & APP_LANE_MODE) && mode != APP_LANE_MODE) {
+		RTE_LOG(INFO, APP, "lcore %u was configured for both scheduler lanes and other threads !!!\n",
+				 lcore_id);
+		return -1;
+	}
+
 	RTE_LOG(INFO, APP, "entering main loop on lcore %u\n", lcore_id);
 	/* initialize mbuf memory */
 	if (mode == APP_RX_MODE) {
@@ -127,6 +171,13 @@ app_main_loop(__rte_unused void *dummy)
 
 		app_worker_thread(wt_confs);
 	}
+	else if (mode == APP_LANE_MODE) {
+		for (i = 0; i < lane_idx; i++) {
+			RTE_LOG(INFO, APP, "lane %u lcoreid %u scheduling\n", i, lcore_id);
+		}
+
+		app_lane_thread(lane_confs);
+	}
 
 	return 0;
 }
@@ -160,6 +211,17 @@ app_stat(void)
 		memcpy(&tx_stats[i], &stats, sizeof(stats));
 
 #if APP_COLLECT_STAT
+		uint32_t j;
+
+		/* scheduler lanes add up to the worker thread */
+		for (j = 0; j < flow->n_lanes; j++) {
+			struct thread_stat *lane_stat = &flow->lane_thread[j].stat;
+
+			flow->wt_thread.stat.nb_rx += lane_stat->nb_rx;
+			flow->wt_thread.stat.nb_drop += lane_stat->nb_drop;
+			memset(lane_stat, 0, sizeof(struct thread_stat));
+		}
+
 		printf("-------+------------+------------+\n");
 		printf("       |  received  |   dropped  |\n");
 		printf("-------+------------+------------+\n");
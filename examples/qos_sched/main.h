@@ -42,6 +42,7 @@ extern "C" {
 #define MAX_SCHED_PIPES		4096
 #define MAX_SCHED_PIPE_PROFILES		256
 #define MAX_SCHED_SUBPORT_PROFILES	8
+#define MAX_SCHED_LANES		8
 
 #ifndef APP_COLLECT_STAT
 #define APP_COLLECT_STAT		1
@@ -72,6 +73,12 @@ struct __rte_cache_aligned thread_conf
 	struct rte_ring *rx_ring;
 	struct rte_ring *tx_ring;
 	struct rte_sched_port *sched_port;
+	struct rte_sched_lane *sched_lane;
+
+	/* RX dispatch to the scheduler lanes of the flow */
+	uint32_t n_lanes;
+	struct rte_ring **lane_rings;
+	const uint8_t *subport_lane;
 
 #if APP_COLLECT_STAT
 	struct thread_stat stat;
@@ -96,6 +103,16 @@ struct flow_conf
 	struct thread_conf rx_thread;
 	struct thread_conf wt_thread;
 	struct thread_conf tx_thread;
+
+	/* Multi-core scheduling, lane 0 runs on the WT lcore */
+	uint32_t n_lanes;
+	uint32_t lane_core[MAX_SCHED_LANES];
+	uint8_t subport_lane[MAX_SCHED_SUBPORTS];
+	struct rte_ring *lane_rx_ring[MAX_SCHED_LANES];
+	struct rte_ring *lane_tx_ring[MAX_SCHED_LANES];
+	struct rte_sched_lane *sched_lane[MAX_SCHED_LANES];
+	struct thread_conf lane_thread[MAX_SCHED_LANES];
+	struct thread_conf lane_tx_thread[MAX_SCHED_LANES];
 };
 
 
@@ -150,6 +167,7 @@ void app_rx_thread(struct thread_conf **qconf);
 void app_tx_thread(struct thread_conf **qconf);
 void app_worker_thread(struct thread_conf **qconf);
 void app_mixed_thread(struct thread_conf **qconf);
+void app_lane_thread(struct thread_conf **qconf);
 
 void app_stat(void);
 int subport_stat(uint16_t port_id, uint32_t subport_id);
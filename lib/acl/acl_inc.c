@@ -0,0 +1,438 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <eal_export.h>
+#include <rte_acl.h>
+#include <rte_stdatomic.h>
+
+#include "acl.h"
+#include "acl_log.h"
+
+/* max number of input buffers classified per sub-context call */
+#define ACL_INC_BURST	64
+
+/* rule storage slot which doesn't hold a rule */
+#define ACL_INC_SLOT_FREE	UINT32_MAX
+
+/*
+ * Built sub-context.
+ * It is never modified once visible to classification: userdata of the
+ * rules in the ACL context is replaced by an index into rd[],
+ * which keeps the original priority and userdata of each rule.
+ */
+struct acl_inc_shard {
+	struct rte_acl_ctx *ctx;
+	uint32_t gen;
+	uint32_t num_rules;
+	struct rte_acl_rule_data rd[];
+};
+
+struct rte_acl_inc {
+	char name[RTE_ACL_NAMESIZE];
+	int32_t socket_id;
+	uint32_t rule_sz;
+	uint32_t max_rules;
+	uint32_t num_rules;
+	uint32_t num_shards;
+	uint64_t dirty;         /* mask of shards with pending updates */
+	struct rte_rcu_qsbr *v;
+	struct rte_acl_config cfg;
+	uint32_t shard_rules[RTE_ACL_INC_MAX_SHARDS];
+	RTE_ATOMIC(struct acl_inc_shard *) shard[RTE_ACL_INC_MAX_SHARDS];
+	uint32_t *free_slots;   /* stack of free rule slots */
+	uint32_t num_free;
+	uint32_t *slot_shard;   /* owner shard of each rule slot */
+	uint8_t *rules;         /* rule slots */
+};
+
+static inline struct rte_acl_rule *
+acl_inc_rule(const struct rte_acl_inc *inc, uint32_t slot)
+{
+	return (struct rte_acl_rule *)(inc->rules + (size_t)slot * inc->rule_sz);
+}
+
+static void
+acl_inc_shard_free(struct acl_inc_shard *sh)
+{
+	if (sh == NULL)
+		return;
+	rte_acl_free(sh->ctx);
+	rte_free(sh);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_free, 25.07)
+void
+rte_acl_inc_free(struct rte_acl_inc *inc)
+{
+	uint32_t i;
+
+	if (inc == NULL)
+		return;
+
+	for (i = 0; i != inc->num_shards; i++)
+		acl_inc_shard_free(rte_atomic_load_explicit(&inc->shard[i],
+			rte_memory_order_relaxed));
+	rte_free(inc);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_create, 25.07)
+struct rte_acl_inc *
+rte_acl_inc_create(const struct rte_acl_inc_param *param)
+{
+	struct rte_acl_inc *inc;
+	uint32_t i;
+	size_t sz;
+
+	/* leave room for "_<shard>_<gen>" in the sub-context names */
+	if (param == NULL || param->name == NULL || param->cfg == NULL ||
+			strnlen(param->name, RTE_ACL_NAMESIZE) >
+				RTE_ACL_NAMESIZE - 7 ||
+			param->rule_size == 0 || param->max_rule_num == 0 ||
+			param->num_shards == 0 ||
+			param->num_shards > RTE_ACL_INC_MAX_SHARDS) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	sz = sizeof(*inc) +
+		(size_t)param->max_rule_num * 2 * sizeof(uint32_t) +
+		(size_t)param->max_rule_num * param->rule_size;
+
+	inc = rte_zmalloc_socket(param->name, sz, RTE_CACHE_LINE_SIZE,
+		param->socket_id);
+	if (inc == NULL) {
+		ACL_LOG(ERR, "allocation of %zu bytes on socket %d for %s failed",
+			sz, param->socket_id, param->name);
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(inc->name, param->name, sizeof(inc->name));
+	inc->socket_id = param->socket_id;
+	inc->rule_sz = param->rule_size;
+	inc->max_rules = param->max_rule_num;
+	inc->num_shards = param->num_shards;
+	inc->cfg = *param->cfg;
+	inc->free_slots = (uint32_t *)(inc + 1);
+	inc->slot_shard = inc->free_slots + inc->max_rules;
+	inc->rules = (uint8_t *)(inc->slot_shard + inc->max_rules);
+
+	/* lowest slots are handed out first */
+	for (i = 0; i != inc->max_rules; i++) {
+		inc->free_slots[i] = inc->max_rules - i - 1;
+		inc->slot_shard[i] = ACL_INC_SLOT_FREE;
+	}
+	inc->num_free = inc->max_rules;
+
+	return inc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_rcu_qsbr_add, 25.07)
+int
+rte_acl_inc_rcu_qsbr_add(struct rte_acl_inc *inc, struct rte_rcu_qsbr *v)
+{
+	if (inc == NULL || v == NULL)
+		return -EINVAL;
+	if (inc->v != NULL)
+		return -EEXIST;
+
+	inc->v = v;
+	return 0;
+}
+
+/*
+ * New rules go to the sub-context with the least rules,
+ * so that each rebuild handles about max_rules / num_shards rules.
+ */
+static uint32_t
+acl_inc_pick_shard(const struct rte_acl_inc *inc)
+{
+	uint32_t i, s;
+
+	s = 0;
+	for (i = 1; i != inc->num_shards; i++) {
+		if (inc->shard_rules[i] < inc->shard_rules[s])
+			s = i;
+	}
+	return s;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_add_rules, 25.07)
+int
+rte_acl_inc_add_rules(struct rte_acl_inc *inc,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	const struct rte_acl_rule *rv;
+	uint32_t i, s, slot;
+	int32_t rc;
+
+	if (inc == NULL || rules == NULL)
+		return -EINVAL;
+
+	for (i = 0; i != num; i++) {
+		rv = (const struct rte_acl_rule *)
+			((uintptr_t)rules + i * inc->rule_sz);
+		rc = acl_check_rule(&rv->data);
+		if (rc != 0) {
+			ACL_LOG(ERR, "%s(%s): rule #%u is invalid",
+				__func__, inc->name, i + 1);
+			return rc;
+		}
+	}
+
+	if (num > inc->num_free)
+		return -ENOMEM;
+
+	for (i = 0; i != num; i++) {
+		rv = (const struct rte_acl_rule *)
+			((uintptr_t)rules + i * inc->rule_sz);
+		slot = inc->free_slots[--inc->num_free];
+		s = acl_inc_pick_shard(inc);
+
+		memcpy(acl_inc_rule(inc, slot), rv, inc->rule_sz);
+		inc->slot_shard[slot] = s;
+		inc->shard_rules[s]++;
+		inc->dirty |= RTE_BIT64(s);
+	}
+
+	inc->num_rules += num;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_del_rules, 25.07)
+int
+rte_acl_inc_del_rules(struct rte_acl_inc *inc,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	const struct rte_acl_rule *rv;
+	uint32_t i, s, slot;
+	int32_t rc;
+
+	if (inc == NULL || rules == NULL)
+		return -EINVAL;
+
+	rc = 0;
+	for (i = 0; i != num; i++) {
+		rv = (const struct rte_acl_rule *)
+			((uintptr_t)rules + i * inc->rule_sz);
+
+		for (slot = 0; slot != inc->max_rules; slot++) {
+			if (inc->slot_shard[slot] != ACL_INC_SLOT_FREE &&
+					memcmp(acl_inc_rule(inc, slot), rv,
+						inc->rule_sz) == 0)
+				break;
+		}
+
+		if (slot == inc->max_rules) {
+			rc = -ENOENT;
+			continue;
+		}
+
+		s = inc->slot_shard[slot];
+		inc->slot_shard[slot] = ACL_INC_SLOT_FREE;
+		inc->free_slots[inc->num_free++] = slot;
+		inc->shard_rules[s]--;
+		inc->num_rules--;
+		inc->dirty |= RTE_BIT64(s);
+	}
+
+	return rc;
+}
+
+/*
+ * Build a new version of the given sub-context from the rules it owns.
+ */
+static int
+acl_inc_build_shard(const struct rte_acl_inc *inc, uint32_t s,
+	struct acl_inc_shard **shard)
+{
+	struct acl_inc_shard *old, *sh;
+	struct rte_acl_param prm;
+	struct rte_acl_rule *rv;
+	char name[RTE_ACL_NAMESIZE];
+	uint32_t n, slot;
+	int32_t rc;
+
+	*shard = NULL;
+	if (inc->shard_rules[s] == 0)
+		return 0;
+
+	sh = rte_zmalloc_socket(NULL,
+		sizeof(*sh) + inc->shard_rules[s] * sizeof(sh->rd[0]),
+		RTE_CACHE_LINE_SIZE, inc->socket_id);
+	if (sh == NULL)
+		return -ENOMEM;
+
+	/* alternate names, as the previous version is still alive */
+	old = rte_atomic_load_explicit(&inc->shard[s],
+		rte_memory_order_relaxed);
+	sh->gen = (old == NULL) ? 0 : old->gen + 1;
+	snprintf(name, sizeof(name), "%s_%u_%u", inc->name, s, sh->gen & 1);
+
+	prm.name = name;
+	prm.socket_id = inc->socket_id;
+	prm.rule_size = inc->rule_sz;
+	prm.max_rule_num = inc->shard_rules[s];
+
+	sh->ctx = rte_acl_create(&prm);
+	if (sh->ctx == NULL) {
+		rte_free(sh);
+		return -ENOMEM;
+	}
+
+	/* rules were validated when added, copy them in directly */
+	n = 0;
+	for (slot = 0; slot != inc->max_rules; slot++) {
+		if (inc->slot_shard[slot] != s)
+			continue;
+
+		rv = (struct rte_acl_rule *)((uintptr_t)sh->ctx->rules +
+			n * sh->ctx->rule_sz);
+		memcpy(rv, acl_inc_rule(inc, slot), inc->rule_sz);
+		sh->rd[n] = rv->data;
+		rv->data.userdata = ++n;
+	}
+	sh->ctx->num_rules = n;
+	sh->num_rules = n;
+
+	rc = rte_acl_build(sh->ctx, &inc->cfg);
+	if (rc != 0) {
+		ACL_LOG(ERR, "%s(%s): build of sub-context %u failed: %d",
+			__func__, inc->name, s, rc);
+		acl_inc_shard_free(sh);
+		return rc;
+	}
+
+	*shard = sh;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_commit, 25.07)
+int
+rte_acl_inc_commit(struct rte_acl_inc *inc)
+{
+	struct acl_inc_shard *old[RTE_ACL_INC_MAX_SHARDS];
+	struct acl_inc_shard *sh;
+	uint64_t dirty, done;
+	uint32_t s;
+	int32_t rc;
+
+	if (inc == NULL)
+		return -EINVAL;
+
+	rc = 0;
+	done = 0;
+	dirty = inc->dirty;
+
+	while (dirty != 0) {
+		s = rte_ctz64(dirty);
+		dirty &= ~RTE_BIT64(s);
+
+		rc = acl_inc_build_shard(inc, s, &sh);
+		if (rc != 0)
+			break;
+
+		old[s] = rte_atomic_load_explicit(&inc->shard[s],
+			rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&inc->shard[s], sh,
+			rte_memory_order_release);
+		done |= RTE_BIT64(s);
+	}
+
+	inc->dirty &= ~done;
+	if (done == 0)
+		return rc;
+
+	/* wait until no reader can see the replaced sub-contexts */
+	if (inc->v != NULL)
+		rte_rcu_qsbr_synchronize(inc->v, RTE_QSBR_THRID_INVALID);
+
+	while (done != 0) {
+		s = rte_ctz64(done);
+		done &= ~RTE_BIT64(s);
+		acl_inc_shard_free(old[s]);
+	}
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_classify, 25.07)
+int
+rte_acl_inc_classify(const struct rte_acl_inc *inc, const uint8_t **data,
+	uint32_t *results, uint32_t num, uint32_t categories)
+{
+	uint32_t res[ACL_INC_BURST * RTE_ACL_MAX_CATEGORIES];
+	int32_t prio[ACL_INC_BURST * RTE_ACL_MAX_CATEGORIES];
+	const struct rte_acl_rule_data *rd;
+	const struct acl_inc_shard *sh;
+	uint32_t i, j, k, n, s;
+	uint32_t *out;
+	int32_t rc;
+
+	if (inc == NULL || data == NULL || results == NULL ||
+			categories == 0 || categories > RTE_ACL_MAX_CATEGORIES)
+		return -EINVAL;
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, (uint32_t)ACL_INC_BURST);
+		k = n * categories;
+		out = results + i * categories;
+
+		memset(out, 0, k * sizeof(out[0]));
+		memset(prio, 0, k * sizeof(prio[0]));
+
+		/* keep the highest priority match among all sub-contexts */
+		for (s = 0; s != inc->num_shards; s++) {
+			sh = rte_atomic_load_explicit(&inc->shard[s],
+				rte_memory_order_acquire);
+			if (sh == NULL)
+				continue;
+
+			rc = rte_acl_classify(sh->ctx, data + i, res, n,
+				categories);
+			if (rc != 0)
+				return rc;
+
+			for (j = 0; j != k; j++) {
+				if (res[j] == 0)
+					continue;
+				rd = &sh->rd[res[j] - 1];
+				if (rd->priority > prio[j]) {
+					prio[j] = rd->priority;
+					out[j] = rd->userdata;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_inc_get_stats, 25.07)
+int
+rte_acl_inc_get_stats(const struct rte_acl_inc *inc,
+	struct rte_acl_inc_stats *stats)
+{
+	const struct acl_inc_shard *sh;
+	uint32_t s;
+
+	if (inc == NULL || stats == NULL)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->num_rules = inc->num_rules;
+	stats->num_shards = inc->num_shards;
+	stats->num_dirty = rte_popcount64(inc->dirty);
+
+	for (s = 0; s != inc->num_shards; s++) {
+		sh = rte_atomic_load_explicit(&inc->shard[s],
+			rte_memory_order_relaxed);
+		if (sh == NULL)
+			continue;
+		stats->num_built++;
+		stats->mem_size += sh->ctx->mem_sz;
+	}
+
+	return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <rte_common.h>
 #include <rte_acl_osdep.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -359,6 +360,199 @@ rte_acl_dump(const struct rte_acl_ctx *ctx);
 void
 rte_acl_list_dump(void);
 
+/** Max number of independently built sub-contexts of an incremental ACL. */
+#define RTE_ACL_INC_MAX_SHARDS	64
+
+/**
+ * Parameters used when creating an incremental ACL object.
+ */
+struct rte_acl_inc_param {
+	const char *name;         /**< Name of the incremental ACL object. */
+	int         socket_id;    /**< Socket ID to allocate memory for. */
+	uint32_t    rule_size;    /**< Size of each rule. */
+	uint32_t    max_rule_num; /**< Maximum number of rules. */
+	uint32_t    num_shards;
+	/**< Number of sub-contexts the rules are spread over. */
+	const struct rte_acl_config *cfg;
+	/**< Build configuration used for all the sub-contexts. */
+};
+
+/**
+ * Statistics of an incremental ACL object.
+ */
+struct rte_acl_inc_stats {
+	uint32_t num_rules;  /**< Number of rules, including uncommitted ones. */
+	uint32_t num_shards; /**< Number of sub-contexts. */
+	uint32_t num_built;  /**< Number of sub-contexts with built tries. */
+	uint32_t num_dirty;  /**< Number of sub-contexts with pending updates. */
+	size_t   mem_size;   /**< Run-time memory used by all sub-contexts. */
+};
+
+/** @internal opaque incremental ACL handle */
+struct rte_acl_inc;
+
+/**
+ * De-allocate all memory used by an incremental ACL object.
+ *
+ * @param inc
+ *   Incremental ACL object to free.
+ *   If inc is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_acl_inc_free(struct rte_acl_inc *inc);
+
+/**
+ * Create a new incremental ACL object.
+ *
+ * Rules of an incremental ACL object are spread over *num_shards*
+ * independent ACL contexts. When rules are added or deleted,
+ * rte_acl_inc_commit() rebuilds only the contexts which own these rules,
+ * while the tries of all other contexts are kept as they are.
+ * Classification runs all the contexts and returns the highest
+ * priority match, so more shards mean faster updates but slower lookups.
+ *
+ * @param param
+ *   Parameters used to create and initialise the incremental ACL object.
+ * @return
+ *   Pointer to incremental ACL object, or NULL on error,
+ *   with error code set in rte_errno.
+ *   Possible rte_errno errors include:
+ *   - EINVAL - invalid parameter passed to function
+ *   - ENOMEM - memory allocation failure
+ */
+__rte_experimental
+struct rte_acl_inc *
+rte_acl_inc_create(const struct rte_acl_inc_param *param)
+	__rte_malloc __rte_dealloc(rte_acl_inc_free, 1);
+
+/**
+ * Associate RCU QSBR variable with an incremental ACL object.
+ * Once associated, rte_acl_inc_commit() waits for the readers to report
+ * a quiescent state before it frees replaced sub-contexts.
+ * Without RCU QSBR variable, the application must ensure that no
+ * classification is in progress while rte_acl_inc_commit() runs.
+ *
+ * @param inc
+ *   Incremental ACL object.
+ * @param v
+ *   RCU QSBR variable used by the classifying threads.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -EEXIST if a RCU QSBR variable is already associated.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_inc_rcu_qsbr_add(struct rte_acl_inc *inc, struct rte_rcu_qsbr *v);
+
+/**
+ * Add rules to an incremental ACL object.
+ * Rules become visible to classification after rte_acl_inc_commit().
+ * This function is not multi-thread safe with regard to other updates.
+ *
+ * @param inc
+ *   Incremental ACL object to add rules to.
+ * @param rules
+ *   Array of rules to add, in the format described for rte_acl_add_rules().
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -ENOMEM if there is no space in the object for these rules.
+ *   - -EINVAL if the parameters are invalid.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_inc_add_rules(struct rte_acl_inc *inc,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * Delete rules from an incremental ACL object.
+ * A rule is deleted if it is identical, byte for byte and including its
+ * rte_acl_rule_data, to one of the input rules.
+ * Rules stop being visible to classification after rte_acl_inc_commit().
+ * This function is not multi-thread safe with regard to other updates.
+ *
+ * @param inc
+ *   Incremental ACL object to delete rules from.
+ * @param rules
+ *   Array of rules to delete.
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOENT if at least one rule was not found,
+ *     all the rules which were found are deleted.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_inc_del_rules(struct rte_acl_inc *inc,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * Rebuild the sub-contexts modified since the last commit and make them
+ * visible to classification.
+ * Classification can run concurrently: each sub-context is replaced
+ * atomically and the old one is freed after a RCU grace period.
+ * If the rebuild of a sub-context fails, it keeps its previous tries and
+ * its updates stay pending for the next commit.
+ * This function is not multi-thread safe with regard to other updates.
+ *
+ * @param inc
+ *   Incremental ACL object to commit.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - Negative error code returned by rte_acl_build() on failure.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_inc_commit(struct rte_acl_inc *inc);
+
+/**
+ * Perform search for a matching rule of an incremental ACL object
+ * for each input data buffer.
+ * Semantics of the parameters are the same as for rte_acl_classify().
+ * This function is multi-thread safe with regard to rte_acl_inc_commit()
+ * when a RCU QSBR variable is associated to the object.
+ *
+ * @param inc
+ *   Incremental ACL object to search with.
+ * @param data
+ *   Array of pointers to input data buffers to perform search.
+ * @param results
+ *   Array of search results, *categories* results per each input data buffer.
+ * @param num
+ *   Number of elements in the input data buffers array.
+ * @param categories
+ *   Number of maximum possible matches for each input buffer.
+ * @return
+ *   zero on successful completion.
+ *   -EINVAL for incorrect arguments.
+ */
+__rte_experimental
+int
+rte_acl_inc_classify(const struct rte_acl_inc *inc, const uint8_t **data,
+	uint32_t *results, uint32_t num, uint32_t categories);
+
+/**
+ * Retrieve statistics of an incremental ACL object.
+ *
+ * @param inc
+ *   Incremental ACL object.
+ * @param stats
+ *   Pointer to the structure to fill.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_inc_get_stats(const struct rte_acl_inc *inc,
+	struct rte_acl_inc_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
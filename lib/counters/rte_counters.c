@@ -0,0 +1,297 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/queue.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_lcore_var.h>
+#include <rte_log.h>
+#include <rte_spinlock.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+
+#include "rte_counters.h"
+
+RTE_LOG_REGISTER_DEFAULT(counters_logtype, INFO);
+#define RTE_LOGTYPE_COUNTERS counters_logtype
+#define COUNTERS_LOG(level, ...) \
+	RTE_LOG_LINE(level, COUNTERS, "" __VA_ARGS__)
+
+/* private part of a counter set */
+struct counters_set {
+	struct rte_counters pub;
+	TAILQ_ENTRY(counters_set) next;
+	char name[RTE_COUNTERS_NAMESIZE];
+	/* values at the last reset */
+	uint64_t *offset;
+	char (*names)[RTE_COUNTERS_NAMESIZE];
+};
+
+static TAILQ_HEAD(, counters_set) counters_list =
+	TAILQ_HEAD_INITIALIZER(counters_list);
+
+/* protects the list, and the allocation of lcore variables in create */
+static rte_spinlock_t counters_lock = RTE_SPINLOCK_INITIALIZER;
+
+/*
+ * The lcore variable allocator aborts when it runs out of memory.
+ * The counter sets are carved out of a single lcore variable, allocated
+ * with the first set, so that running out of space is an error.
+ */
+#define COUNTERS_LCORE_VAR_SIZE (RTE_MAX_LCORE_VAR / 4)
+#define COUNTERS_MAX (COUNTERS_LCORE_VAR_SIZE / sizeof(uint64_t))
+
+static RTE_LCORE_VAR_HANDLE(uint64_t, counters_values);
+static unsigned int counters_used;
+
+static struct counters_set *
+counters_set(struct rte_counters *c)
+{
+	return container_of(c, struct counters_set, pub);
+}
+
+static const struct counters_set *
+counters_set_const(const struct rte_counters *c)
+{
+	return container_of(c, const struct counters_set, pub);
+}
+
+static struct counters_set *
+counters_find(const char *name)
+{
+	struct counters_set *s;
+
+	TAILQ_FOREACH(s, &counters_list, next)
+		if (strcmp(s->name, name) == 0)
+			return s;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_create, 25.07)
+struct rte_counters *
+rte_counters_create(const char *name, const char * const names[],
+	unsigned int nb_counters)
+{
+	struct counters_set *s;
+	unsigned int i;
+
+	if (name == NULL || names == NULL || nb_counters == 0 ||
+			strnlen(name, RTE_COUNTERS_NAMESIZE) ==
+				RTE_COUNTERS_NAMESIZE ||
+			nb_counters > COUNTERS_MAX) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	for (i = 0; i < nb_counters; i++) {
+		if (names[i] == NULL || strnlen(names[i],
+				RTE_COUNTERS_NAMESIZE) == RTE_COUNTERS_NAMESIZE) {
+			rte_errno = EINVAL;
+			return NULL;
+		}
+	}
+
+	s = calloc(1, sizeof(*s));
+	if (s == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+	s->pub.shared = calloc(nb_counters, sizeof(*s->pub.shared));
+	s->offset = calloc(nb_counters, sizeof(*s->offset));
+	s->names = calloc(nb_counters, sizeof(*s->names));
+	if (s->pub.shared == NULL || s->offset == NULL || s->names == NULL) {
+		rte_errno = ENOMEM;
+		goto error;
+	}
+	s->pub.nb_counters = nb_counters;
+	strlcpy(s->name, name, sizeof(s->name));
+	for (i = 0; i < nb_counters; i++)
+		strlcpy(s->names[i], names[i], sizeof(s->names[i]));
+
+	rte_spinlock_lock(&counters_lock);
+	if (counters_find(name) != NULL) {
+		rte_spinlock_unlock(&counters_lock);
+		rte_errno = EEXIST;
+		goto error;
+	}
+	/* lcore variables are never freed, take space once the name is free */
+	if (nb_counters > COUNTERS_MAX - counters_used) {
+		rte_spinlock_unlock(&counters_lock);
+		COUNTERS_LOG(ERR, "no space left for %u counters, %u used of %zu",
+			nb_counters, counters_used, COUNTERS_MAX);
+		rte_errno = ENOMEM;
+		goto error;
+	}
+	if (counters_values == NULL)
+		RTE_LCORE_VAR_ALLOC_SIZE_ALIGN(counters_values,
+			COUNTERS_LCORE_VAR_SIZE, RTE_CACHE_LINE_SIZE);
+	/* the values of all lcores are at the same offset in the variable */
+	s->pub.values = (void *)(counters_values + counters_used);
+	counters_used += nb_counters;
+	TAILQ_INSERT_TAIL(&counters_list, s, next);
+	rte_spinlock_unlock(&counters_lock);
+
+	COUNTERS_LOG(DEBUG, "created counter set %s with %u counters",
+		name, nb_counters);
+	return &s->pub;
+
+error:
+	free(s->names);
+	free(s->offset);
+	free(s->pub.shared);
+	free(s);
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_lookup, 25.07)
+struct rte_counters *
+rte_counters_lookup(const char *name)
+{
+	struct counters_set *s;
+
+	if (name == NULL)
+		return NULL;
+
+	rte_spinlock_lock(&counters_lock);
+	s = counters_find(name);
+	rte_spinlock_unlock(&counters_lock);
+
+	return s != NULL ? &s->pub : NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_count, 25.07)
+unsigned int
+rte_counters_count(const struct rte_counters *c)
+{
+	return c->nb_counters;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_name, 25.07)
+const char *
+rte_counters_name(const struct rte_counters *c, unsigned int id)
+{
+	if (id >= c->nb_counters)
+		return NULL;
+	return counters_set_const(c)->names[id];
+}
+
+/* sum of the lcore and shared instances, without the reset offset */
+static uint64_t
+counters_sum(const struct rte_counters *c, unsigned int id)
+{
+	RTE_ATOMIC(uint64_t) *v;
+	unsigned int lcore_id;
+	uint64_t sum;
+
+	sum = rte_atomic_load_explicit(&c->shared[id],
+		rte_memory_order_relaxed);
+	RTE_LCORE_VAR_FOREACH(lcore_id, v, c->values)
+		sum += rte_atomic_load_explicit(&v[id],
+			rte_memory_order_relaxed);
+	return sum;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_read, 25.07)
+uint64_t
+rte_counters_read(const struct rte_counters *c, unsigned int id)
+{
+	if (id >= c->nb_counters)
+		return 0;
+	return counters_sum(c, id) - counters_set_const(c)->offset[id];
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_read_all, 25.07)
+int
+rte_counters_read_all(const struct rte_counters *c, uint64_t values[],
+	unsigned int n)
+{
+	const struct counters_set *s;
+	RTE_ATOMIC(uint64_t) *v;
+	unsigned int lcore_id, i;
+
+	if (c == NULL || values == NULL)
+		return -EINVAL;
+
+	s = counters_set_const(c);
+	n = RTE_MIN(n, c->nb_counters);
+	for (i = 0; i < n; i++)
+		values[i] = rte_atomic_load_explicit(&c->shared[i],
+			rte_memory_order_relaxed) - s->offset[i];
+
+	/* walk each lcore instance once, in memory order */
+	RTE_LCORE_VAR_FOREACH(lcore_id, v, c->values)
+		for (i = 0; i < n; i++)
+			values[i] += rte_atomic_load_explicit(&v[i],
+				rte_memory_order_relaxed);
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_counters_reset, 25.07)
+void
+rte_counters_reset(struct rte_counters *c)
+{
+	struct counters_set *s = counters_set(c);
+	unsigned int i;
+
+	for (i = 0; i < c->nb_counters; i++)
+		s->offset[i] = counters_sum(c, i);
+}
+
+#define COUNTERS_LIST_REQ	"/counters/list"
+#define COUNTERS_INFO_REQ	"/counters/info"
+
+static int
+counters_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	struct counters_set *s;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	rte_spinlock_lock(&counters_lock);
+	TAILQ_FOREACH(s, &counters_list, next)
+		rte_tel_data_add_array_string(d, s->name);
+	rte_spinlock_unlock(&counters_lock);
+	return 0;
+}
+
+static int
+counters_handle_info(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_counters *c;
+	struct counters_set *s;
+	uint64_t *values;
+	unsigned int i;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	c = rte_counters_lookup(params);
+	if (c == NULL)
+		return -EINVAL;
+	s = counters_set(c);
+
+	values = malloc(c->nb_counters * sizeof(*values));
+	if (values == NULL)
+		return -ENOMEM;
+	rte_counters_read_all(c, values, c->nb_counters);
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < c->nb_counters; i++)
+		rte_tel_data_add_dict_uint(d, s->names[i], values[i]);
+	free(values);
+	return 0;
+}
+
+RTE_INIT(counters_telemetry)
+{
+	rte_telemetry_register_cmd(COUNTERS_LIST_REQ, counters_handle_list,
+		"Returns list of counter sets. Takes no parameters");
+	rte_telemetry_register_cmd(COUNTERS_INFO_REQ, counters_handle_info,
+		"Returns counters of a counter set, summed over all lcores. Parameters: counter set name");
+}
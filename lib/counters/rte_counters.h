@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_COUNTERS_H_
+#define _RTE_COUNTERS_H_
+
+/**
+ * @file
+ * RTE per-lcore statistics counters
+ *
+ * A counter set is a named array of 64-bit counters, with one instance
+ * of the array per lcore id, stored in an lcore variable.
+ * Each lcore updates its own instance with plain loads and stores,
+ * without atomic operations nor sharing of cache lines with other lcores.
+ * Reading a counter sums the instances of all lcores.
+ *
+ * Threads without lcore id update a shared instance with atomic operations.
+ *
+ * The counter sets are local to a process. They are never freed,
+ * like the lcore variables they are stored in.
+ * Their values are returned by the telemetry command /counters/info.
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_debug.h>
+#include <rte_lcore.h>
+#include <rte_lcore_var.h>
+#include <rte_stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum length of the name of a counter set or of a counter. */
+#define RTE_COUNTERS_NAMESIZE 64
+
+/**
+ * A counter set.
+ *
+ * The structure is public for the inline functions only,
+ * its fields must not be accessed directly.
+ */
+struct rte_counters {
+	/** lcore variable of the counters */
+	RTE_LCORE_VAR_HANDLE(RTE_ATOMIC(uint64_t), values);
+	/** counters of the threads without lcore id */
+	RTE_ATOMIC(uint64_t) *shared;
+	/** number of counters */
+	unsigned int nb_counters;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a counter set, with all counters at zero.
+ *
+ * This function is not multi-thread safe with the allocation of lcore
+ * variables, and is expected to be called at initialization.
+ *
+ * @param name
+ *   The name of the counter set.
+ * @param names
+ *   The names of the counters, nb_counters entries.
+ * @param nb_counters
+ *   The number of counters.
+ * @return
+ *   The counter set, or NULL on error with rte_errno set:
+ *   - EINVAL: invalid parameter
+ *   - EEXIST: a counter set with the same name exists
+ *   - ENOMEM: not enough memory, or no space left for the counters
+ */
+__rte_experimental
+struct rte_counters *
+rte_counters_create(const char *name, const char * const names[],
+	unsigned int nb_counters);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Look up a counter set by its name.
+ *
+ * @param name
+ *   The name of the counter set.
+ * @return
+ *   The counter set, or NULL if not found.
+ */
+__rte_experimental
+struct rte_counters *
+rte_counters_lookup(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the number of counters of a counter set.
+ *
+ * @param c
+ *   The counter set.
+ * @return
+ *   The number of counters.
+ */
+__rte_experimental
+unsigned int
+rte_counters_count(const struct rte_counters *c);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the name of a counter.
+ *
+ * @param c
+ *   The counter set.
+ * @param id
+ *   The index of the counter.
+ * @return
+ *   The name of the counter, or NULL if id is invalid.
+ */
+__rte_experimental
+const char *
+rte_counters_name(const struct rte_counters *c, unsigned int id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add a value to a counter.
+ *
+ * On a thread with an lcore id, the counter instance of the lcore is
+ * updated without atomic operation, so the function must not be called
+ * by two threads with the same lcore id at the same time.
+ *
+ * @param c
+ *   The counter set.
+ * @param id
+ *   The index of the counter.
+ * @param val
+ *   The value to add.
+ */
+__rte_experimental
+static inline void
+rte_counters_add(struct rte_counters *c, unsigned int id, uint64_t val)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	RTE_ATOMIC(uint64_t) *v;
+
+	RTE_ASSERT(id < c->nb_counters);
+
+	if (unlikely(lcore_id == LCORE_ID_ANY)) {
+		rte_atomic_fetch_add_explicit(&c->shared[id], val,
+			rte_memory_order_relaxed);
+		return;
+	}
+
+	/* single writer: a plain load and store, atomic for the readers */
+	v = RTE_LCORE_VAR_LCORE(lcore_id, c->values);
+	rte_atomic_store_explicit(&v[id],
+		rte_atomic_load_explicit(&v[id], rte_memory_order_relaxed) +
+		val, rte_memory_order_relaxed);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Increment a counter.
+ *
+ * @see rte_counters_add()
+ *
+ * @param c
+ *   The counter set.
+ * @param id
+ *   The index of the counter.
+ */
+__rte_experimental
+static inline void
+rte_counters_inc(struct rte_counters *c, unsigned int id)
+{
+	rte_counters_add(c, id, 1);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Read a counter, summed over all lcores.
+ *
+ * The counters may be updated while they are read.
+ *
+ * @param c
+ *   The counter set.
+ * @param id
+ *   The index of the counter.
+ * @return
+ *   The value of the counter since its creation or last reset,
+ *   0 if id is invalid.
+ */
+__rte_experimental
+uint64_t
+rte_counters_read(const struct rte_counters *c, unsigned int id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Read all counters of a counter set, summed over all lcores.
+ *
+ * @param c
+ *   The counter set.
+ * @param values
+ *   The array of values to fill.
+ * @param n
+ *   The size of the array.
+ * @return
+ *   The number of values filled, at most n,
+ *   or a negative errno value on error.
+ */
+__rte_experimental
+int
+rte_counters_read_all(const struct rte_counters *c, uint64_t values[],
+	unsigned int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset all counters of a counter set.
+ *
+ * The values of the lcores are not modified, the current sums become
+ * the new zero of the counters. The reset must not be called concurrently
+ * with reads.
+ *
+ * @param c
+ *   The counter set.
+ */
+__rte_experimental
+void
+rte_counters_reset(struct rte_counters *c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_COUNTERS_H_ */
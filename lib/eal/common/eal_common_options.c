@@ -107,6 +107,8 @@ eal_long_options[] = {
 	{OPT_NO_TELEMETRY,      0, NULL, OPT_NO_TELEMETRY_NUM     },
 	{OPT_FORCE_MAX_SIMD_BITWIDTH, 1, NULL, OPT_FORCE_MAX_SIMD_BITWIDTH_NUM},
 	{OPT_HUGE_WORKER_STACK, 2, NULL, OPT_HUGE_WORKER_STACK_NUM     },
+	{OPT_HUGE_PREFAULT_THREADS, 1, NULL, OPT_HUGE_PREFAULT_THREADS_NUM},
+	{OPT_HUGE_ZERO_RESERVE, 1, NULL, OPT_HUGE_ZERO_RESERVE_NUM},
 
 	{0,                     0, NULL, 0                        }
 };
@@ -370,6 +372,8 @@ eal_reset_internal_config(struct internal_config *internal_cfg)
 	internal_cfg->init_complete = 0;
 	internal_cfg->max_simd_bitwidth.bitwidth = RTE_VECT_DEFAULT_SIMD_BITWIDTH;
 	internal_cfg->max_simd_bitwidth.forced = 0;
+	internal_cfg->huge_prefault_threads = 0;
+	internal_cfg->zero_reserve = 0;
 }
 
 static int
@@ -22,6 +22,7 @@
 #include "eal_private.h"
 #include "eal_thread.h"
 #include "eal_trace.h"
+#include "malloc_cache.h"
 
 RTE_EXPORT_SYMBOL(per_lcore__lcore_id)
 RTE_DEFINE_PER_LCORE(unsigned int, _lcore_id) = LCORE_ID_ANY;
@@ -408,8 +409,10 @@ rte_thread_unregister(void)
 {
 	unsigned int lcore_id = rte_lcore_id();
 
-	if (lcore_id != LCORE_ID_ANY)
+	if (lcore_id != LCORE_ID_ANY) {
+		malloc_cache_flush();
 		eal_lcore_non_eal_release(lcore_id);
+	}
 	__rte_thread_uninit();
 	if (lcore_id != LCORE_ID_ANY)
 		EAL_LOG(DEBUG, "Unregistered non-EAL thread (was lcore %u).",
@@ -102,6 +102,10 @@ struct internal_config {
 	struct simd_bitwidth max_simd_bitwidth;
 	/**< max simd bitwidth path to use */
 	size_t huge_worker_stack_size; /**< worker thread stack size */
+	/** threads mapping hugepages at init, 0 for one per CPU of the socket */
+	unsigned int huge_prefault_threads;
+	/** freed memory cleared in background and kept per heap, 0 to disable */
+	size_t zero_reserve;
 };
 
 void eal_reset_internal_config(struct internal_config *internal_cfg);
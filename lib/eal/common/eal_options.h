@@ -93,6 +93,10 @@ enum {
 	OPT_FORCE_MAX_SIMD_BITWIDTH_NUM,
 #define OPT_HUGE_WORKER_STACK  "huge-worker-stack"
 	OPT_HUGE_WORKER_STACK_NUM,
+#define OPT_HUGE_PREFAULT_THREADS "huge-prefault-threads"
+	OPT_HUGE_PREFAULT_THREADS_NUM,
+#define OPT_HUGE_ZERO_RESERVE "huge-zero-reserve"
+	OPT_HUGE_ZERO_RESERVE_NUM,
 
 	OPT_LONG_MAX_NUM
 };
@@ -0,0 +1,350 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_eal_memconfig.h>
+#include <rte_lcore.h>
+#include <rte_lcore_var.h>
+#include <rte_malloc.h>
+#include <rte_stdatomic.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <rte_telemetry.h>
+#endif
+
+#include <eal_export.h>
+#include "eal_memcfg.h"
+#include "eal_private.h"
+#include "malloc_cache.h"
+#include "malloc_elem.h"
+#include "malloc_heap.h"
+
+/* size classes are powers of 2, from 64 bytes to 4 KB */
+#define MALLOC_CACHE_MIN_SHIFT	6
+#define MALLOC_CACHE_MAX_SHIFT	12
+#define MALLOC_CACHE_NB_CLASSES \
+	(MALLOC_CACHE_MAX_SHIFT - MALLOC_CACHE_MIN_SHIFT + 1)
+
+/* elements cached per class and lcore, moved to or from the heap by half */
+#define MALLOC_CACHE_SIZE	32
+#define MALLOC_CACHE_BATCH	(MALLOC_CACHE_SIZE / 2)
+
+struct malloc_cache_class {
+	uint32_t len;
+	void *objs[MALLOC_CACHE_SIZE];
+	uint64_t hits;    /**< allocations served by the cache */
+	uint64_t misses;  /**< allocations served by the heap */
+	uint64_t refills; /**< batches taken from the heap */
+	uint64_t flushes; /**< batches given back to the heap */
+};
+
+struct malloc_cache {
+	/** heap of the cached elements, the first one used by the lcore */
+	struct malloc_heap *heap;
+	struct malloc_cache_class cls[MALLOC_CACHE_NB_CLASSES];
+};
+
+static RTE_LCORE_VAR_HANDLE(struct malloc_cache, malloc_caches);
+static RTE_ATOMIC(bool) cache_enabled;
+
+bool
+malloc_cache_enabled(void)
+{
+	return rte_atomic_load_explicit(&cache_enabled,
+			rte_memory_order_relaxed);
+}
+
+static inline size_t
+class_size(unsigned int c)
+{
+	return (size_t)1 << (c + MALLOC_CACHE_MIN_SHIFT);
+}
+
+/* smallest class holding size bytes */
+static inline int
+class_of_size(size_t size)
+{
+	if (size > class_size(MALLOC_CACHE_NB_CLASSES - 1))
+		return -1;
+	if (size <= class_size(0))
+		return 0;
+	return rte_log2_u64(size) - MALLOC_CACHE_MIN_SHIFT;
+}
+
+/* biggest class fitting in an element of len bytes, if not too wasteful */
+static inline int
+class_of_len(size_t len)
+{
+	int c;
+
+	if (len < class_size(0))
+		return -1;
+	c = (63 - rte_clz64(len)) - MALLOC_CACHE_MIN_SHIFT;
+	return c < MALLOC_CACHE_NB_CLASSES ? c : -1;
+}
+
+static void
+cache_flush_class(struct malloc_cache_class *cls, uint32_t n)
+{
+	uint32_t i;
+
+	for (i = 0; i != n; i++)
+		if (malloc_heap_free(malloc_elem_from_data(cls->objs[i])) < 0)
+			EAL_LOG(ERR, "Error: Invalid cached memory");
+
+	/* keep the most recently freed elements */
+	cls->len -= n;
+	memmove(cls->objs, cls->objs + n, cls->len * sizeof(cls->objs[0]));
+	cls->flushes++;
+}
+
+/* bind the cache to the heap of the first allocation of the lcore */
+static int
+cache_set_heap(struct malloc_cache *cache, int socket)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	int heap_id;
+
+	if (socket == SOCKET_ID_ANY)
+		socket = malloc_get_numa_socket();
+	heap_id = malloc_socket_to_heap_id(socket);
+	if (heap_id < 0)
+		return -1;
+	cache->heap = &mcfg->malloc_heaps[heap_id];
+	return 0;
+}
+
+static uint32_t
+cache_refill_class(struct malloc_cache *cache, unsigned int c)
+{
+	struct malloc_cache_class *cls = &cache->cls[c];
+
+	cls->len = malloc_heap_alloc_bulk(cache->heap, class_size(c),
+			RTE_CACHE_LINE_SIZE, cls->objs, MALLOC_CACHE_BATCH);
+	if (cls->len != 0)
+		cls->refills++;
+	return cls->len;
+}
+
+void *
+malloc_cache_alloc(size_t size, unsigned int align, int socket)
+{
+	struct malloc_cache *cache;
+	struct malloc_cache_class *cls;
+	int c;
+
+	if (align > RTE_CACHE_LINE_SIZE || rte_lcore_id() == LCORE_ID_ANY)
+		return NULL;
+
+	c = class_of_size(size);
+	if (c < 0)
+		return NULL;
+
+	cache = RTE_LCORE_VAR(malloc_caches);
+	if (cache->heap == NULL && cache_set_heap(cache, socket) < 0)
+		return NULL;
+	if (socket != SOCKET_ID_ANY &&
+			(unsigned int)socket != cache->heap->socket_id)
+		return NULL;
+
+	cls = &cache->cls[c];
+	if (cls->len == 0 && cache_refill_class(cache, c) == 0) {
+		cls->misses++;
+		return NULL;
+	}
+
+	cls->hits++;
+	return cls->objs[--cls->len];
+}
+
+int
+malloc_cache_free(void *addr)
+{
+	struct malloc_elem *elem = malloc_elem_from_data(addr);
+	struct malloc_cache *cache;
+	struct malloc_cache_class *cls;
+	size_t len;
+	int c;
+
+	if (!malloc_elem_cookies_ok(elem) || elem->state != ELEM_BUSY)
+		return -1;
+
+	if (rte_lcore_id() == LCORE_ID_ANY)
+		return 1;
+
+	cache = RTE_LCORE_VAR(malloc_caches);
+	if (elem->heap != cache->heap)
+		return 1;
+
+	len = elem->size - elem->pad - MALLOC_ELEM_OVERHEAD;
+	c = class_of_len(len);
+	if (c < 0)
+		return 1;
+
+	cls = &cache->cls[c];
+	if (cls->len == MALLOC_CACHE_SIZE)
+		cache_flush_class(cls, MALLOC_CACHE_BATCH);
+
+	/* the element is not zeroed, rte_zmalloc() has to clear it */
+	elem->dirty = 1;
+	cls->objs[cls->len++] = addr;
+	return 0;
+}
+
+void
+malloc_cache_flush(void)
+{
+	struct malloc_cache *cache;
+	unsigned int c;
+
+	if (malloc_caches == NULL || rte_lcore_id() == LCORE_ID_ANY)
+		return;
+
+	cache = RTE_LCORE_VAR(malloc_caches);
+	for (c = 0; c != MALLOC_CACHE_NB_CLASSES; c++)
+		if (cache->cls[c].len != 0)
+			cache_flush_class(&cache->cls[c], cache->cls[c].len);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_malloc_cache_enable, 25.07)
+int
+rte_malloc_cache_enable(void)
+{
+#ifdef RTE_MALLOC_ASAN
+	/* cached elements would keep the shadow of their previous allocation */
+	return -ENOTSUP;
+#else
+	if (malloc_caches == NULL)
+		RTE_LCORE_VAR_ALLOC(malloc_caches);
+
+	rte_atomic_store_explicit(&cache_enabled, true,
+			rte_memory_order_relaxed);
+	return 0;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_malloc_cache_disable, 25.07)
+void
+rte_malloc_cache_disable(void)
+{
+	rte_atomic_store_explicit(&cache_enabled, false,
+			rte_memory_order_relaxed);
+	malloc_cache_flush();
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_malloc_cache_flush, 25.07)
+void
+rte_malloc_cache_flush(void)
+{
+	malloc_cache_flush();
+}
+
+#ifndef RTE_EXEC_ENV_WINDOWS
+
+#define EAL_MALLOC_CACHE_REQ	"/eal/malloc_cache"
+
+static void
+malloc_cache_telemetry_classes(struct rte_tel_data *d)
+{
+	struct malloc_cache_class sum[MALLOC_CACHE_NB_CLASSES];
+	struct malloc_cache *cache;
+	struct rte_tel_data *cd;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	unsigned int lcore_id, c;
+
+	memset(sum, 0, sizeof(sum));
+	RTE_LCORE_VAR_FOREACH(lcore_id, cache, malloc_caches) {
+		for (c = 0; c != MALLOC_CACHE_NB_CLASSES; c++) {
+			sum[c].len += cache->cls[c].len;
+			sum[c].hits += cache->cls[c].hits;
+			sum[c].misses += cache->cls[c].misses;
+			sum[c].refills += cache->cls[c].refills;
+			sum[c].flushes += cache->cls[c].flushes;
+		}
+	}
+
+	for (c = 0; c != MALLOC_CACHE_NB_CLASSES; c++) {
+		cd = rte_tel_data_alloc();
+		if (cd == NULL)
+			return;
+		rte_tel_data_start_dict(cd);
+		rte_tel_data_add_dict_uint(cd, "cached", sum[c].len);
+		rte_tel_data_add_dict_uint(cd, "cached_size",
+				sum[c].len * class_size(c));
+		rte_tel_data_add_dict_uint(cd, "hits", sum[c].hits);
+		rte_tel_data_add_dict_uint(cd, "misses", sum[c].misses);
+		rte_tel_data_add_dict_uint(cd, "refills", sum[c].refills);
+		rte_tel_data_add_dict_uint(cd, "flushes", sum[c].flushes);
+		snprintf(name, sizeof(name), "class_%zu", class_size(c));
+		rte_tel_data_add_dict_container(d, name, cd, 0);
+	}
+}
+
+/*
+ * Fragmentation of a heap is the share of its free memory that is not
+ * in its biggest free element, in percent.
+ */
+static void
+malloc_cache_telemetry_heaps(struct rte_tel_data *d)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	struct rte_malloc_socket_stats stats;
+	struct malloc_heap *heap;
+	struct rte_tel_data *hd;
+	unsigned int heap_id;
+	uint64_t frag;
+
+	/* external heaps are not cached */
+	for (heap_id = 0; heap_id < rte_socket_count(); heap_id++) {
+		heap = &mcfg->malloc_heaps[heap_id];
+		if (malloc_heap_get_stats(heap, &stats) != 0 ||
+				stats.heap_totalsz_bytes == 0)
+			continue;
+
+		frag = stats.heap_freesz_bytes == 0 ? 0 :
+			100 - (uint64_t)stats.greatest_free_size * 100 /
+				stats.heap_freesz_bytes;
+
+		hd = rte_tel_data_alloc();
+		if (hd == NULL)
+			return;
+		rte_tel_data_start_dict(hd);
+		rte_tel_data_add_dict_uint(hd, "Free_size",
+				stats.heap_freesz_bytes);
+		rte_tel_data_add_dict_uint(hd, "Greatest_free_size",
+				stats.greatest_free_size);
+		rte_tel_data_add_dict_uint(hd, "Free_count", stats.free_count);
+		rte_tel_data_add_dict_uint(hd, "Alloc_count", stats.alloc_count);
+		rte_tel_data_add_dict_uint(hd, "Fragmentation", frag);
+		rte_tel_data_add_dict_container(d, heap->name, hd, 0);
+	}
+}
+
+/* Telemetry callback handler to return the malloc cache and heap usage. */
+static int
+handle_eal_malloc_cache_request(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "enabled", malloc_cache_enabled());
+	if (malloc_caches != NULL)
+		malloc_cache_telemetry_classes(d);
+	malloc_cache_telemetry_heaps(d);
+	return 0;
+}
+
+RTE_INIT(malloc_cache_telemetry)
+{
+	rte_telemetry_register_cmd(EAL_MALLOC_CACHE_REQ,
+			handle_eal_malloc_cache_request,
+			"Returns malloc cache usage per size class and heap fragmentation. Takes no parameters");
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
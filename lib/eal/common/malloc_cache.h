@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef MALLOC_CACHE_H_
+#define MALLOC_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Per-lcore front end of the malloc heaps for small allocations.
+ *
+ * When enabled, each lcore keeps a stack of allocated elements for each
+ * size class, from 64 bytes to 4 KB. Freed elements of these sizes stay
+ * allocated in the heap and are pushed to the cache of the freeing lcore,
+ * to be reused by its next allocations of the same class.
+ * The cache is refilled from and flushed to the heap in batches,
+ * so the heap lock is taken once per batch.
+ */
+
+/* return an element of the size class of size, or NULL if not cached */
+void *
+malloc_cache_alloc(size_t size, unsigned int align, int socket);
+
+/* give back an allocation to the cache: 0 if cached, 1 if not, -1 if invalid */
+int
+malloc_cache_free(void *addr);
+
+/* give back all the elements cached by the calling lcore to the heap */
+void
+malloc_cache_flush(void);
+
+/* true if the cache is enabled */
+bool
+malloc_cache_enabled(void);
+
+#endif /* MALLOC_CACHE_H_ */
@@ -407,6 +407,7 @@ malloc_elem_free_list_insert(struct malloc_elem *elem)
 	idx = malloc_elem_free_list_index(elem->size - MALLOC_ELEM_HEADER_LEN);
 	elem->state = ELEM_FREE;
 	LIST_INSERT_HEAD(&elem->heap->free_head[idx], elem, free_list);
+	elem->heap->free_size += elem->size;
 }
 
 /*
@@ -416,6 +417,7 @@ void
 malloc_elem_free_list_remove(struct malloc_elem *elem)
 {
 	LIST_REMOVE(elem, free_list);
+	elem->heap->free_size -= elem->size;
 }
 
 /*
@@ -508,14 +510,20 @@ join_elem(struct malloc_elem *elem1, struct malloc_elem *elem2)
 	}
 }
 
-struct malloc_elem *
-malloc_elem_join_adjacent_free(struct malloc_elem *elem)
+/*
+ * Join an element with its adjacent free neighbors.
+ * If clean_only is true, the dirty neighbors are not joined,
+ * so that the joint element stays clean.
+ */
+static struct malloc_elem *
+join_adjacent_free(struct malloc_elem *elem, bool clean_only)
 {
 	/*
 	 * check if next element exists, is adjacent and is free, if so join
 	 * with it, need to remove from free list.
 	 */
 	if (elem->next != NULL && elem->next->state == ELEM_FREE &&
+			!(clean_only && elem->next->dirty) &&
 			next_elem_is_adjacent(elem)) {
 		void *erase;
 		size_t erase_len;
@@ -537,6 +545,7 @@ malloc_elem_join_adjacent_free(struct malloc_elem *elem)
 	 * with it, need to remove from free list.
 	 */
 	if (elem->prev != NULL && elem->prev->state == ELEM_FREE &&
+			!(clean_only && elem->prev->dirty) &&
 			prev_elem_is_adjacent(elem)) {
 		struct malloc_elem *new_elem;
 		void *erase;
@@ -561,13 +570,21 @@ malloc_elem_join_adjacent_free(struct malloc_elem *elem)
 	return elem;
 }
 
+struct malloc_elem *
+malloc_elem_join_adjacent_free(struct malloc_elem *elem)
+{
+	return join_adjacent_free(elem, false);
+}
+
 /*
  * free a malloc_elem block by adding it to the free list. If the
  * blocks either immediately before or immediately after newly freed block
  * are also free, the blocks are merged together.
+ * The memory is cleared, unless it was cleared by the caller, in which case
+ * it is not merged with dirty blocks.
  */
 struct malloc_elem *
-malloc_elem_free(struct malloc_elem *elem)
+malloc_elem_free(struct malloc_elem *elem, bool zeroed)
 {
 	void *ptr;
 	size_t data_len;
@@ -583,7 +600,8 @@ malloc_elem_free(struct malloc_elem *elem)
 	 * There is no need to clear the memory if the joint element is dirty.
 	 */
 	elem->dirty = false;
-	elem = malloc_elem_join_adjacent_free(elem);
+	/* memory cleared by the caller is not joined with dirty memory */
+	elem = join_adjacent_free(elem, zeroed);
 
 	malloc_elem_free_list_insert(elem);
 
@@ -594,16 +612,37 @@ malloc_elem_free(struct malloc_elem *elem)
 
 #ifndef RTE_MALLOC_DEBUG
 	/* Normally clear the memory when needed. */
-	if (!elem->dirty)
+	if (!elem->dirty && !zeroed)
 		memset(ptr, 0, data_len);
 #else
 	/* Always poison the memory in debug mode. */
+	RTE_SET_USED(zeroed);
 	memset(ptr, MALLOC_POISON, data_len);
 #endif
 
 	return elem;
 }
 
+/*
+ * Take a free element out of the free list, as a busy element of at most
+ * size bytes. The rest of the element, if big enough, stays free.
+ */
+struct malloc_elem *
+malloc_elem_take(struct malloc_elem *elem, size_t size)
+{
+	struct malloc_elem *split_pt;
+
+	malloc_elem_free_list_remove(elem);
+	if (elem->size > size + MALLOC_ELEM_OVERHEAD + MIN_DATA_SIZE) {
+		split_pt = RTE_PTR_ADD(elem, size);
+		asan_clear_split_alloczone(split_pt);
+		split_elem(elem, split_pt);
+		malloc_elem_free_list_insert(split_pt);
+	}
+	elem->state = ELEM_BUSY;
+	return elem;
+}
+
 /* assume all checks were already done */
 void
 malloc_elem_hide_region(struct malloc_elem *elem, void *start, size_t len)
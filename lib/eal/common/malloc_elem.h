@@ -350,9 +350,11 @@ malloc_elem_alloc(struct malloc_elem *elem, size_t size,
  * free a malloc_elem block by adding it to the free list. If the
  * blocks either immediately before or immediately after newly freed block
  * are also free, the blocks are merged together.
+ * The memory is cleared, unless it was cleared by the caller, in which case
+ * it is not merged with dirty blocks.
  */
 struct malloc_elem *
-malloc_elem_free(struct malloc_elem *elem);
+malloc_elem_free(struct malloc_elem *elem, bool zeroed);
 
 struct malloc_elem *
 malloc_elem_join_adjacent_free(struct malloc_elem *elem);
@@ -364,6 +366,13 @@ malloc_elem_join_adjacent_free(struct malloc_elem *elem);
 int
 malloc_elem_resize(struct malloc_elem *elem, size_t size);
 
+/*
+ * Take a free element out of the free list, as a busy element of at most
+ * size bytes, splitting the rest of the element off if big enough.
+ */
+struct malloc_elem *
+malloc_elem_take(struct malloc_elem *elem, size_t size);
+
 void
 malloc_elem_hide_region(struct malloc_elem *elem, void *start, size_t len);
 
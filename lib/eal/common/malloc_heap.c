@@ -9,6 +9,7 @@
 #include <sys/queue.h>
 
 #include <rte_memory.h>
+#include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_eal.h>
 #include <rte_eal_memconfig.h>
@@ -18,6 +19,8 @@
 #include <rte_spinlock.h>
 #include <rte_memzone.h>
 #include <rte_fbarray.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
 
 #include "eal_internal_cfg.h"
 #include "eal_memalloc.h"
@@ -254,6 +257,27 @@ heap_alloc(struct malloc_heap *heap, size_t size, unsigned int flags,
 	return elem == NULL ? NULL : (void *)(&elem[1]);
 }
 
+/*
+ * Allocate several elements of the same size from a heap, taking the heap
+ * lock once. The heap is not expanded, so fewer elements may be allocated.
+ */
+unsigned int
+malloc_heap_alloc_bulk(struct malloc_heap *heap, size_t size, size_t align,
+		void **objs, unsigned int n)
+{
+	unsigned int i;
+
+	rte_spinlock_lock(&(heap->lock));
+	for (i = 0; i != n; i++) {
+		objs[i] = heap_alloc(heap, size, 0, align, 0, false);
+		if (objs[i] == NULL)
+			break;
+	}
+	rte_spinlock_unlock(&(heap->lock));
+
+	return i;
+}
+
 static void *
 heap_alloc_biggest(struct malloc_heap *heap, unsigned int flags, size_t align, bool contig)
 {
@@ -698,7 +722,7 @@ malloc_heap_alloc_on_heap_id(size_t size, unsigned int heap_id, unsigned int fla
 	return ret;
 }
 
-static unsigned int
+unsigned int
 malloc_get_numa_socket(void)
 {
 	const struct internal_config *conf = eal_get_internal_configuration();
@@ -727,8 +751,10 @@ malloc_get_numa_socket(void)
 	return rte_socket_id_by_idx(0);
 }
 
-void *
-malloc_heap_alloc(size_t size, int socket_arg, unsigned int flags,
+static unsigned int heap_zero_drain(void);
+
+static void *
+heap_alloc_on_socket(size_t size, int socket_arg, unsigned int flags,
 		  size_t align, size_t bound, bool contig)
 {
 	int socket, heap_id, i;
@@ -769,6 +795,21 @@ malloc_heap_alloc(size_t size, int socket_arg, unsigned int flags,
 	return NULL;
 }
 
+void *
+malloc_heap_alloc(size_t size, int socket_arg, unsigned int flags,
+		  size_t align, size_t bound, bool contig)
+{
+	void *ret;
+
+	ret = heap_alloc_on_socket(size, socket_arg, flags, align, bound,
+			contig);
+	/* freed memory may be waiting to be cleared */
+	if (ret == NULL && heap_zero_drain() != 0)
+		ret = heap_alloc_on_socket(size, socket_arg, flags, align,
+				bound, contig);
+	return ret;
+}
+
 static void *
 heap_alloc_biggest_on_heap_id(unsigned int heap_id,
 		unsigned int flags, size_t align, bool contig)
@@ -854,8 +895,101 @@ malloc_heap_free_pages(void *aligned_start, size_t aligned_len)
 	return 0;
 }
 
-int
-malloc_heap_free(struct malloc_elem *elem)
+/*
+ * With a reserve, big freed elements are not cleared by the freeing thread.
+ * They are queued, still busy, to be cleared by a control thread of the
+ * primary process, which also clears the dirty free elements.
+ * The cleared memory is kept in the heap, instead of being given back to
+ * the system, as long as the free memory of the heap is within its reserve.
+ * Zeroed allocations then come out of memory already cleared.
+ * Dirty free elements are cleared by chunks, each chunk being taken out
+ * of the heap only while it is cleared.
+ */
+#define MALLOC_ZERO_MIN_SIZE	(256 * 1024)
+#define MALLOC_ZERO_CHUNK_SIZE	(2 * 1024 * 1024)
+#define MALLOC_ZERO_POLL_US	1000
+
+static rte_thread_t zero_thread;
+static RTE_ATOMIC(bool) zero_thread_stop;
+static bool zero_thread_running;
+
+/* true if the free memory of the heap is within its reserve */
+static bool
+heap_zero_keep(struct malloc_heap *heap)
+{
+	return heap->free_size <= heap->zero_reserve;
+}
+
+/* queue a busy element to be cleared, instead of freeing it now */
+static bool
+heap_zero_defer(struct malloc_elem *elem)
+{
+	struct malloc_heap *heap = elem->heap;
+
+	if (heap->zero_reserve == 0 ||
+			elem->size - MALLOC_ELEM_OVERHEAD < MALLOC_ZERO_MIN_SIZE)
+		return false;
+
+	rte_spinlock_lock(&heap->lock);
+	/* the reserve is disabled under the lock at cleanup */
+	if (heap->zero_reserve == 0) {
+		rte_spinlock_unlock(&heap->lock);
+		return false;
+	}
+	/* the free list entry is not used by busy elements */
+	LIST_INSERT_HEAD(&heap->zero_list, elem, free_list);
+	heap->zero_pending += elem->size;
+	rte_spinlock_unlock(&heap->lock);
+	return true;
+}
+
+/*
+ * Take an element to clear out of the heap: a queued one or, if dirty is
+ * true, a dirty free one. Must be called with the heap lock held.
+ */
+static struct malloc_elem *
+heap_zero_take(struct malloc_heap *heap, bool dirty)
+{
+	struct malloc_elem *elem;
+	size_t idx, size;
+
+	elem = LIST_FIRST(&heap->zero_list);
+	if (elem != NULL) {
+		LIST_REMOVE(elem, free_list);
+		heap->zero_pending -= elem->size;
+		return elem;
+	}
+	if (!dirty)
+		return NULL;
+
+	idx = malloc_elem_free_list_index(MALLOC_ZERO_MIN_SIZE);
+	for (; idx < RTE_HEAP_NUM_FREELISTS; idx++) {
+		LIST_FOREACH(elem, &heap->free_head[idx], free_list) {
+			if (!elem->dirty || elem->size - MALLOC_ELEM_OVERHEAD <
+					MALLOC_ZERO_MIN_SIZE)
+				continue;
+			/*
+			 * allocate a chunk while it is cleared, leaving
+			 * a remainder big enough to be taken next
+			 */
+			size = elem->size;
+			if (size > MALLOC_ZERO_CHUNK_SIZE + MALLOC_ZERO_MIN_SIZE +
+					MALLOC_ELEM_OVERHEAD)
+				size = MALLOC_ZERO_CHUNK_SIZE;
+			elem = malloc_elem_take(elem, size);
+			elem->heap->alloc_count++;
+			return elem;
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Free an element, and give back to the system the pages it frees.
+ * The memory is cleared, unless it was cleared by the caller.
+ */
+static int
+heap_free(struct malloc_elem *elem, bool zeroed)
 {
 	struct malloc_heap *heap;
 	void *start, *aligned_start, *end, *aligned_end;
@@ -867,9 +1001,6 @@ malloc_heap_free(struct malloc_elem *elem)
 	const struct internal_config *internal_conf =
 		eal_get_internal_configuration();
 
-	if (!malloc_elem_cookies_ok(elem) || elem->state != ELEM_BUSY)
-		return -1;
-
 	asan_clear_redzone(elem);
 
 	/* elem may be merged with previous element, so keep heap address */
@@ -885,7 +1016,7 @@ malloc_heap_free(struct malloc_elem *elem)
 	/* mark element as free */
 	elem->state = ELEM_FREE;
 
-	elem = malloc_elem_free(elem);
+	elem = malloc_elem_free(elem, zeroed);
 
 	/* anything after this is a bonus */
 	ret = 0;
@@ -896,6 +1027,10 @@ malloc_heap_free(struct malloc_elem *elem)
 	if (internal_conf->legacy_mem || (msl->external > 0))
 		goto free_unlock;
 
+	/* cleared memory is kept in the heap up to its reserve */
+	if (zeroed && heap_zero_keep(heap))
+		goto free_unlock;
+
 	/* check if we can free any memory back to the system */
 	if (elem->size < page_sz)
 		goto free_unlock;
@@ -1075,6 +1210,69 @@ malloc_heap_free(struct malloc_elem *elem)
 	return ret;
 }
 
+int
+malloc_heap_free(struct malloc_elem *elem)
+{
+	if (!malloc_elem_cookies_ok(elem) || elem->state != ELEM_BUSY)
+		return -1;
+
+	if (heap_zero_defer(elem))
+		return 0;
+
+	return heap_free(elem, false);
+}
+
+/* clear an element of the heap, return 1 if there was one to clear */
+static unsigned int
+heap_zero_one(struct malloc_heap *heap, bool dirty)
+{
+	struct malloc_elem *elem;
+
+	rte_spinlock_lock(&heap->lock);
+	elem = heap_zero_take(heap, dirty);
+	rte_spinlock_unlock(&heap->lock);
+	if (elem == NULL)
+		return 0;
+
+	memset(RTE_PTR_ADD(elem, MALLOC_ELEM_HEADER_LEN), 0,
+			elem->size - MALLOC_ELEM_OVERHEAD);
+	heap_free(elem, true);
+	return 1;
+}
+
+/* clear the queued elements of all heaps, return the number cleared */
+static unsigned int
+heap_zero_drain(void)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	unsigned int i, n = 0;
+
+	for (i = 0; i < rte_socket_count(); i++) {
+		struct malloc_heap *heap = &mcfg->malloc_heaps[i];
+
+		while (heap_zero_one(heap, false) != 0)
+			n++;
+	}
+	return n;
+}
+
+static uint32_t
+heap_zero_thread(void *arg __rte_unused)
+{
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	unsigned int i, n;
+
+	while (!rte_atomic_load_explicit(&zero_thread_stop,
+			rte_memory_order_relaxed)) {
+		n = 0;
+		for (i = 0; i < rte_socket_count(); i++)
+			n += heap_zero_one(&mcfg->malloc_heaps[i], true);
+		if (n == 0)
+			rte_delay_us_sleep(MALLOC_ZERO_POLL_US);
+	}
+	return 0;
+}
+
 int
 malloc_heap_resize(struct malloc_elem *elem, size_t size)
 {
@@ -1361,6 +1559,7 @@ malloc_heap_create(struct malloc_heap *heap, const char *heap_name)
 	LIST_INIT(heap->free_head);
 	rte_spinlock_init(&heap->lock);
 	heap->total_size = 0;
+	heap->free_size = 0;
 	heap->socket_id = next_socket_id;
 
 	/* we hold a global mem hotplug writelock, so it's safe to increment */
@@ -1402,10 +1601,19 @@ rte_eal_malloc_heap_init(void)
 	unsigned int i;
 	const struct internal_config *internal_conf =
 		eal_get_internal_configuration();
+	size_t zero_reserve = internal_conf->zero_reserve;
 
 	if (internal_conf->match_allocations)
 		EAL_LOG(DEBUG, "Hugepages will be freed exactly as allocated.");
 
+#ifdef RTE_MALLOC_ASAN
+	/* the elements would be cleared out of their ASan state */
+	if (zero_reserve != 0) {
+		EAL_LOG(WARNING, "Background clearing of memory is not supported with ASan");
+		zero_reserve = 0;
+	}
+#endif
+
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
 		/* assign min socket ID to external heaps */
 		mcfg->next_socket_id = EXTERNAL_HEAP_MIN_SOCKET_ID;
@@ -1420,6 +1628,18 @@ rte_eal_malloc_heap_init(void)
 					"socket_%i", socket_id);
 			strlcpy(heap->name, heap_name, RTE_HEAP_NAME_MAX_LEN);
 			heap->socket_id = socket_id;
+			heap->zero_reserve = zero_reserve;
+		}
+
+		if (zero_reserve != 0) {
+			if (rte_thread_create_internal_control(&zero_thread,
+					"mem-zero", heap_zero_thread, NULL) != 0) {
+				EAL_LOG(ERR, "Cannot create memory clearing thread");
+				return -1;
+			}
+			zero_thread_running = true;
+			EAL_LOG(DEBUG, "Freed memory is cleared in background, keeping up to %zuMB per heap",
+				zero_reserve >> 20);
 		}
 	}
 
@@ -1449,5 +1669,23 @@ int rte_eal_malloc_heap_populate(void)
 void
 rte_eal_malloc_heap_cleanup(void)
 {
+	struct rte_mem_config *mcfg = rte_eal_get_configuration()->mem_config;
+	unsigned int i;
+
+	if (zero_thread_running) {
+		/* free the queued elements, and clear the next ones on free */
+		for (i = 0; i < rte_socket_count(); i++) {
+			struct malloc_heap *heap = &mcfg->malloc_heaps[i];
+
+			rte_spinlock_lock(&heap->lock);
+			heap->zero_reserve = 0;
+			rte_spinlock_unlock(&heap->lock);
+		}
+		heap_zero_drain();
+		rte_atomic_store_explicit(&zero_thread_stop, true,
+				rte_memory_order_relaxed);
+		rte_thread_join(zero_thread, NULL);
+		zero_thread_running = false;
+	}
 	unregister_mp_requests();
 }
@@ -30,13 +30,24 @@ struct __rte_cache_aligned malloc_heap {
 	unsigned int alloc_count;
 	unsigned int socket_id;
 	size_t total_size;
+	size_t free_size; /**< size of the elements in the free lists */
 	char name[RTE_HEAP_NAME_MAX_LEN];
+
+	/* big freed elements, still busy, waiting to be cleared */
+	LIST_HEAD(, malloc_elem) zero_list;
+	size_t zero_pending; /**< size of the elements to be cleared */
+	/** free memory kept from the system, 0 to clear on free */
+	size_t zero_reserve;
 };
 
 void *
 malloc_heap_alloc(size_t size, int socket, unsigned int flags, size_t align,
 		  size_t bound, bool contig);
 
+unsigned int
+malloc_heap_alloc_bulk(struct malloc_heap *heap, size_t size, size_t align,
+		void **objs, unsigned int n);
+
 void *
 malloc_heap_alloc_biggest(int socket, unsigned int flags, size_t align, bool contig);
 
@@ -81,6 +92,9 @@ malloc_heap_dump(struct malloc_heap *heap, FILE *f);
 int
 malloc_socket_to_heap_id(unsigned int socket_id);
 
+unsigned int
+malloc_get_numa_socket(void);
+
 int
 rte_eal_malloc_heap_init(void);
 
@@ -20,6 +20,7 @@
 #include <eal_trace_internal.h>
 
 #include <rte_malloc.h>
+#include "malloc_cache.h"
 #include "malloc_elem.h"
 #include "malloc_heap.h"
 #include "eal_memalloc.h"
@@ -35,6 +36,16 @@ mem_free(void *addr, const bool trace_ena)
 		rte_eal_trace_mem_free(addr);
 
 	if (addr == NULL) return;
+	if (malloc_cache_enabled()) {
+		int ret = malloc_cache_free(addr);
+
+		if (ret == 0)
+			return;
+		if (ret < 0) {
+			EAL_LOG(ERR, "Error: Invalid memory");
+			return;
+		}
+	}
 	if (malloc_heap_free(malloc_elem_from_data(addr)) < 0)
 		EAL_LOG(ERR, "Error: Invalid memory");
 }
@@ -71,8 +82,18 @@ malloc_socket(const char *type, size_t size, unsigned int align,
 				!rte_eal_has_hugepages())
 		socket_arg = SOCKET_ID_ANY;
 
-	ptr = malloc_heap_alloc(size, socket_arg, 0,
-			align == 0 ? 1 : align, 0, false);
+	ptr = NULL;
+	if (malloc_cache_enabled())
+		ptr = malloc_cache_alloc(size, align, socket_arg);
+	if (ptr == NULL)
+		ptr = malloc_heap_alloc(size, socket_arg, 0,
+				align == 0 ? 1 : align, 0, false);
+	/* the memory may be held by the cache of this lcore */
+	if (ptr == NULL && malloc_cache_enabled()) {
+		malloc_cache_flush();
+		ptr = malloc_heap_alloc(size, socket_arg, 0,
+				align == 0 ? 1 : align, 0, false);
+	}
 
 	if (trace_ena)
 		rte_eal_trace_mem_malloc(type, size, align, socket_arg, ptr);
@@ -13,6 +13,7 @@
 
 #include <stdio.h>
 #include <stddef.h>
+#include <rte_compat.h>
 #include <rte_memory.h>
 
 #ifdef __cplusplus
@@ -545,6 +546,54 @@ rte_malloc_dump_heaps(FILE *f);
 rte_iova_t
 rte_malloc_virt2iova(const void *addr);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable the per-lcore cache of small allocations.
+ *
+ * When enabled, allocations of up to 4 KB with no alignment constraint
+ * beyond a cache line, on the default heap or the heap of the lcore,
+ * are rounded up to a power of 2 size class and served from a cache
+ * owned by the calling lcore. Freed blocks of these sizes are kept in
+ * the cache of the freeing lcore, instead of being returned to the heap.
+ * The cache is refilled from and flushed to the heap in batches,
+ * which reduces the contention on the heap lock between lcores.
+ * Threads with no lcore ID do not use the cache.
+ *
+ * The cached blocks are accounted as allocated in the heap statistics.
+ *
+ * @return
+ *   0 on success, -ENOTSUP if the cache cannot be used in this build.
+ */
+__rte_experimental
+int
+rte_malloc_cache_enable(void);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Disable the per-lcore cache of small allocations.
+ *
+ * The blocks cached by the calling lcore are returned to the heap.
+ * The other lcores keep their cached blocks until they call
+ * rte_malloc_cache_flush().
+ */
+__rte_experimental
+void
+rte_malloc_cache_disable(void);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the blocks cached by the calling lcore to the heap.
+ */
+__rte_experimental
+void
+rte_malloc_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
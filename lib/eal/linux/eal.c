@@ -17,9 +17,11 @@
 #include <fnmatch.h>
 #include <stddef.h>
 #include <errno.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <time.h>
 #if defined(RTE_ARCH_X86)
 #include <sys/io.h>
 #endif
@@ -39,6 +41,8 @@
 #include <rte_cpuflags.h>
 #include <rte_bus.h>
 #include <rte_version.h>
+#include <rte_telemetry.h>
+#include <rte_time.h>
 #include <malloc_heap.h>
 #include <rte_vfio.h>
 
@@ -460,6 +464,12 @@ eal_usage(const char *prgname)
 	       "                      Allocate worker thread stacks from hugepage memory.\n"
 	       "                      Size is in units of kbytes and defaults to system\n"
 	       "                      thread stack size if not specified.\n"
+	       "  --"OPT_HUGE_PREFAULT_THREADS"=<num>\n"
+	       "                      Number of threads mapping hugepages at startup,\n"
+	       "                      defaults to the number of CPUs of each socket.\n"
+	       "  --"OPT_HUGE_ZERO_RESERVE"=<MB>\n"
+	       "                      Clear freed memory in background, and keep up to\n"
+	       "                      this size of free memory per socket.\n"
 	       "\n");
 	/* Allow the application to print its usage message too if hook is set */
 	if (hook) {
@@ -586,6 +596,40 @@ eal_parse_huge_worker_stack(const char *arg)
 	return 0;
 }
 
+static int
+eal_parse_huge_prefault_threads(const char *arg)
+{
+	struct internal_config *cfg = eal_get_internal_configuration();
+	unsigned long threads;
+	char *end;
+
+	errno = 0;
+	threads = strtoul(arg, &end, 10);
+	if (errno || end == arg || *end != '\0' || threads == 0 ||
+			threads > RTE_MAX_LCORE)
+		return -1;
+
+	cfg->huge_prefault_threads = threads;
+	return 0;
+}
+
+static int
+eal_parse_huge_zero_reserve(const char *arg)
+{
+	struct internal_config *cfg = eal_get_internal_configuration();
+	unsigned long long size;
+	char *end;
+
+	errno = 0;
+	size = strtoull(arg, &end, 10);
+	if (errno || end == arg || *end != '\0' || size == 0 ||
+			size >= SIZE_MAX >> 20)
+		return -1;
+
+	cfg->zero_reserve = (size_t)size << 20;
+	return 0;
+}
+
 /* Parse the argument given in the command line of the application */
 static int
 eal_parse_args(int argc, char **argv)
@@ -733,6 +777,26 @@ eal_parse_args(int argc, char **argv)
 			}
 			break;
 
+		case OPT_HUGE_PREFAULT_THREADS_NUM:
+			if (eal_parse_huge_prefault_threads(optarg) < 0) {
+				EAL_LOG(ERR, "invalid parameter for --"
+					OPT_HUGE_PREFAULT_THREADS);
+				eal_usage(prgname);
+				ret = -1;
+				goto out;
+			}
+			break;
+
+		case OPT_HUGE_ZERO_RESERVE_NUM:
+			if (eal_parse_huge_zero_reserve(optarg) < 0) {
+				EAL_LOG(ERR, "invalid parameter for --"
+					OPT_HUGE_ZERO_RESERVE);
+				eal_usage(prgname);
+				ret = -1;
+				goto out;
+			}
+			break;
+
 		default:
 			if (opt < OPT_LONG_MIN_NUM && isprint(opt)) {
 				EAL_LOG(ERR, "Option %c is not supported "
@@ -916,6 +980,95 @@ eal_worker_thread_create(unsigned int lcore_id)
 	return ret;
 }
 
+/*
+ * Steps of rte_eal_init(), timed to find out where the startup time goes,
+ * e.g. in mapping hugepages.
+ */
+enum eal_init_phase {
+	EAL_INIT_ARGS,
+	EAL_INIT_CONFIG,
+	EAL_INIT_BUS_SCAN,
+	EAL_INIT_HUGEPAGE_INFO,
+	EAL_INIT_MEMORY,
+	EAL_INIT_MALLOC_HEAP,
+	EAL_INIT_TIMERS,
+	EAL_INIT_LCORES,
+	EAL_INIT_DEVICES,
+	EAL_INIT_PHASE_MAX
+};
+
+static const char * const eal_init_phase_names[EAL_INIT_PHASE_MAX] = {
+	[EAL_INIT_ARGS] = "args",
+	[EAL_INIT_CONFIG] = "config",
+	[EAL_INIT_BUS_SCAN] = "bus_scan",
+	[EAL_INIT_HUGEPAGE_INFO] = "hugepage_info",
+	[EAL_INIT_MEMORY] = "memory",
+	[EAL_INIT_MALLOC_HEAP] = "malloc_heap",
+	[EAL_INIT_TIMERS] = "timers",
+	[EAL_INIT_LCORES] = "lcores",
+	[EAL_INIT_DEVICES] = "devices",
+};
+
+static uint64_t eal_init_phase_ns[EAL_INIT_PHASE_MAX];
+static uint64_t eal_init_phase_last;
+
+static uint64_t
+eal_init_clock_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return rte_timespec_to_ns(&ts);
+}
+
+/* the phase ends now, the next one starts */
+static void
+eal_init_phase_end(enum eal_init_phase phase)
+{
+	uint64_t now = eal_init_clock_ns();
+
+	eal_init_phase_ns[phase] = now - eal_init_phase_last;
+	eal_init_phase_last = now;
+}
+
+static void
+eal_init_phase_report(void)
+{
+	uint64_t total = 0;
+	unsigned int i;
+
+	for (i = 0; i < EAL_INIT_PHASE_MAX; i++) {
+		EAL_LOG(DEBUG, "Init phase %s took %"PRIu64" us",
+			eal_init_phase_names[i], eal_init_phase_ns[i] / 1000);
+		total += eal_init_phase_ns[i];
+	}
+	EAL_LOG(INFO, "Initialization took %"PRIu64" ms, %"PRIu64" ms in memory setup",
+		total / 1000000,
+		(eal_init_phase_ns[EAL_INIT_MEMORY] +
+		 eal_init_phase_ns[EAL_INIT_MALLOC_HEAP]) / 1000000);
+}
+
+/* Telemetry callback handler to return the duration of the init phases. */
+static int
+handle_eal_init_timings_request(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	unsigned int i;
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < EAL_INIT_PHASE_MAX; i++)
+		rte_tel_data_add_dict_uint(d, eal_init_phase_names[i],
+			eal_init_phase_ns[i] / 1000);
+	return 0;
+}
+
+RTE_INIT(eal_init_telemetry)
+{
+	rte_telemetry_register_cmd("/eal/init_timings",
+		handle_eal_init_timings_request,
+		"Returns the duration of the EAL init phases in microseconds. Takes no parameters");
+}
+
 /* Launch threads, called at application init(). */
 RTE_EXPORT_SYMBOL(rte_eal_init)
 int
@@ -931,6 +1084,8 @@ rte_eal_init(int argc, char **argv)
 	struct internal_config *internal_conf =
 		eal_get_internal_configuration();
 
+	eal_init_phase_last = eal_init_clock_ns();
+
 	/* setup log as early as possible */
 	if (eal_parse_log_options(argc, argv) < 0) {
 		rte_eal_init_alert("invalid log arguments.");
@@ -999,6 +1154,8 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	eal_init_phase_end(EAL_INIT_ARGS);
+
 	if (rte_config_init() < 0) {
 		rte_eal_init_alert("Cannot init config");
 		return -1;
@@ -1026,6 +1183,8 @@ rte_eal_init(int argc, char **argv)
 		}
 	}
 
+	eal_init_phase_end(EAL_INIT_CONFIG);
+
 	if (rte_bus_scan()) {
 		rte_eal_init_alert("Cannot scan the buses for devices");
 		rte_errno = ENODEV;
@@ -1085,6 +1244,8 @@ rte_eal_init(int argc, char **argv)
 	EAL_LOG(INFO, "Selected IOVA mode '%s'",
 		rte_eal_iova_mode() == RTE_IOVA_PA ? "PA" : "VA");
 
+	eal_init_phase_end(EAL_INIT_BUS_SCAN);
+
 	if (internal_conf->no_hugetlbfs == 0) {
 		/* rte_config isn't initialized yet */
 		ret = internal_conf->process_type == RTE_PROC_PRIMARY ?
@@ -1098,6 +1259,8 @@ rte_eal_init(int argc, char **argv)
 		}
 	}
 
+	eal_init_phase_end(EAL_INIT_HUGEPAGE_INFO);
+
 	if (internal_conf->memory == 0 && internal_conf->force_sockets == 0) {
 		if (internal_conf->no_hugetlbfs)
 			internal_conf->memory = MEMSIZE_IF_NO_HUGE_PAGE;
@@ -1144,6 +1307,8 @@ rte_eal_init(int argc, char **argv)
 	/* the directories are locked during eal_hugepage_info_init */
 	eal_hugedirs_unlock();
 
+	eal_init_phase_end(EAL_INIT_MEMORY);
+
 	if (rte_eal_malloc_heap_init() < 0) {
 		rte_mcfg_mem_read_unlock();
 		rte_eal_init_alert("Cannot init malloc heap");
@@ -1159,6 +1324,8 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	eal_init_phase_end(EAL_INIT_MALLOC_HEAP);
+
 	/* register multi-process action callbacks for hotplug after memory init */
 	if (eal_mp_dev_hotplug_init() < 0) {
 		rte_eal_init_alert("failed to register mp callback for hotplug");
@@ -1187,6 +1354,9 @@ rte_eal_init(int argc, char **argv)
 		rte_errno = EINVAL;
 		return -1;
 	}
+
+	eal_init_phase_end(EAL_INIT_TIMERS);
+
 	__rte_thread_init(config->main_lcore,
 		&lcore_config[config->main_lcore].cpuset);
 
@@ -1231,6 +1401,8 @@ rte_eal_init(int argc, char **argv)
 	rte_eal_mp_remote_launch(sync_func, NULL, SKIP_MAIN);
 	rte_eal_mp_wait_lcore();
 
+	eal_init_phase_end(EAL_INIT_LCORES);
+
 	/* initialize services so vdevs register service during bus_probe. */
 	ret = rte_service_init();
 	if (ret) {
@@ -1255,6 +1427,9 @@ rte_eal_init(int argc, char **argv)
 		return -1;
 	}
 
+	eal_init_phase_end(EAL_INIT_DEVICES);
+	eal_init_phase_report();
+
 	/*
 	 * Clean up unused files in runtime directory. We do this at the end of
 	 * init and not at the beginning because we want to clean stuff up
@@ -3,6 +3,7 @@
  */
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -14,8 +15,10 @@
 #include <unistd.h>
 #include <limits.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <signal.h>
 #include <setjmp.h>
+#include <time.h>
 #ifdef F_ADD_SEALS /* if file sealing is supported, so is memfd */
 #include <linux/memfd.h>
 #define MEMFD_SUPPORTED
@@ -31,12 +34,17 @@
 #include <rte_log.h>
 #include <rte_eal.h>
 #include <rte_memory.h>
+#include <rte_per_lcore.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
+#include <rte_time.h>
 
 #include "eal_filesystem.h"
 #include "eal_internal_cfg.h"
 #include "eal_memalloc.h"
 #include "eal_memcfg.h"
 #include "eal_private.h"
+#include "eal_thread.h"
 
 const int anonymous_hugepages_supported =
 #ifdef MAP_HUGE_SHIFT
@@ -97,11 +105,15 @@ static struct {
 /** local copy of a memory map, used to synchronize memory hotplug in MP */
 static struct rte_memseg_list local_memsegs[RTE_MAX_MEMSEG_LISTS];
 
-static sigjmp_buf huge_jmpenv;
+/* serializes the address space fixups of the threads mapping pages */
+static pthread_mutex_t huge_remap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* per thread, as pages may be mapped by several threads at init */
+static RTE_DEFINE_PER_LCORE(sigjmp_buf, huge_jmpenv);
 
 static void huge_sigbus_handler(int signo __rte_unused)
 {
-	siglongjmp(huge_jmpenv, 1);
+	siglongjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 /* Put setjmp into a wrap method to avoid compiling error. Any non-volatile,
@@ -110,11 +122,13 @@ static void huge_sigbus_handler(int signo __rte_unused)
  */
 static int huge_wrap_sigsetjmp(void)
 {
-	return sigsetjmp(huge_jmpenv, 1);
+	return sigsetjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 static struct sigaction huge_action_old;
 static int huge_need_recover;
+/* handler installed once for all the threads mapping pages in parallel */
+static bool huge_sigbus_shared;
 
 static void
 huge_register_sigbus(void)
@@ -122,6 +136,9 @@ huge_register_sigbus(void)
 	sigset_t mask;
 	struct sigaction action;
 
+	if (huge_sigbus_shared)
+		return;
+
 	sigemptyset(&mask);
 	sigaddset(&mask, SIGBUS);
 	action.sa_flags = 0;
@@ -134,6 +151,8 @@ huge_register_sigbus(void)
 static void
 huge_recover_sigbus(void)
 {
+	if (huge_sigbus_shared)
+		return;
 	if (huge_need_recover) {
 		sigaction(SIGBUS, &huge_action_old, NULL);
 		huge_need_recover = 0;
@@ -695,7 +714,9 @@ alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
 unmapped:
 	huge_recover_sigbus();
 	flags = EAL_RESERVE_FORCE_ADDRESS;
+	pthread_mutex_lock(&huge_remap_lock);
 	new_addr = eal_get_virtual_area(addr, &alloc_sz, alloc_sz, 0, flags);
+	pthread_mutex_unlock(&huge_remap_lock);
 	if (new_addr != addr) {
 		if (new_addr != NULL)
 			munmap(new_addr, alloc_sz);
@@ -810,6 +831,163 @@ struct alloc_walk_param {
 	int socket;
 	bool exact;
 };
+
+/*
+ * At init, the hugepages are mapped by several threads running on the CPUs
+ * of their socket, as the time is spent in the kernel clearing each page
+ * on its first fault. The calling thread is one of these threads.
+ */
+#define PREFAULT_MIN_SEGS 4 /* fewer pages are mapped by the caller only */
+
+struct prefault_param {
+	struct rte_memseg_list *msl;
+	struct hugepage_info *hi;
+	unsigned int msl_idx;
+	int start_idx;
+	int socket;
+	bool *mapped; /**< pages mapped, from start_idx */
+	RTE_ATOMIC(unsigned int) next; /**< next page to map */
+	RTE_ATOMIC(unsigned int) failed; /**< first page not mapped */
+};
+
+static uint32_t
+prefault_thread(void *arg)
+{
+	struct prefault_param *pp = arg;
+	struct rte_memseg *ms;
+	unsigned int i, failed;
+	int seg_idx;
+
+	for (;;) {
+		i = rte_atomic_fetch_add_explicit(&pp->next, 1,
+				rte_memory_order_relaxed);
+		failed = rte_atomic_load_explicit(&pp->failed,
+				rte_memory_order_relaxed);
+		if (i >= failed)
+			break;
+
+		seg_idx = pp->start_idx + i;
+		ms = rte_fbarray_get(&pp->msl->memseg_arr, seg_idx);
+		if (alloc_seg(ms, RTE_PTR_ADD(pp->msl->base_va,
+				(size_t)seg_idx * pp->msl->page_sz), pp->socket,
+				pp->hi, pp->msl_idx, seg_idx) == 0) {
+			pp->mapped[i] = true;
+			continue;
+		}
+
+		/* the pages after a failure are not used */
+		while (i < failed && !rte_atomic_compare_exchange_weak_explicit(
+				&pp->failed, &failed, i,
+				rte_memory_order_relaxed, rte_memory_order_relaxed))
+			;
+		break;
+	}
+	return 0;
+}
+
+/* CPUs of the calling thread on a socket, or all of them if there is none */
+static unsigned int
+prefault_cpuset(int socket, rte_cpuset_t *cpuset)
+{
+	rte_cpuset_t allowed;
+	unsigned int cpu;
+
+	CPU_ZERO(cpuset);
+	if (rte_thread_get_affinity_by_id(rte_thread_self(), &allowed) != 0)
+		return 0;
+
+	for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		if (CPU_ISSET(cpu, &allowed) &&
+				eal_cpu_socket_id(cpu) == (unsigned int)socket)
+			CPU_SET(cpu, cpuset);
+
+	if (CPU_COUNT(cpuset) == 0)
+		*cpuset = allowed;
+	return CPU_COUNT(cpuset);
+}
+
+/*
+ * Map the pages [start_idx, start_idx + need) of a list with several threads.
+ * Return the number of pages mapped from start_idx, the following ones are
+ * left free. Return 0 if the pages are to be mapped by the caller alone.
+ */
+static unsigned int
+alloc_seg_prefault(struct rte_memseg_list *msl, unsigned int msl_idx,
+		int start_idx, unsigned int need, struct alloc_walk_param *wa)
+{
+	const struct internal_config *internal_conf =
+		eal_get_internal_configuration();
+	rte_thread_t threads[RTE_MAX_LCORE];
+	struct prefault_param pp;
+	rte_thread_attr_t attr;
+	rte_cpuset_t cpuset;
+	unsigned int nb_threads, nb_started, i, done;
+	uint64_t start;
+	struct timespec ts;
+
+	/* in single file mode, the pages share the file of their list */
+	if (internal_conf->init_complete ||
+			internal_conf->single_file_segments ||
+			need < PREFAULT_MIN_SEGS)
+		return 0;
+
+	nb_threads = prefault_cpuset(wa->socket, &cpuset);
+	if (internal_conf->huge_prefault_threads != 0)
+		nb_threads = internal_conf->huge_prefault_threads;
+	nb_threads = RTE_MIN(nb_threads, RTE_MIN(need, (unsigned int)RTE_MAX_LCORE));
+	if (nb_threads <= 1)
+		return 0;
+
+	memset(&pp, 0, sizeof(pp));
+	pp.mapped = calloc(need, sizeof(*pp.mapped));
+	if (pp.mapped == NULL)
+		return 0;
+	pp.msl = msl;
+	pp.hi = wa->hi;
+	pp.msl_idx = msl_idx;
+	pp.start_idx = start_idx;
+	pp.socket = wa->socket;
+	rte_atomic_store_explicit(&pp.failed, need, rte_memory_order_relaxed);
+
+	rte_thread_attr_init(&attr);
+	if (CPU_COUNT(&cpuset) != 0)
+		rte_thread_attr_set_affinity(&attr, &cpuset);
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	start = rte_timespec_to_ns(&ts);
+
+	/* the threads inherit the memory policy of the caller */
+	huge_register_sigbus();
+	huge_sigbus_shared = true;
+	for (nb_started = 0; nb_started < nb_threads - 1; nb_started++)
+		if (rte_thread_create(&threads[nb_started], &attr,
+				prefault_thread, &pp) != 0)
+			break;
+	prefault_thread(&pp);
+	for (i = 0; i < nb_started; i++)
+		rte_thread_join(threads[i], NULL);
+	huge_sigbus_shared = false;
+	huge_recover_sigbus();
+
+	/* keep the pages before the first failure only */
+	done = rte_atomic_load_explicit(&pp.failed, rte_memory_order_relaxed);
+	for (i = done; i < need; i++) {
+		if (!pp.mapped[i])
+			continue;
+		if (free_seg(rte_fbarray_get(&msl->memseg_arr, start_idx + i),
+				wa->hi, msl_idx, start_idx + i))
+			EAL_LOG(DEBUG, "Cannot free page");
+	}
+	free(pp.mapped);
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	EAL_LOG(DEBUG, "Mapped %u of %u pages of %"PRIu64"kB on socket %d with %u threads in %"PRIu64" ms",
+		done, need, msl->page_sz >> 10, wa->socket, nb_started + 1,
+		(rte_timespec_to_ns(&ts) - start) / 1000000);
+
+	return done;
+}
+
 static int
 alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 {
@@ -818,7 +996,7 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 	struct rte_memseg_list *cur_msl;
 	size_t page_sz;
 	int cur_idx, start_idx, j, dir_fd = -1;
-	unsigned int msl_idx, need, i;
+	unsigned int msl_idx, need, prefaulted, i;
 	const struct internal_config *internal_conf =
 		eal_get_internal_configuration();
 
@@ -886,6 +1064,8 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 		}
 	}
 
+	prefaulted = alloc_seg_prefault(cur_msl, msl_idx, start_idx, need, wa);
+
 	for (i = 0; i < need; i++, cur_idx++) {
 		struct rte_memseg *cur;
 		void *map_addr;
@@ -894,8 +1074,8 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 		map_addr = RTE_PTR_ADD(cur_msl->base_va,
 				cur_idx * page_sz);
 
-		if (alloc_seg(cur, map_addr, wa->socket, wa->hi,
-				msl_idx, cur_idx)) {
+		if (i >= prefaulted && alloc_seg(cur, map_addr, wa->socket,
+				wa->hi, msl_idx, cur_idx)) {
 			EAL_LOG(DEBUG, "attempted to allocate %i segments, but only %i were allocated",
 				need, i);
 
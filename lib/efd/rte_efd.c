@@ -20,6 +20,8 @@
 #include <rte_branch_prediction.h>
 #include <rte_memcpy.h>
 #include <rte_ring.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
 #include <rte_tailq.h>
@@ -196,6 +198,9 @@ struct efd_offline_group_rules {
  * Those rules are split into EFD_CHUNK_NUM_GROUPS groups per chunk.
  */
 struct efd_offline_chunk_rules {
+	rte_spinlock_t lock;
+	/**< Serializes the writers of the chunk. */
+
 	uint16_t num_rules;
 	/**< Number of rules in the entire chunk;
 	 * used to detect unbalanced groups
@@ -242,7 +247,7 @@ struct rte_efd_table {
 	uint32_t max_num_rules;
 	/**< Static maximum number of entries the table was constructed to hold. */
 
-	uint32_t num_rules;
+	RTE_ATOMIC(uint32_t) num_rules;
 	/**< Number of entries currently in the table . */
 
 	uint32_t num_chunks;
@@ -254,8 +259,16 @@ struct rte_efd_table {
 	enum efd_lookup_internal_function lookup_fn;
 	/**< Indicates which lookup function to use. */
 
-	struct efd_online_chunk *chunks[RTE_MAX_NUMA_NODES];
-	/**< Dynamic array of size num_chunks of chunk records. */
+	RTE_ATOMIC(struct efd_online_chunk *) *chunks[RTE_MAX_NUMA_NODES];
+	/**< Dynamic array of size num_chunks of pointers to chunk records,
+	 * allocated once RCU is enabled. NULL while the chunk records
+	 * are updated in place.
+	 */
+
+	struct efd_online_chunk *chunk_blocks[RTE_MAX_NUMA_NODES];
+	/**< Continuous block of num_chunks chunk records allocated at creation,
+	 * which the chunk pointers refer to until a chunk is replaced.
+	 */
 
 	struct efd_offline_chunk_rules *offline_chunks;
 	/**< Dynamic array of size num_chunks of key-value pairs. */
@@ -264,6 +277,10 @@ struct rte_efd_table {
 	/**< Ring that stores all indexes of the free slots in the key table */
 
 	uint8_t *keys; /**< Dynamic array of size max_num_rules of keys */
+
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable used by lookups */
+	enum rte_efd_qsbr_mode rcu_mode; /**< Mode of RCU QSBR */
+	struct rte_rcu_qsbr_dq *dq; /**< RCU QSBR defer queue */
 };
 
 /**
@@ -302,14 +319,36 @@ efd_get_bin_id(const struct rte_efd_table * const table,
 }
 
 /**
- * Looks up the current permutation choice for a particular bin in the online table
+ * Gets the online chunk record currently used by lookups
  *
  * @param table
  *  EFD table to reference
  * @param socket_id
  *   Socket ID to use to look up existing values (ideally caller's socket id)
  * @param chunk_id
- *   Chunk ID of bin to look up
+ *   Chunk ID to look up
+ *
+ * @return
+ *   Online chunk record
+ */
+static inline struct efd_online_chunk *
+efd_get_chunk(const struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t chunk_id)
+{
+	/* Without RCU, the records of the block are updated in place */
+	if (table->chunks[socket_id] == NULL)
+		return &table->chunk_blocks[socket_id][chunk_id];
+
+	/* Pairs with the release exchange of efd_replace_chunk() */
+	return rte_atomic_load_explicit(&table->chunks[socket_id][chunk_id],
+			rte_memory_order_acquire);
+}
+
+/**
+ * Looks up the current permutation choice for a particular bin in the online table
+ *
+ * @param chunk
+ *   Online chunk record of the bin
  * @param bin_id
  *   Bin ID to look up
  *
@@ -317,11 +356,9 @@ efd_get_bin_id(const struct rte_efd_table * const table,
  *   Currently active permutation choice in the online table
  */
 static inline uint8_t
-efd_get_choice(const struct rte_efd_table * const table,
-		const unsigned int socket_id, const uint32_t chunk_id,
+efd_get_choice(const struct efd_online_chunk * const chunk,
 		const uint32_t bin_id)
 {
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
 
 	/*
 	 * Grab the chunk (byte) that contains the choices
@@ -497,6 +534,43 @@ efd_search_hash(struct rte_efd_table * const table,
 	return 0;
 }
 
+/*
+ * Online chunk records are allocated in one block per socket at creation.
+ * Once RCU is enabled, an update replaces the record of the chunk with a
+ * separately allocated copy, which is freed once no lookup uses it.
+ */
+static struct efd_online_chunk *
+efd_online_chunk_alloc(unsigned int socket_id)
+{
+	/* Keep the padding for vectorized over-reads of the last group */
+	return rte_malloc_socket(NULL, sizeof(struct efd_online_chunk) +
+			EFD_NUM_CHUNK_PADDING_BYTES, RTE_CACHE_LINE_SIZE,
+			socket_id);
+}
+
+static void
+efd_online_chunk_free(const struct rte_efd_table *table,
+		unsigned int socket_id, struct efd_online_chunk *chunk)
+{
+	const struct efd_online_chunk *block = table->chunk_blocks[socket_id];
+
+	if (chunk >= block && chunk < block + table->num_chunks)
+		return;
+
+	rte_free(chunk);
+}
+
+static void
+efd_rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	const struct rte_efd_table *table = p;
+	uintptr_t *entry = data;
+	struct efd_online_chunk *chunk = (struct efd_online_chunk *)entry[0];
+	unsigned int socket_id = (unsigned int)entry[1];
+
+	efd_online_chunk_free(table, socket_id, chunk);
+}
+
 RTE_EXPORT_SYMBOL(rte_efd_create)
 struct rte_efd_table *
 rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
@@ -606,8 +680,10 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 			num_chunks, table->max_num_rules);
 
 	/* Make sure all the allocatable table pointers are NULL initially */
-	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
 		table->chunks[socket_id] = NULL;
+		table->chunk_blocks[socket_id] = NULL;
+	}
 	table->offline_chunks = NULL;
 
 	/*
@@ -623,13 +699,13 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 			 * Allocate all of the EFD table chunks (the online portion)
 			 * as a continuous block
 			 */
-			table->chunks[socket_id] =
+			table->chunk_blocks[socket_id] =
 				rte_zmalloc_socket(
 				NULL,
 				online_table_size,
 				RTE_CACHE_LINE_SIZE,
 				socket_id);
-			if (table->chunks[socket_id] == NULL) {
+			if (table->chunk_blocks[socket_id] == NULL) {
 				EFD_LOG(ERR,
 						"Allocating EFD online table on "
 						"socket %u failed",
@@ -754,14 +830,25 @@ void
 rte_efd_free(struct rte_efd_table *table)
 {
 	uint8_t socket_id;
+	uint32_t i;
 	struct rte_efd_list *efd_list;
 	struct rte_tailq_entry *te, *temp;
 
 	if (table == NULL)
 		return;
 
-	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+	rte_rcu_qsbr_dq_delete(table->dq);
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		if (table->chunks[socket_id] != NULL &&
+				table->chunk_blocks[socket_id] != NULL) {
+			for (i = 0; i < table->num_chunks; i++)
+				efd_online_chunk_free(table, socket_id,
+					table->chunks[socket_id][i]);
+		}
 		rte_free(table->chunks[socket_id]);
+		rte_free(table->chunk_blocks[socket_id]);
+	}
 
 	efd_list = RTE_TAILQ_CAST(rte_efd_tailq.head, rte_efd_list);
 	rte_mcfg_tailq_write_lock();
@@ -781,6 +868,118 @@ rte_efd_free(struct rte_efd_table *table)
 	rte_free(table);
 }
 
+/**
+ * Replaces the online chunk record used by lookups on one socket and
+ * retires the previous one, once RCU is enabled on the table.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID of the online table to update
+ * @param chunk_id
+ *   Chunk index to update
+ * @param new_chunk
+ *   New chunk record, already filled in
+ */
+static inline void
+efd_replace_chunk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t chunk_id,
+		struct efd_online_chunk * const new_chunk)
+{
+	struct efd_online_chunk *old_chunk;
+	uintptr_t entry[2];
+
+	old_chunk = rte_atomic_exchange_explicit(
+			&table->chunks[socket_id][chunk_id], new_chunk,
+			rte_memory_order_release);
+
+	if (table->rcu_mode == RTE_EFD_QSBR_MODE_DQ) {
+		entry[0] = (uintptr_t)old_chunk;
+		entry[1] = socket_id;
+		if (rte_rcu_qsbr_dq_enqueue(table->dq, entry) == 0)
+			return;
+		EFD_LOG(DEBUG, "Failed to push QSBR FIFO, waiting for readers");
+	}
+
+	rte_rcu_qsbr_synchronize(table->v, RTE_QSBR_THRID_INVALID);
+	efd_online_chunk_free(table, socket_id, old_chunk);
+}
+
+/**
+ * Applies an updated chunk record to the specified table for all
+ * socket-local copies of the online table.
+ * Without RCU, the modified groups and the bin choices are written
+ * in place. With RCU, each socket gets a new copy of the chunk record.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param chunk_id
+ *   Chunk index to update
+ * @param new_chunk
+ *   Updated chunk record
+ * @param group_mask
+ *   Bitmask of the groups modified in the chunk record
+ */
+static inline void
+efd_publish_chunk(struct rte_efd_table * const table, const uint32_t chunk_id,
+		const struct efd_online_chunk * const new_chunk,
+		uint64_t group_mask)
+{
+	struct efd_online_chunk *chunk;
+	unsigned int i;
+	uint64_t mask;
+
+	/* Update the online table with the new data across all sockets */
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		if (table->chunk_blocks[i] == NULL)
+			continue;
+
+		if (table->chunks[i] != NULL) {
+			chunk = efd_online_chunk_alloc(i);
+			if (chunk != NULL) {
+				memcpy(chunk, new_chunk, sizeof(*chunk));
+				efd_replace_chunk(table, i, chunk_id, chunk);
+				continue;
+			}
+			EFD_LOG(ERR, "Allocating EFD chunk on socket %u "
+					"failed, updating it in place", i);
+		}
+
+		chunk = efd_get_chunk(table, i, chunk_id);
+		for (mask = group_mask; mask != 0; mask &= mask - 1)
+			memcpy(&chunk->groups[rte_ctz64(mask)],
+					&new_chunk->groups[rte_ctz64(mask)],
+					sizeof(struct efd_online_group_entry));
+		memcpy(chunk->bin_choice_list, new_chunk->bin_choice_list,
+				sizeof(chunk->bin_choice_list));
+	}
+}
+
+/**
+ * Sets the permutation choice of a bin in a chunk record
+ *
+ * @param chunk
+ *   Chunk record to modify
+ * @param bin_id
+ *   Bin to modify
+ * @param new_bin_choice
+ *   Newly chosen permutation which this bin should use - only lower 2 bits
+ */
+static inline void
+efd_set_choice(struct efd_online_chunk * const chunk, const uint32_t bin_id,
+		const uint8_t new_bin_choice)
+{
+	uint8_t bin_index = bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
+
+	/* Compute the offset into the chunk that needs to be updated */
+	int offset = (bin_id & 0x3) * 2;
+
+	/* Zero the two bits of interest and set them to new_bin_choice */
+	chunk->bin_choice_list[bin_index] =
+			(chunk->bin_choice_list[bin_index] & (~(0x03 << offset)))
+			| ((new_bin_choice & 0x03) << offset);
+}
+
 /**
  * Applies a previously computed table entry to the specified table for all
  * socket-local copies of the online table.
@@ -808,35 +1007,15 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 		const uint32_t bin_id, const uint8_t new_bin_choice,
 		const struct efd_online_group_entry * const new_group_entry)
 {
-	int i;
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
-	uint8_t bin_index = bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
-
-	/*
-	 * Grab the current byte that contains the choices
-	 * for four neighboring bins
-	 */
-	uint8_t choice_chunk =
-			chunk->bin_choice_list[bin_index];
+	struct efd_online_chunk new_chunk;
 
+	memcpy(&new_chunk, efd_get_chunk(table, socket_id, chunk_id),
+			sizeof(new_chunk));
+	memcpy(&new_chunk.groups[group_id], new_group_entry,
+			sizeof(struct efd_online_group_entry));
+	efd_set_choice(&new_chunk, bin_id, new_bin_choice);
 
-	/* Compute the offset into the chunk that needs to be updated */
-	int offset = (bin_id & 0x3) * 2;
-
-	/* Zero the two bits of interest and set them to new_bin_choice */
-	choice_chunk = (choice_chunk & (~(0x03 << offset)))
-			| ((new_bin_choice & 0x03) << offset);
-
-	/* Update the online table with the new data across all sockets */
-	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
-		if (table->chunks[i] != NULL) {
-			memcpy(&(table->chunks[i][chunk_id].groups[group_id]),
-					new_group_entry,
-					sizeof(struct efd_online_group_entry));
-			table->chunks[i][chunk_id].bin_choice_list[bin_index] =
-					choice_chunk;
-		}
-	}
+	efd_publish_chunk(table, chunk_id, &new_chunk, RTE_BIT64(group_id));
 }
 
 /*
@@ -984,8 +1163,8 @@ efd_compute_update(struct rte_efd_table * const table,
 			&table->offline_chunks[*chunk_id];
 	struct efd_offline_group_rules *new_group;
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
-			*chunk_id, *bin_id);
+	uint8_t current_choice = efd_get_choice(
+			efd_get_chunk(table, socket_id, *chunk_id), *bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][*bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
@@ -1041,7 +1220,7 @@ efd_compute_update(struct rte_efd_table * const table,
 			status = RTE_EFD_UPDATE_WARN_GROUP_FULL;
 		}
 
-		if (rte_ring_sc_dequeue(table->free_slots, &slot_id) != 0)
+		if (rte_ring_dequeue(table->free_slots, &slot_id) != 0)
 			return RTE_EFD_UPDATE_FAILED;
 
 		new_k = RTE_PTR_ADD(table->keys, (uintptr_t) slot_id *
@@ -1054,7 +1233,8 @@ efd_compute_update(struct rte_efd_table * const table,
 		current_group->value[current_group->num_rules] = value;
 		current_group->bin_id[current_group->num_rules] = *bin_id;
 		current_group->num_rules++;
-		table->num_rules++;
+		rte_atomic_fetch_add_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
 		bin_size++;
 	} else {
 		uint32_t last = current_group->num_rules - 1;
@@ -1159,17 +1339,23 @@ efd_compute_update(struct rte_efd_table * const table,
 
 	if (!found) {
 		current_group->num_rules--;
-		table->num_rules--;
+		rte_atomic_fetch_sub_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
+		rte_ring_enqueue(table->free_slots, (void *)((uintptr_t)
+			current_group->key_idx[current_group->num_rules]));
 	} else
 		current_group->value[current_group->num_rules - 1] =
 			key_changed_previous_value;
 	return RTE_EFD_UPDATE_FAILED;
 }
 
-RTE_EXPORT_SYMBOL(rte_efd_update)
-int
-rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
-		const void *key, const efd_value_t value)
+/*
+ * Single key update, called with the lock of the chunk of the key held
+ */
+static int
+efd_update_locked(struct rte_efd_table * const table,
+		const unsigned int socket_id, const void *key,
+		const efd_value_t value)
 {
 	uint32_t chunk_id = 0, group_id = 0, bin_id = 0;
 	uint8_t new_bin_choice = 0;
@@ -1190,6 +1376,376 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 	return status;
 }
 
+RTE_EXPORT_SYMBOL(rte_efd_update)
+int
+rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+		const void *key, const efd_value_t value)
+{
+	uint32_t chunk_id, bin_id;
+	struct efd_offline_chunk_rules *chunk;
+	int status;
+
+	efd_compute_ids(table, key, &chunk_id, &bin_id);
+	chunk = &table->offline_chunks[chunk_id];
+
+	rte_spinlock_lock(&chunk->lock);
+	status = efd_update_locked(table, socket_id, key, value);
+	rte_spinlock_unlock(&chunk->lock);
+
+	return status;
+}
+
+/*
+ * Scratch memory of a bulk update: the state of the chunk being updated
+ * before the batch, and the key indexes sorted by chunk.
+ */
+struct efd_bulk_ctx {
+	struct efd_offline_group_rules group_rules[EFD_CHUNK_NUM_GROUPS];
+	struct efd_online_chunk online;
+	uint64_t order[];
+};
+
+#define EFD_INVALID_SLOT UINT32_MAX
+
+/**
+ * Applies a key/value pair of a batch to the offline table, and to the
+ * bin choices of the new chunk record, without searching a new perfect
+ * hash: the modified groups are only recorded in group_mask, for the
+ * search to be done once per batch.
+ *
+ * @return
+ *   Same values as efd_compute_update()
+ */
+static inline int
+efd_stage_update(struct rte_efd_table * const table,
+		struct efd_offline_chunk_rules * const chunk,
+		struct efd_online_chunk * const new_chunk, const void *key,
+		const efd_value_t value, const uint32_t bin_id,
+		uint64_t * const group_mask, uint32_t * const new_slot)
+{
+	uint8_t current_choice = efd_get_choice(new_chunk, bin_id);
+	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
+	struct efd_offline_group_rules * const current_group =
+			&chunk->group_rules[current_group_id];
+	int status = EXIT_SUCCESS;
+	uint8_t bin_size = 0;
+	int found = -1;
+	void *slot_id;
+	uint32_t new_idx;
+	unsigned int i;
+
+	/* Scan the current group and see if the key is already present */
+	for (i = 0; i < current_group->num_rules; i++) {
+		if (current_group->bin_id[i] != bin_id)
+			continue;
+
+		bin_size++;
+		if (found < 0 && unlikely(memcmp(EFD_KEY(
+				current_group->key_idx[i], table), key,
+				table->key_len) == 0))
+			found = i;
+	}
+
+	if (found >= 0) {
+		if (current_group->value[found] == value)
+			return RTE_EFD_UPDATE_NO_CHANGE;
+
+		current_group->value[found] = value;
+	} else {
+		/* Key does not exist. Insert the rule into the bin/group */
+		if (unlikely(current_group->num_rules >= EFD_MAX_GROUP_NUM_RULES)) {
+			EFD_LOG(ERR,
+					"Fatal: No room remaining for insert into "
+					"group %u bin %u",
+					current_group_id, bin_id);
+			return RTE_EFD_UPDATE_FAILED;
+		}
+
+		if (unlikely(current_group->num_rules ==
+				(EFD_MAX_GROUP_NUM_RULES - 1)))
+			status = RTE_EFD_UPDATE_WARN_GROUP_FULL;
+
+		if (rte_ring_dequeue(table->free_slots, &slot_id) != 0)
+			return RTE_EFD_UPDATE_FAILED;
+
+		new_idx = (uint32_t)((uintptr_t)slot_id);
+		rte_memcpy(EFD_KEY(new_idx, table), key, table->key_len);
+		current_group->key_idx[current_group->num_rules] = new_idx;
+		current_group->value[current_group->num_rules] = value;
+		current_group->bin_id[current_group->num_rules] = bin_id;
+		current_group->num_rules++;
+		rte_atomic_fetch_add_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
+		*new_slot = new_idx;
+		bin_size++;
+	}
+
+	*group_mask |= RTE_BIT64(current_group_id);
+
+	/* Group need to be rebalanced when it starts to get loaded */
+	if (current_group->num_rules > EFD_MIN_BALANCED_NUM_RULES) {
+		uint8_t smallest_choice = current_choice;
+		uint32_t smallest_size = current_group->num_rules - bin_size;
+		uint32_t smallest_group_id = current_group_id;
+		uint8_t choice;
+
+		for (choice = 0; choice < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
+				choice++) {
+			uint32_t test_group_id = efd_bin_to_group[choice][bin_id];
+			uint32_t num_rules =
+					chunk->group_rules[test_group_id].num_rules;
+			if (num_rules < smallest_size &&
+					num_rules + bin_size <= EFD_MAX_GROUP_NUM_RULES) {
+				smallest_choice = choice;
+				smallest_size = num_rules;
+				smallest_group_id = test_group_id;
+			}
+		}
+
+		/*
+		 * The group left by the bin keeps a valid hash function
+		 * for its remaining keys.
+		 */
+		if (smallest_group_id != current_group_id) {
+			move_groups(bin_id, bin_size,
+					&chunk->group_rules[smallest_group_id],
+					current_group);
+			efd_set_choice(new_chunk, bin_id, smallest_choice);
+			*group_mask |= RTE_BIT64(smallest_group_id);
+		}
+	}
+
+	return status;
+}
+
+static int
+efd_bulk_order_cmp(const void *a, const void *b)
+{
+	uint64_t va = *(const uint64_t *)a;
+	uint64_t vb = *(const uint64_t *)b;
+
+	return (va > vb) - (va < vb);
+}
+
+/*
+ * Update the keys of one chunk, called with the chunk lock held.
+ * Returns the number of failed keys.
+ */
+static int
+efd_update_chunk_locked(struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t chunk_id,
+		struct efd_bulk_ctx * const ctx, const uint64_t *order,
+		uint32_t num, const void **key_list,
+		const efd_value_t *value_list, int *status_list,
+		uint32_t *slot_list, const uint32_t *bin_id_list)
+{
+	struct efd_offline_chunk_rules * const chunk =
+			&table->offline_chunks[chunk_id];
+	uint64_t group_mask = 0, mask;
+	uint32_t i, idx;
+	int failed = 0;
+
+	memcpy(&ctx->online, efd_get_chunk(table, socket_id, chunk_id),
+			sizeof(ctx->online));
+	memcpy(ctx->group_rules, chunk->group_rules, sizeof(ctx->group_rules));
+
+	for (i = 0; i < num; i++) {
+		idx = (uint32_t)order[i];
+		slot_list[idx] = EFD_INVALID_SLOT;
+		status_list[idx] = efd_stage_update(table, chunk, &ctx->online,
+				key_list[idx], value_list[idx], bin_id_list[idx],
+				&group_mask, &slot_list[idx]);
+	}
+
+	/* Recompute the hash function of each modified group once */
+	for (mask = group_mask; mask != 0; mask &= mask - 1) {
+		uint32_t group_id = rte_ctz64(mask);
+
+		if (efd_search_hash(table, &chunk->group_rules[group_id],
+				&ctx->online.groups[group_id]) != 0)
+			break;
+	}
+
+	if (mask == 0) {
+		if (group_mask != 0)
+			efd_publish_chunk(table, chunk_id, &ctx->online,
+					group_mask);
+
+		for (i = 0; i < num; i++) {
+			idx = (uint32_t)order[i];
+			if (status_list[idx] == RTE_EFD_UPDATE_NO_CHANGE)
+				status_list[idx] = EXIT_SUCCESS;
+			else if (status_list[idx] == RTE_EFD_UPDATE_FAILED)
+				failed++;
+		}
+		return failed;
+	}
+
+	EFD_LOG(DEBUG, "Failed to find perfect hash for batch of chunk %u, "
+			"updating its %u keys one at a time", chunk_id, num);
+
+	/* Revert the batch and apply it key by key */
+	memcpy(chunk->group_rules, ctx->group_rules, sizeof(ctx->group_rules));
+	for (i = 0; i < num; i++) {
+		idx = (uint32_t)order[i];
+		if (slot_list[idx] == EFD_INVALID_SLOT)
+			continue;
+		rte_ring_enqueue(table->free_slots,
+				(void *)((uintptr_t)slot_list[idx]));
+		rte_atomic_fetch_sub_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
+	}
+
+	for (i = 0; i < num; i++) {
+		idx = (uint32_t)order[i];
+		status_list[idx] = efd_update_locked(table, socket_id,
+				key_list[idx], value_list[idx]);
+		if (status_list[idx] == RTE_EFD_UPDATE_FAILED)
+			failed++;
+	}
+
+	return failed;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_update_bulk, 25.07)
+int
+rte_efd_update_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const int num_keys,
+		const void **key_list, const efd_value_t *value_list,
+		int *status_list)
+{
+	struct efd_bulk_ctx *ctx;
+	uint32_t *chunk_id_list, *bin_id_list, *slot_list;
+	int *status;
+	uint32_t i, first, chunk_id;
+	int failed = 0;
+
+	if (table == NULL || num_keys < 0 || (num_keys > 0 &&
+			(key_list == NULL || value_list == NULL)))
+		return -EINVAL;
+
+	if (num_keys == 0)
+		return 0;
+
+	ctx = rte_malloc(NULL, sizeof(*ctx) + num_keys * (sizeof(uint64_t) +
+			3 * sizeof(uint32_t) + sizeof(int)), RTE_CACHE_LINE_SIZE);
+	if (ctx == NULL)
+		return -ENOMEM;
+
+	chunk_id_list = (uint32_t *)&ctx->order[num_keys];
+	bin_id_list = &chunk_id_list[num_keys];
+	slot_list = &bin_id_list[num_keys];
+	status = status_list != NULL ? status_list :
+			(int *)&slot_list[num_keys];
+
+	/* Sort the keys by chunk, keeping the batch order within a chunk */
+	for (i = 0; i < (uint32_t)num_keys; i++) {
+		efd_compute_ids(table, key_list[i], &chunk_id_list[i],
+				&bin_id_list[i]);
+		ctx->order[i] = ((uint64_t)chunk_id_list[i] << 32) | i;
+	}
+	qsort(ctx->order, num_keys, sizeof(ctx->order[0]), efd_bulk_order_cmp);
+
+	for (first = 0; first < (uint32_t)num_keys; first = i) {
+		chunk_id = ctx->order[first] >> 32;
+		for (i = first + 1; i < (uint32_t)num_keys &&
+				(ctx->order[i] >> 32) == chunk_id; i++)
+			;
+
+		rte_spinlock_lock(&table->offline_chunks[chunk_id].lock);
+		failed += efd_update_chunk_locked(table, socket_id, chunk_id,
+				ctx, &ctx->order[first], i - first, key_list,
+				value_list, status, slot_list, bin_id_list);
+		rte_spinlock_unlock(&table->offline_chunks[chunk_id].lock);
+	}
+
+	rte_free(ctx);
+
+	return failed;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_rcu_qsbr_add, 25.07)
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+		struct rte_efd_rcu_config *cfg)
+{
+	RTE_ATOMIC(struct efd_online_chunk *) *chunks[RTE_MAX_NUMA_NODES] = {0};
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	unsigned int socket_id;
+	int ret = -ENOMEM;
+	uint32_t i;
+
+	if (table == NULL || cfg == NULL || cfg->v == NULL)
+		return -EINVAL;
+
+	if (table->v != NULL)
+		return -EEXIST;
+
+	if (cfg->mode != RTE_EFD_QSBR_MODE_SYNC &&
+			cfg->mode != RTE_EFD_QSBR_MODE_DQ)
+		return -EINVAL;
+
+	/* The updates now replace the chunk records through pointers */
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		if (table->chunk_blocks[socket_id] == NULL)
+			continue;
+		chunks[socket_id] = rte_malloc_socket(NULL,
+				table->num_chunks * sizeof(chunks[socket_id][0]),
+				RTE_CACHE_LINE_SIZE, socket_id);
+		if (chunks[socket_id] == NULL) {
+			EFD_LOG(ERR, "Allocating EFD chunk pointers on "
+					"socket %u failed", socket_id);
+			goto error;
+		}
+		for (i = 0; i < table->num_chunks; i++)
+			chunks[socket_id][i] = &table->chunk_blocks[socket_id][i];
+	}
+
+	if (cfg->mode == RTE_EFD_QSBR_MODE_SYNC) {
+		/* No other things to do. */
+	} else if (cfg->mode == RTE_EFD_QSBR_MODE_DQ) {
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+				"EFD_RCU_%s", table->name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = RTE_EFD_RCU_DQ_RECLAIM_SZ;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_EFD_RCU_DQ_RECLAIM_MAX;
+		/* Chunk record and its socket */
+		params.esize = 2 * sizeof(uintptr_t);
+		params.free_fn = efd_rcu_qsbr_free_resource;
+		params.p = table;
+		params.v = cfg->v;
+		table->dq = rte_rcu_qsbr_dq_create(&params);
+		if (table->dq == NULL) {
+			EFD_LOG(ERR, "EFD defer queue creation failed");
+			ret = -rte_errno;
+			goto error;
+		}
+	}
+
+	/*
+	 * No update is done yet, the lookups find the same records
+	 * through the pointers as in the blocks.
+	 */
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+		table->chunks[socket_id] = chunks[socket_id];
+	table->rcu_mode = cfg->mode;
+	table->v = cfg->v;
+
+	return 0;
+
+error:
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+		rte_free(chunks[socket_id]);
+	return ret;
+}
+
 RTE_EXPORT_SYMBOL(rte_efd_delete)
 int
 rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
@@ -1204,8 +1760,10 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	struct efd_offline_chunk_rules * const chunk =
 			&table->offline_chunks[chunk_id];
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
-			chunk_id, bin_id);
+	rte_spinlock_lock(&chunk->lock);
+
+	uint8_t current_choice = efd_get_choice(
+			efd_get_chunk(table, socket_id, chunk_id), bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
@@ -1224,7 +1782,7 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 					*prev_value = current_group->value[i];
 
 				not_found = 0;
-				rte_ring_sp_enqueue(table->free_slots,
+				rte_ring_enqueue(table->free_slots,
 					(void *)((uintptr_t)current_group->key_idx[i]));
 			}
 		} else {
@@ -1241,10 +1799,13 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	}
 
 	if (not_found == 0) {
-		table->num_rules--;
+		rte_atomic_fetch_sub_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
 		current_group->num_rules--;
 	}
 
+	rte_spinlock_unlock(&chunk->lock);
+
 	return not_found;
 }
 
@@ -1315,13 +1876,14 @@ rte_efd_lookup(const struct rte_efd_table * const table,
 	uint32_t chunk_id, group_id, bin_id;
 	uint8_t bin_choice;
 	const struct efd_online_group_entry *group;
-	const struct efd_online_chunk * const chunks = table->chunks[socket_id];
+	const struct efd_online_chunk *chunk;
 
 	/* Determine the chunk and group location for the given key */
 	efd_compute_ids(table, key, &chunk_id, &bin_id);
-	bin_choice = efd_get_choice(table, socket_id, chunk_id, bin_id);
+	chunk = efd_get_chunk(table, socket_id, chunk_id);
+	bin_choice = efd_get_choice(chunk, bin_id);
 	group_id = efd_bin_to_group[bin_choice][bin_id];
-	group = &chunks[chunk_id].groups[group_id];
+	group = &chunk->groups[group_id];
 
 	return efd_lookup_internal(group,
 			EFD_HASHFUNCA(key, table),
@@ -1339,27 +1901,28 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	uint32_t bin_id_list[RTE_EFD_BURST_MAX];
 	uint8_t bin_choice_list[RTE_EFD_BURST_MAX];
 	uint32_t group_id_list[RTE_EFD_BURST_MAX];
-	struct efd_online_group_entry *group;
-
-	struct efd_online_chunk *chunks = table->chunks[socket_id];
+	const struct efd_online_chunk *chunk_list[RTE_EFD_BURST_MAX];
+	const struct efd_online_group_entry *group;
 
 	for (i = 0; i < num_keys; i++) {
 		efd_compute_ids(table, key_list[i], &chunk_id_list[i],
 				&bin_id_list[i]);
-		rte_prefetch0(&chunks[chunk_id_list[i]].bin_choice_list);
+		chunk_list[i] = efd_get_chunk(table, socket_id,
+				chunk_id_list[i]);
+		rte_prefetch0(&chunk_list[i]->bin_choice_list);
 	}
 
 	for (i = 0; i < num_keys; i++) {
-		bin_choice_list[i] = efd_get_choice(table, socket_id,
-				chunk_id_list[i], bin_id_list[i]);
+		bin_choice_list[i] = efd_get_choice(chunk_list[i],
+				bin_id_list[i]);
 		group_id_list[i] =
 				efd_bin_to_group[bin_choice_list[i]][bin_id_list[i]];
-		group = &chunks[chunk_id_list[i]].groups[group_id_list[i]];
+		group = &chunk_list[i]->groups[group_id_list[i]];
 		rte_prefetch0(group);
 	}
 
 	for (i = 0; i < num_keys; i++) {
-		group = &chunks[chunk_id_list[i]].groups[group_id_list[i]];
+		group = &chunk_list[i]->groups[group_id_list[i]];
 		value_list[i] = efd_lookup_internal(group,
 				EFD_HASHFUNCA(key_list[i], table),
 				EFD_HASHFUNCB(key_list[i], table),
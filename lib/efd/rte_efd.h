@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -116,6 +119,39 @@ typedef uint32_t efd_value_t;
 typedef uint16_t efd_lookuptbl_t;
 typedef uint16_t efd_hashfunc_t;
 
+/** @internal Default RCU defer queue entries to reclaim in one go. */
+#define RTE_EFD_RCU_DQ_RECLAIM_MAX	16
+/** @internal Default RCU defer queue size. */
+#define RTE_EFD_RCU_DQ_RECLAIM_SZ	128
+
+/** RCU reclamation modes */
+enum rte_efd_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_EFD_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_EFD_QSBR_MODE_SYNC
+};
+
+/** EFD RCU QSBR configuration structure. */
+struct rte_efd_rcu_config {
+	/** RCU QSBR variable. */
+	struct rte_rcu_qsbr *v;
+	/** Mode of RCU QSBR. See RTE_EFD_QSBR_MODE_xxx.
+	 * Default: RTE_EFD_QSBR_MODE_DQ, create defer queue for reclaim.
+	 */
+	enum rte_efd_qsbr_mode mode;
+	/** RCU defer queue size.
+	 * Default: RTE_EFD_RCU_DQ_RECLAIM_SZ.
+	 */
+	uint32_t dq_size;
+	/** Threshold to trigger auto reclaim. */
+	uint32_t reclaim_thd;
+	/** Max entries to reclaim in one go.
+	 * Default: RTE_EFD_RCU_DQ_RECLAIM_MAX.
+	 */
+	uint32_t reclaim_max;
+};
+
 /**
  * Creates an EFD table with a single offline region and multiple per-socket
  * internally-managed copies of the online table used for lookups
@@ -172,8 +208,10 @@ rte_efd_find_existing(const char *name);
  * Computes an updated table entry for the supplied key/value pair.
  * The update is then immediately applied to the provided table and
  * all socket-local copies of the chunks are updated.
- * This operation is not multi-thread safe
- * and should only be called one from thread.
+ * This operation is multi-thread safe: writers serialize per chunk,
+ * so that updates of keys in different chunks run in parallel.
+ * Concurrent lookups see a consistent group only when an RCU QSBR
+ * variable is associated with the table, see rte_efd_rcu_qsbr_add().
  *
  * @param table
  *   EFD table to reference
@@ -203,8 +241,7 @@ rte_efd_update(struct rte_efd_table *table, unsigned int socket_id,
 
 /**
  * Removes any value currently associated with the specified key from the table
- * This operation is not multi-thread safe
- * and should only be called from one thread.
+ * This operation is multi-thread safe.
  *
  * @param table
  *   EFD table to reference
@@ -223,6 +260,42 @@ int
 rte_efd_delete(struct rte_efd_table *table, unsigned int socket_id,
 	const void *key, efd_value_t *prev_value);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Computes and applies updated table entries for several key/value pairs.
+ * The keys are processed chunk by chunk, and each group of a chunk that
+ * is affected by the batch gets its perfect hash recomputed only once,
+ * instead of once per key as with rte_efd_update().
+ * If no perfect hash can be found for the batch of a chunk, the keys of
+ * this chunk are applied one at a time as rte_efd_update() does.
+ * This operation is multi-thread safe.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID to use to lookup existing value (ideally caller's socket id)
+ * @param num_keys
+ *   Number of keys in the key_list array
+ * @param key_list
+ *   Array of num_keys pointers which point to keys to modify
+ * @param value_list
+ *   Array of num_keys values to associate with the keys
+ * @param status_list
+ *   If not NULL, array of num_keys where the result of rte_efd_update()
+ *   for each key is stored
+ *
+ * @return
+ *   Number of keys for which the update failed, with status
+ *   RTE_EFD_UPDATE_FAILED, or a negative errno value for invalid parameters
+ */
+__rte_experimental
+int
+rte_efd_update_bulk(struct rte_efd_table *table, unsigned int socket_id,
+		int num_keys, const void **key_list, const efd_value_t *value_list,
+		int *status_list);
+
 /**
  * Looks up the value associated with a key
  * This operation is multi-thread safe.
@@ -273,6 +346,35 @@ rte_efd_lookup_bulk(const struct rte_efd_table *table, unsigned int socket_id,
 		int num_keys, const void **key_list,
 		efd_value_t *value_list);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Associate RCU QSBR variable with an EFD table.
+ *
+ * Once associated, updates are applied to a copy of the affected online
+ * chunk, which then replaces the chunk seen by lookups. The replaced
+ * chunk is freed after the lookup threads reported a quiescent state,
+ * so that a lookup never reads a partially updated group.
+ * Must be called before any update is done on the table.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EEXIST - already added QSBR
+ *   - -ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+		struct rte_efd_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,7 @@
 #include <rte_fib.h>
 #include "dir24_8.h"
 #include "fib_log.h"
+#include "fib_snapshot.h"
 
 #ifdef CC_AVX512_SUPPORT
 
@@ -655,3 +656,79 @@ dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 
 	return 0;
 }
+
+int
+dir24_8_snapshot_prepare(struct dir24_8_tbl *dp, struct fib_snapshot_hdr *hdr,
+	const void *data[])
+{
+	unsigned int pending = 0;
+
+	/* tbl8 groups waiting for readers would be lost */
+	if (dp->dq != NULL) {
+		rte_rcu_qsbr_dq_reclaim(dp->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0)
+			return -EBUSY;
+	}
+
+	hdr->nh_sz = dp->nh_sz;
+	hdr->number_tbl8s = dp->number_tbl8s;
+	hdr->rsvd_tbl8s = dp->rsvd_tbl8s;
+	hdr->cur_tbl8s = dp->cur_tbl8s;
+	hdr->def_nh = dp->def_nh;
+
+	hdr->sec[FIB_SNAPSHOT_TBL24].len =
+		(uint64_t)DIR24_8_TBL24_NUM_ENT << dp->nh_sz;
+	data[FIB_SNAPSHOT_TBL24] = dp->tbl24;
+	hdr->sec[FIB_SNAPSHOT_TBL8].len = ((uint64_t)DIR24_8_TBL8_GRP_NUM_ENT *
+		(dp->number_tbl8s + 1)) << dp->nh_sz;
+	data[FIB_SNAPSHOT_TBL8] = dp->tbl8;
+	hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len =
+		RTE_ALIGN_CEIL(dp->number_tbl8s, 64) >> 3;
+	data[FIB_SNAPSHOT_TBL8_IDX] = dp->tbl8_idxes;
+
+	return 0;
+}
+
+int
+dir24_8_snapshot_check(struct dir24_8_tbl *dp,
+	const struct fib_snapshot_hdr *hdr)
+{
+	unsigned int pending;
+
+	if (hdr->nh_sz != dp->nh_sz || hdr->number_tbl8s != dp->number_tbl8s ||
+			hdr->def_nh != dp->def_nh ||
+			hdr->rsvd_tbl8s > dp->number_tbl8s ||
+			hdr->cur_tbl8s > dp->number_tbl8s ||
+			hdr->sec[FIB_SNAPSHOT_TBL24].len !=
+			(uint64_t)DIR24_8_TBL24_NUM_ENT << dp->nh_sz ||
+			hdr->sec[FIB_SNAPSHOT_TBL8].len !=
+			((uint64_t)DIR24_8_TBL8_GRP_NUM_ENT *
+			(dp->number_tbl8s + 1)) << dp->nh_sz ||
+			hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len !=
+			RTE_ALIGN_CEIL(dp->number_tbl8s, 64) >> 3)
+		return -EINVAL;
+
+	/* tbl8 groups waiting for readers would be freed into the restored
+	 * tables
+	 */
+	if (dp->dq != NULL) {
+		rte_rcu_qsbr_dq_reclaim(dp->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0)
+			return -EBUSY;
+	}
+	return 0;
+}
+
+void
+dir24_8_snapshot_restore(struct dir24_8_tbl *dp,
+	const struct fib_snapshot_hdr *hdr)
+{
+	memcpy(dp->tbl24, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL24),
+		hdr->sec[FIB_SNAPSHOT_TBL24].len);
+	memcpy(dp->tbl8, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL8),
+		hdr->sec[FIB_SNAPSHOT_TBL8].len);
+	memcpy(dp->tbl8_idxes, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL8_IDX),
+		hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len);
+	dp->rsvd_tbl8s = hdr->rsvd_tbl8s;
+	dp->cur_tbl8s = hdr->cur_tbl8s;
+}
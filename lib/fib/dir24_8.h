@@ -303,4 +303,18 @@ int
 dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 	const char *name);
 
+struct fib_snapshot_hdr;
+
+int
+dir24_8_snapshot_prepare(struct dir24_8_tbl *dp, struct fib_snapshot_hdr *hdr,
+	const void *data[]);
+
+int
+dir24_8_snapshot_check(struct dir24_8_tbl *dp,
+	const struct fib_snapshot_hdr *hdr);
+
+void
+dir24_8_snapshot_restore(struct dir24_8_tbl *dp,
+	const struct fib_snapshot_hdr *hdr);
+
 #endif /* _DIR24_8_H_ */
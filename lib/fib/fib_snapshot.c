@@ -0,0 +1,170 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
+#include <rte_hash_crc.h>
+#include <rte_log.h>
+
+#include "fib_log.h"
+#include "fib_snapshot.h"
+
+#define FIB_SNAPSHOT_ALIGN	4096
+/* Checksum is computed by chunks, as rte_hash_crc() length is 32-bit. */
+#define FIB_SNAPSHOT_CRC_CHUNK	(UINT32_C(1) << 30)
+
+static uint32_t
+fib_snapshot_crc(const void *data, uint64_t len, uint32_t crc)
+{
+	const uint8_t *p = data;
+	uint32_t n;
+
+	while (len != 0) {
+		n = RTE_MIN(len, (uint64_t)FIB_SNAPSHOT_CRC_CHUNK);
+		crc = rte_hash_crc(p, n, crc);
+		p += n;
+		len -= n;
+	}
+	return crc;
+}
+
+int
+fib_snapshot_write(const char *path, struct fib_snapshot_hdr *hdr,
+	const void * const data[FIB_SNAPSHOT_NB_SECS])
+{
+	static const uint8_t zero[FIB_SNAPSHOT_ALIGN];
+	uint64_t off, pos, pad;
+	unsigned int i;
+	uint32_t crc;
+	FILE *f;
+
+	hdr->magic = FIB_SNAPSHOT_MAGIC;
+	hdr->version = FIB_SNAPSHOT_VERSION;
+	hdr->crc = 0;
+	off = RTE_ALIGN_CEIL(sizeof(*hdr), FIB_SNAPSHOT_ALIGN);
+	for (i = 0; i < FIB_SNAPSHOT_NB_SECS; i++) {
+		hdr->sec[i].off = off;
+		off += RTE_ALIGN_CEIL(hdr->sec[i].len, FIB_SNAPSHOT_ALIGN);
+	}
+
+	f = fopen(path, "wb");
+	if (f == NULL) {
+		FIB_LOG(ERR, "Cannot create FIB snapshot %s: %s",
+			path, strerror(errno));
+		return -errno;
+	}
+
+	/* header is written last, once the checksum is known */
+	crc = fib_snapshot_crc(hdr, sizeof(*hdr), 0);
+	pos = 0;
+	for (i = 0; i < FIB_SNAPSHOT_NB_SECS; i++) {
+		if (hdr->sec[i].len == 0)
+			continue;
+		for (pad = hdr->sec[i].off - pos; pad != 0; pad -= RTE_MIN(pad,
+				sizeof(zero))) {
+			if (fwrite(zero, RTE_MIN(pad, sizeof(zero)), 1, f) != 1)
+				goto error;
+		}
+		if (fwrite(data[i], hdr->sec[i].len, 1, f) != 1)
+			goto error;
+		crc = fib_snapshot_crc(data[i], hdr->sec[i].len, crc);
+		pos = hdr->sec[i].off + hdr->sec[i].len;
+	}
+
+	hdr->crc = crc;
+	if (fseek(f, 0, SEEK_SET) != 0 || fwrite(hdr, sizeof(*hdr), 1, f) != 1)
+		goto error;
+	if (fclose(f) != 0) {
+		f = NULL;
+		goto error;
+	}
+	return 0;
+
+error:
+	FIB_LOG(ERR, "Cannot write FIB snapshot %s: %s", path, strerror(errno));
+	if (f != NULL)
+		fclose(f);
+	remove(path);
+	return -EIO;
+}
+
+const struct fib_snapshot_hdr *
+fib_snapshot_map(const char *path, uint32_t family, size_t *size)
+{
+	const struct fib_snapshot_hdr *hdr;
+	struct fib_snapshot_hdr tmp;
+	struct stat st;
+	unsigned int i;
+	uint32_t crc;
+	void *base;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		FIB_LOG(ERR, "Cannot open FIB snapshot %s: %s",
+			path, strerror(errno));
+		rte_errno = errno;
+		return NULL;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*hdr)) {
+		close(fd);
+		FIB_LOG(ERR, "Invalid FIB snapshot %s", path);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	base = rte_mem_map(NULL, st.st_size, RTE_PROT_READ, RTE_MAP_PRIVATE,
+			fd, 0);
+	close(fd);
+	if (base == NULL) {
+		FIB_LOG(ERR, "Cannot map FIB snapshot %s", path);
+		return NULL;
+	}
+	hdr = base;
+
+	if (hdr->magic != FIB_SNAPSHOT_MAGIC ||
+			hdr->version != FIB_SNAPSHOT_VERSION ||
+			hdr->family != family) {
+		FIB_LOG(ERR, "%s is not an IPv%u FIB snapshot", path, family);
+		goto error;
+	}
+	for (i = 0; i < FIB_SNAPSHOT_NB_SECS; i++) {
+		if (hdr->sec[i].off + hdr->sec[i].len > (uint64_t)st.st_size) {
+			FIB_LOG(ERR, "FIB snapshot %s is truncated", path);
+			goto error;
+		}
+	}
+
+	tmp = *hdr;
+	tmp.crc = 0;
+	crc = fib_snapshot_crc(&tmp, sizeof(tmp), 0);
+	for (i = 0; i < FIB_SNAPSHOT_NB_SECS; i++)
+		crc = fib_snapshot_crc(fib_snapshot_sec_data(hdr, i),
+				hdr->sec[i].len, crc);
+	if (crc != hdr->crc) {
+		FIB_LOG(ERR, "FIB snapshot %s checksum mismatch", path);
+		goto error;
+	}
+
+	*size = st.st_size;
+	return hdr;
+
+error:
+	rte_mem_unmap(base, st.st_size);
+	rte_errno = EINVAL;
+	return NULL;
+}
+
+void
+fib_snapshot_unmap(const struct fib_snapshot_hdr *hdr, size_t size)
+{
+	rte_mem_unmap((void *)(uintptr_t)hdr, size);
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _FIB_SNAPSHOT_H_
+#define _FIB_SNAPSHOT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file
+ * FIB snapshot file format, shared by the IPv4 and IPv6 FIBs.
+ *
+ * A snapshot is a header followed by page aligned sections: the dataplane
+ * tables, as they are laid out in memory, and the list of routes used to
+ * refill the RIB.
+ */
+
+#define FIB_SNAPSHOT_MAGIC	UINT64_C(0x50414e534249465f) /* "_FIBSNAP" */
+#define FIB_SNAPSHOT_VERSION	1
+
+enum fib_snapshot_sec_id {
+	FIB_SNAPSHOT_TBL24,
+	FIB_SNAPSHOT_TBL8,
+	FIB_SNAPSHOT_TBL8_IDX,	/* tbl8 allocator: bitmap or pool */
+	FIB_SNAPSHOT_ROUTES,
+	FIB_SNAPSHOT_NB_SECS
+};
+
+/* Section descriptor, the offset is from the start of the file. */
+struct fib_snapshot_sec {
+	uint64_t off;
+	uint64_t len;
+};
+
+struct fib_snapshot_hdr {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t crc;		/* of the header with crc set to 0 and data */
+	uint32_t family;	/* 4 or 6 */
+	uint32_t type;		/* enum rte_fib_type or rte_fib6_type */
+	uint32_t nh_sz;
+	uint32_t number_tbl8s;
+	uint32_t rsvd_tbl8s;
+	uint32_t cur_tbl8s;
+	uint32_t tbl8_pool_pos;
+	uint32_t nb_routes;
+	uint64_t def_nh;
+	struct fib_snapshot_sec sec[FIB_SNAPSHOT_NB_SECS];
+};
+
+/*
+ * Write a snapshot. The section lengths must be set in the header, the
+ * offsets and the checksum are computed.
+ */
+int
+fib_snapshot_write(const char *path, struct fib_snapshot_hdr *hdr,
+	const void * const data[FIB_SNAPSHOT_NB_SECS]);
+
+/*
+ * Map a snapshot and check its header and checksum.
+ * Return the mapped header, or NULL with rte_errno set.
+ */
+const struct fib_snapshot_hdr *
+fib_snapshot_map(const char *path, uint32_t family, size_t *size);
+
+void
+fib_snapshot_unmap(const struct fib_snapshot_hdr *hdr, size_t size);
+
+static inline const void *
+fib_snapshot_sec_data(const struct fib_snapshot_hdr *hdr,
+	enum fib_snapshot_sec_id id)
+{
+	return (const uint8_t *)hdr + hdr->sec[id].off;
+}
+
+#endif /* _FIB_SNAPSHOT_H_ */
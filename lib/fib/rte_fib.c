@@ -19,6 +19,7 @@
 
 #include "dir24_8.h"
 #include "fib_log.h"
+#include "fib_snapshot.h"
 
 RTE_LOG_REGISTER_DEFAULT(fib_logtype, INFO);
 
@@ -367,3 +368,155 @@ rte_fib_rcu_qsbr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg)
 		return -ENOTSUP;
 	}
 }
+
+/* Route of a FIB snapshot, used to refill the RIB. */
+struct fib_snapshot_route {
+	uint64_t nh;
+	uint32_t ip;
+	uint8_t depth;
+	uint8_t reserved[3];
+};
+
+static void
+fib_snapshot_set_route(struct fib_snapshot_route *route,
+	const struct rte_rib_node *node)
+{
+	rte_rib_get_ip(node, &route->ip);
+	rte_rib_get_depth(node, &route->depth);
+	rte_rib_get_nh(node, &route->nh);
+}
+
+static struct fib_snapshot_route *
+fib_snapshot_get_routes(struct rte_rib *rib, uint32_t *nb_routes)
+{
+	struct fib_snapshot_route *routes;
+	struct rte_rib_node *def, *node;
+	uint32_t i, n = 0;
+
+	/* rte_rib_get_nxt() does not return the covering prefix itself */
+	def = rte_rib_lookup_exact(rib, 0, 0);
+	if (def != NULL)
+		n++;
+	for (node = NULL; (node = rte_rib_get_nxt(rib, 0, 0, node,
+			RTE_RIB_GET_NXT_ALL)) != NULL;)
+		n++;
+
+	routes = rte_zmalloc("FIB_SNAPSHOT", RTE_MAX(n, 1U) * sizeof(*routes),
+		0);
+	if (routes == NULL)
+		return NULL;
+
+	i = 0;
+	if (def != NULL)
+		fib_snapshot_set_route(&routes[i++], def);
+	for (node = NULL; (node = rte_rib_get_nxt(rib, 0, 0, node,
+			RTE_RIB_GET_NXT_ALL)) != NULL;)
+		fib_snapshot_set_route(&routes[i++], node);
+	*nb_routes = n;
+	return routes;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_snapshot_save, 25.07)
+int
+rte_fib_snapshot_save(struct rte_fib *fib, const char *path)
+{
+	const void *data[FIB_SNAPSHOT_NB_SECS] = { NULL };
+	struct fib_snapshot_route *routes;
+	struct fib_snapshot_hdr hdr;
+	int ret;
+
+	if (fib == NULL || path == NULL)
+		return -EINVAL;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.family = 4;
+	hdr.type = fib->type;
+	hdr.def_nh = fib->def_nh;
+	if (fib->type == RTE_FIB_DIR24_8) {
+		ret = dir24_8_snapshot_prepare(fib->dp, &hdr, data);
+		if (ret < 0)
+			return ret;
+	}
+
+	routes = fib_snapshot_get_routes(fib->rib, &hdr.nb_routes);
+	if (routes == NULL)
+		return -ENOMEM;
+	hdr.sec[FIB_SNAPSHOT_ROUTES].len = (uint64_t)hdr.nb_routes *
+		sizeof(*routes);
+	data[FIB_SNAPSHOT_ROUTES] = routes;
+
+	ret = fib_snapshot_write(path, &hdr, data);
+	rte_free(routes);
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_snapshot_load, 25.07)
+int
+rte_fib_snapshot_load(struct rte_fib *fib, const char *path)
+{
+	const struct fib_snapshot_route *routes;
+	const struct fib_snapshot_hdr *hdr;
+	struct rte_rib_node *node;
+	size_t size;
+	uint32_t i;
+	int ret = 0;
+
+	if (fib == NULL || path == NULL)
+		return -EINVAL;
+
+	if (rte_rib_lookup_exact(fib->rib, 0, 0) != NULL ||
+			rte_rib_get_nxt(fib->rib, 0, 0, NULL,
+			RTE_RIB_GET_NXT_ALL) != NULL) {
+		FIB_LOG(ERR, "FIB %s must be empty to load a snapshot",
+			fib->name);
+		return -EEXIST;
+	}
+
+	hdr = fib_snapshot_map(path, 4, &size);
+	if (hdr == NULL)
+		return -rte_errno;
+
+	if (hdr->type != (uint32_t)fib->type || hdr->def_nh != fib->def_nh ||
+			hdr->sec[FIB_SNAPSHOT_ROUTES].len !=
+			(uint64_t)hdr->nb_routes * sizeof(*routes))
+		ret = -EINVAL;
+	else if (fib->type == RTE_FIB_DIR24_8)
+		ret = dir24_8_snapshot_check(fib->dp, hdr);
+	if (ret == -EBUSY) {
+		FIB_LOG(ERR, "FIB %s has tbl8 groups waiting for readers",
+			fib->name);
+		goto exit;
+	} else if (ret != 0) {
+		FIB_LOG(ERR, "FIB snapshot %s does not match FIB %s",
+			path, fib->name);
+		goto exit;
+	}
+
+	/* Refill the RIB first, the dataplane is only written on success. */
+	routes = fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_ROUTES);
+	for (i = 0; i < hdr->nb_routes; i++) {
+		if (routes[i].depth > RTE_FIB_MAXDEPTH) {
+			ret = -EINVAL;
+			break;
+		}
+		node = rte_rib_insert(fib->rib, routes[i].ip, routes[i].depth);
+		if (node == NULL) {
+			ret = -rte_errno;
+			break;
+		}
+		rte_rib_set_nh(node, routes[i].nh);
+	}
+	if (ret != 0) {
+		FIB_LOG(ERR, "Cannot restore routes of FIB %s", fib->name);
+		while (i-- > 0)
+			rte_rib_remove(fib->rib, routes[i].ip, routes[i].depth);
+		goto exit;
+	}
+
+	if (fib->type == RTE_FIB_DIR24_8)
+		dir24_8_snapshot_restore(fib->dp, hdr);
+
+exit:
+	fib_snapshot_unmap(hdr, size);
+	return ret;
+}
@@ -280,6 +280,70 @@ __rte_experimental
 int
 rte_fib_rcu_qsbr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Save the routes and the dataplane tables of a FIB to a file.
+ *
+ * The dataplane tables are written as they are laid out in memory, so
+ * that rte_fib_snapshot_load() restores them without processing the
+ * routes again. The RIB extension area is not saved.
+ * If a defer queue is used, it is reclaimed first.
+ *
+ * This function must not be called concurrently with a FIB update.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param path
+ *   Path of the file to create
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EBUSY - tbl8 groups are still referenced by readers
+ *   - -ENOMEM - memory allocation failure
+ *   - -EIO or another errno value - the file cannot be written
+ */
+__rte_experimental
+int
+rte_fib_snapshot_save(struct rte_fib *fib, const char *path);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Restore the routes and the dataplane tables of a FIB from a file
+ * written by rte_fib_snapshot_save().
+ *
+ * The FIB must be empty, and must have been created with the same type,
+ * default next hop and dataplane configuration as the saved FIB.
+ * The file is mapped and its checksum is verified before the FIB is
+ * modified.
+ *
+ * This function must not be called concurrently with any other operation
+ * on the FIB, including lookups.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param path
+ *   Path of the snapshot file
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters, or the snapshot does not match the FIB
+ *   - -EEXIST - the FIB is not empty
+ *   - -EBUSY - tbl8 groups are still waiting for RCU readers
+ *   - -ENOSPC or -ENOMEM - the RIB cannot hold the routes
+ *   - another errno value - the file cannot be read
+ *   The FIB is left unchanged on error.
+ */
+__rte_experimental
+int
+rte_fib_snapshot_load(struct rte_fib *fib, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
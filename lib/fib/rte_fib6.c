@@ -21,6 +21,7 @@
 
 #include "trie.h"
 #include "fib_log.h"
+#include "fib_snapshot.h"
 
 TAILQ_HEAD(rte_fib6_list, rte_tailq_entry);
 static struct rte_tailq_elem rte_fib6_tailq = {
@@ -349,3 +350,174 @@ rte_fib6_select_lookup(struct rte_fib6 *fib,
 		return -EINVAL;
 	}
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib6_rcu_qsbr_add, 25.07)
+int
+rte_fib6_rcu_qsbr_add(struct rte_fib6 *fib, struct rte_fib6_rcu_config *cfg)
+{
+	if (fib == NULL)
+		return -EINVAL;
+
+	switch (fib->type) {
+	case RTE_FIB6_TRIE:
+		return trie_rcu_qsbr_add(fib->dp, cfg, fib->name);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+/* Route of a FIB snapshot, used to refill the RIB. */
+struct fib6_snapshot_route {
+	uint64_t nh;
+	struct rte_ipv6_addr ip;
+	uint8_t depth;
+	uint8_t reserved[7];
+};
+
+static void
+fib6_snapshot_set_route(struct fib6_snapshot_route *route,
+	const struct rte_rib6_node *node)
+{
+	rte_rib6_get_ip(node, &route->ip);
+	rte_rib6_get_depth(node, &route->depth);
+	rte_rib6_get_nh(node, &route->nh);
+}
+
+static struct fib6_snapshot_route *
+fib6_snapshot_get_routes(struct rte_rib6 *rib, uint32_t *nb_routes)
+{
+	const struct rte_ipv6_addr unspec = RTE_IPV6_ADDR_UNSPEC;
+	struct fib6_snapshot_route *routes;
+	struct rte_rib6_node *def, *node;
+	uint32_t i, n = 0;
+
+	/* rte_rib6_get_nxt() does not return the covering prefix itself */
+	def = rte_rib6_lookup_exact(rib, &unspec, 0);
+	if (def != NULL)
+		n++;
+	for (node = NULL; (node = rte_rib6_get_nxt(rib, &unspec, 0, node,
+			RTE_RIB6_GET_NXT_ALL)) != NULL;)
+		n++;
+
+	routes = rte_zmalloc("FIB6_SNAPSHOT", RTE_MAX(n, 1U) * sizeof(*routes),
+		0);
+	if (routes == NULL)
+		return NULL;
+
+	i = 0;
+	if (def != NULL)
+		fib6_snapshot_set_route(&routes[i++], def);
+	for (node = NULL; (node = rte_rib6_get_nxt(rib, &unspec, 0, node,
+			RTE_RIB6_GET_NXT_ALL)) != NULL;)
+		fib6_snapshot_set_route(&routes[i++], node);
+	*nb_routes = n;
+	return routes;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib6_snapshot_save, 25.07)
+int
+rte_fib6_snapshot_save(struct rte_fib6 *fib, const char *path)
+{
+	const void *data[FIB_SNAPSHOT_NB_SECS] = { NULL };
+	struct fib6_snapshot_route *routes;
+	struct fib_snapshot_hdr hdr;
+	int ret;
+
+	if (fib == NULL || path == NULL)
+		return -EINVAL;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.family = 6;
+	hdr.type = fib->type;
+	hdr.def_nh = fib->def_nh;
+	if (fib->type == RTE_FIB6_TRIE) {
+		ret = trie_snapshot_prepare(fib->dp, &hdr, data);
+		if (ret < 0)
+			return ret;
+	}
+
+	routes = fib6_snapshot_get_routes(fib->rib, &hdr.nb_routes);
+	if (routes == NULL)
+		return -ENOMEM;
+	hdr.sec[FIB_SNAPSHOT_ROUTES].len = (uint64_t)hdr.nb_routes *
+		sizeof(*routes);
+	data[FIB_SNAPSHOT_ROUTES] = routes;
+
+	ret = fib_snapshot_write(path, &hdr, data);
+	rte_free(routes);
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib6_snapshot_load, 25.07)
+int
+rte_fib6_snapshot_load(struct rte_fib6 *fib, const char *path)
+{
+	const struct rte_ipv6_addr unspec = RTE_IPV6_ADDR_UNSPEC;
+	const struct fib6_snapshot_route *routes;
+	const struct fib_snapshot_hdr *hdr;
+	struct rte_rib6_node *node;
+	size_t size;
+	uint32_t i;
+	int ret = 0;
+
+	if (fib == NULL || path == NULL)
+		return -EINVAL;
+
+	if (rte_rib6_lookup_exact(fib->rib, &unspec, 0) != NULL ||
+			rte_rib6_get_nxt(fib->rib, &unspec, 0, NULL,
+			RTE_RIB6_GET_NXT_ALL) != NULL) {
+		FIB_LOG(ERR, "FIB6 %s must be empty to load a snapshot",
+			fib->name);
+		return -EEXIST;
+	}
+
+	hdr = fib_snapshot_map(path, 6, &size);
+	if (hdr == NULL)
+		return -rte_errno;
+
+	if (hdr->type != (uint32_t)fib->type || hdr->def_nh != fib->def_nh ||
+			hdr->sec[FIB_SNAPSHOT_ROUTES].len !=
+			(uint64_t)hdr->nb_routes * sizeof(*routes))
+		ret = -EINVAL;
+	else if (fib->type == RTE_FIB6_TRIE)
+		ret = trie_snapshot_check(fib->dp, hdr);
+	if (ret == -EBUSY) {
+		FIB_LOG(ERR, "FIB6 %s has tbl8 groups waiting for readers",
+			fib->name);
+		goto exit;
+	} else if (ret != 0) {
+		FIB_LOG(ERR, "FIB6 snapshot %s does not match FIB6 %s",
+			path, fib->name);
+		goto exit;
+	}
+
+	/* Refill the RIB first, the dataplane is only written on success. */
+	routes = fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_ROUTES);
+	for (i = 0; i < hdr->nb_routes; i++) {
+		if (routes[i].depth > RTE_IPV6_MAX_DEPTH) {
+			ret = -EINVAL;
+			break;
+		}
+		node = rte_rib6_insert(fib->rib, &routes[i].ip,
+			routes[i].depth);
+		if (node == NULL) {
+			ret = -rte_errno;
+			break;
+		}
+		rte_rib6_set_nh(node, routes[i].nh);
+	}
+	if (ret != 0) {
+		FIB_LOG(ERR, "Cannot restore routes of FIB6 %s", fib->name);
+		while (i-- > 0)
+			rte_rib6_remove(fib->rib, &routes[i].ip,
+				routes[i].depth);
+		goto exit;
+	}
+
+	if (fib->type == RTE_FIB6_TRIE)
+		trie_snapshot_restore(fib->dp, hdr);
+
+exit:
+	fib_snapshot_unmap(hdr, size);
+	return ret;
+}
@@ -19,6 +19,7 @@
 
 #include <rte_common.h>
 #include <rte_ip6.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,19 @@ extern "C" {
 struct rte_fib6;
 struct rte_rib6;
 
+/** @internal Default RCU defer queue entries to reclaim in one go. */
+#define RTE_FIB6_RCU_DQ_RECLAIM_MAX	16
+/** @internal Default RCU defer queue size. */
+#define RTE_FIB6_RCU_DQ_RECLAIM_SZ	128
+
+/** RCU reclamation modes */
+enum rte_fib6_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_FIB6_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_FIB6_QSBR_MODE_SYNC
+};
+
 /** Type of FIB struct */
 enum rte_fib6_type {
 	RTE_FIB6_DUMMY,		/**< RIB6 tree based FIB */
@@ -82,6 +96,26 @@ struct rte_fib6_conf {
 	};
 };
 
+/** FIB RCU QSBR configuration structure. */
+struct rte_fib6_rcu_config {
+	/** RCU QSBR variable. */
+	struct rte_rcu_qsbr *v;
+	/** Mode of RCU QSBR. See RTE_FIB6_QSBR_MODE_xxx.
+	 * Default: RTE_FIB6_QSBR_MODE_DQ, create defer queue for reclaim.
+	 */
+	enum rte_fib6_qsbr_mode mode;
+	/** RCU defer queue size.
+	 * Default: RTE_FIB6_RCU_DQ_RECLAIM_SZ.
+	 */
+	uint32_t dq_size;
+	/** Threshold to trigger auto reclaim. */
+	uint32_t reclaim_thd;
+	/** Max entries to reclaim in one go.
+	 * Default: RTE_FIB6_RCU_DQ_RECLAIM_MAX.
+	 */
+	uint32_t reclaim_max;
+};
+
 /**
  * Free an FIB object.
  *
@@ -217,6 +251,90 @@ rte_fib6_get_rib(struct rte_fib6 *fib);
 int
 rte_fib6_select_lookup(struct rte_fib6 *fib, enum rte_fib6_lookup_type type);
 
+/**
+ * Associate RCU QSBR variable with a FIB object.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EEXIST - already added QSBR
+ *   - -ENOMEM - memory allocation failure
+ *   - -ENOTSUP - not supported by configured dataplane algorithm
+ */
+__rte_experimental
+int
+rte_fib6_rcu_qsbr_add(struct rte_fib6 *fib, struct rte_fib6_rcu_config *cfg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Save the routes and the dataplane tables of a FIB to a file.
+ *
+ * The dataplane tables are written as they are laid out in memory, so
+ * that rte_fib6_snapshot_load() restores them without processing the
+ * routes again. The RIB extension area is not saved.
+ * If a defer queue is used, it is reclaimed first.
+ *
+ * This function must not be called concurrently with a FIB update.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param path
+ *   Path of the file to create
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EBUSY - tbl8 groups are still referenced by readers
+ *   - -ENOMEM - memory allocation failure
+ *   - -EIO or another errno value - the file cannot be written
+ */
+__rte_experimental
+int
+rte_fib6_snapshot_save(struct rte_fib6 *fib, const char *path);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Restore the routes and the dataplane tables of a FIB from a file
+ * written by rte_fib6_snapshot_save().
+ *
+ * The FIB must be empty, and must have been created with the same type,
+ * default next hop and dataplane configuration as the saved FIB.
+ * The file is mapped and its checksum is verified before the FIB is
+ * modified.
+ *
+ * This function must not be called concurrently with any other operation
+ * on the FIB, including lookups.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param path
+ *   Path of the snapshot file
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters, or the snapshot does not match the FIB
+ *   - -EEXIST - the FIB is not empty
+ *   - -EBUSY - tbl8 groups are still waiting for RCU readers
+ *   - -ENOSPC or -ENOMEM - the RIB cannot hold the routes
+ *   - another errno value - the file cannot be read
+ *   The FIB is left unchanged on error.
+ */
+__rte_experimental
+int
+rte_fib6_snapshot_load(struct rte_fib6 *fib, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
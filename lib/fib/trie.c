@@ -13,6 +13,8 @@
 #include <rte_rib6.h>
 #include <rte_fib6.h>
 #include "trie.h"
+#include "fib_log.h"
+#include "fib_snapshot.h"
 
 #ifdef CC_AVX512_SUPPORT
 
@@ -159,6 +161,12 @@ tbl8_alloc(struct rte_trie_tbl *dp, uint64_t nh)
 	uint8_t		*tbl8_ptr;
 
 	tbl8_idx = tbl8_get(dp);
+
+	/* If there are no tbl8 groups try to reclaim one. */
+	if (unlikely(tbl8_idx == -ENOSPC && dp->dq &&
+			!rte_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL)))
+		tbl8_idx = tbl8_get(dp);
+
 	if (tbl8_idx < 0)
 		return tbl8_idx;
 	tbl8_ptr = get_tbl_p_by_idx(dp->tbl8,
@@ -169,6 +177,25 @@ tbl8_alloc(struct rte_trie_tbl *dp, uint64_t nh)
 	return tbl8_idx;
 }
 
+static void
+tbl8_cleanup_and_free(struct rte_trie_tbl *dp, uint64_t tbl8_idx)
+{
+	uint8_t *ptr = (uint8_t *)dp->tbl8 +
+		(tbl8_idx * TRIE_TBL8_GRP_NUM_ENT << dp->nh_sz);
+
+	memset(ptr, 0, TRIE_TBL8_GRP_NUM_ENT << dp->nh_sz);
+	tbl8_put(dp, tbl8_idx);
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	struct rte_trie_tbl *dp = p;
+	uint64_t tbl8_idx = *(uint64_t *)data;
+
+	tbl8_cleanup_and_free(dp, tbl8_idx);
+}
+
 static void
 tbl8_recycle(struct rte_trie_tbl *dp, void *par, uint64_t tbl8_idx)
 {
@@ -190,8 +217,6 @@ tbl8_recycle(struct rte_trie_tbl *dp, void *par, uint64_t tbl8_idx)
 				return;
 		}
 		write_to_dp(par, nh, dp->nh_sz, 1);
-		for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-			ptr16[i] = 0;
 		break;
 	case RTE_FIB6_TRIE_4B:
 		ptr32 = &((uint32_t *)dp->tbl8)[tbl8_idx *
@@ -204,8 +229,6 @@ tbl8_recycle(struct rte_trie_tbl *dp, void *par, uint64_t tbl8_idx)
 				return;
 		}
 		write_to_dp(par, nh, dp->nh_sz, 1);
-		for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-			ptr32[i] = 0;
 		break;
 	case RTE_FIB6_TRIE_8B:
 		ptr64 = &((uint64_t *)dp->tbl8)[tbl8_idx *
@@ -218,11 +241,18 @@ tbl8_recycle(struct rte_trie_tbl *dp, void *par, uint64_t tbl8_idx)
 				return;
 		}
 		write_to_dp(par, nh, dp->nh_sz, 1);
-		for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-			ptr64[i] = 0;
 		break;
 	}
-	tbl8_put(dp, tbl8_idx);
+
+	if (dp->v == NULL) {
+		tbl8_cleanup_and_free(dp, tbl8_idx);
+	} else if (dp->rcu_mode == RTE_FIB6_QSBR_MODE_SYNC) {
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+		tbl8_cleanup_and_free(dp, tbl8_idx);
+	} else { /* RTE_FIB6_QSBR_MODE_DQ */
+		if (rte_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx))
+			FIB_LOG(ERR, "Failed to push QSBR FIFO");
+	}
 }
 
 #define BYTE_SIZE	8
@@ -679,7 +709,133 @@ trie_free(void *p)
 {
 	struct rte_trie_tbl *dp = (struct rte_trie_tbl *)p;
 
+	rte_rcu_qsbr_dq_delete(dp->dq);
 	rte_free(dp->tbl8_pool);
 	rte_free(dp->tbl8);
 	rte_free(dp);
 }
+
+int
+trie_rcu_qsbr_add(struct rte_trie_tbl *dp, struct rte_fib6_rcu_config *cfg,
+	const char *name)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (dp == NULL || cfg == NULL)
+		return -EINVAL;
+
+	if (dp->v != NULL)
+		return -EEXIST;
+
+	if (cfg->mode == RTE_FIB6_QSBR_MODE_SYNC) {
+		/* No other things to do. */
+	} else if (cfg->mode == RTE_FIB6_QSBR_MODE_DQ) {
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+				"FIB6_RCU_%s", name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = RTE_FIB6_RCU_DQ_RECLAIM_SZ;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_FIB6_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(uint64_t);
+		params.free_fn = __rcu_qsbr_free_resource;
+		params.p = dp;
+		params.v = cfg->v;
+		dp->dq = rte_rcu_qsbr_dq_create(&params);
+		if (dp->dq == NULL) {
+			FIB_LOG(ERR, "FIB6 defer queue creation failed");
+			return -rte_errno;
+		}
+	} else {
+		return -EINVAL;
+	}
+
+	dp->rcu_mode = cfg->mode;
+	dp->v = cfg->v;
+
+	return 0;
+}
+
+int
+trie_snapshot_prepare(struct rte_trie_tbl *dp, struct fib_snapshot_hdr *hdr,
+	const void *data[])
+{
+	unsigned int pending = 0;
+
+	/* tbl8 groups waiting for readers would be lost */
+	if (dp->dq != NULL) {
+		rte_rcu_qsbr_dq_reclaim(dp->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0)
+			return -EBUSY;
+	}
+
+	hdr->nh_sz = dp->nh_sz;
+	hdr->number_tbl8s = dp->number_tbl8s;
+	hdr->rsvd_tbl8s = dp->rsvd_tbl8s;
+	hdr->cur_tbl8s = dp->cur_tbl8s;
+	hdr->tbl8_pool_pos = dp->tbl8_pool_pos;
+	hdr->def_nh = dp->def_nh;
+
+	hdr->sec[FIB_SNAPSHOT_TBL24].len =
+		(uint64_t)TRIE_TBL24_NUM_ENT << dp->nh_sz;
+	data[FIB_SNAPSHOT_TBL24] = dp->tbl24;
+	hdr->sec[FIB_SNAPSHOT_TBL8].len = (TRIE_TBL8_GRP_NUM_ENT *
+		(dp->number_tbl8s + 1)) << dp->nh_sz;
+	data[FIB_SNAPSHOT_TBL8] = dp->tbl8;
+	hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len =
+		sizeof(uint32_t) * dp->number_tbl8s;
+	data[FIB_SNAPSHOT_TBL8_IDX] = dp->tbl8_pool;
+
+	return 0;
+}
+
+int
+trie_snapshot_check(struct rte_trie_tbl *dp,
+	const struct fib_snapshot_hdr *hdr)
+{
+	unsigned int pending;
+
+	if (hdr->nh_sz != dp->nh_sz || hdr->number_tbl8s != dp->number_tbl8s ||
+			hdr->def_nh != dp->def_nh ||
+			hdr->rsvd_tbl8s > dp->number_tbl8s ||
+			hdr->cur_tbl8s > dp->number_tbl8s ||
+			hdr->tbl8_pool_pos > dp->number_tbl8s ||
+			hdr->sec[FIB_SNAPSHOT_TBL24].len !=
+			(uint64_t)TRIE_TBL24_NUM_ENT << dp->nh_sz ||
+			hdr->sec[FIB_SNAPSHOT_TBL8].len !=
+			(TRIE_TBL8_GRP_NUM_ENT * (dp->number_tbl8s + 1)) <<
+			dp->nh_sz ||
+			hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len !=
+			sizeof(uint32_t) * dp->number_tbl8s)
+		return -EINVAL;
+
+	/* tbl8 groups waiting for readers would be freed into the restored
+	 * tables
+	 */
+	if (dp->dq != NULL) {
+		rte_rcu_qsbr_dq_reclaim(dp->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0)
+			return -EBUSY;
+	}
+	return 0;
+}
+
+void
+trie_snapshot_restore(struct rte_trie_tbl *dp,
+	const struct fib_snapshot_hdr *hdr)
+{
+	memcpy(dp->tbl24, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL24),
+		hdr->sec[FIB_SNAPSHOT_TBL24].len);
+	memcpy(dp->tbl8, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL8),
+		hdr->sec[FIB_SNAPSHOT_TBL8].len);
+	memcpy(dp->tbl8_pool, fib_snapshot_sec_data(hdr, FIB_SNAPSHOT_TBL8_IDX),
+		hdr->sec[FIB_SNAPSHOT_TBL8_IDX].len);
+	dp->rsvd_tbl8s = hdr->rsvd_tbl8s;
+	dp->cur_tbl8s = hdr->cur_tbl8s;
+	dp->tbl8_pool_pos = hdr->tbl8_pool_pos;
+}
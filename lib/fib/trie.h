@@ -10,6 +10,7 @@
 
 #include <rte_common.h>
 #include <rte_fib6.h>
+#include <rte_rcu_qsbr.h>
 
 /**
  * @file
@@ -38,6 +39,10 @@ struct rte_trie_tbl {
 	uint64_t	*tbl8;		/**< tbl8 table. */
 	uint32_t	*tbl8_pool;	/**< bitmap containing free tbl8 idxes*/
 	uint32_t	tbl8_pool_pos;
+	/* RCU config. */
+	enum rte_fib6_qsbr_mode rcu_mode; /* Blocking, defer queue. */
+	struct rte_rcu_qsbr *v;		/* RCU QSBR variable. */
+	struct rte_rcu_qsbr_dq *dq;	/* RCU QSBR defer queue. */
 	/* tbl24 table. */
 	alignas(RTE_CACHE_LINE_SIZE) uint64_t	tbl24[];
 };
@@ -143,4 +148,22 @@ int
 trie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
 	uint8_t depth, uint64_t next_hop, int op);
 
+int
+trie_rcu_qsbr_add(struct rte_trie_tbl *dp, struct rte_fib6_rcu_config *cfg,
+	const char *name);
+
+struct fib_snapshot_hdr;
+
+int
+trie_snapshot_prepare(struct rte_trie_tbl *dp, struct fib_snapshot_hdr *hdr,
+	const void *data[]);
+
+int
+trie_snapshot_check(struct rte_trie_tbl *dp,
+	const struct fib_snapshot_hdr *hdr);
+
+void
+trie_snapshot_restore(struct rte_trie_tbl *dp,
+	const struct fib_snapshot_hdr *hdr);
+
 #endif /* _TRIE_H_ */
@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _GRO_VXLAN_H_
+#define _GRO_VXLAN_H_
+
+#include <string.h>
+
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+
+/*
+ * Outer IP addresses of a VxLAN flow, for an outer IPv4 or IPv6 header.
+ * An IPv4 address is stored in the first bytes of the field and the
+ * other bytes are zero, so both families are compared the same way.
+ */
+struct vxlan_outer_ip_key {
+	union {
+		uint32_t ipv4;
+		struct rte_ipv6_addr ipv6;
+	} src_addr, dst_addr;
+	uint8_t is_ipv6;
+};
+
+/* Check if the outer header of a VxLAN packet is IPv6 */
+static inline uint8_t
+vxlan_outer_is_ipv6(const struct rte_mbuf *pkt)
+{
+	return RTE_ETH_IS_IPV6_HDR(pkt->packet_type) != 0;
+}
+
+static inline void
+vxlan_outer_ip_key_set(struct vxlan_outer_ip_key *key,
+		const void *outer_ip_hdr,
+		uint8_t is_ipv6)
+{
+	const struct rte_ipv4_hdr *ipv4_hdr = outer_ip_hdr;
+	const struct rte_ipv6_hdr *ipv6_hdr = outer_ip_hdr;
+
+	memset(key, 0, sizeof(*key));
+	key->is_ipv6 = is_ipv6;
+	if (is_ipv6) {
+		key->src_addr.ipv6 = ipv6_hdr->src_addr;
+		key->dst_addr.ipv6 = ipv6_hdr->dst_addr;
+	} else {
+		key->src_addr.ipv4 = ipv4_hdr->src_addr;
+		key->dst_addr.ipv4 = ipv4_hdr->dst_addr;
+	}
+}
+
+static inline int
+is_same_vxlan_outer_ip(const struct vxlan_outer_ip_key *k1,
+		const struct vxlan_outer_ip_key *k2)
+{
+	return (k1->is_ipv6 == k2->is_ipv6) &&
+			rte_ipv6_addr_eq(&k1->src_addr.ipv6, &k2->src_addr.ipv6) &&
+			rte_ipv6_addr_eq(&k1->dst_addr.ipv6, &k2->dst_addr.ipv6);
+}
+
+/*
+ * Update the length of the outer IP header of a merged packet.
+ * 'len' is the length from the start of the outer IP header.
+ * Return the outer IP header.
+ */
+static inline void *
+vxlan_update_outer_ip_len(struct rte_mbuf *pkt, uint16_t len)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	if (vxlan_outer_is_ipv6(pkt)) {
+		ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+				pkt->outer_l2_len);
+		ipv6_hdr->payload_len = rte_cpu_to_be_16(len -
+				sizeof(struct rte_ipv6_hdr));
+		return ipv6_hdr;
+	}
+	ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr *,
+			pkt->outer_l2_len);
+	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+	return ipv4_hdr;
+}
+
+#endif
@@ -171,8 +171,7 @@ insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 	dst->vxlan_hdr.vx_vni = src->vxlan_hdr.vx_vni;
 	rte_ether_addr_copy(&(src->outer_eth_saddr), &(dst->outer_eth_saddr));
 	rte_ether_addr_copy(&(src->outer_eth_daddr), &(dst->outer_eth_daddr));
-	dst->outer_ip_src_addr = src->outer_ip_src_addr;
-	dst->outer_ip_dst_addr = src->outer_ip_dst_addr;
+	dst->outer_ip = src->outer_ip;
 	dst->outer_src_port = src->outer_src_port;
 	dst->outer_dst_port = src->outer_dst_port;
 
@@ -190,8 +189,7 @@ is_same_vxlan_tcp4_flow(struct vxlan_tcp4_flow_key k1,
 					&k2.outer_eth_saddr) &&
 			rte_is_same_ether_addr(&k1.outer_eth_daddr,
 				&k2.outer_eth_daddr) &&
-			(k1.outer_ip_src_addr == k2.outer_ip_src_addr) &&
-			(k1.outer_ip_dst_addr == k2.outer_ip_dst_addr) &&
+			is_same_vxlan_outer_ip(&k1.outer_ip, &k2.outer_ip) &&
 			(k1.outer_src_port == k2.outer_src_port) &&
 			(k1.outer_dst_port == k2.outer_dst_port) &&
 			(k1.vxlan_hdr.vx_flags == k2.vxlan_hdr.vx_flags) &&
@@ -261,16 +259,15 @@ update_vxlan_header(struct gro_vxlan_tcp4_item *item)
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_mbuf *pkt = item->inner_item.firstseg;
 	uint16_t len;
+	void *outer_ip_hdr;
 
-	/* Update the outer IPv4 header. */
+	/* Update the outer IP header. */
 	len = pkt->pkt_len - pkt->outer_l2_len;
-	ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr *,
-					   pkt->outer_l2_len);
-	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+	outer_ip_hdr = vxlan_update_outer_ip_len(pkt, len);
 
 	/* Update the outer UDP header. */
 	len -= pkt->outer_l3_len;
-	udp_hdr = (struct rte_udp_hdr *)((char *)ipv4_hdr + pkt->outer_l3_len);
+	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ip_hdr + pkt->outer_l3_len);
 	udp_hdr->dgram_len = rte_cpu_to_be_16(len);
 
 	/* Update the inner IPv4 header. */
@@ -286,6 +283,8 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 {
 	struct rte_ether_hdr *outer_eth_hdr, *eth_hdr;
 	struct rte_ipv4_hdr *outer_ipv4_hdr, *ipv4_hdr;
+	void *outer_ip_hdr;
+	uint8_t outer_is_ipv6 = vxlan_outer_is_ipv6(pkt);
 	struct rte_tcp_hdr *tcp_hdr;
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_vxlan_hdr *vxlan_hdr;
@@ -309,9 +308,8 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 		return -1;
 
 	outer_eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
-	outer_ipv4_hdr = (struct rte_ipv4_hdr *)((char *)outer_eth_hdr +
-			pkt->outer_l2_len);
-	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ipv4_hdr +
+	outer_ip_hdr = (char *)outer_eth_hdr + pkt->outer_l2_len;
+	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ip_hdr +
 			pkt->outer_l3_len);
 	vxlan_hdr = (struct rte_vxlan_hdr *)((char *)udp_hdr +
 			sizeof(struct rte_udp_hdr));
@@ -339,13 +337,20 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 
 	/*
 	 * Save IPv4 ID for the packet whose DF bit is 0. For the packet
-	 * whose DF bit is 1, IPv4 ID is ignored.
+	 * whose DF bit is 1, IPv4 ID is ignored. An outer IPv6 header
+	 * has no ID.
 	 */
-	frag_off = rte_be_to_cpu_16(outer_ipv4_hdr->fragment_offset);
-	outer_is_atomic =
-		(frag_off & RTE_IPV4_HDR_DF_FLAG) == RTE_IPV4_HDR_DF_FLAG;
-	outer_ip_id = outer_is_atomic ? 0 :
-		rte_be_to_cpu_16(outer_ipv4_hdr->packet_id);
+	if (outer_is_ipv6) {
+		outer_is_atomic = 1;
+		outer_ip_id = 0;
+	} else {
+		outer_ipv4_hdr = outer_ip_hdr;
+		frag_off = rte_be_to_cpu_16(outer_ipv4_hdr->fragment_offset);
+		outer_is_atomic = (frag_off & RTE_IPV4_HDR_DF_FLAG) ==
+			RTE_IPV4_HDR_DF_FLAG;
+		outer_ip_id = outer_is_atomic ? 0 :
+			rte_be_to_cpu_16(outer_ipv4_hdr->packet_id);
+	}
 	frag_off = rte_be_to_cpu_16(ipv4_hdr->fragment_offset);
 	is_atomic = (frag_off & RTE_IPV4_HDR_DF_FLAG) == RTE_IPV4_HDR_DF_FLAG;
 	ip_id = is_atomic ? 0 : rte_be_to_cpu_16(ipv4_hdr->packet_id);
@@ -364,8 +369,7 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 	key.vxlan_hdr.vx_vni = vxlan_hdr->vx_vni;
 	rte_ether_addr_copy(&(outer_eth_hdr->src_addr), &(key.outer_eth_saddr));
 	rte_ether_addr_copy(&(outer_eth_hdr->dst_addr), &(key.outer_eth_daddr));
-	key.outer_ip_src_addr = outer_ipv4_hdr->src_addr;
-	key.outer_ip_dst_addr = outer_ipv4_hdr->dst_addr;
+	vxlan_outer_ip_key_set(&key.outer_ip, outer_ip_hdr, outer_is_ipv6);
 	key.outer_src_port = udp_hdr->src_port;
 	key.outer_dst_port = udp_hdr->dst_port;
 
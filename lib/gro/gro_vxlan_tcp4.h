@@ -6,6 +6,7 @@
 #define _GRO_VXLAN_TCP4_H_
 
 #include "gro_tcp4.h"
+#include "gro_vxlan.h"
 
 #define GRO_VXLAN_TCP4_TBL_MAX_ITEM_NUM (1024UL * 1024UL)
 
@@ -17,8 +18,7 @@ struct vxlan_tcp4_flow_key {
 	struct rte_ether_addr outer_eth_saddr;
 	struct rte_ether_addr outer_eth_daddr;
 
-	uint32_t outer_ip_src_addr;
-	uint32_t outer_ip_dst_addr;
+	struct vxlan_outer_ip_key outer_ip;
 
 	/* Outer UDP ports */
 	uint16_t outer_src_port;
@@ -39,12 +39,12 @@ struct gro_vxlan_tcp4_item {
 	struct gro_tcp_item inner_item;
 	/* IPv4 ID in the outer IPv4 header */
 	uint16_t outer_ip_id;
-	/* Indicate if outer IPv4 ID can be ignored */
+	/* Indicate if outer IPv4 ID can be ignored, always set for IPv6 */
 	uint8_t outer_is_atomic;
 };
 
 /*
- * VxLAN (with an outer IPv4 header and an inner TCP/IPv4 packet)
+ * VxLAN (with an outer IPv4 or IPv6 header and an inner TCP/IPv4 packet)
  * reassembly table structure
  */
 struct gro_vxlan_tcp4_tbl {
@@ -64,7 +64,7 @@ struct gro_vxlan_tcp4_tbl {
 
 /**
  * This function creates a VxLAN reassembly table for VxLAN packets
- * which have an outer IPv4 header and an inner TCP/IPv4 packet.
+ * which have an outer IPv4 or IPv6 header and an inner TCP/IPv4 packet.
  *
  * @param socket_id
  *  Socket index for allocating the table
@@ -90,8 +90,8 @@ void *gro_vxlan_tcp4_tbl_create(uint16_t socket_id,
 void gro_vxlan_tcp4_tbl_destroy(void *tbl);
 
 /**
- * This function merges a VxLAN packet which has an outer IPv4 header and
- * an inner TCP/IPv4 packet. It doesn't process the packet, whose TCP
+ * This function merges a VxLAN packet which has an outer IPv4 or IPv6
+ * header and an inner TCP/IPv4 packet. It doesn't process the packet, whose TCP
  * header has SYN, FIN, RST, PSH, CWR, ECE or URG bit set, or which
  * doesn't have payload.
  *
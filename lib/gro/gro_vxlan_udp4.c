@@ -169,8 +169,7 @@ insert_new_flow(struct gro_vxlan_udp4_tbl *tbl,
 	dst->vxlan_hdr.vx_vni = src->vxlan_hdr.vx_vni;
 	rte_ether_addr_copy(&(src->outer_eth_saddr), &(dst->outer_eth_saddr));
 	rte_ether_addr_copy(&(src->outer_eth_daddr), &(dst->outer_eth_daddr));
-	dst->outer_ip_src_addr = src->outer_ip_src_addr;
-	dst->outer_ip_dst_addr = src->outer_ip_dst_addr;
+	dst->outer_ip = src->outer_ip;
 	dst->outer_dst_port = src->outer_dst_port;
 
 	tbl->flows[flow_idx].start_index = item_idx;
@@ -193,8 +192,7 @@ is_same_vxlan_udp4_flow(struct vxlan_udp4_flow_key k1,
 					&k2.outer_eth_saddr) &&
 			rte_is_same_ether_addr(&k1.outer_eth_daddr,
 				&k2.outer_eth_daddr) &&
-			(k1.outer_ip_src_addr == k2.outer_ip_src_addr) &&
-			(k1.outer_ip_dst_addr == k2.outer_ip_dst_addr) &&
+			is_same_vxlan_outer_ip(&k1.outer_ip, &k2.outer_ip) &&
 			(k1.outer_dst_port == k2.outer_dst_port) &&
 			(k1.vxlan_hdr.vx_flags == k2.vxlan_hdr.vx_flags) &&
 			(k1.vxlan_hdr.vx_vni == k2.vxlan_hdr.vx_vni) &&
@@ -256,16 +254,15 @@ update_vxlan_header(struct gro_vxlan_udp4_item *item)
 	struct rte_mbuf *pkt = item->inner_item.firstseg;
 	uint16_t len;
 	uint16_t frag_offset;
+	void *outer_ip_hdr;
 
-	/* Update the outer IPv4 header. */
+	/* Update the outer IP header. */
 	len = pkt->pkt_len - pkt->outer_l2_len;
-	ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr *,
-					   pkt->outer_l2_len);
-	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+	outer_ip_hdr = vxlan_update_outer_ip_len(pkt, len);
 
 	/* Update the outer UDP header. */
 	len -= pkt->outer_l3_len;
-	udp_hdr = (struct rte_udp_hdr *)((char *)ipv4_hdr + pkt->outer_l3_len);
+	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ip_hdr + pkt->outer_l3_len);
 	udp_hdr->dgram_len = rte_cpu_to_be_16(len);
 
 	/* Update the inner IPv4 header. */
@@ -287,7 +284,8 @@ gro_vxlan_udp4_reassemble(struct rte_mbuf *pkt,
 		uint64_t start_time)
 {
 	struct rte_ether_hdr *outer_eth_hdr, *eth_hdr;
-	struct rte_ipv4_hdr *outer_ipv4_hdr, *ipv4_hdr;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	void *outer_ip_hdr;
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_vxlan_hdr *vxlan_hdr;
 	uint16_t frag_offset;
@@ -303,10 +301,9 @@ gro_vxlan_udp4_reassemble(struct rte_mbuf *pkt,
 	uint8_t find;
 
 	outer_eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
-	outer_ipv4_hdr = (struct rte_ipv4_hdr *)((char *)outer_eth_hdr +
-			pkt->outer_l2_len);
+	outer_ip_hdr = (char *)outer_eth_hdr + pkt->outer_l2_len;
 
-	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ipv4_hdr +
+	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ip_hdr +
 			pkt->outer_l3_len);
 	vxlan_hdr = (struct rte_vxlan_hdr *)((char *)udp_hdr +
 			sizeof(struct rte_udp_hdr));
@@ -347,8 +344,8 @@ gro_vxlan_udp4_reassemble(struct rte_mbuf *pkt,
 	key.vxlan_hdr.vx_vni = vxlan_hdr->vx_vni;
 	rte_ether_addr_copy(&(outer_eth_hdr->src_addr), &(key.outer_eth_saddr));
 	rte_ether_addr_copy(&(outer_eth_hdr->dst_addr), &(key.outer_eth_daddr));
-	key.outer_ip_src_addr = outer_ipv4_hdr->src_addr;
-	key.outer_ip_dst_addr = outer_ipv4_hdr->dst_addr;
+	vxlan_outer_ip_key_set(&key.outer_ip, outer_ip_hdr,
+			vxlan_outer_is_ipv6(pkt));
 	/* Note: It is unnecessary to save outer_src_port here because it can
 	 * be different for VxLAN UDP fragments from the same flow.
 	 */
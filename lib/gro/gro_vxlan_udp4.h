@@ -6,6 +6,7 @@
 #define _GRO_VXLAN_UDP4_H_
 
 #include "gro_udp4.h"
+#include "gro_vxlan.h"
 
 #define GRO_VXLAN_UDP4_TBL_MAX_ITEM_NUM (1024UL * 1024UL)
 
@@ -17,8 +18,7 @@ struct vxlan_udp4_flow_key {
 	struct rte_ether_addr outer_eth_saddr;
 	struct rte_ether_addr outer_eth_daddr;
 
-	uint32_t outer_ip_src_addr;
-	uint32_t outer_ip_dst_addr;
+	struct vxlan_outer_ip_key outer_ip;
 
 	/* Note: It is unnecessary to save outer_src_port here because it can
 	 * be different for VxLAN UDP fragments from the same flow.
@@ -45,7 +45,7 @@ struct gro_vxlan_udp4_item {
 };
 
 /*
- * VxLAN (with an outer IPv4 header and an inner UDP/IPv4 packet)
+ * VxLAN (with an outer IPv4 or IPv6 header and an inner UDP/IPv4 packet)
  * reassembly table structure
  */
 struct gro_vxlan_udp4_tbl {
@@ -65,7 +65,7 @@ struct gro_vxlan_udp4_tbl {
 
 /**
  * This function creates a VxLAN reassembly table for VxLAN packets
- * which have an outer IPv4 header and an inner UDP/IPv4 packet.
+ * which have an outer IPv4 or IPv6 header and an inner UDP/IPv4 packet.
  *
  * @param socket_id
  *  Socket index for allocating the table
@@ -91,9 +91,9 @@ void *gro_vxlan_udp4_tbl_create(uint16_t socket_id,
 void gro_vxlan_udp4_tbl_destroy(void *tbl);
 
 /**
- * This function merges a VxLAN packet which has an outer IPv4 header and
- * an inner UDP/IPv4 packet. It does not process the packet which does not
- * have payload.
+ * This function merges a VxLAN packet which has an outer IPv4 or IPv6
+ * header and an inner UDP/IPv4 packet. It does not process the packet
+ * which does not have payload.
  *
  * This function does not check if the packet has correct checksums and
  * does not re-calculate checksums for the merged packet. It returns the
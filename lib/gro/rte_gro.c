@@ -11,6 +11,7 @@
 #include "gro_tcp4.h"
 #include "gro_tcp6.h"
 #include "gro_udp4.h"
+#include "gro_udp6.h"
 #include "gro_vxlan_tcp4.h"
 #include "gro_vxlan_udp4.h"
 
@@ -22,16 +23,20 @@ typedef uint32_t (*gro_tbl_pkt_count_fn)(void *tbl);
 
 static gro_tbl_create_fn tbl_create_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		gro_tcp4_tbl_create, gro_vxlan_tcp4_tbl_create,
-		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create, NULL};
+		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create,
+		gro_udp6_tbl_create, gro_vxlan_tcp4_tbl_create,
+		gro_vxlan_udp4_tbl_create, NULL};
 static gro_tbl_destroy_fn tbl_destroy_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_destroy, gro_vxlan_tcp4_tbl_destroy,
 			gro_udp4_tbl_destroy, gro_vxlan_udp4_tbl_destroy,
-			gro_tcp6_tbl_destroy,
+			gro_tcp6_tbl_destroy, gro_udp6_tbl_destroy,
+			gro_vxlan_tcp4_tbl_destroy, gro_vxlan_udp4_tbl_destroy,
 			NULL};
 static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_pkt_count, gro_vxlan_tcp4_tbl_pkt_count,
 			gro_udp4_tbl_pkt_count, gro_vxlan_udp4_tbl_pkt_count,
-			gro_tcp6_tbl_pkt_count,
+			gro_tcp6_tbl_pkt_count, gro_udp6_tbl_pkt_count,
+			gro_vxlan_tcp4_tbl_pkt_count, gro_vxlan_udp4_tbl_pkt_count,
 			NULL};
 
 #define IS_IPV4_TCP_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
@@ -49,6 +54,10 @@ static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
 		(RTE_ETH_IS_TUNNEL_PKT(ptype) == 0))
 
+#define IS_IPV6_UDP_PKT(ptype) (RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
+		(RTE_ETH_IS_TUNNEL_PKT(ptype) == 0))
+
 #define IS_IPV4_VXLAN_TCP4_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
 		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
 		((ptype & RTE_PTYPE_L4_FRAG) != RTE_PTYPE_L4_FRAG) && \
@@ -76,6 +85,33 @@ static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
 		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
 
+#define IS_IPV6_VXLAN_TCP4_PKT(ptype) (RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
+		((ptype & RTE_PTYPE_L4_FRAG) != RTE_PTYPE_L4_FRAG) && \
+		((ptype & RTE_PTYPE_TUNNEL_VXLAN) == \
+		 RTE_PTYPE_TUNNEL_VXLAN) && \
+		((ptype & RTE_PTYPE_INNER_L4_TCP) == \
+		 RTE_PTYPE_INNER_L4_TCP) && \
+		(((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
+
+#define IS_IPV6_VXLAN_UDP4_PKT(ptype) (RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
+		((ptype & RTE_PTYPE_TUNNEL_VXLAN) == \
+		 RTE_PTYPE_TUNNEL_VXLAN) && \
+		((ptype & RTE_PTYPE_INNER_L4_UDP) == \
+		 RTE_PTYPE_INNER_L4_UDP) && \
+		(((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
+
 /*
  * GRO context structure. It keeps the table structures, which are
  * used to merge packets, for different GRO types. Before using
@@ -171,28 +207,36 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	struct gro_udp4_flow udp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_udp4_item udp_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
 
-	/* Allocate a reassembly table for VXLAN TCP GRO */
+	/* Allocate a reassembly table for VXLAN TCP GRO, outer IPv4 or IPv6 */
 	struct gro_vxlan_tcp4_tbl vxlan_tcp_tbl;
 	struct gro_vxlan_tcp4_flow vxlan_tcp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_vxlan_tcp4_item vxlan_tcp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
 			= {{{0}, 0, 0} };
 
-	/* Allocate a reassembly table for VXLAN UDP GRO */
+	/* Allocate a reassembly table for VXLAN UDP GRO, outer IPv4 or IPv6 */
 	struct gro_vxlan_udp4_tbl vxlan_udp_tbl;
 	struct gro_vxlan_udp4_flow vxlan_udp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_vxlan_udp4_item vxlan_udp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
 			= {{{0}} };
 
+	/* Allocate a reassembly table for UDP/IPv6 GRO */
+	struct gro_udp6_tbl udp6_tbl;
+	struct gro_udp6_flow udp6_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
+	struct gro_udp4_item udp6_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
+
 	uint32_t item_num;
 	int32_t ret;
 	uint16_t i, unprocess_num = 0, nb_after_gro = nb_pkts;
 	uint8_t do_tcp4_gro = 0, do_vxlan_tcp_gro = 0, do_udp4_gro = 0,
-		do_vxlan_udp_gro = 0, do_tcp6_gro = 0;
+		do_vxlan_udp_gro = 0, do_tcp6_gro = 0, do_udp6_gro = 0,
+		do_vxlan6_tcp_gro = 0, do_vxlan6_udp_gro = 0;
 
 	if (unlikely((param->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
 					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
 					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+					RTE_GRO_UDP_IPV4 | RTE_GRO_UDP_IPV6 |
+					RTE_GRO_IPV6_VXLAN_TCP_IPV4 |
+					RTE_GRO_IPV6_VXLAN_UDP_IPV4)) == 0))
 		return nb_pkts;
 
 	/* Get the maximum number of packets */
@@ -200,7 +244,8 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 				param->max_item_per_flow));
 	item_num = RTE_MIN(item_num, RTE_GRO_MAX_BURST_ITEM_NUM);
 
-	if (param->gro_types & RTE_GRO_IPV4_VXLAN_TCP_IPV4) {
+	if (param->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4)) {
 		for (i = 0; i < item_num; i++)
 			vxlan_tcp_flows[i].start_index = INVALID_ARRAY_INDEX;
 
@@ -210,10 +255,14 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		vxlan_tcp_tbl.item_num = 0;
 		vxlan_tcp_tbl.max_flow_num = item_num;
 		vxlan_tcp_tbl.max_item_num = item_num;
-		do_vxlan_tcp_gro = 1;
+		do_vxlan_tcp_gro = !!(param->gro_types &
+				RTE_GRO_IPV4_VXLAN_TCP_IPV4);
+		do_vxlan6_tcp_gro = !!(param->gro_types &
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4);
 	}
 
-	if (param->gro_types & RTE_GRO_IPV4_VXLAN_UDP_IPV4) {
+	if (param->gro_types & (RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
+				RTE_GRO_IPV6_VXLAN_UDP_IPV4)) {
 		for (i = 0; i < item_num; i++)
 			vxlan_udp_flows[i].start_index = INVALID_ARRAY_INDEX;
 
@@ -223,7 +272,10 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		vxlan_udp_tbl.item_num = 0;
 		vxlan_udp_tbl.max_flow_num = item_num;
 		vxlan_udp_tbl.max_item_num = item_num;
-		do_vxlan_udp_gro = 1;
+		do_vxlan_udp_gro = !!(param->gro_types &
+				RTE_GRO_IPV4_VXLAN_UDP_IPV4);
+		do_vxlan6_udp_gro = !!(param->gro_types &
+				RTE_GRO_IPV6_VXLAN_UDP_IPV4);
 	}
 
 	if (param->gro_types & RTE_GRO_TCP_IPV4) {
@@ -265,6 +317,19 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		do_tcp6_gro = 1;
 	}
 
+	if (param->gro_types & RTE_GRO_UDP_IPV6) {
+		for (i = 0; i < item_num; i++)
+			udp6_flows[i].start_index = INVALID_ARRAY_INDEX;
+
+		udp6_tbl.flows = udp6_flows;
+		udp6_tbl.items = udp6_items;
+		udp6_tbl.flow_num = 0;
+		udp6_tbl.item_num = 0;
+		udp6_tbl.max_flow_num = item_num;
+		udp6_tbl.max_item_num = item_num;
+		do_udp6_gro = 1;
+	}
+
 	for (i = 0; i < nb_pkts; i++) {
 		/*
 		 * The timestamp is ignored, since all packets
@@ -312,6 +377,32 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 				nb_after_gro--;
 			else if (ret < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			ret = gro_vxlan_tcp4_reassemble(pkts[i],
+							&vxlan_tcp_tbl, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_UDP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_udp_gro) {
+			ret = gro_vxlan_udp4_reassemble(pkts[i],
+							&vxlan_udp_tbl, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_UDP_PKT(pkts[i]->packet_type) &&
+				do_udp6_gro) {
+			ret = gro_udp6_reassemble(pkts[i], &udp6_tbl, 0);
+			if (ret > 0)
+				/* merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else
 			pkts[unprocess_num++] = pkts[i];
 	}
@@ -322,12 +413,12 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		i = unprocess_num;
 
 		/* Flush all packets from the tables */
-		if (do_vxlan_tcp_gro) {
+		if (do_vxlan_tcp_gro || do_vxlan6_tcp_gro) {
 			i += gro_vxlan_tcp4_tbl_timeout_flush(&vxlan_tcp_tbl,
 					0, &pkts[i], nb_pkts - i);
 		}
 
-		if (do_vxlan_udp_gro) {
+		if (do_vxlan_udp_gro || do_vxlan6_udp_gro) {
 			i += gro_vxlan_udp4_tbl_timeout_flush(&vxlan_udp_tbl,
 					0, &pkts[i], nb_pkts - i);
 
@@ -347,6 +438,11 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 			i += gro_tcp6_tbl_timeout_flush(&tcp6_tbl, 0,
 					&pkts[i], nb_pkts - i);
 		}
+
+		if (do_udp6_gro) {
+			i += gro_udp6_tbl_timeout_flush(&udp6_tbl, 0,
+					&pkts[i], nb_pkts - i);
+		}
 	}
 
 	return nb_after_gro;
@@ -360,14 +456,18 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 {
 	struct gro_ctx *gro_ctx = ctx;
 	void *tcp_tbl, *udp_tbl, *vxlan_tcp_tbl, *vxlan_udp_tbl, *tcp6_tbl;
+	void *udp6_tbl, *vxlan6_tcp_tbl, *vxlan6_udp_tbl;
 	uint64_t current_time;
 	uint16_t i, unprocess_num = 0;
 	uint8_t do_tcp4_gro, do_vxlan_tcp_gro, do_udp4_gro, do_vxlan_udp_gro, do_tcp6_gro;
+	uint8_t do_udp6_gro, do_vxlan6_tcp_gro, do_vxlan6_udp_gro;
 
 	if (unlikely((gro_ctx->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
 					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
 					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+					RTE_GRO_UDP_IPV4 | RTE_GRO_UDP_IPV6 |
+					RTE_GRO_IPV6_VXLAN_TCP_IPV4 |
+					RTE_GRO_IPV6_VXLAN_UDP_IPV4)) == 0))
 		return nb_pkts;
 
 	tcp_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV4_INDEX];
@@ -375,6 +475,9 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	udp_tbl = gro_ctx->tbls[RTE_GRO_UDP_IPV4_INDEX];
 	vxlan_udp_tbl = gro_ctx->tbls[RTE_GRO_IPV4_VXLAN_UDP_IPV4_INDEX];
 	tcp6_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV6_INDEX];
+	udp6_tbl = gro_ctx->tbls[RTE_GRO_UDP_IPV6_INDEX];
+	vxlan6_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX];
+	vxlan6_udp_tbl = gro_ctx->tbls[RTE_GRO_IPV6_VXLAN_UDP_IPV4_INDEX];
 
 	do_tcp4_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV4) ==
 		RTE_GRO_TCP_IPV4;
@@ -385,6 +488,11 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	do_vxlan_udp_gro = (gro_ctx->gro_types & RTE_GRO_IPV4_VXLAN_UDP_IPV4) ==
 		RTE_GRO_IPV4_VXLAN_UDP_IPV4;
 	do_tcp6_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV6) == RTE_GRO_TCP_IPV6;
+	do_udp6_gro = (gro_ctx->gro_types & RTE_GRO_UDP_IPV6) == RTE_GRO_UDP_IPV6;
+	do_vxlan6_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) ==
+		RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	do_vxlan6_udp_gro = (gro_ctx->gro_types & RTE_GRO_IPV6_VXLAN_UDP_IPV4) ==
+		RTE_GRO_IPV6_VXLAN_UDP_IPV4;
 
 	current_time = rte_rdtsc();
 
@@ -414,6 +522,21 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 			if (gro_tcp6_reassemble(pkts[i], tcp6_tbl,
 						current_time) < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			if (gro_vxlan_tcp4_reassemble(pkts[i], vxlan6_tcp_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_UDP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_udp_gro) {
+			if (gro_vxlan_udp4_reassemble(pkts[i], vxlan6_udp_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_UDP_PKT(pkts[i]->packet_type) &&
+				do_udp6_gro) {
+			if (gro_udp6_reassemble(pkts[i], udp6_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else
 			pkts[unprocess_num++] = pkts[i];
 	}
@@ -474,7 +597,28 @@ rte_gro_timeout_flush(void *ctx,
 				gro_ctx->tbls[RTE_GRO_TCP_IPV6_INDEX],
 				flush_timestamp,
 				&out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_vxlan_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
 
+	if ((gro_types & RTE_GRO_IPV6_VXLAN_UDP_IPV4) && left_nb_out > 0) {
+		num += gro_vxlan_udp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV6_VXLAN_UDP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_UDP_IPV6) && left_nb_out > 0) {
+		num += gro_udp6_tbl_timeout_flush(
+				gro_ctx->tbls[RTE_GRO_UDP_IPV6_INDEX],
+				flush_timestamp,
+				&out[num], left_nb_out);
 	}
 
 	return num;
@@ -5,6 +5,8 @@
 #ifndef _GSO_COMMON_H_
 #define _GSO_COMMON_H_
 
+#include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <rte_ip.h>
@@ -38,6 +40,38 @@
 #define IS_IPV4_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4)) == \
 		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4))
 
+#define IS_IPV6_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6))
+
+#define IS_IPV6_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6)) == \
+		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6))
+
+#define IS_VXLAN_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | \
+				RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_TUNNEL_VXLAN))
+
+#define IS_GENEVE_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | \
+				RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_TUNNEL_GENEVE))
+
+#define OUTER_IP_FLAG(flag) \
+		((flag) & (RTE_MBUF_F_TX_OUTER_IPV4 | RTE_MBUF_F_TX_OUTER_IPV6))
+
+#define INNER_IP_FLAG(flag) \
+		((flag) & (RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IPV6))
+
+/*
+ * UDP tunneled TCP packet, with an IPv6 outer or inner header.
+ * The version of both headers must be given.
+ */
+#define IS_IPV6_UDP_TUNNEL_TCP(flag) \
+		((IS_VXLAN_TCP(flag) || IS_GENEVE_TCP(flag)) && \
+		 ((OUTER_IP_FLAG(flag) == RTE_MBUF_F_TX_OUTER_IPV6 && \
+		   (INNER_IP_FLAG(flag) == RTE_MBUF_F_TX_IPV4 || \
+		    INNER_IP_FLAG(flag) == RTE_MBUF_F_TX_IPV6)) || \
+		  (OUTER_IP_FLAG(flag) == RTE_MBUF_F_TX_OUTER_IPV4 && \
+		   INNER_IP_FLAG(flag) == RTE_MBUF_F_TX_IPV6)))
+
 /**
  * Internal function which updates the UDP header of a packet, following
  * segmentation. This is required to update the header's datagram length field.
@@ -110,6 +144,79 @@ update_ipv4_header(struct rte_mbuf *pkt, uint16_t l3_offset, uint16_t id)
 	ipv4_hdr->packet_id = rte_cpu_to_be_16(id);
 }
 
+/**
+ * Internal function which updates the IPv6 header of a packet, following
+ * segmentation. This is required to update the header's 'payload_len'
+ * field, to reflect the reduced length of the now-segmented packet.
+ *
+ * @param pkt
+ *  The packet containing the IPv6 header.
+ * @param l3_offset
+ *  The offset of the IPv6 header from the start of the packet.
+ */
+static inline void
+update_ipv6_header(struct rte_mbuf *pkt, uint16_t l3_offset)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+					   l3_offset);
+	ipv6_hdr->payload_len = rte_cpu_to_be_16(pkt->pkt_len - l3_offset -
+			sizeof(struct rte_ipv6_hdr));
+}
+
+/**
+ * Internal function which skips the extension headers which follow
+ * the IPv6 header of a packet. The extension headers must end exactly
+ * at the end of the L3 header.
+ *
+ * @param pkt
+ *  The packet containing the IPv6 header.
+ * @param l3_offset
+ *  The offset of the IPv6 header from the start of the packet.
+ * @param l3_len
+ *  The length of the IPv6 header, including its extension headers.
+ * @param nh_offset
+ *  If not NULL, filled with the offset from the start of the packet
+ *  of the last 'next header' field, which holds the upper layer protocol.
+ *
+ * @return
+ *  - The upper layer protocol on success.
+ *  - Return -EINVAL if the packet is an IPv6 fragment, or if the
+ *    extension headers are malformed.
+ */
+static inline int
+gso_ipv6_skip_ext(struct rte_mbuf *pkt, uint16_t l3_offset, uint16_t l3_len,
+		uint16_t *nh_offset)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+	size_t ext_len;
+	uint16_t off, nh_off;
+	int proto;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+					   l3_offset);
+	proto = ipv6_hdr->proto;
+	nh_off = l3_offset + offsetof(struct rte_ipv6_hdr, proto);
+
+	for (off = sizeof(*ipv6_hdr); off < l3_len; off += ext_len) {
+		if (proto == IPPROTO_FRAGMENT)
+			return -EINVAL;
+		nh_off = l3_offset + off;
+		proto = rte_ipv6_get_next_ext((uint8_t *)ipv6_hdr + off, proto,
+				&ext_len);
+		if (proto < 0)
+			return -EINVAL;
+	}
+
+	if (off != l3_len || proto == IPPROTO_FRAGMENT)
+		return -EINVAL;
+
+	if (nh_offset != NULL)
+		*nh_offset = nh_off;
+	return proto;
+}
+
 /**
  * Internal function which divides the input packet into small segments.
  * Each of the newly-created segments is organized as a two-segment MBUF,
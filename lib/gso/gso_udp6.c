@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <rte_random.h>
+
+#include "gso_common.h"
+#include "gso_udp6.h"
+
+/*
+ * Turn output segments into IPv6 fragments: append a fragment header
+ * to the copy of the packet header, which is the whole first MBUF of
+ * every output segment, and chain it after the last extension header.
+ */
+static inline void
+update_ipv6_udp_headers(struct rte_mbuf *pkt, struct rte_mbuf **segs,
+		uint16_t nb_segs, uint16_t nh_offset)
+{
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	uint8_t *next_proto;
+	uint32_t frag_id;
+	uint16_t frag_offset = 0, is_mf;
+	uint16_t l2_hdrlen = pkt->l2_len, l3_hdrlen = pkt->l3_len;
+	uint16_t hdr_offset = l2_hdrlen + l3_hdrlen;
+	uint16_t tail_idx = nb_segs - 1, i;
+	uint8_t proto;
+
+	proto = *rte_pktmbuf_mtod_offset(pkt, uint8_t *, nh_offset);
+	frag_id = rte_cpu_to_be_32((uint32_t)rte_rand());
+
+	for (i = 0; i < nb_segs; i++) {
+		frag_hdr = rte_pktmbuf_mtod_offset(segs[i],
+			struct rte_ipv6_fragment_ext *, hdr_offset);
+		segs[i]->data_len += RTE_IPV6_FRAG_HDR_SIZE;
+		segs[i]->pkt_len += RTE_IPV6_FRAG_HDR_SIZE;
+		segs[i]->l3_len += RTE_IPV6_FRAG_HDR_SIZE;
+
+		next_proto = rte_pktmbuf_mtod_offset(segs[i], uint8_t *,
+			nh_offset);
+		*next_proto = IPPROTO_FRAGMENT;
+
+		is_mf = i < tail_idx ? RTE_IPV6_EHDR_MF_MASK : 0;
+		frag_hdr->next_header = proto;
+		frag_hdr->reserved = 0;
+		frag_hdr->frag_data = rte_cpu_to_be_16(
+			RTE_IPV6_SET_FRAG_DATA(frag_offset, is_mf));
+		frag_hdr->id = frag_id;
+
+		update_ipv6_header(segs[i], l2_hdrlen);
+		frag_offset += segs[i]->pkt_len - hdr_offset -
+			RTE_IPV6_FRAG_HDR_SIZE;
+	}
+}
+
+int
+gso_udp6_segment(struct rte_mbuf *pkt,
+		uint16_t gso_size,
+		struct rte_mempool *direct_pool,
+		struct rte_mempool *indirect_pool,
+		struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out)
+{
+	uint16_t pyld_unit_size, hdr_offset, nh_offset;
+	int ret;
+
+	/* Don't process the fragmented packet */
+	if (unlikely(gso_ipv6_skip_ext(pkt, pkt->l2_len, pkt->l3_len,
+			&nh_offset) != IPPROTO_UDP))
+		return 0;
+
+	/*
+	 * UDP fragmentation is the same as IP fragmentation.
+	 * Except the first one, other output packets just have l2
+	 * and l3 headers, followed by a fragment header.
+	 */
+	hdr_offset = pkt->l2_len + pkt->l3_len;
+
+	/* Don't process the packet without data. */
+	if (unlikely(hdr_offset + pkt->l4_len >= pkt->pkt_len))
+		return 0;
+
+	/* Direct buffers must have room for the fragment header. */
+	if (unlikely(gso_size < hdr_offset + RTE_IPV6_FRAG_HDR_SIZE +
+			RTE_IPV6_EHDR_FO_ALIGN ||
+			rte_pktmbuf_data_room_size(direct_pool) <
+			RTE_PKTMBUF_HEADROOM + hdr_offset +
+			RTE_IPV6_FRAG_HDR_SIZE))
+		return -EINVAL;
+
+	/* pyld_unit_size must be a multiple of 8 because frag_off
+	 * uses 8 bytes as unit.
+	 */
+	pyld_unit_size = (gso_size - hdr_offset - RTE_IPV6_FRAG_HDR_SIZE) &
+		~(RTE_IPV6_EHDR_FO_ALIGN - 1);
+
+	/* Segment the payload */
+	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
+			indirect_pool, pkts_out, nb_pkts_out);
+	if (ret > 1)
+		update_ipv6_udp_headers(pkt, pkts_out, ret, nh_offset);
+
+	return ret;
+}
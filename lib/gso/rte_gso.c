@@ -11,9 +11,12 @@
 #include "rte_gso.h"
 #include "gso_common.h"
 #include "gso_tcp4.h"
+#include "gso_tcp6.h"
 #include "gso_tunnel_tcp4.h"
+#include "gso_tunnel_tcp6.h"
 #include "gso_tunnel_udp4.h"
 #include "gso_udp4.h"
+#include "gso_udp6.h"
 
 #define ILLEGAL_UDP_GSO_CTX(ctx) \
 	((((ctx)->gso_types & RTE_ETH_TX_OFFLOAD_UDP_TSO) == 0) || \
@@ -22,7 +25,8 @@
 #define ILLEGAL_TCP_GSO_CTX(ctx) \
 	((((ctx)->gso_types & (RTE_ETH_TX_OFFLOAD_TCP_TSO | \
 		RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO | \
-		RTE_ETH_TX_OFFLOAD_GRE_TNL_TSO)) == 0) || \
+		RTE_ETH_TX_OFFLOAD_GRE_TNL_TSO | \
+		RTE_ETH_TX_OFFLOAD_GENEVE_TNL_TSO)) == 0) || \
 		(ctx)->gso_size < RTE_GSO_SEG_SIZE_MIN)
 
 RTE_EXPORT_SYMBOL(rte_gso_segment)
@@ -63,6 +67,15 @@ rte_gso_segment(struct rte_mbuf *pkt,
 		ret = gso_tunnel_tcp4_segment(pkt, gso_size, ipid_delta,
 				direct_pool, indirect_pool,
 				pkts_out, nb_pkts_out);
+	} else if (IS_IPV6_UDP_TUNNEL_TCP(pkt->ol_flags) &&
+			((IS_VXLAN_TCP(pkt->ol_flags) &&
+			 (gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO)) ||
+			 (IS_GENEVE_TCP(pkt->ol_flags) &&
+			 (gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_GENEVE_TNL_TSO)))) {
+		pkt->ol_flags &= (~RTE_MBUF_F_TX_TCP_SEG);
+		ret = gso_tunnel_tcp6_segment(pkt, gso_size, ipid_delta,
+				direct_pool, indirect_pool,
+				pkts_out, nb_pkts_out);
 	} else if (IS_IPV4_VXLAN_UDP4(pkt->ol_flags) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_UDP_TSO)) {
@@ -81,6 +94,16 @@ rte_gso_segment(struct rte_mbuf *pkt,
 		pkt->ol_flags &= (~RTE_MBUF_F_TX_UDP_SEG);
 		ret = gso_udp4_segment(pkt, gso_size, direct_pool,
 				indirect_pool, pkts_out, nb_pkts_out);
+	} else if (IS_IPV6_TCP(pkt->ol_flags) &&
+			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_TCP_TSO)) {
+		pkt->ol_flags &= (~RTE_MBUF_F_TX_TCP_SEG);
+		ret = gso_tcp6_segment(pkt, gso_size, direct_pool,
+				indirect_pool, pkts_out, nb_pkts_out);
+	} else if (IS_IPV6_UDP(pkt->ol_flags) &&
+			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_UDP_TSO)) {
+		pkt->ol_flags &= (~RTE_MBUF_F_TX_UDP_SEG);
+		ret = gso_udp6_segment(pkt, gso_size, direct_pool,
+				indirect_pool, pkts_out, nb_pkts_out);
 	} else {
 		ret = -ENOTSUP;	/* only UDP or TCP allowed */
 	}
@@ -1301,6 +1301,137 @@ rte_hash_add_key_data(const struct rte_hash *h, const void *key, void *data)
 		return ret;
 }
 
+/* Insert a burst of keys.
+ * Hashes are computed and buckets prefetched for the whole burst first.
+ * Keys that are already present or that fit into a free entry of their
+ * primary bucket are then handled under a single writer lock. The remaining
+ * keys, which need cuckoo displacement, extendable buckets or slot
+ * reclamation, fall back to the single key path.
+ */
+static inline int
+__rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		void **data, uint32_t num_keys, int32_t *positions)
+{
+	hash_sig_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t short_sig[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash_bucket *prim_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash_bucket *sec_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash_key *new_k, *key_store = h->key_store;
+	struct lcore_cache *cached_free_slots = NULL;
+	struct rte_hash_bucket *cur_bkt;
+	uint64_t slow_mask = 0;
+	uint32_t prim_index, sec_index;
+	uint32_t slot_id;
+	uint32_t i, j;
+	int32_t ret;
+	int num_added = 0;
+
+	/* Calculate hashes and prefetch both buckets of every key */
+	for (i = 0; i < num_keys; i++) {
+		prim_hash[i] = rte_hash_hash(h, keys[i]);
+		short_sig[i] = get_short_sig(prim_hash[i]);
+		prim_index = get_prim_bucket_index(h, prim_hash[i]);
+		sec_index = get_alt_bucket_index(h, prim_index, short_sig[i]);
+		prim_bkt[i] = &h->buckets[prim_index];
+		sec_bkt[i] = &h->buckets[sec_index];
+		rte_prefetch0(prim_bkt[i]);
+		rte_prefetch0(sec_bkt[i]);
+	}
+
+	if (h->use_local_cache)
+		cached_free_slots = &h->local_free_slots[rte_lcore_id()];
+
+	__hash_rw_writer_lock(h);
+	for (i = 0; i < num_keys; i++) {
+		void *key_data = (data != NULL) ? data[i] : NULL;
+
+		/* Check if key is already inserted */
+		ret = search_and_update(h, key_data, keys[i], prim_bkt[i],
+				short_sig[i]);
+		if (ret == -1) {
+			FOR_EACH_BUCKET(cur_bkt, sec_bkt[i]) {
+				ret = search_and_update(h, key_data, keys[i],
+						cur_bkt, short_sig[i]);
+				if (ret != -1)
+					break;
+			}
+		}
+		if (ret != -1) {
+			positions[i] = ret;
+			continue;
+		}
+
+		/* Look for an empty entry in the primary bucket */
+		for (j = 0; j < RTE_HASH_BUCKET_ENTRIES; j++)
+			if (prim_bkt[i]->key_idx[j] == EMPTY_SLOT)
+				break;
+		if (j == RTE_HASH_BUCKET_ENTRIES) {
+			slow_mask |= 1ULL << i;
+			continue;
+		}
+
+		slot_id = alloc_slot(h, cached_free_slots);
+		if (slot_id == EMPTY_SLOT) {
+			slow_mask |= 1ULL << i;
+			continue;
+		}
+
+		new_k = RTE_PTR_ADD(key_store, slot_id * h->key_entry_size);
+		/* pdata is the guard variable of the application data */
+		rte_atomic_store_explicit(&new_k->pdata,
+			key_data,
+			rte_memory_order_release);
+		memcpy(new_k->key, keys[i], h->key_len);
+
+		prim_bkt[i]->sig_current[j] = short_sig[i];
+		/* key_idx is the guard variable for signature and key */
+		rte_atomic_store_explicit(&prim_bkt[i]->key_idx[j],
+				 slot_id,
+				 rte_memory_order_release);
+		positions[i] = slot_id - 1;
+	}
+	__hash_rw_writer_unlock(h);
+
+	/* Keys which need to make space go one by one */
+	while (slow_mask) {
+		i = rte_ctz64(slow_mask);
+		slow_mask &= ~(1ULL << i);
+		positions[i] = __rte_hash_add_key_with_hash(h, keys[i],
+				prim_hash[i], (data != NULL) ? data[i] : NULL);
+	}
+
+	for (i = 0; i < num_keys; i++)
+		if (positions[i] >= 0)
+			num_added++;
+
+	return num_added;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_add_key_bulk, 25.07)
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions)
+{
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	return __rte_hash_add_key_bulk(h, keys, NULL, num_keys, positions);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_add_key_bulk_data, 25.07)
+int
+rte_hash_add_key_bulk_data(const struct rte_hash *h, const void **keys,
+		void **data, uint32_t num_keys, int32_t *positions)
+{
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (data == NULL) ||
+			(num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	return __rte_hash_add_key_bulk(h, keys, data, num_keys, positions);
+}
+
 /* Search one bucket to find the match key - uses rw lock */
 static inline int32_t
 search_one_bucket_l(const struct rte_hash *h, const void *key,
@@ -1765,9 +1896,17 @@ search_and_remove(const struct rte_hash *h, const void *key,
 	return -1;
 }
 
+/* Remove a key from the table.
+ * Writer is expected to hold the lock while calling this function.
+ * If @sync_entry is not NULL and the table uses RTE_HASH_QSBR_MODE_SYNC,
+ * the resources of the deleted key are not reclaimed here: they are
+ * returned in @sync_entry and @sync_pending is set, so that the caller
+ * can wait for a single grace period for a whole batch of deletes.
+ */
 static inline int32_t
-__rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
-						hash_sig_t sig)
+__rte_hash_del_key_with_hash_locked(const struct rte_hash *h,
+		const void *key, hash_sig_t sig,
+		struct __rte_hash_rcu_dq_entry *sync_entry, int *sync_pending)
 {
 	uint32_t prim_bucket_idx, sec_bucket_idx;
 	struct rte_hash_bucket *prim_bkt, *sec_bkt, *prev_bkt, *last_bkt;
@@ -1783,7 +1922,6 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
 	prim_bkt = &h->buckets[prim_bucket_idx];
 
-	__hash_rw_writer_lock(h);
 	/* look for key in primary bucket */
 	ret = search_and_remove(h, key, prim_bkt, short_sig, &pos);
 	if (ret != -1) {
@@ -1806,7 +1944,6 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 		}
 	}
 
-	__hash_rw_writer_unlock(h);
 	return -ENOENT;
 
 /* Search last bucket to see if empty to be recycled */
@@ -1853,7 +1990,11 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 		/* Key index where key is stored, adding the first dummy index */
 		rcu_dq_entry.key_idx = ret + 1;
 		rcu_dq_entry.ext_bkt_idx = index;
-		if (h->dq == NULL) {
+		if (h->dq == NULL && sync_entry != NULL) {
+			/* Batched delete, grace period is waited by caller */
+			*sync_entry = rcu_dq_entry;
+			*sync_pending = 1;
+		} else if (h->dq == NULL) {
 			/* Wait for quiescent state change if using
 			 * RTE_HASH_QSBR_MODE_SYNC
 			 */
@@ -1866,6 +2007,17 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 			if (rte_rcu_qsbr_dq_enqueue(h->dq, &rcu_dq_entry) != 0)
 				HASH_LOG(ERR, "Failed to push QSBR FIFO");
 	}
+	return ret;
+}
+
+static inline int32_t
+__rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
+						hash_sig_t sig)
+{
+	int32_t ret;
+
+	__hash_rw_writer_lock(h);
+	ret = __rte_hash_del_key_with_hash_locked(h, key, sig, NULL, NULL);
 	__hash_rw_writer_unlock(h);
 	return ret;
 }
@@ -1887,6 +2039,64 @@ rte_hash_del_key(const struct rte_hash *h, const void *key)
 	return __rte_hash_del_key_with_hash(h, key, rte_hash_hash(h, key));
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_del_key_bulk, 25.07)
+int
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions)
+{
+	hash_sig_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	struct __rte_hash_rcu_dq_entry sync_entry[RTE_HASH_LOOKUP_BULK_MAX];
+	int sync_pending[RTE_HASH_LOOKUP_BULK_MAX] = {0};
+	struct __rte_hash_rcu_dq_entry *sync_entries = NULL;
+	int need_sync = 0;
+	uint32_t prim_index, sec_index;
+	uint32_t i;
+	int num_deleted = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	/* Wait for a single grace period for the whole burst */
+	if (h->hash_rcu_cfg != NULL && h->dq == NULL)
+		sync_entries = sync_entry;
+
+	/* Calculate hashes and prefetch both buckets of every key */
+	for (i = 0; i < num_keys; i++) {
+		prim_hash[i] = rte_hash_hash(h, keys[i]);
+		prim_index = get_prim_bucket_index(h, prim_hash[i]);
+		sec_index = get_alt_bucket_index(h, prim_index,
+				get_short_sig(prim_hash[i]));
+		rte_prefetch0(&h->buckets[prim_index]);
+		rte_prefetch0(&h->buckets[sec_index]);
+	}
+
+	__hash_rw_writer_lock(h);
+	for (i = 0; i < num_keys; i++) {
+		positions[i] = __rte_hash_del_key_with_hash_locked(h, keys[i],
+				prim_hash[i],
+				sync_entries != NULL ? &sync_entry[i] : NULL,
+				&sync_pending[i]);
+		if (positions[i] >= 0)
+			num_deleted++;
+		need_sync |= sync_pending[i];
+	}
+
+	if (need_sync) {
+		/* Wait for quiescent state change once for all the keys */
+		rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
+					 RTE_QSBR_THRID_INVALID);
+		for (i = 0; i < num_keys; i++)
+			if (sync_pending[i])
+				__hash_rcu_qsbr_free_resource(
+					(void *)((uintptr_t)h),
+					&sync_entry[i], 1);
+	}
+	__hash_rw_writer_unlock(h);
+
+	return num_deleted;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_get_key_with_position)
 int
 rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
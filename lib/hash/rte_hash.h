@@ -320,6 +320,66 @@ rte_hash_add_key(const struct rte_hash *h, const void *key);
 int32_t
 rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t sig);
 
+/**
+ * Add multiple keys to an existing hash table.
+ * The hash of every key is calculated and its buckets are prefetched
+ * before any of them is modified, and the writer lock (if any)
+ * is taken once for the whole burst when no cuckoo displacement is needed.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread by default.
+ * Thread safety can be enabled by setting flag during
+ * table creation.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a status for each key of the list.
+ *   A non-negative value is the unique key ID, as returned by rte_hash_add_key.
+ *   -ENOSPC is set if there is no space in the hash for this key.
+ * @return
+ *   -EINVAL if the parameters are invalid, otherwise number of keys added.
+ */
+__rte_experimental
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions);
+
+/**
+ * Add multiple key-value pairs to an existing hash table.
+ * The hash of every key is calculated and its buckets are prefetched
+ * before any of them is modified, and the writer lock (if any)
+ * is taken once for the whole burst when no cuckoo displacement is needed.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread by default.
+ * Thread safety can be enabled by setting flag during
+ * table creation.
+ * If a key exists already in the table, its value is updated
+ * as done by rte_hash_add_key_data.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param data
+ *   A pointer to a list of data to add, one per key.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a status for each key of the list.
+ *   A non-negative value is the unique key ID, as returned by rte_hash_add_key.
+ *   -ENOSPC is set if there is no space in the hash for this key.
+ * @return
+ *   -EINVAL if the parameters are invalid, otherwise number of keys added.
+ */
+__rte_experimental
+int
+rte_hash_add_key_bulk_data(const struct rte_hash *h, const void **keys,
+		void **data, uint32_t num_keys, int32_t *positions);
+
 /**
  * Remove a key from an existing hash table.
  * This operation is not multi-thread safe
@@ -382,6 +442,38 @@ rte_hash_del_key(const struct rte_hash *h, const void *key);
 int32_t
 rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t sig);
 
+/**
+ * Remove multiple keys from an existing hash table.
+ * The hash of every key is calculated and its buckets are prefetched
+ * before any of them is modified, and the writer lock (if any)
+ * is taken once for the whole burst.
+ * When internal RCU is enabled in RTE_HASH_QSBR_MODE_SYNC mode,
+ * a single grace period is waited for the whole burst.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread by default.
+ * Thread safety can be enabled by setting flag during
+ * table creation.
+ * The rules described for rte_hash_del_key about freeing the key index
+ * apply to every key of the burst.
+ *
+ * @param h
+ *   Hash table to remove the keys from.
+ * @param keys
+ *   A pointer to a list of keys to remove.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a status for each key of the list.
+ *   A non-negative value is the key ID returned when the key was added.
+ *   -ENOENT is set if the key is not found.
+ * @return
+ *   -EINVAL if the parameters are invalid, otherwise number of keys removed.
+ */
+__rte_experimental
+int
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions);
+
 /**
  * Find a key in the hash table given the position.
  * This operation is multi-thread safe with regarding to other lookup threads.
@@ -700,6 +792,68 @@ __rte_experimental
 int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed,
 		unsigned int *pending, unsigned int *available);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Save the content of a hash table to a file.
+ *
+ * The buckets and the keys are written as they are laid out in memory,
+ * so that the table can be restored with rte_hash_snapshot_load()
+ * without hashing any key again. The data associated to the keys is
+ * saved as is: if it is a pointer, it must be valid in the process
+ * loading the snapshot.
+ *
+ * This function must not be called concurrently with a writer.
+ *
+ * @param h
+ *   Hash table to save.
+ * @param path
+ *   Path of the file to create.
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -EIO or another negative errno value if the file cannot be written.
+ */
+__rte_experimental
+int
+rte_hash_snapshot_save(const struct rte_hash *h, const char *path);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Replace the content of a hash table by a snapshot.
+ *
+ * The hash table must have been created with the same parameters and
+ * hash function as the table which was saved. The file is mapped and
+ * checked (layout, parameters, checksum, and the hash function on a
+ * sample of the keys) before the table is modified.
+ * Keys waiting in the RCU defer queue are reclaimed first; the load is
+ * refused if some of them are still in use by readers.
+ *
+ * This function must not be called concurrently with any other operation
+ * on the table.
+ *
+ * @param h
+ *   Hash table to restore.
+ * @param path
+ *   Path of a file written by rte_hash_snapshot_save().
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the parameters are invalid or the snapshot does not
+ *     match the table. The table is left unchanged.
+ *   - -EBUSY if deleted keys are still waiting for RCU readers.
+ *     The table is left unchanged.
+ *   - -ENOMEM if the free lists cannot be rebuilt, or -EINVAL if the
+ *     bucket chains of the snapshot are inconsistent.
+ *     The table is left empty.
+ *   - another negative errno value if the file cannot be read.
+ */
+__rte_experimental
+int
+rte_hash_snapshot_load(struct rte_hash *h, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
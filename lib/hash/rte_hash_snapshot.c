@@ -0,0 +1,449 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_memcpy.h>
+#include <rte_ring_elem.h>
+#include <rte_rcu_qsbr.h>
+
+#include "rte_hash.h"
+#include "rte_hash_crc.h"
+
+extern int hash_logtype;
+#define RTE_LOGTYPE_HASH hash_logtype
+#define HASH_LOG(level, ...) \
+	RTE_LOG_LINE(level, HASH, "" __VA_ARGS__)
+
+#include "rte_cuckoo_hash.h"
+
+/*
+ * A snapshot is a header followed by the bucket array, the extendable
+ * bucket array and the key store, as they are laid out in memory. Each
+ * section starts on a page boundary so the file can be mapped and each
+ * section copied with a single memcpy, without hashing any key again.
+ *
+ * The free slot and free extendable bucket rings are not saved: they are
+ * rebuilt on load from the entries the buckets refer to, which also
+ * drops the lcore caches and the deleted entries that were waiting for
+ * an RCU grace period.
+ */
+
+#define HASH_SNAPSHOT_MAGIC	UINT64_C(0x50414e5348534852) /* "RHSHSNAP" */
+#define HASH_SNAPSHOT_VERSION	1
+#define HASH_SNAPSHOT_ALIGN	4096
+/* Number of keys hashed again on load to check the hash function. */
+#define HASH_SNAPSHOT_CHECK_KEYS	64
+/* Checksum is computed by chunks, as rte_hash_crc() length is 32-bit. */
+#define HASH_SNAPSHOT_CRC_CHUNK	(UINT32_C(1) << 30)
+
+enum hash_snapshot_sec_id {
+	HASH_SNAPSHOT_BUCKETS,
+	HASH_SNAPSHOT_EXT_BUCKETS,
+	HASH_SNAPSHOT_KEYS,
+	HASH_SNAPSHOT_NB_SECS
+};
+
+struct hash_snapshot_sec {
+	uint64_t off;
+	uint64_t len;
+};
+
+struct hash_snapshot_hdr {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t crc;		/* of the header with crc set to 0 and data */
+	uint32_t entries;
+	uint32_t key_len;
+	uint32_t num_buckets;
+	uint32_t bucket_size;	/* detects a different bucket layout */
+	uint32_t key_entry_size;
+	uint32_t num_key_slots;
+	uint32_t hash_func_init_val;
+	uint8_t ext_table_support;
+	uint8_t use_local_cache;
+	uint8_t reserved[2];
+	uint64_t buckets_ext_addr; /* to relocate the bucket chains */
+	struct hash_snapshot_sec sec[HASH_SNAPSHOT_NB_SECS];
+};
+
+static uint32_t
+hash_snapshot_num_key_slots(const struct rte_hash *h)
+{
+	if (h->use_local_cache)
+		return h->entries + (RTE_MAX_LCORE - 1) *
+				(LCORE_CACHE_SIZE - 1) + 1;
+	return h->entries + 1;
+}
+
+static uint32_t
+hash_snapshot_crc(const void *data, uint64_t len, uint32_t crc)
+{
+	const uint8_t *p = data;
+	uint32_t n;
+
+	while (len != 0) {
+		n = RTE_MIN(len, (uint64_t)HASH_SNAPSHOT_CRC_CHUNK);
+		crc = rte_hash_crc(p, n, crc);
+		p += n;
+		len -= n;
+	}
+	return crc;
+}
+
+static void
+hash_snapshot_init_hdr(const struct rte_hash *h, struct hash_snapshot_hdr *hdr)
+{
+	uint64_t off;
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->magic = HASH_SNAPSHOT_MAGIC;
+	hdr->version = HASH_SNAPSHOT_VERSION;
+	hdr->entries = h->entries;
+	hdr->key_len = h->key_len;
+	hdr->num_buckets = h->num_buckets;
+	hdr->bucket_size = sizeof(struct rte_hash_bucket);
+	hdr->key_entry_size = h->key_entry_size;
+	hdr->num_key_slots = hash_snapshot_num_key_slots(h);
+	hdr->hash_func_init_val = h->hash_func_init_val;
+	hdr->ext_table_support = h->ext_table_support;
+	hdr->use_local_cache = h->use_local_cache;
+	hdr->buckets_ext_addr = (uintptr_t)h->buckets_ext;
+
+	off = RTE_ALIGN_CEIL(sizeof(*hdr), HASH_SNAPSHOT_ALIGN);
+	hdr->sec[HASH_SNAPSHOT_BUCKETS].off = off;
+	hdr->sec[HASH_SNAPSHOT_BUCKETS].len = (uint64_t)h->num_buckets *
+			sizeof(struct rte_hash_bucket);
+	off += RTE_ALIGN_CEIL(hdr->sec[HASH_SNAPSHOT_BUCKETS].len,
+			HASH_SNAPSHOT_ALIGN);
+
+	hdr->sec[HASH_SNAPSHOT_EXT_BUCKETS].off = off;
+	if (h->ext_table_support)
+		hdr->sec[HASH_SNAPSHOT_EXT_BUCKETS].len =
+			hdr->sec[HASH_SNAPSHOT_BUCKETS].len;
+	off += RTE_ALIGN_CEIL(hdr->sec[HASH_SNAPSHOT_EXT_BUCKETS].len,
+			HASH_SNAPSHOT_ALIGN);
+
+	hdr->sec[HASH_SNAPSHOT_KEYS].off = off;
+	hdr->sec[HASH_SNAPSHOT_KEYS].len = (uint64_t)h->key_entry_size *
+			hdr->num_key_slots;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_snapshot_save, 25.07)
+int
+rte_hash_snapshot_save(const struct rte_hash *h, const char *path)
+{
+	static const uint8_t zero[HASH_SNAPSHOT_ALIGN];
+	struct hash_snapshot_hdr hdr;
+	const void *data[HASH_SNAPSHOT_NB_SECS];
+	uint64_t pos, pad;
+	uint32_t crc;
+	unsigned int i;
+	FILE *f;
+
+	if (h == NULL || path == NULL)
+		return -EINVAL;
+
+	hash_snapshot_init_hdr(h, &hdr);
+	data[HASH_SNAPSHOT_BUCKETS] = h->buckets;
+	data[HASH_SNAPSHOT_EXT_BUCKETS] = h->buckets_ext;
+	data[HASH_SNAPSHOT_KEYS] = h->key_store;
+
+	f = fopen(path, "wb");
+	if (f == NULL) {
+		HASH_LOG(ERR, "Cannot create hash snapshot %s: %s",
+			path, strerror(errno));
+		return -errno;
+	}
+
+	/* header is written last, once the checksum is known */
+	crc = hash_snapshot_crc(&hdr, sizeof(hdr), 0);
+	pos = 0;
+	for (i = 0; i < HASH_SNAPSHOT_NB_SECS; i++) {
+		if (hdr.sec[i].len == 0)
+			continue;
+		for (pad = hdr.sec[i].off - pos; pad != 0; pad -= RTE_MIN(pad,
+				sizeof(zero))) {
+			if (fwrite(zero, RTE_MIN(pad, sizeof(zero)), 1, f) != 1)
+				goto error;
+		}
+		if (fwrite(data[i], hdr.sec[i].len, 1, f) != 1)
+			goto error;
+		crc = hash_snapshot_crc(data[i], hdr.sec[i].len, crc);
+		pos = hdr.sec[i].off + hdr.sec[i].len;
+	}
+
+	hdr.crc = crc;
+	if (fseek(f, 0, SEEK_SET) != 0 || fwrite(&hdr, sizeof(hdr), 1, f) != 1)
+		goto error;
+	if (fclose(f) != 0) {
+		f = NULL;
+		goto error;
+	}
+
+	HASH_LOG(DEBUG, "Hash %s saved to %s", h->name, path);
+	return 0;
+
+error:
+	HASH_LOG(ERR, "Cannot write hash snapshot %s: %s",
+		path, strerror(errno));
+	if (f != NULL)
+		fclose(f);
+	remove(path);
+	return -EIO;
+}
+
+/* Check that a snapshot was taken from a table of the same layout. */
+static int
+hash_snapshot_check(const struct rte_hash *h,
+		const struct hash_snapshot_hdr *hdr, uint64_t size)
+{
+	struct hash_snapshot_hdr ref;
+	struct hash_snapshot_hdr tmp;
+	unsigned int i;
+	uint32_t crc;
+
+	if (size < sizeof(*hdr) || hdr->magic != HASH_SNAPSHOT_MAGIC ||
+			hdr->version != HASH_SNAPSHOT_VERSION) {
+		HASH_LOG(ERR, "Not a hash snapshot");
+		return -EINVAL;
+	}
+
+	hash_snapshot_init_hdr(h, &ref);
+	if (hdr->entries != ref.entries || hdr->key_len != ref.key_len ||
+			hdr->num_buckets != ref.num_buckets ||
+			hdr->bucket_size != ref.bucket_size ||
+			hdr->key_entry_size != ref.key_entry_size ||
+			hdr->num_key_slots != ref.num_key_slots ||
+			hdr->hash_func_init_val != ref.hash_func_init_val ||
+			hdr->ext_table_support != ref.ext_table_support ||
+			hdr->use_local_cache != ref.use_local_cache) {
+		HASH_LOG(ERR, "Hash snapshot parameters do not match hash %s",
+			h->name);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < HASH_SNAPSHOT_NB_SECS; i++) {
+		if (hdr->sec[i].off != ref.sec[i].off ||
+				hdr->sec[i].len != ref.sec[i].len ||
+				hdr->sec[i].off + hdr->sec[i].len > size) {
+			HASH_LOG(ERR, "Hash snapshot is truncated");
+			return -EINVAL;
+		}
+	}
+
+	tmp = *hdr;
+	tmp.crc = 0;
+	crc = hash_snapshot_crc(&tmp, sizeof(tmp), 0);
+	for (i = 0; i < HASH_SNAPSHOT_NB_SECS; i++)
+		crc = hash_snapshot_crc(RTE_PTR_ADD(hdr, hdr->sec[i].off),
+				hdr->sec[i].len, crc);
+	if (crc != hdr->crc) {
+		HASH_LOG(ERR, "Hash snapshot checksum mismatch");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * The hash function cannot be saved. Hash again some of the keys to
+ * check they are in their primary or secondary bucket.
+ */
+static int
+hash_snapshot_check_func(const struct rte_hash *h,
+		const struct hash_snapshot_hdr *hdr)
+{
+	const struct rte_hash_bucket *bkt =
+		RTE_PTR_ADD(hdr, hdr->sec[HASH_SNAPSHOT_BUCKETS].off);
+	const void *keys = RTE_PTR_ADD(hdr, hdr->sec[HASH_SNAPSHOT_KEYS].off);
+	const struct rte_hash_key *k;
+	unsigned int checked = 0;
+	uint32_t i, j, idx, prim;
+	hash_sig_t sig;
+
+	for (i = 0; i < h->num_buckets &&
+			checked < HASH_SNAPSHOT_CHECK_KEYS; i++) {
+		for (j = 0; j < RTE_HASH_BUCKET_ENTRIES; j++) {
+			idx = bkt[i].key_idx[j];
+			if (idx == EMPTY_SLOT)
+				continue;
+			if (idx >= hdr->num_key_slots)
+				return -EINVAL;
+			k = RTE_PTR_ADD(keys, (uint64_t)idx * h->key_entry_size);
+			sig = rte_hash_hash(h, k->key);
+			prim = sig & h->bucket_bitmask;
+			if ((uint16_t)(sig >> 16) != bkt[i].sig_current[j] ||
+					(prim != i && ((prim ^ (sig >> 16)) &
+					h->bucket_bitmask) != i)) {
+				HASH_LOG(ERR,
+					"Hash snapshot keys do not match the hash function of %s",
+					h->name);
+				return -EINVAL;
+			}
+			checked++;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Relocate the extendable bucket chains, and rebuild the free slot and
+ * free extendable bucket rings from the used entries.
+ */
+static int
+hash_snapshot_rebuild(struct rte_hash *h, uint64_t old_ext_addr)
+{
+	uint32_t num_key_slots = hash_snapshot_num_key_slots(h);
+	struct rte_hash_bucket *bkt;
+	uint8_t *used_keys, *used_ext = NULL;
+	uint32_t i, j, idx, ext_idx;
+	uint64_t off;
+	int ret = -EINVAL;
+
+	used_keys = rte_zmalloc(NULL, num_key_slots, 0);
+	if (h->ext_table_support)
+		used_ext = rte_zmalloc(NULL, h->num_buckets + 1, 0);
+	if (used_keys == NULL || (h->ext_table_support && used_ext == NULL)) {
+		ret = -ENOMEM;
+		goto exit;
+	}
+
+	for (i = 0; i < h->num_buckets; i++) {
+		for (bkt = &h->buckets[i]; bkt != NULL; bkt = bkt->next) {
+			if (bkt->next != NULL) {
+				off = (uintptr_t)bkt->next - old_ext_addr;
+				ext_idx = off / sizeof(struct rte_hash_bucket);
+				if (used_ext == NULL || ext_idx >= h->num_buckets ||
+						off % sizeof(struct rte_hash_bucket) != 0 ||
+						used_ext[ext_idx + 1] != 0)
+					goto exit;
+				used_ext[ext_idx + 1] = 1;
+				bkt->next = &h->buckets_ext[ext_idx];
+			}
+			for (j = 0; j < RTE_HASH_BUCKET_ENTRIES; j++) {
+				idx = bkt->key_idx[j];
+				if (idx >= num_key_slots)
+					goto exit;
+				used_keys[idx] = 1;
+			}
+		}
+	}
+
+	rte_ring_reset(h->free_slots);
+	for (i = 1; i < num_key_slots; i++) {
+		if (used_keys[i] == 0)
+			rte_ring_sp_enqueue_elem(h->free_slots, &i,
+					sizeof(uint32_t));
+	}
+
+	if (h->ext_table_support) {
+		rte_ring_reset(h->free_ext_bkts);
+		for (i = 1; i <= h->num_buckets; i++) {
+			if (used_ext[i] == 0)
+				rte_ring_sp_enqueue_elem(h->free_ext_bkts, &i,
+						sizeof(uint32_t));
+		}
+		memset(h->ext_bkt_to_free, 0, sizeof(uint32_t) * num_key_slots);
+	}
+
+	if (h->use_local_cache) {
+		for (i = 0; i < RTE_MAX_LCORE; i++)
+			h->local_free_slots[i].len = 0;
+	}
+	*h->tbl_chng_cnt = 0;
+	ret = 0;
+
+exit:
+	rte_free(used_keys);
+	rte_free(used_ext);
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_snapshot_load, 25.07)
+int
+rte_hash_snapshot_load(struct rte_hash *h, const char *path)
+{
+	const struct hash_snapshot_hdr *hdr;
+	unsigned int pending;
+	struct stat st;
+	void *base;
+	int fd, ret;
+
+	if (h == NULL || path == NULL)
+		return -EINVAL;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		HASH_LOG(ERR, "Cannot open hash snapshot %s: %s",
+			path, strerror(errno));
+		return -errno;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*hdr)) {
+		close(fd);
+		HASH_LOG(ERR, "Invalid hash snapshot %s", path);
+		return -EINVAL;
+	}
+	base = rte_mem_map(NULL, st.st_size, RTE_PROT_READ, RTE_MAP_PRIVATE,
+			fd, 0);
+	close(fd);
+	if (base == NULL) {
+		HASH_LOG(ERR, "Cannot map hash snapshot %s", path);
+		return -rte_errno;
+	}
+	hdr = base;
+
+	ret = hash_snapshot_check(h, hdr, st.st_size);
+	if (ret == 0)
+		ret = hash_snapshot_check_func(h, hdr);
+	if (ret != 0)
+		goto exit;
+
+	/* deleted entries still waiting for readers would be freed later
+	 * into the restored free lists
+	 */
+	if (h->dq != NULL) {
+		rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0) {
+			HASH_LOG(ERR, "Hash %s has %u entries waiting for readers",
+				h->name, pending);
+			ret = -EBUSY;
+			goto exit;
+		}
+	}
+
+	rte_memcpy(h->buckets,
+		RTE_PTR_ADD(hdr, hdr->sec[HASH_SNAPSHOT_BUCKETS].off),
+		hdr->sec[HASH_SNAPSHOT_BUCKETS].len);
+	if (h->ext_table_support)
+		rte_memcpy(h->buckets_ext,
+			RTE_PTR_ADD(hdr, hdr->sec[HASH_SNAPSHOT_EXT_BUCKETS].off),
+			hdr->sec[HASH_SNAPSHOT_EXT_BUCKETS].len);
+	rte_memcpy(h->key_store,
+		RTE_PTR_ADD(hdr, hdr->sec[HASH_SNAPSHOT_KEYS].off),
+		hdr->sec[HASH_SNAPSHOT_KEYS].len);
+
+	ret = hash_snapshot_rebuild(h, hdr->buckets_ext_addr);
+	if (ret != 0) {
+		HASH_LOG(ERR, "Hash snapshot %s is inconsistent", path);
+		rte_hash_reset(h);
+	} else {
+		HASH_LOG(DEBUG, "Hash %s loaded from %s", h->name, path);
+	}
+
+exit:
+	rte_mem_unmap(base, st.st_size);
+	return ret;
+}
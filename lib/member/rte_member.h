@@ -10,9 +10,10 @@
  * The Membership Library is an extension and generalization of a traditional
  * filter (for example Bloom Filter and cuckoo filter) structure that has
  * multiple usages in a variety of workloads and applications. The library is
- * used to test if a key belongs to certain sets. Two types of such
- * "set-summary" structures are implemented: hash-table based (HT) and vector
- * bloom filter (vBF). For HT setsummary, two subtypes or modes are available,
+ * used to test if a key belongs to certain sets. Several types of such
+ * "set-summary" structures are implemented: hash-table based (HT), vector
+ * bloom filter (vBF), sketch, cuckoo filter (CF) and counting bloom filter
+ * (CBF). For HT setsummary, two subtypes or modes are available,
  * cache and non-cache modes. The table below summarize some properties of
  * the different implementations.
  */
@@ -48,6 +49,20 @@
  * |properties| used for heavy hitter       |
  * |          | detection.                  |
  * +----------+-----------------------------+
+ * +==========+=====================+========================+
+ * |   type   |      cf             |     cbf                |
+ * +==========+=====================+========================+
+ * |structure | cuckoo filter of    | bloom filter of 4-bit  |
+ * |          | 16-bit fingerprints | counters               |
+ * +----------+---------------------+------------------------+
+ * |set id    | single set: 1       | single set: 1          |
+ * +----------+---------------------+------------------------+
+ * |usages &  | can delete, half the| can delete,            |
+ * |properties| memory of HT, false | user-specified         |
+ * |          | positive depend on  | false-positive rate,   |
+ * |          | table size, add can | add never fails.       |
+ * |          | fail when full.     |                        |
+ * +----------+---------------------+------------------------+
  * -->
  */
 
@@ -115,6 +130,8 @@ enum rte_member_setsum_type {
 	RTE_MEMBER_TYPE_HT = 0,  /**< Hash table based set summary. */
 	RTE_MEMBER_TYPE_VBF,     /**< Vector of bloom filters. */
 	RTE_MEMBER_TYPE_SKETCH,
+	RTE_MEMBER_TYPE_CF,      /**< Cuckoo filter. */
+	RTE_MEMBER_TYPE_CBF,     /**< Counting bloom filter. */
 	RTE_MEMBER_NUM_TYPE
 };
 
@@ -204,6 +221,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 *
 	 * vBF setsummary is a vector of bloom filters. It is used when number
 	 * of sets is not big (less than 32 for current implementation).
+	 *
+	 * CF and CBF setsummaries summarize a single set and support deletion.
+	 * CF stores 16-bit fingerprints in a cuckoo table, CBF is a bloom
+	 * filter of counters. They are used for membership-only checks.
 	 */
 	enum rte_member_setsum_type type;
 
@@ -243,6 +264,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * number of bits we need for each BF. User does not specify the size of
 	 * each BF directly because the optimal size depends on the num_keys
 	 * and false positive rate.
+	 *
+	 * For CF, num_keys equals to the number of entries of the table, like
+	 * for non-cache HT. For CBF, num_keys is the expected number of keys,
+	 * like for vBF.
 	 */
 	uint32_t num_keys;
 
@@ -281,6 +306,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * to number of entries (num_keys) divided by entry count per bucket
 	 * (RTE_MEMBER_BUCKET_ENTRIES). Thus, the false_positive_rate is not
 	 * directly set by users for HT mode.
+	 *
+	 * CBF uses it like a vBF with one set. CF does not use it, its false
+	 * positive rate is in the order of 2*8/2^16 per lookup, since a key is
+	 * compared to the 16-bit fingerprints of 8 entries in two buckets.
 	 */
 	float false_positive_rate;
 
@@ -473,6 +502,7 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   For HT mode, the set_id has range as [1, 0x7FFF], MSB is reserved.
  *   For vBF mode the set id is limited by the num_set parameter when create
  *   the set-summary. For sketch mode, this id is ignored.
+ *   For CF and CBF modes, the set id must be 1.
  * @return
  *   HT (cache mode) and vBF should never fail unless the set_id is not in the
  *   valid range. In such case -EINVAL is returned.
@@ -483,7 +513,9 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   Return 0 for HT (cache mode) if the add does not cause
  *   eviction, return 1 otherwise. Return 0 for non-cache mode if success,
  *   -ENOSPC for full, and 1 if cuckoo eviction happens.
- *   Always returns 0 for vBF mode and sketch.
+ *   Always returns 0 for vBF mode, CBF mode and sketch.
+ *   For CF, return 0 if success, 1 if fingerprints were moved to make
+ *   room, and -ENOSPC for full, in which case the filter is unchanged.
  */
 int
 rte_member_add(const struct rte_member_setsum *setsum, const void *key,
@@ -561,6 +593,8 @@ rte_member_reset(const struct rte_member_setsum *setsum);
  *   For HT mode, we need both key and its corresponding set_id to
  *   properly delete the key. Without set_id, we may delete other keys with the
  *   same signature.
+ *   For CF and CBF modes, the set id must be 1. A key must only be deleted
+ *   if it was added, otherwise other keys could be deleted.
  * @return
  *   If no entry found to delete, an error code of -ENOENT could be returned.
  */
@@ -0,0 +1,245 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <rte_malloc.h>
+#include <rte_errno.h>
+#include <rte_log.h>
+#include <rte_prefetch.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cbf.h"
+
+/*
+ * Counting bloom filter: a bloom filter in which every bit is replaced by a
+ * 4-bit counter, so that a key can be deleted by decrementing the counters
+ * it incremented. It summarizes a single set. A counter which overflows
+ * sticks to its maximum value, it is never decremented afterwards: this
+ * may only cause false positives, never false negatives.
+ *
+ * Two counters are packed in one byte, so the filter takes four times the
+ * memory of a single bloom filter with the same false positive rate.
+ */
+int
+rte_member_create_cbf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint32_t counters;
+
+	if (params->num_keys == 0 ||
+			params->false_positive_rate <= 0 ||
+			params->false_positive_rate > 1) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR, "Membership CBF create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/* Same sizing as a bloom filter: m = -n * ln(p) / (ln(2)^2) */
+	counters = ceil((params->num_keys * log(params->false_positive_rate)) /
+			log(1.0 / (pow(2.0, log(2.0)))));
+
+	/* We round to power of 2 for performance during lookup */
+	ss->bits = rte_align32pow2(RTE_MAX(counters,
+			(uint32_t)RTE_MEMBER_CBF_MIN_COUNTERS));
+	ss->bit_mask = ss->bits - 1;
+	ss->num_hashes = RTE_MAX((uint32_t)(log(2.0) * counters /
+			params->num_keys), 1U);
+
+	MEMBER_LOG(DEBUG, "counting bloom filter created, "
+		"expects %u keys, has %u counters, %u hashes, "
+		"with false positive rate set as %.5f",
+		params->num_keys, ss->bits, ss->num_hashes,
+		params->false_positive_rate);
+
+	ss->table = rte_zmalloc_socket(NULL,
+			ss->bits / (8 / RTE_MEMBER_CBF_COUNTER_BITS),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static inline uint32_t
+get_counter(const uint8_t *cbf, uint32_t loc)
+{
+	return (cbf[loc >> 1] >> ((loc & 1) * RTE_MEMBER_CBF_COUNTER_BITS)) &
+			RTE_MEMBER_CBF_COUNTER_MAX;
+}
+
+static inline void
+inc_counter(uint8_t *cbf, uint32_t loc)
+{
+	uint32_t shift = (loc & 1) * RTE_MEMBER_CBF_COUNTER_BITS;
+
+	if (((cbf[loc >> 1] >> shift) & RTE_MEMBER_CBF_COUNTER_MAX) !=
+			RTE_MEMBER_CBF_COUNTER_MAX)
+		cbf[loc >> 1] += 1 << shift;
+}
+
+static inline void
+dec_counter(uint8_t *cbf, uint32_t loc)
+{
+	uint32_t shift = (loc & 1) * RTE_MEMBER_CBF_COUNTER_BITS;
+	uint32_t cnt = (cbf[loc >> 1] >> shift) & RTE_MEMBER_CBF_COUNTER_MAX;
+
+	if (cnt != 0 && cnt != RTE_MEMBER_CBF_COUNTER_MAX)
+		cbf[loc >> 1] -= 1 << shift;
+}
+
+static inline void
+get_cbf_hashes(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *h1, uint32_t *h2)
+{
+	*h1 = MEMBER_HASH_FUNC(key, ss->key_len, ss->prim_hash_seed);
+	*h2 = MEMBER_HASH_FUNC(h1, sizeof(uint32_t), ss->sec_hash_seed);
+}
+
+/* Return 1 if all the counters of a key are not zero. */
+static inline int
+test_counters(const struct rte_member_setsum *ss, uint32_t h1, uint32_t h2)
+{
+	const uint8_t *cbf = ss->table;
+	uint32_t j;
+
+	for (j = 0; j < ss->num_hashes; j++) {
+		if (get_counter(cbf, (h1 + j * h2) & ss->bit_mask) == 0)
+			return 0;
+	}
+	return 1;
+}
+
+int
+rte_member_lookup_cbf(const struct rte_member_setsum *ss, const void *key,
+		member_set_t *set_id)
+{
+	uint32_t h1, h2;
+
+	get_cbf_hashes(ss, key, &h1, &h2);
+	if (test_counters(ss, h1, h2)) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_cbf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	const uint8_t *cbf = ss->table;
+	uint32_t h1[RTE_MEMBER_LOOKUP_BULK_MAX], h2[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t num_matches = 0;
+	uint32_t i;
+
+	/*
+	 * Most misses are detected on the first counter, prefetch it for all
+	 * keys before testing any of them.
+	 */
+	for (i = 0; i < num_keys; i++) {
+		get_cbf_hashes(ss, keys[i], &h1[i], &h2[i]);
+		rte_prefetch0(&cbf[(h1[i] & ss->bit_mask) >> 1]);
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		if (test_counters(ss, h1[i], h2[i])) {
+			set_ids[i] = 1;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+/* A counting bloom filter summarizes a single set, so at most one match. */
+uint32_t
+rte_member_lookup_multi_cbf(const struct rte_member_setsum *ss,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id)
+{
+	if (match_per_key == 0)
+		return 0;
+	return rte_member_lookup_cbf(ss, key, set_id);
+}
+
+uint32_t
+rte_member_lookup_multi_bulk_cbf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids)
+{
+	member_set_t tmp_set[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t i, num_matches;
+
+	if (match_per_key == 0) {
+		for (i = 0; i < num_keys; i++)
+			match_count[i] = 0;
+		return 0;
+	}
+
+	num_matches = rte_member_lookup_bulk_cbf(ss, keys, num_keys, tmp_set);
+	for (i = 0; i < num_keys; i++) {
+		set_ids[i * match_per_key] = tmp_set[i];
+		match_count[i] = tmp_set[i] != RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+int
+rte_member_add_cbf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	uint8_t *cbf = ss->table;
+	uint32_t i, h1, h2;
+
+	if (set_id != 1)
+		return -EINVAL;
+
+	get_cbf_hashes(ss, key, &h1, &h2);
+	for (i = 0; i < ss->num_hashes; i++)
+		inc_counter(cbf, (h1 + i * h2) & ss->bit_mask);
+
+	return 0;
+}
+
+void
+rte_member_free_cbf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+int
+rte_member_delete_cbf(const struct rte_member_setsum *ss, const void *key,
+		member_set_t set_id)
+{
+	uint8_t *cbf = ss->table;
+	uint32_t i, h1, h2;
+
+	if (set_id != 1)
+		return -EINVAL;
+
+	/*
+	 * Decrementing the counters of a key which was never added would
+	 * remove other keys, refuse it when it is known not to be there.
+	 */
+	get_cbf_hashes(ss, key, &h1, &h2);
+	if (!test_counters(ss, h1, h2))
+		return -ENOENT;
+
+	for (i = 0; i < ss->num_hashes; i++)
+		dec_counter(cbf, (h1 + i * h2) & ss->bit_mask);
+
+	return 0;
+}
+
+void
+rte_member_reset_cbf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, ss->bits / (8 / RTE_MEMBER_CBF_COUNTER_BITS));
+}
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_MEMBER_CBF_H_
+#define _RTE_MEMBER_CBF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Counters are 4 bits wide, two of them are packed in one byte. */
+#define RTE_MEMBER_CBF_COUNTER_BITS 4
+/* A counter reaching this value sticks to it, it is never decremented. */
+#define RTE_MEMBER_CBF_COUNTER_MAX ((1 << RTE_MEMBER_CBF_COUNTER_BITS) - 1)
+/* Minimum number of counters, so that the table is at least a cache line. */
+#define RTE_MEMBER_CBF_MIN_COUNTERS 128
+
+int
+rte_member_create_cbf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_cbf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_cbf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+uint32_t
+rte_member_lookup_multi_cbf(const struct rte_member_setsum *setsum,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_multi_bulk_cbf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids);
+
+int
+rte_member_add_cbf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_free_cbf(struct rte_member_setsum *setsum);
+
+int
+rte_member_delete_cbf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_reset_cbf(const struct rte_member_setsum *setsum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CBF_H_ */
@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_random.h>
+#include <rte_log.h>
+#include <rte_vect.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cf.h"
+
+/*
+ * Cuckoo filter [B. Fan, et al. "Cuckoo Filter: Practically Better Than
+ * Bloom"]. Unlike the HT setsummary, no set id is stored along with the
+ * 16-bit fingerprints, so a cuckoo filter takes half of the memory of a non
+ * cache HT setsummary with the same number of entries, and it summarizes a
+ * single set. Keys can be deleted, as opposed to vBF.
+ *
+ * A bucket holds 8 fingerprints, so that all of them are compared in one
+ * SIMD instruction on both x86 and Arm.
+ */
+
+static_assert(sizeof(struct member_cf_bucket) == 16,
+	"cuckoo filter bucket must be 16 bytes for SIMD comparison");
+
+/* Return a mask with bit i set if entry i of the bucket holds fp. */
+static inline uint32_t
+search_cf_bucket(const struct member_cf_bucket *bkt, member_fp_t fp)
+{
+#if defined(RTE_ARCH_X86)
+	__m128i cmp = _mm_cmpeq_epi16(
+		_mm_load_si128((__m128i const *)bkt->fps),
+		_mm_set1_epi16(fp));
+
+	/* narrow 16-bit lanes to 8-bit lanes to get one bit per entry */
+	return _mm_movemask_epi8(_mm_packs_epi16(cmp, _mm_setzero_si128()));
+#elif defined(RTE_ARCH_ARM64)
+	const uint16x8_t mask = {0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80};
+	uint16x8_t vmat = vceqq_u16(vld1q_dup_u16(&fp), vld1q_u16(bkt->fps));
+
+	return vaddvq_u16(vandq_u16(vmat, mask));
+#else
+	uint32_t i, hitmask = 0;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++)
+		hitmask |= (uint32_t)(bkt->fps[i] == fp) << i;
+	return hitmask;
+#endif
+}
+
+static inline void
+get_cf_index(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *prim_bkt, member_fp_t *fp)
+{
+	uint32_t first_hash = MEMBER_HASH_FUNC(key, ss->key_len,
+						ss->prim_hash_seed);
+	uint32_t sec_hash = MEMBER_HASH_FUNC(&first_hash, sizeof(uint32_t),
+						ss->sec_hash_seed);
+
+	/* Fingerprint 0 marks an empty entry */
+	*fp = first_hash >> 16;
+	if (*fp == RTE_MEMBER_CF_EMPTY)
+		*fp = 1;
+	*prim_bkt = sec_hash & ss->bucket_mask;
+}
+
+/*
+ * The alternative bucket only depends on the current bucket and on the
+ * fingerprint, so that a fingerprint can be moved without the key. The
+ * fingerprint is mixed before the xor, otherwise on tables of more than
+ * 64K buckets a fingerprint could only move within a 64K bucket range.
+ */
+static inline uint32_t
+get_cf_alt_bucket(const struct rte_member_setsum *ss, uint32_t bkt,
+		member_fp_t fp)
+{
+	return (bkt ^ (fp * 0x5bd1e995)) & ss->bucket_mask;
+}
+
+int
+rte_member_create_cf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint32_t num_entries = rte_align32pow2(params->num_keys);
+	uint32_t num_buckets;
+	struct member_cf_bucket *buckets;
+
+	if (num_entries > RTE_MEMBER_ENTRIES_MAX ||
+			num_entries < RTE_MEMBER_CF_BUCKET_ENTRIES) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership cuckoo filter create with invalid parameters");
+		return -EINVAL;
+	}
+
+	num_buckets = num_entries / RTE_MEMBER_CF_BUCKET_ENTRIES;
+	buckets = rte_zmalloc_socket(NULL,
+			num_buckets * sizeof(struct member_cf_bucket),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (buckets == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for cuckoo filter "
+						"setsummary");
+		return -ENOMEM;
+	}
+
+	ss->table = buckets;
+	ss->bucket_cnt = num_buckets;
+	ss->bucket_mask = num_buckets - 1;
+
+	MEMBER_LOG(DEBUG, "Cuckoo filter created, "
+			"the table has %u entries, %u buckets",
+			num_entries, num_buckets);
+	return 0;
+}
+
+int
+rte_member_lookup_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t *set_id)
+{
+	const struct member_cf_bucket *buckets = ss->table;
+	uint32_t prim_bucket;
+	member_fp_t fp;
+
+	get_cf_index(ss, key, &prim_bucket, &fp);
+
+	if (search_cf_bucket(&buckets[prim_bucket], fp) != 0 ||
+			search_cf_bucket(&buckets[get_cf_alt_bucket(ss,
+				prim_bucket, fp)], fp) != 0) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_cf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	const struct member_cf_bucket *buckets = ss->table;
+	member_fp_t fp[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t prim_buckets[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t sec_buckets[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t num_matches = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		get_cf_index(ss, keys[i], &prim_buckets[i], &fp[i]);
+		sec_buckets[i] = get_cf_alt_bucket(ss, prim_buckets[i], fp[i]);
+		rte_prefetch0(&buckets[prim_buckets[i]]);
+		rte_prefetch0(&buckets[sec_buckets[i]]);
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		if (search_cf_bucket(&buckets[prim_buckets[i]], fp[i]) != 0 ||
+				search_cf_bucket(&buckets[sec_buckets[i]],
+					fp[i]) != 0) {
+			set_ids[i] = 1;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+/* A cuckoo filter summarizes a single set, so there is at most one match. */
+uint32_t
+rte_member_lookup_multi_cf(const struct rte_member_setsum *ss,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id)
+{
+	if (match_per_key == 0)
+		return 0;
+	return rte_member_lookup_cf(ss, key, set_id);
+}
+
+uint32_t
+rte_member_lookup_multi_bulk_cf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids)
+{
+	member_set_t tmp_set[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t i, num_matches;
+
+	if (match_per_key == 0) {
+		for (i = 0; i < num_keys; i++)
+			match_count[i] = 0;
+		return 0;
+	}
+
+	num_matches = rte_member_lookup_bulk_cf(ss, keys, num_keys, tmp_set);
+	for (i = 0; i < num_keys; i++) {
+		set_ids[i * match_per_key] = tmp_set[i];
+		match_count[i] = tmp_set[i] != RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+int
+rte_member_add_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	struct member_cf_bucket *buckets = ss->table;
+	uint32_t path_bkt[RTE_MEMBER_CF_MAX_KICKS];
+	uint8_t path_slot[RTE_MEMBER_CF_MAX_KICKS];
+	uint32_t bkt, hitmask, n;
+	member_fp_t fp, victim;
+	uint8_t slot;
+
+	if (set_id != 1)
+		return -EINVAL;
+
+	get_cf_index(ss, key, &bkt, &fp);
+
+	/* If not full then insert into one slot */
+	hitmask = search_cf_bucket(&buckets[bkt], RTE_MEMBER_CF_EMPTY);
+	if (hitmask == 0) {
+		bkt = get_cf_alt_bucket(ss, bkt, fp);
+		hitmask = search_cf_bucket(&buckets[bkt], RTE_MEMBER_CF_EMPTY);
+	}
+	if (hitmask != 0) {
+		buckets[bkt].fps[rte_ctz32(hitmask)] = fp;
+		return 0;
+	}
+
+	/*
+	 * Both buckets are full: kick out a random fingerprint of the
+	 * secondary bucket to its own alternative bucket, and so on until
+	 * one of them finds a free entry. The path is recorded so that a
+	 * failed insertion leaves the filter unchanged, otherwise the last
+	 * kicked out fingerprint would be lost and cause a false negative.
+	 */
+	for (n = 0; n < RTE_MEMBER_CF_MAX_KICKS; n++) {
+		slot = rte_rand() & (RTE_MEMBER_CF_BUCKET_ENTRIES - 1);
+		path_bkt[n] = bkt;
+		path_slot[n] = slot;
+		victim = buckets[bkt].fps[slot];
+		buckets[bkt].fps[slot] = fp;
+		fp = victim;
+
+		bkt = get_cf_alt_bucket(ss, bkt, fp);
+		hitmask = search_cf_bucket(&buckets[bkt], RTE_MEMBER_CF_EMPTY);
+		if (hitmask != 0) {
+			buckets[bkt].fps[rte_ctz32(hitmask)] = fp;
+			return 1;
+		}
+	}
+
+	while (n-- > 0) {
+		victim = buckets[path_bkt[n]].fps[path_slot[n]];
+		buckets[path_bkt[n]].fps[path_slot[n]] = fp;
+		fp = victim;
+	}
+	return -ENOSPC;
+}
+
+void
+rte_member_free_cf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+int
+rte_member_delete_cf(const struct rte_member_setsum *ss, const void *key,
+		member_set_t set_id)
+{
+	struct member_cf_bucket *buckets = ss->table;
+	uint32_t bkt, hitmask;
+	member_fp_t fp;
+
+	if (set_id != 1)
+		return -EINVAL;
+
+	get_cf_index(ss, key, &bkt, &fp);
+
+	hitmask = search_cf_bucket(&buckets[bkt], fp);
+	if (hitmask == 0) {
+		bkt = get_cf_alt_bucket(ss, bkt, fp);
+		hitmask = search_cf_bucket(&buckets[bkt], fp);
+	}
+	if (hitmask == 0)
+		return -ENOENT;
+
+	buckets[bkt].fps[rte_ctz32(hitmask)] = RTE_MEMBER_CF_EMPTY;
+	return 0;
+}
+
+void
+rte_member_reset_cf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, ss->bucket_cnt * sizeof(struct member_cf_bucket));
+}
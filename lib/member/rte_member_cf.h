@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_MEMBER_CF_H_
+#define _RTE_MEMBER_CF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fingerprint count per bucket in cuckoo filter mode. */
+#define RTE_MEMBER_CF_BUCKET_ENTRIES 8
+/* Maximum number of displaced fingerprints before an insertion fails. */
+#define RTE_MEMBER_CF_MAX_KICKS 500
+/* Fingerprint value marking an empty entry. */
+#define RTE_MEMBER_CF_EMPTY 0
+
+typedef uint16_t member_fp_t;			/* fingerprint size is 16 bit */
+
+/* The bucket struct for cuckoo filter setsum, one SSE register wide */
+struct __rte_aligned(16) member_cf_bucket {
+	member_fp_t fps[RTE_MEMBER_CF_BUCKET_ENTRIES];	/* 2-byte fingerprint */
+};
+
+int
+rte_member_create_cf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_cf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_cf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+uint32_t
+rte_member_lookup_multi_cf(const struct rte_member_setsum *setsum,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_multi_bulk_cf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids);
+
+int
+rte_member_add_cf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_free_cf(struct rte_member_setsum *setsum);
+
+int
+rte_member_delete_cf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_reset_cf(const struct rte_member_setsum *setsum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CF_H_ */
@@ -216,6 +216,79 @@ rte_mempool_mem_iter(struct rte_mempool *mp,
 	return n;
 }
 
+/* get the socket, page size and IOVA contiguity of a memory chunk */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_mem_locality_get, 25.07)
+int
+rte_mempool_mem_locality_get(const struct rte_mempool_memhdr *memhdr,
+	struct rte_mempool_mem_locality *loc)
+{
+	const struct rte_memseg_list *msl;
+	const struct rte_memseg *ms;
+	char *start, *end, *va;
+	rte_iova_t iova;
+
+	if (memhdr == NULL || loc == NULL)
+		return -EINVAL;
+
+	start = memhdr->addr;
+	end = start + memhdr->len;
+	/* outside of DPDK memory, the IOVA was given for the whole chunk */
+	loc->iova_contig = memhdr->iova != RTE_BAD_IOVA;
+	msl = rte_mem_virt2memseg_list(start);
+	if (msl == NULL) {
+		loc->socket_id = SOCKET_ID_ANY;
+		loc->page_sz = rte_mem_page_size();
+	} else {
+		loc->socket_id = msl->socket_id;
+		loc->page_sz = msl->page_sz;
+	}
+	loc->nb_pages = RTE_PTR_DIFF(RTE_PTR_ALIGN_CEIL(end, loc->page_sz),
+		RTE_PTR_ALIGN_FLOOR(start, loc->page_sz)) / loc->page_sz;
+
+	if (msl == NULL || !loc->iova_contig || rte_eal_iova_mode() == RTE_IOVA_VA)
+		return 0;
+
+	/* in PA mode, check that each page follows the previous one */
+	for (va = start; va < end;
+			va = RTE_PTR_ALIGN_FLOOR(va, msl->page_sz) + msl->page_sz) {
+		ms = rte_mem_virt2memseg(va, msl);
+		if (ms == NULL || ms->iova == RTE_BAD_IOVA) {
+			loc->iova_contig = false;
+			break;
+		}
+		iova = ms->iova + RTE_PTR_DIFF(va, ms->addr);
+		if (iova != memhdr->iova + RTE_PTR_DIFF(va, start)) {
+			loc->iova_contig = false;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_locality_stats_get, 25.07)
+int
+rte_mempool_locality_stats_get(const struct rte_mempool *mp,
+	uint64_t *samples, uint64_t *remote)
+{
+#ifdef RTE_LIBRTE_MEMPOOL_STATS
+	unsigned int lcore_id;
+
+	*samples = 0;
+	*remote = 0;
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		*samples += mp->stats[lcore_id].locality_samples;
+		*remote += mp->stats[lcore_id].locality_remote;
+	}
+	return 0;
+#else
+	RTE_SET_USED(mp);
+	*samples = 0;
+	*remote = 0;
+	return -ENOTSUP;
+#endif
+}
+
 /* get the header, trailer and total size of a mempool element. */
 RTE_EXPORT_SYMBOL(rte_mempool_calc_obj_size)
 uint32_t
@@ -751,6 +824,12 @@ rte_mempool_free(struct rte_mempool *mp)
 	rte_mempool_trace_free(mp);
 	rte_mempool_free_memchunks(mp);
 	rte_mempool_ops_free(mp);
+	if (mp->cache_size != 0) {
+		unsigned int lcore_id;
+
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+			rte_ring_free(mp->local_cache[lcore_id].handoff_in);
+	}
 	rte_memzone_free(mp->mz);
 }
 
@@ -810,6 +889,158 @@ rte_mempool_cache_free(struct rte_mempool_cache *cache)
 	rte_free(cache);
 }
 
+/* Number of flushes and fills after which the size of a cache is adapted. */
+#define CACHE_ADAPT_WINDOW	32
+/* Number of flushes or fills in a window for an lcore to be unbalanced. */
+#define CACHE_ADAPT_UNBALANCED	((CACHE_ADAPT_WINDOW * 3) / 4)
+
+/*
+ * Adapt the size and the flush threshold of a cache to the flushes and
+ * fills of the last window. An lcore which mostly frees objects keeps
+ * the default size but flushes in bigger bursts, an lcore which mostly
+ * allocates objects fills its cache in bigger bursts.
+ */
+static void
+mempool_cache_adapt(const struct rte_mempool *mp,
+		    struct rte_mempool_cache *cache)
+{
+	uint32_t size, flushthresh;
+
+	if (cache->nb_flush + cache->nb_fill < CACHE_ADAPT_WINDOW)
+		return;
+
+	if (cache->nb_flush >= CACHE_ADAPT_UNBALANCED) {
+		size = mp->cache_size;
+		flushthresh = RTE_MIN(cache->flushthresh * 2,
+				      cache->adaptive_max * 2);
+	} else if (cache->nb_fill >= CACHE_ADAPT_UNBALANCED) {
+		size = RTE_MIN(cache->size * 2, cache->adaptive_max);
+		flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+	} else {
+		size = mp->cache_size;
+		flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+	}
+
+	cache->size = size;
+	cache->flushthresh = RTE_MAX(flushthresh, CALC_CACHE_FLUSHTHRESH(size));
+	cache->nb_flush = 0;
+	cache->nb_fill = 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_adaptive_flush, 25.07)
+void
+rte_mempool_cache_adaptive_flush(struct rte_mempool *mp,
+				 struct rte_mempool_cache *cache)
+{
+	unsigned int n = 0;
+
+	if (cache->handoff_out != NULL)
+		n = rte_ring_sp_enqueue_burst(cache->handoff_out, cache->objs,
+					      cache->len, NULL);
+	if (n < cache->len)
+		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[n],
+					     cache->len - n);
+
+	cache->nb_flush++;
+	mempool_cache_adapt(mp, cache);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_adaptive_fill, 25.07)
+int
+rte_mempool_cache_adaptive_fill(struct rte_mempool *mp,
+				struct rte_mempool_cache *cache, unsigned int n)
+{
+	unsigned int len, got = 0;
+	int ret;
+
+	cache->nb_fill++;
+	mempool_cache_adapt(mp, cache);
+
+	len = cache->size + n;
+	if (cache->handoff_in != NULL) {
+		got = rte_ring_sc_dequeue_burst(cache->handoff_in, cache->objs,
+						len, NULL);
+		if (got == len)
+			return 0;
+	}
+
+	ret = rte_mempool_ops_dequeue_bulk(mp, &cache->objs[got], len - got);
+	if (ret < 0 && got != 0) {
+		/* let the caller get the objects from the common pool */
+		rte_mempool_ops_enqueue_bulk(mp, cache->objs, got);
+	}
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_adaptive_enable, 25.07)
+int
+rte_mempool_cache_adaptive_enable(struct rte_mempool *mp)
+{
+	struct rte_mempool_cache *cache;
+	unsigned int lcore_id;
+	uint32_t max;
+
+	if (mp == NULL || mp->cache_size == 0)
+		return -EINVAL;
+
+	/*
+	 * A cache holds up to twice its max size before being flushed,
+	 * keep at least half of the pool out of the caches.
+	 */
+	max = mp->size / (4 * rte_lcore_count());
+	max = RTE_MIN(max, (uint32_t)RTE_MEMPOOL_CACHE_MAX_SIZE);
+	max = RTE_MAX(max, mp->cache_size);
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+		cache->adaptive_max = max;
+		cache->nb_flush = 0;
+		cache->nb_fill = 0;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_pair, 25.07)
+int
+rte_mempool_cache_pair(struct rte_mempool *mp, unsigned int free_lcore,
+		       unsigned int alloc_lcore)
+{
+	char ring_name[RTE_RING_NAMESIZE];
+	struct rte_ring *r;
+	int ret;
+
+	if (mp == NULL || mp->cache_size == 0 || free_lcore >= RTE_MAX_LCORE ||
+			alloc_lcore >= RTE_MAX_LCORE || free_lcore == alloc_lcore)
+		return -EINVAL;
+
+	if (mp->local_cache[free_lcore].handoff_out != NULL ||
+			mp->local_cache[alloc_lcore].handoff_in != NULL)
+		return -EEXIST;
+
+	if (mp->local_cache[free_lcore].adaptive_max == 0) {
+		ret = rte_mempool_cache_adaptive_enable(mp);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* a flush is at most twice the max cache size */
+	snprintf(ring_name, sizeof(ring_name), "MPH_%u_%p", alloc_lcore, mp);
+	r = rte_ring_create(ring_name, RTE_MEMPOOL_CACHE_MAX_SIZE * 2,
+			    mp->socket_id,
+			    RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (r == NULL) {
+		RTE_MEMPOOL_LOG(ERR, "Cannot allocate handoff ring for %s",
+				mp->name);
+		return -rte_errno;
+	}
+
+	mp->local_cache[free_lcore].handoff_out = r;
+	mp->local_cache[alloc_lcore].handoff_in = r;
+
+	return 0;
+}
+
 /* create an empty mempool */
 RTE_EXPORT_SYMBOL(rte_mempool_create_empty)
 struct rte_mempool *
@@ -1029,8 +1260,12 @@ rte_mempool_avail_count(const struct rte_mempool *mp)
 	if (mp->cache_size == 0)
 		return count;
 
-	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
 		count += mp->local_cache[lcore_id].len;
+		if (mp->local_cache[lcore_id].handoff_in != NULL)
+			count += rte_ring_count(
+				mp->local_cache[lcore_id].handoff_in);
+	}
 
 	/*
 	 * due to race condition (access to len is not locked), the
@@ -1067,6 +1302,12 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 		cache_count = mp->local_cache[lcore_id].len;
 		fprintf(f, "    cache_count[%u]=%"PRIu32"\n",
 			lcore_id, cache_count);
+		if (mp->local_cache[lcore_id].adaptive_max != 0 &&
+				cache_count != 0)
+			fprintf(f, "    cache_size[%u]=%"PRIu32
+				" flushthresh[%u]=%"PRIu32"\n",
+				lcore_id, mp->local_cache[lcore_id].size,
+				lcore_id, mp->local_cache[lcore_id].flushthresh);
 		count += cache_count;
 	}
 	fprintf(f, "    total_cache_count=%u\n", count);
@@ -1241,6 +1482,7 @@ rte_mempool_dump(FILE *f, struct rte_mempool *mp)
 	struct rte_mempool_debug_stats sum;
 	unsigned lcore_id;
 #endif
+	struct rte_mempool_mem_locality loc;
 	struct rte_mempool_memhdr *memhdr;
 	struct rte_mempool_ops *ops;
 	unsigned common_count;
@@ -1273,6 +1515,10 @@ rte_mempool_dump(FILE *f, struct rte_mempool *mp)
 	STAILQ_FOREACH(memhdr, &mp->mem_list, next) {
 		fprintf(f, "  memory chunk at %p, addr=%p, iova=0x%" PRIx64 ", len=%zu\n",
 				memhdr, memhdr->addr, memhdr->iova, memhdr->len);
+		if (rte_mempool_mem_locality_get(memhdr, &loc) == 0)
+			fprintf(f, "    socket_id=%d, page_sz=%" PRIu64 ", nb_pages=%u, iova_contig=%d\n",
+				loc.socket_id, loc.page_sz, loc.nb_pages,
+				loc.iova_contig);
 		mem_len += memhdr->len;
 	}
 	if (mem_len != 0) {
@@ -1303,6 +1549,8 @@ rte_mempool_dump(FILE *f, struct rte_mempool *mp)
 		sum.get_fail_objs += mp->stats[lcore_id].get_fail_objs;
 		sum.get_success_blks += mp->stats[lcore_id].get_success_blks;
 		sum.get_fail_blks += mp->stats[lcore_id].get_fail_blks;
+		sum.locality_samples += mp->stats[lcore_id].locality_samples;
+		sum.locality_remote += mp->stats[lcore_id].locality_remote;
 	}
 	if (mp->cache_size != 0) {
 		/* Add the statistics stored in the mempool caches. */
@@ -1329,6 +1577,8 @@ rte_mempool_dump(FILE *f, struct rte_mempool *mp)
 			sum.get_success_blks);
 		fprintf(f, "    get_fail_blks=%"PRIu64"\n", sum.get_fail_blks);
 	}
+	fprintf(f, "    locality_samples=%"PRIu64"\n", sum.locality_samples);
+	fprintf(f, "    locality_remote=%"PRIu64"\n", sum.locality_remote);
 #else
 	fprintf(f, "  no statistics available\n");
 #endif
@@ -1625,10 +1875,93 @@ mempool_handle_info(const char *cmd __rte_unused, const char *params,
 	return 0;
 }
 
+struct mempool_locality_cb_arg {
+	struct rte_tel_data *d;
+	int socket_id;
+	uint64_t page_sz;
+	uint32_t remote_chunks;
+	uint32_t noncontig_chunks;
+};
+
+static void
+mempool_locality_chunk_cb(struct rte_mempool *mp __rte_unused, void *arg,
+		struct rte_mempool_memhdr *memhdr, unsigned int mem_idx)
+{
+	struct mempool_locality_cb_arg *loc_arg = arg;
+	struct rte_mempool_mem_locality loc;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	struct rte_tel_data *cd;
+
+	if (rte_mempool_mem_locality_get(memhdr, &loc) != 0)
+		return;
+	if (loc.socket_id != loc_arg->socket_id)
+		loc_arg->remote_chunks++;
+	if (!loc.iova_contig)
+		loc_arg->noncontig_chunks++;
+	if (loc_arg->page_sz == 0 || loc.page_sz < loc_arg->page_sz)
+		loc_arg->page_sz = loc.page_sz;
+
+	cd = rte_tel_data_alloc();
+	if (cd == NULL)
+		return;
+	rte_tel_data_start_dict(cd);
+	rte_tel_data_add_dict_uint(cd, "addr", (uintptr_t)memhdr->addr);
+	rte_tel_data_add_dict_uint(cd, "iova", memhdr->iova);
+	rte_tel_data_add_dict_uint(cd, "len", memhdr->len);
+	rte_tel_data_add_dict_int(cd, "socket_id", loc.socket_id);
+	rte_tel_data_add_dict_uint(cd, "page_sz", loc.page_sz);
+	rte_tel_data_add_dict_uint(cd, "nb_pages", loc.nb_pages);
+	rte_tel_data_add_dict_uint(cd, "iova_contig", loc.iova_contig);
+	snprintf(name, sizeof(name), "chunk_%u", mem_idx);
+	rte_tel_data_add_dict_container(loc_arg->d, name, cd, 0);
+}
+
+static int
+mempool_handle_locality(const char *cmd __rte_unused, const char *params,
+		    struct rte_tel_data *d)
+{
+	struct mempool_locality_cb_arg loc_arg;
+	uint64_t samples, remote;
+	struct rte_mempool *mp;
+
+	if (!params || strlen(params) == 0)
+		return -EINVAL;
+
+	mp = rte_mempool_lookup(params);
+	if (mp == NULL)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_string(d, "name", mp->name);
+	rte_tel_data_add_dict_int(d, "socket_id", mp->socket_id);
+
+	memset(&loc_arg, 0, sizeof(loc_arg));
+	loc_arg.d = d;
+	loc_arg.socket_id = mp->socket_id;
+	rte_mempool_mem_iter(mp, mempool_locality_chunk_cb, &loc_arg);
+	rte_tel_data_add_dict_uint(d, "nb_mem_chunks", mp->nb_mem_chunks);
+	rte_tel_data_add_dict_uint(d, "min_page_sz", loc_arg.page_sz);
+	/* chunks of a pool created on any socket are not remote */
+	if (mp->socket_id != SOCKET_ID_ANY)
+		rte_tel_data_add_dict_uint(d, "remote_chunks",
+					  loc_arg.remote_chunks);
+	rte_tel_data_add_dict_uint(d, "noncontig_chunks",
+				  loc_arg.noncontig_chunks);
+
+	if (rte_mempool_locality_stats_get(mp, &samples, &remote) == 0) {
+		rte_tel_data_add_dict_uint(d, "sampled_objs", samples);
+		rte_tel_data_add_dict_uint(d, "sampled_remote_objs", remote);
+	}
+
+	return 0;
+}
+
 RTE_INIT(mempool_init_telemetry)
 {
 	rte_telemetry_register_cmd("/mempool/list", mempool_handle_list,
 		"Returns list of available mempool. Takes no parameters");
 	rte_telemetry_register_cmd("/mempool/info", mempool_handle_info,
 		"Returns mempool info. Parameters: pool_name");
+	rte_telemetry_register_cmd("/mempool/locality", mempool_handle_locality,
+		"Returns socket, page size and IOVA contiguity of mempool memory chunks, and sampled object locality. Parameters: pool_name");
 }
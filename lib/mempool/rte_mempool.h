@@ -48,6 +48,7 @@
 #include <rte_branch_prediction.h>
 #include <rte_ring.h>
 #include <rte_memcpy.h>
+#include <rte_memory.h>
 #include <rte_common.h>
 
 #include "rte_mempool_trace_fp.h"
@@ -80,6 +81,9 @@ struct __rte_cache_aligned rte_mempool_debug_stats {
 	uint64_t get_fail_objs;        /**< Objects that failed to be allocated. */
 	uint64_t get_success_blks;     /**< Successful allocation number of contiguous blocks. */
 	uint64_t get_fail_blks;        /**< Failed allocation number of contiguous blocks. */
+	uint64_t locality_calls;       /**< Number of get/put calls seen for sampling. */
+	uint64_t locality_samples;     /**< Number of objects sampled for NUMA locality. */
+	uint64_t locality_remote;      /**< Sampled objects not on the lcore socket. */
 	RTE_CACHE_GUARD;
 };
 #endif
@@ -104,6 +108,15 @@ struct __rte_cache_aligned rte_mempool_cache {
 		uint64_t get_success_objs;  /**< Objects successfully allocated. */
 	} stats;                        /**< Statistics */
 #endif
+	/*
+	 * Adaptive sizing, see rte_mempool_cache_adaptive_enable().
+	 * Only used when the cache is flushed to or filled from the pool.
+	 */
+	uint32_t adaptive_max;  /**< Max size, 0 if adaptive sizing is off */
+	uint16_t nb_flush;      /**< Flushes in the current window */
+	uint16_t nb_fill;       /**< Fills in the current window */
+	struct rte_ring *handoff_out; /**< Flushed objects to the paired cache */
+	struct rte_ring *handoff_in;  /**< Objects from the paired cache */
 	/**
 	 * Cache objects
 	 *
@@ -360,6 +373,52 @@ struct __rte_cache_aligned rte_mempool {
 #define RTE_MEMPOOL_CACHE_STAT_ADD(cache, name, n) do {} while (0)
 #endif
 
+#ifdef RTE_LIBRTE_MEMPOOL_STATS
+/** One get/put call out of this number is sampled for NUMA locality. */
+#define RTE_MEMPOOL_LOCALITY_PERIOD 64
+
+/**
+ * @internal When stats is enabled, sample the NUMA locality of objects.
+ *
+ * The socket of the first object is compared with the socket of the
+ * calling lcore, once every RTE_MEMPOOL_LOCALITY_PERIOD calls per lcore.
+ *
+ * @param mp
+ *   Pointer to the memory pool.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects in obj_table.
+ */
+static __rte_always_inline void
+rte_mempool_locality_sample(struct rte_mempool *mp, void * const *obj_table,
+		unsigned int n)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_mempool_debug_stats *stats;
+	const struct rte_memseg_list *msl;
+	int socket_id;
+
+	if (unlikely(n == 0 || lcore_id >= RTE_MAX_LCORE))
+		return;
+	stats = &mp->stats[lcore_id];
+	if (likely(stats->locality_calls++ % RTE_MEMPOOL_LOCALITY_PERIOD != 0))
+		return;
+
+	socket_id = (int)rte_socket_id();
+	msl = rte_mem_virt2memseg_list(obj_table[0]);
+	if (socket_id == SOCKET_ID_ANY || msl == NULL)
+		return;
+	stats->locality_samples++;
+	if (msl->socket_id != socket_id)
+		stats->locality_remote++;
+}
+#define RTE_MEMPOOL_LOCALITY_SAMPLE(mp, obj_table, n) \
+	rte_mempool_locality_sample(mp, obj_table, n)
+#else
+#define RTE_MEMPOOL_LOCALITY_SAMPLE(mp, obj_table, n) do {} while (0)
+#endif
+
 /**
  * @internal Calculate the size of the mempool header.
  *
@@ -1283,6 +1342,66 @@ uint32_t rte_mempool_obj_iter(struct rte_mempool *mp,
 uint32_t rte_mempool_mem_iter(struct rte_mempool *mp,
 	rte_mempool_mem_cb_t *mem_cb, void *mem_cb_arg);
 
+/**
+ * Memory locality of a mempool memory chunk.
+ */
+struct rte_mempool_mem_locality {
+	/** NUMA socket of the chunk, SOCKET_ID_ANY if not in DPDK memory */
+	int socket_id;
+	/** Number of pages spanned by the chunk */
+	uint32_t nb_pages;
+	/** Size of the pages backing the chunk */
+	uint64_t page_sz;
+	/** True if the chunk is contiguous in IO address space */
+	bool iova_contig;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the memory locality of a mempool memory chunk.
+ *
+ * The chunk memory is looked up in the DPDK memory segments,
+ * which is too slow for the datapath.
+ * A chunk which is not in DPDK memory, like anonymous memory,
+ * is reported on SOCKET_ID_ANY with the system page size.
+ *
+ * @param memhdr
+ *   A memory chunk, as given by rte_mempool_mem_iter().
+ * @param loc
+ *   The locality of the chunk to fill.
+ * @return
+ *   0 on success, -EINVAL if a parameter is NULL.
+ */
+__rte_experimental
+int rte_mempool_mem_locality_get(const struct rte_mempool_memhdr *memhdr,
+	struct rte_mempool_mem_locality *loc);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the sampled NUMA locality of the objects of a mempool.
+ *
+ * When the mempool statistics are enabled at build time,
+ * one get or put call out of RTE_MEMPOOL_LOCALITY_PERIOD per lcore
+ * compares the socket of its first object with the socket of the lcore.
+ * The calls of non-EAL threads and unpinned lcores are not sampled.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param samples
+ *   The number of sampled objects.
+ * @param remote
+ *   The number of sampled objects not on the socket of the lcore.
+ * @return
+ *   0 on success, -ENOTSUP if the mempool statistics are disabled.
+ */
+__rte_experimental
+int rte_mempool_locality_stats_get(const struct rte_mempool *mp,
+	uint64_t *samples, uint64_t *remote);
+
 /**
  * Dump the status of the mempool to a file.
  *
@@ -1319,6 +1438,70 @@ rte_mempool_cache_create(uint32_t size, int socket_id);
 void
 rte_mempool_cache_free(struct rte_mempool_cache *cache);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable adaptive sizing of the per-lcore default caches of a mempool.
+ *
+ * Each time a cache is flushed to or filled from the common pool, the
+ * event is counted. Over a window of such events, a cache which is
+ * mostly flushed (an lcore which only frees objects) raises its flush
+ * threshold, so that objects are returned in bigger bursts. A cache
+ * which is mostly filled (an lcore which only allocates objects) raises
+ * its size, so that objects are taken in bigger bursts. Otherwise, the
+ * cache goes back to the size given at mempool creation.
+ *
+ * The size of a cache is limited according to the mempool size and the
+ * number of lcores, and is never lower than the size given at creation.
+ *
+ * This function must be called before the mempool is used by the lcores.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: The mempool has no per-lcore cache.
+ */
+__rte_experimental
+int
+rte_mempool_cache_adaptive_enable(struct rte_mempool *mp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Pair the default caches of two lcores.
+ *
+ * When the cache of the freeing lcore is flushed, its objects are
+ * passed to the cache of the allocating lcore through a single producer,
+ * single consumer ring, instead of going through the common pool.
+ * The allocating lcore fills its cache from this ring first. This suits
+ * pipelines where an lcore frees the objects allocated by another one.
+ *
+ * Adaptive sizing is enabled on the mempool if it was not.
+ * An lcore can free objects to one lcore and allocate objects from
+ * another one.
+ *
+ * This function must be called before the mempool is used by the lcores.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param free_lcore
+ *   The lcore freeing objects.
+ * @param alloc_lcore
+ *   The lcore allocating objects.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid lcores, or the mempool has no per-lcore cache.
+ *   - -EEXIST: One of the caches is already paired in this direction.
+ *   - -ENOMEM: The ring cannot be allocated.
+ */
+__rte_experimental
+int
+rte_mempool_cache_pair(struct rte_mempool *mp, unsigned int free_lcore,
+	unsigned int alloc_lcore);
+
 /**
  * Get a pointer to the per-lcore default mempool cache.
  *
@@ -1365,6 +1548,51 @@ rte_mempool_cache_flush(struct rte_mempool_cache *cache,
 	cache->len = 0;
 }
 
+/**
+ * @internal
+ * Helper routine for rte_mempool_do_generic_put().
+ * Flush an adaptive cache.
+ * It is only called from the inline fast path of code built with the
+ * experimental API, the other code flushes the cache to the common pool.
+ *
+ * All the objects of the cache are passed to the paired cache if any,
+ * then to the common pool, and the cache size is adapted.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to a default cache of the mempool.
+ */
+__rte_experimental
+void
+rte_mempool_cache_adaptive_flush(struct rte_mempool *mp,
+	struct rte_mempool_cache *cache);
+
+/**
+ * @internal
+ * Helper routine for rte_mempool_do_generic_get().
+ * Fill an adaptive cache.
+ * It is only called from the inline fast path of code built with the
+ * experimental API, the other code fills the cache from the common pool.
+ *
+ * The cache size is adapted, then the cache is filled with size + n
+ * objects, taken first from the paired cache if any.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to an empty default cache of the mempool.
+ * @param n
+ *   The number of objects needed on top of the cache size.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error; code of driver dequeue function, the cache is left empty.
+ */
+__rte_experimental
+int
+rte_mempool_cache_adaptive_fill(struct rte_mempool *mp,
+	struct rte_mempool_cache *cache, unsigned int n);
+
 /**
  * @internal Put several objects back in the mempool; used internally.
  * @param mp
@@ -1407,7 +1635,12 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		cache->len += n;
 	} else {
 		cache_objs = &cache->objs[0];
-		rte_mempool_ops_enqueue_bulk(mp, cache_objs, cache->len);
+#ifdef ALLOW_EXPERIMENTAL_API
+		if (unlikely(cache->adaptive_max != 0))
+			rte_mempool_cache_adaptive_flush(mp, cache);
+		else
+#endif
+			rte_mempool_ops_enqueue_bulk(mp, cache_objs, cache->len);
 		cache->len = n;
 	}
 
@@ -1447,6 +1680,7 @@ rte_mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 {
 	rte_mempool_trace_generic_put(mp, obj_table, n, cache);
 	RTE_MEMPOOL_CHECK_COOKIES(mp, obj_table, n, 0);
+	RTE_MEMPOOL_LOCALITY_SAMPLE(mp, obj_table, n);
 	rte_mempool_do_generic_put(mp, obj_table, n, cache);
 }
 
@@ -1570,8 +1804,13 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 		goto driver_dequeue;
 
 	/* Fill the cache from the backend; fetch size + remaining objects. */
-	ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs,
-			cache->size + remaining);
+#ifdef ALLOW_EXPERIMENTAL_API
+	if (unlikely(cache->adaptive_max != 0))
+		ret = rte_mempool_cache_adaptive_fill(mp, cache, remaining);
+	else
+#endif
+		ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs,
+				cache->size + remaining);
 	if (unlikely(ret < 0)) {
 		/*
 		 * We are buffer constrained, and not able to allocate
@@ -1650,8 +1889,10 @@ rte_mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 {
 	int ret;
 	ret = rte_mempool_do_generic_get(mp, obj_table, n, cache);
-	if (ret == 0)
+	if (ret == 0) {
 		RTE_MEMPOOL_CHECK_COOKIES(mp, obj_table, n, 1);
+		RTE_MEMPOOL_LOCALITY_SAMPLE(mp, obj_table, n);
+	}
 	rte_mempool_trace_generic_get(mp, obj_table, n, cache);
 	return ret;
 }
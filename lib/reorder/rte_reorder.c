@@ -58,6 +58,16 @@ struct __rte_cache_aligned rte_reorder_buffer {
 	struct cir_buffer order_buf; /**< buffer used to reorder entries */
 };
 
+/* Multiple reorder buffers, one per flow hash bucket */
+struct __rte_cache_aligned rte_reorder_mw {
+	char name[RTE_REORDER_NAMESIZE];
+	unsigned int nb_windows; /**< number of windows, power of 2 */
+	unsigned int window_mask; /**< [nb_windows - 1] */
+	unsigned int window_memsize; /**< distance between two windows */
+	rte_reorder_seqn_t *next_seqn; /**< next sequence number per window */
+	void *windows; /**< first window */
+};
+
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
@@ -565,3 +575,169 @@ rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_se
 
 	return 0;
 }
+
+static inline struct rte_reorder_buffer *
+reorder_mw_window_get(const struct rte_reorder_mw *mw, unsigned int window)
+{
+	return RTE_PTR_ADD(mw->windows, (size_t)window * mw->window_memsize);
+}
+
+/*
+ * Sequence numbers are assigned per window from 0, so there is no need
+ * to learn the start of the window from the first inserted packet.
+ */
+static inline void
+reorder_mw_window_start(struct rte_reorder_buffer *b)
+{
+	b->min_seqn = 0;
+	b->is_initialized = true;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_create, 25.07)
+struct rte_reorder_mw *
+rte_reorder_mw_create(const char *name, unsigned int socket_id,
+		unsigned int nb_windows, unsigned int size)
+{
+	struct rte_reorder_buffer *b;
+	struct rte_reorder_mw *mw;
+	size_t seqn_size, memsize;
+	unsigned int i;
+
+	if (name == NULL) {
+		REORDER_LOG(ERR, "Invalid reorder buffer name ptr:"
+					" NULL");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (nb_windows == 0 || !rte_is_power_of_2(nb_windows)) {
+		REORDER_LOG(ERR, "Invalid number of reorder windows"
+				" - Not a power of 2");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (!rte_is_power_of_2(size)) {
+		REORDER_LOG(ERR, "Invalid reorder buffer size"
+				" - Not a power of 2");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	seqn_size = RTE_ALIGN_CEIL(nb_windows * sizeof(rte_reorder_seqn_t),
+			RTE_CACHE_LINE_SIZE);
+	memsize = RTE_ALIGN_CEIL(rte_reorder_memory_footprint_get(size),
+			RTE_CACHE_LINE_SIZE);
+	if (memsize > UINT_MAX) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	mw = rte_zmalloc_socket("REORDER_MW", sizeof(*mw) + seqn_size +
+			nb_windows * memsize, RTE_CACHE_LINE_SIZE, socket_id);
+	if (mw == NULL) {
+		REORDER_LOG(ERR, "Multi-window reorder allocation failed");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(mw->name, name, sizeof(mw->name));
+	mw->nb_windows = nb_windows;
+	mw->window_mask = nb_windows - 1;
+	mw->window_memsize = memsize;
+	mw->next_seqn = (void *)&mw[1];
+	mw->windows = RTE_PTR_ADD(mw->next_seqn, seqn_size);
+
+	for (i = 0; i < nb_windows; i++) {
+		b = rte_reorder_init(reorder_mw_window_get(mw, i), memsize,
+				name, size);
+		if (b == NULL) {
+			rte_free(mw);
+			return NULL;
+		}
+		reorder_mw_window_start(b);
+	}
+
+	return mw;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_free, 25.07)
+void
+rte_reorder_mw_free(struct rte_reorder_mw *mw)
+{
+	unsigned int i;
+
+	if (mw == NULL)
+		return;
+
+	for (i = 0; i < mw->nb_windows; i++)
+		rte_reorder_free_mbufs(reorder_mw_window_get(mw, i));
+
+	rte_free(mw);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_reset, 25.07)
+void
+rte_reorder_mw_reset(struct rte_reorder_mw *mw)
+{
+	struct rte_reorder_buffer *b;
+	unsigned int i;
+
+	for (i = 0; i < mw->nb_windows; i++) {
+		b = reorder_mw_window_get(mw, i);
+		rte_reorder_reset(b);
+		reorder_mw_window_start(b);
+		mw->next_seqn[i] = 0;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_window_count, 25.07)
+unsigned int
+rte_reorder_mw_window_count(const struct rte_reorder_mw *mw)
+{
+	return mw->nb_windows;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_window, 25.07)
+unsigned int
+rte_reorder_mw_window(const struct rte_reorder_mw *mw,
+		const struct rte_mbuf *mbuf)
+{
+	return mbuf->hash.rss & mw->window_mask;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_seqn_assign, 25.07)
+void
+rte_reorder_mw_seqn_assign(struct rte_reorder_mw *mw,
+		struct rte_mbuf **mbufs, unsigned int nb_mbufs)
+{
+	unsigned int i, w;
+
+	for (i = 0; i < nb_mbufs; i++) {
+		w = mbufs[i]->hash.rss & mw->window_mask;
+		*rte_reorder_seqn(mbufs[i]) = mw->next_seqn[w]++;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_insert, 25.07)
+int
+rte_reorder_mw_insert(struct rte_reorder_mw *mw, struct rte_mbuf *mbuf)
+{
+	if (mw == NULL || mbuf == NULL) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	return rte_reorder_insert(reorder_mw_window_get(mw,
+			mbuf->hash.rss & mw->window_mask), mbuf);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_mw_drain, 25.07)
+unsigned int
+rte_reorder_mw_drain(struct rte_reorder_mw *mw, unsigned int window,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs)
+{
+	if (window >= mw->nb_windows)
+		return 0;
+
+	return rte_reorder_drain(reorder_mw_window_get(mw, window),
+			mbufs, max_mbufs);
+}
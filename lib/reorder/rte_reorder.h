@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 struct rte_reorder_buffer;
+struct rte_reorder_mw;
 
 typedef uint32_t rte_reorder_seqn_t;
 extern int rte_reorder_seqn_dynfield_offset;
@@ -231,6 +232,168 @@ __rte_experimental
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a multi-window reorder object.
+ *
+ * The object holds several independent reorder buffers (windows), each
+ * with its own sequence number space. A packet is mapped to a window by
+ * its flow hash (mbuf->hash.rss), so ordering is kept within a flow only.
+ * The sequence space of every window starts at 0,
+ * see rte_reorder_mw_seqn_assign().
+ *
+ * Different windows may be serviced in parallel by different lcores,
+ * as long as each window is inserted into and drained by a single lcore
+ * at a time. rte_reorder_mw_seqn_assign() must not be called
+ * concurrently on the same object.
+ *
+ * @param name
+ *   The name to be given to the object.
+ * @param socket_id
+ *   The NUMA node on which the memory for the object is to be reserved.
+ * @param nb_windows
+ *   Number of windows, must be a power of 2.
+ * @param size
+ *   Max number of elements that can be stored in each window,
+ *   must be a power of 2.
+ * @return
+ *   The initialized object, or NULL on error.
+ *   On error case, rte_errno will be set appropriately:
+ *    - ENOMEM - not enough memory
+ *    - EINVAL - invalid parameters
+ */
+__rte_experimental
+struct rte_reorder_mw *
+rte_reorder_mw_create(const char *name, unsigned int socket_id,
+		unsigned int nb_windows, unsigned int size);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a multi-window reorder object and all mbufs it still holds.
+ *
+ * @param mw
+ *   Pointer to the object. If mw is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_reorder_mw_free(struct rte_reorder_mw *mw);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset all windows of a multi-window reorder object,
+ * freeing the mbufs they hold and restarting all sequence spaces.
+ *
+ * @param mw
+ *   Pointer to the object.
+ */
+__rte_experimental
+void
+rte_reorder_mw_reset(struct rte_reorder_mw *mw);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the number of windows of a multi-window reorder object.
+ *
+ * @param mw
+ *   Pointer to the object.
+ * @return
+ *   Number of windows.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mw_window_count(const struct rte_reorder_mw *mw);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Get the window an mbuf belongs to, based on mbuf->hash.rss.
+ *
+ * @param mw
+ *   Pointer to the object.
+ * @param mbuf
+ *   The mbuf.
+ * @return
+ *   Window index, in the range [0, rte_reorder_mw_window_count()).
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mw_window(const struct rte_reorder_mw *mw,
+		const struct rte_mbuf *mbuf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Assign per-window sequence numbers to a burst of mbufs.
+ *
+ * Each mbuf gets the next sequence number of the window selected by
+ * its flow hash. This is to be called at the point where the original
+ * order is known, e.g. on the Rx core.
+ *
+ * @param mw
+ *   Pointer to the object.
+ * @param mbufs
+ *   Array of mbufs to tag.
+ * @param nb_mbufs
+ *   Number of mbufs in the array.
+ */
+__rte_experimental
+void
+rte_reorder_mw_seqn_assign(struct rte_reorder_mw *mw,
+		struct rte_mbuf **mbufs, unsigned int nb_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert an mbuf in the window selected by its flow hash.
+ *
+ * @see rte_reorder_insert()
+ *
+ * @param mw
+ *   Pointer to the object.
+ * @param mbuf
+ *   mbuf of packet that needs to be inserted.
+ * @return
+ *   0 on success, -1 on error with rte_errno set as by rte_reorder_insert().
+ */
+__rte_experimental
+int
+rte_reorder_mw_insert(struct rte_reorder_mw *mw, struct rte_mbuf *mbuf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch reordered mbufs from one window.
+ *
+ * @see rte_reorder_drain()
+ *
+ * @param mw
+ *   Pointer to the object.
+ * @param window
+ *   Index of the window to drain.
+ * @param mbufs
+ *   Array of mbufs where reordered packets will be inserted.
+ * @param max_mbufs
+ *   The number of elements in the mbufs array.
+ * @return
+ *   Number of mbuf pointers written to mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mw_drain(struct rte_reorder_mw *mw, unsigned int window,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,321 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+
+#include <eal_export.h>
+#include <rte_bitops.h>
+#include <rte_log.h>
+#include <rte_string_fns.h>
+
+#include "rte_ring_fanin.h"
+
+RTE_LOG_REGISTER_DEFAULT(ring_fanin_logtype, INFO);
+#define RTE_LOGTYPE_RING_FANIN ring_fanin_logtype
+#define FANIN_LOG(level, ...) \
+	RTE_LOG_LINE(level, RING_FANIN, "" __VA_ARGS__)
+
+#define FANIN_WORD_BITS	64
+
+/*
+ * The fan-in is laid out in a single memory area:
+ * this header, the occupancy bitmap, the quantum of each ring and the rings.
+ *
+ * A bit of the bitmap is set by the producer of a ring after an enqueue,
+ * if it was not set, and cleared by the consumer when it empties the ring.
+ * Both sides have a full barrier between their ring access and their bitmap
+ * access, so a ring cannot be left non-empty with its bit cleared.
+ */
+struct __rte_cache_aligned rte_ring_fanin {
+	char name[RTE_RING_NAMESIZE];
+	uint32_t nb_rings;
+	uint32_t esize;
+	uint32_t elems;
+	uint32_t nb_words;
+	size_t ring_sz;
+	RTE_ATOMIC(uint64_t) *bitmap;
+	uint32_t *quantum;
+	uint8_t *rings;
+
+	/** ring to start the next dequeue from, used by the consumer only */
+	alignas(RTE_CACHE_LINE_SIZE) uint32_t next;
+};
+
+static inline struct rte_ring *
+fanin_ring(const struct rte_ring_fanin *f, uint32_t idx)
+{
+	return (struct rte_ring *)(f->rings + (size_t)idx * f->ring_sz);
+}
+
+static size_t
+fanin_get_szofs(uint32_t nb_rings, size_t ring_sz, size_t *bitmap_ofs,
+	size_t *quantum_ofs, size_t *rings_ofs)
+{
+	uint32_t nb_words = RTE_ALIGN_CEIL(nb_rings, FANIN_WORD_BITS) /
+		FANIN_WORD_BITS;
+	size_t sz;
+
+	sz = RTE_ALIGN(sizeof(struct rte_ring_fanin), RTE_CACHE_LINE_SIZE);
+	if (bitmap_ofs != NULL)
+		*bitmap_ofs = sz;
+
+	sz += nb_words * sizeof(uint64_t);
+	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+	if (quantum_ofs != NULL)
+		*quantum_ofs = sz;
+
+	sz += nb_rings * sizeof(uint32_t);
+	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+	if (rings_ofs != NULL)
+		*rings_ofs = sz;
+
+	return sz + nb_rings * ring_sz;
+}
+
+static ssize_t
+fanin_ring_memsize(const struct rte_ring_fanin_param *prm)
+{
+	if (prm == NULL || prm->nb_rings == 0 || prm->elems == 0 ||
+			prm->elem_size == 0) {
+		FANIN_LOG(ERR, "invalid fan-in parameters");
+		return -EINVAL;
+	}
+
+	return rte_ring_get_memsize_elem(prm->elem_size,
+		rte_align32pow2(prm->elems + 1));
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_get_memsize, 25.07)
+ssize_t
+rte_ring_fanin_get_memsize(const struct rte_ring_fanin_param *prm)
+{
+	ssize_t ring_sz;
+
+	ring_sz = fanin_ring_memsize(prm);
+	if (ring_sz < 0)
+		return ring_sz;
+
+	return fanin_get_szofs(prm->nb_rings, ring_sz, NULL, NULL, NULL);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_init, 25.07)
+int
+rte_ring_fanin_init(struct rte_ring_fanin *f,
+	const struct rte_ring_fanin_param *prm)
+{
+	size_t bitmap_ofs, quantum_ofs, rings_ofs;
+	ssize_t ring_sz;
+	uint32_t i;
+	int ret;
+
+	if (f == NULL)
+		return -EINVAL;
+
+	ring_sz = fanin_ring_memsize(prm);
+	if (ring_sz < 0)
+		return ring_sz;
+
+	if (prm->name == NULL) {
+		FANIN_LOG(ERR, "fan-in without name");
+		return -EINVAL;
+	}
+
+	fanin_get_szofs(prm->nb_rings, ring_sz, &bitmap_ofs, &quantum_ofs,
+		&rings_ofs);
+
+	memset(f, 0, sizeof(*f));
+	ret = strlcpy(f->name, prm->name, sizeof(f->name));
+	if (ret < 0 || ret >= (int)sizeof(f->name))
+		return -ENAMETOOLONG;
+
+	f->nb_rings = prm->nb_rings;
+	f->esize = prm->elem_size;
+	f->elems = prm->elems;
+	f->nb_words = RTE_ALIGN_CEIL(prm->nb_rings, FANIN_WORD_BITS) /
+		FANIN_WORD_BITS;
+	f->ring_sz = ring_sz;
+	f->bitmap = (void *)((uintptr_t)f + bitmap_ofs);
+	f->quantum = (void *)((uintptr_t)f + quantum_ofs);
+	f->rings = (void *)((uintptr_t)f + rings_ofs);
+
+	memset(f->bitmap, 0, f->nb_words * sizeof(uint64_t));
+	for (i = 0; i != f->nb_rings; i++) {
+		f->quantum[i] = prm->quantum != 0 ?
+			prm->quantum : RTE_RING_FANIN_QUANTUM_DEF;
+		ret = rte_ring_init(fanin_ring(f, i), prm->name, prm->elems,
+			RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_set_quantum, 25.07)
+int
+rte_ring_fanin_set_quantum(struct rte_ring_fanin *f, uint32_t idx,
+	uint32_t quantum)
+{
+	if (f == NULL || idx >= f->nb_rings || quantum == 0)
+		return -EINVAL;
+
+	f->quantum[idx] = quantum;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_count, 25.07)
+unsigned int
+rte_ring_fanin_count(const struct rte_ring_fanin *f)
+{
+	unsigned int count = 0;
+	uint32_t i;
+
+	for (i = 0; i != f->nb_rings; i++)
+		count += rte_ring_count(fanin_ring(f, i));
+	return count;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_dump, 25.07)
+void
+rte_ring_fanin_dump(FILE *f, const struct rte_ring_fanin *fi)
+{
+	uint64_t bits;
+	uint32_t i;
+
+	if (f == NULL || fi == NULL)
+		return;
+
+	fprintf(f, "ring fan-in <%s>@%p\n", fi->name, fi);
+	fprintf(f, "  nb_rings=%"PRIu32"\n", fi->nb_rings);
+	fprintf(f, "  elems=%"PRIu32"\n", fi->elems);
+	fprintf(f, "  esize=%"PRIu32"\n", fi->esize);
+	fprintf(f, "  used=%u\n", rte_ring_fanin_count(fi));
+	fprintf(f, "  next=%"PRIu32"\n", fi->next);
+
+	for (i = 0; i != fi->nb_rings; i++) {
+		bits = rte_atomic_load_explicit(&fi->bitmap[i / FANIN_WORD_BITS],
+			rte_memory_order_relaxed);
+		fprintf(f, "  ring[%"PRIu32"]: used=%u quantum=%"PRIu32
+			" occupied=%u\n", i, rte_ring_count(fanin_ring(fi, i)),
+			fi->quantum[i],
+			(unsigned int)((bits >> (i % FANIN_WORD_BITS)) & 1));
+	}
+}
+
+static inline void
+fanin_mark(struct rte_ring_fanin *f, uint32_t idx)
+{
+	RTE_ATOMIC(uint64_t) *word = &f->bitmap[idx / FANIN_WORD_BITS];
+	uint64_t bit = RTE_BIT64(idx % FANIN_WORD_BITS);
+
+	/* order the ring tail update before the bit test */
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+	if ((rte_atomic_load_explicit(word, rte_memory_order_relaxed) &
+			bit) == 0)
+		rte_atomic_fetch_or_explicit(word, bit,
+			rte_memory_order_release);
+}
+
+static inline void
+fanin_clear(struct rte_ring_fanin *f, uint32_t idx)
+{
+	RTE_ATOMIC(uint64_t) *word = &f->bitmap[idx / FANIN_WORD_BITS];
+	uint64_t bit = RTE_BIT64(idx % FANIN_WORD_BITS);
+
+	rte_atomic_fetch_and_explicit(word, ~bit, rte_memory_order_relaxed);
+	/* order the bit clear before the ring test */
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+
+	/* the producer may have seen the bit still set */
+	if (rte_ring_count(fanin_ring(f, idx)) != 0)
+		rte_atomic_fetch_or_explicit(word, bit,
+			rte_memory_order_relaxed);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_enqueue_bulk, 25.07)
+uint32_t
+rte_ring_fanin_enqueue_bulk(struct rte_ring_fanin *f, uint32_t idx,
+	const void *objs, uint32_t n, uint32_t *free_space)
+{
+	n = rte_ring_sp_enqueue_bulk_elem(fanin_ring(f, idx), objs, f->esize,
+		n, free_space);
+	if (n != 0)
+		fanin_mark(f, idx);
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_enqueue_burst, 25.07)
+uint32_t
+rte_ring_fanin_enqueue_burst(struct rte_ring_fanin *f, uint32_t idx,
+	const void *objs, uint32_t n, uint32_t *free_space)
+{
+	n = rte_ring_sp_enqueue_burst_elem(fanin_ring(f, idx), objs, f->esize,
+		n, free_space);
+	if (n != 0)
+		fanin_mark(f, idx);
+	return n;
+}
+
+/* Visit each occupied ring once, from the ring after the last visited one. */
+static inline uint32_t
+fanin_dequeue_round(struct rte_ring_fanin *f, uint8_t *p, uint32_t n)
+{
+	uint32_t start, w, k, idx, last, got, num, avail;
+	uint64_t bits;
+
+	start = f->next;
+	w = start / FANIN_WORD_BITS;
+	last = UINT32_MAX;
+	num = 0;
+
+	/*
+	 * The word of the start position is visited twice: first its bits
+	 * from the start position, then at the end its bits before it.
+	 */
+	for (k = 0; k <= f->nb_words && num < n; k++) {
+		bits = rte_atomic_load_explicit(&f->bitmap[w],
+			rte_memory_order_acquire);
+		if (k == 0)
+			bits &= UINT64_MAX << (start % FANIN_WORD_BITS);
+		else if (k == f->nb_words)
+			bits &= ~(UINT64_MAX << (start % FANIN_WORD_BITS));
+
+		while (bits != 0 && num < n) {
+			idx = w * FANIN_WORD_BITS + rte_ctz64(bits);
+			bits &= bits - 1;
+
+			got = rte_ring_sc_dequeue_burst_elem(fanin_ring(f, idx),
+				p + (size_t)num * f->esize, f->esize,
+				RTE_MIN(n - num, f->quantum[idx]), &avail);
+			num += got;
+			last = idx;
+			if (avail == 0)
+				fanin_clear(f, idx);
+		}
+
+		w = (w + 1 == f->nb_words) ? 0 : w + 1;
+	}
+
+	if (last != UINT32_MAX)
+		f->next = (last + 1 == f->nb_rings) ? 0 : last + 1;
+
+	return num;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ring_fanin_dequeue_burst, 25.07)
+uint32_t
+rte_ring_fanin_dequeue_burst(struct rte_ring_fanin *f, void *objs,
+	uint32_t n)
+{
+	uint8_t *p = objs;
+	uint32_t got, num = 0;
+
+	do {
+		got = fanin_dequeue_round(f, p + (size_t)num * f->esize,
+			n - num);
+		num += got;
+	} while (num < n && got != 0);
+
+	return num;
+}
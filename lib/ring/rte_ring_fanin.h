@@ -0,0 +1,239 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_RING_FANIN_H_
+#define _RTE_RING_FANIN_H_
+
+/**
+ * @file
+ * This file contains definition of DPDK ring fan-in public API.
+ * Brief description:
+ * a fan-in bundles N single producer, single consumer rings behind one
+ * dequeue API, to aggregate objects from many producers to one consumer
+ * without the producers contending on a shared ring head.
+ * Each producer enqueues to its own ring, identified by its index.
+ * The consumer drains the rings in round-robin order, taking at most
+ * a quantum of objects from each ring at a time. The draining is fair when
+ * all rings have the same quantum, weighted otherwise.
+ * An occupancy bitmap, set by the producers and cleared by the consumer,
+ * lets the consumer skip the empty rings.
+ */
+
+#include <stdio.h>
+
+#include <rte_ring.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** default number of objects dequeued from a ring at each visit */
+#define RTE_RING_FANIN_QUANTUM_DEF	32
+
+struct rte_ring_fanin_param {
+	/** expected name of the fan-in */
+	const char *name;
+	/** number of rings, one per producer */
+	uint32_t nb_rings;
+	/** number of elements in each ring */
+	uint32_t elems;
+	/** size of elements, must be a multiple of 4 */
+	uint32_t elem_size;
+	/**
+	 * number of objects dequeued from a ring at each visit,
+	 * RTE_RING_FANIN_QUANTUM_DEF if 0
+	 */
+	uint32_t quantum;
+};
+
+struct rte_ring_fanin;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Calculate the memory size needed for a fan-in.
+ *
+ * @param prm
+ *   Pointer to the structure that contains fan-in creation parameters.
+ * @return
+ *   - The memory size needed for the fan-in on success.
+ *   - -EINVAL if provided parameter values are invalid.
+ */
+__rte_experimental
+ssize_t
+rte_ring_fanin_get_memsize(const struct rte_ring_fanin_param *prm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Initialize a fan-in structure.
+ *
+ * Initialize a fan-in structure in memory pointed by "f".
+ * The size of the memory area must be at least the size returned by
+ * @ref rte_ring_fanin_get_memsize(), and be cache line aligned.
+ *
+ * @param f
+ *   Pointer to the fan-in structure.
+ * @param prm
+ *   Pointer to the structure that contains fan-in creation parameters.
+ * @return
+ *   - 0 on success, or a negative error code.
+ */
+__rte_experimental
+int
+rte_ring_fanin_init(struct rte_ring_fanin *f,
+	const struct rte_ring_fanin_param *prm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the number of objects dequeued from a ring at each visit.
+ *
+ * This function must be called by the consumer, or when the fan-in
+ * is not used.
+ *
+ * @param f
+ *   A pointer to the fan-in structure.
+ * @param idx
+ *   Index of the ring.
+ * @param quantum
+ *   Number of objects, must not be 0.
+ * @return
+ *   - 0 on success, -EINVAL if a parameter is invalid.
+ */
+__rte_experimental
+int
+rte_ring_fanin_set_quantum(struct rte_ring_fanin *f, uint32_t idx,
+	uint32_t quantum);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the total number of entries in all the rings of a fan-in.
+ *
+ * @param f
+ *   A pointer to the fan-in structure.
+ * @return
+ *   The number of entries in the fan-in.
+ */
+__rte_experimental
+unsigned int
+rte_ring_fanin_count(const struct rte_ring_fanin *f);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dump the status of the fan-in.
+ *
+ * @param f
+ *   A pointer to a file for output
+ * @param fi
+ *   Pointer to the fan-in structure.
+ */
+__rte_experimental
+void
+rte_ring_fanin_dump(FILE *f, const struct rte_ring_fanin *fi);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue several objects on a ring of the fan-in.
+ * Enqueues exactly requested number of objects or none.
+ *
+ * Each ring must have a single producer at a time.
+ *
+ * @param f
+ *   A pointer to the fan-in structure.
+ * @param idx
+ *   Index of the ring of the producer.
+ * @param objs
+ *   A pointer to an array of objects to enqueue.
+ *   Size of objects to enqueue must be the same value as 'elem_size' parameter
+ *   used while creating the fan-in. Otherwise the results are undefined.
+ * @param n
+ *   The number of objects to add in the ring from the 'objs'.
+ * @param free_space
+ *   if non-NULL, returns the amount of space in the ring after the
+ *   enqueue operation has finished.
+ * @return
+ *   - Actual number of objects enqueued, either 0 or n.
+ */
+__rte_experimental
+uint32_t
+rte_ring_fanin_enqueue_bulk(struct rte_ring_fanin *f, uint32_t idx,
+	const void *objs, uint32_t n, uint32_t *free_space);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue several objects on a ring of the fan-in.
+ * Enqueues up to requested number of objects.
+ *
+ * Each ring must have a single producer at a time.
+ *
+ * @param f
+ *   A pointer to the fan-in structure.
+ * @param idx
+ *   Index of the ring of the producer.
+ * @param objs
+ *   A pointer to an array of objects to enqueue.
+ *   Size of objects to enqueue must be the same value as 'elem_size' parameter
+ *   used while creating the fan-in. Otherwise the results are undefined.
+ * @param n
+ *   The number of objects to add in the ring from the 'objs'.
+ * @param free_space
+ *   if non-NULL, returns the amount of space in the ring after the
+ *   enqueue operation has finished.
+ * @return
+ *   - Actual number of objects enqueued.
+ */
+__rte_experimental
+uint32_t
+rte_ring_fanin_enqueue_burst(struct rte_ring_fanin *f, uint32_t idx,
+	const void *objs, uint32_t n, uint32_t *free_space);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue several objects from the rings of the fan-in.
+ * Dequeues up to requested number of objects.
+ *
+ * The non-empty rings are visited in round-robin order, starting after
+ * the last ring visited by the previous call, until the requested number
+ * of objects is reached or all rings are empty. At most the quantum of
+ * a ring is dequeued from it at each visit.
+ * The objects of a ring keep their order, there is no order between
+ * the objects of different rings.
+ *
+ * The fan-in must have a single consumer at a time.
+ *
+ * @param f
+ *   A pointer to the fan-in structure.
+ * @param objs
+ *   A pointer to an array of objects to dequeue.
+ *   Size of objects to dequeue must be the same value as 'elem_size' parameter
+ *   used while creating the fan-in. Otherwise the results are undefined.
+ * @param n
+ *   The number of objects to dequeue from the fan-in into the 'objs'.
+ * @return
+ *   - Actual number of objects dequeued.
+ */
+__rte_experimental
+uint32_t
+rte_ring_fanin_dequeue_burst(struct rte_ring_fanin *f, void *objs,
+	uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RING_FANIN_H_ */
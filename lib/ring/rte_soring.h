@@ -607,6 +607,187 @@ void
 rte_soring_releasx(struct rte_soring *r, const void *objs,
 	const void *meta, uint32_t stage, uint32_t n, uint32_t ftoken);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire several objects from the soring for given stage,
+ * without copying them.
+ * Acquires exactly requested number of objects or none.
+ * Instead of copying the acquired objects into user arrays,
+ * return pointers to them within the soring, see struct rte_ring_zc_data.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param zcd
+ *   Structure filled with the pointers to the acquired objects
+ *   within the soring.
+ *   The objects can be read and updated in place till they are released.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   rte_soring_release_zc().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired, either 0 or 'num'.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquire_zc_bulk(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire several objects plus metadata from the soring for given stage,
+ * without copying them.
+ * Acquires exactly requested number of objects or none.
+ * Instead of copying the acquired objects and metadata into user arrays,
+ * return pointers to them within the soring, see struct rte_ring_zc_data.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param zcd
+ *   Structure filled with the pointers to the acquired objects
+ *   within the soring.
+ *   The objects can be read and updated in place till they are released.
+ * @param mzcd
+ *   Structure filled with the pointers to the metadata values of the
+ *   acquired objects within the soring.
+ *   The metadata values can be read and updated in place till the objects
+ *   are released.
+ *   Can be NULL only if user created the soring with 'meta_size' value
+ *   equals zero.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   rte_soring_release_zc().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired, either 0 or 'num'.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquirx_zc_bulk(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	struct rte_ring_zc_data *mzcd, uint32_t stage, uint32_t num,
+	uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire several objects from the soring for given stage,
+ * without copying them.
+ * Acquires up to requested number of objects.
+ * Instead of copying the acquired objects into user arrays,
+ * return pointers to them within the soring, see struct rte_ring_zc_data.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param zcd
+ *   Structure filled with the pointers to the acquired objects
+ *   within the soring.
+ *   The objects can be read and updated in place till they are released.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   rte_soring_release_zc().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquire_zc_burst(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire several objects plus metadata from the soring for given stage,
+ * without copying them.
+ * Acquires up to requested number of objects.
+ * Instead of copying the acquired objects and metadata into user arrays,
+ * return pointers to them within the soring, see struct rte_ring_zc_data.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param zcd
+ *   Structure filled with the pointers to the acquired objects
+ *   within the soring.
+ *   The objects can be read and updated in place till they are released.
+ * @param mzcd
+ *   Structure filled with the pointers to the metadata values of the
+ *   acquired objects within the soring.
+ *   The metadata values can be read and updated in place till the objects
+ *   are released.
+ *   Can be NULL only if user created the soring with 'meta_size' value
+ *   equals zero.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   rte_soring_release_zc().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquirx_zc_burst(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	struct rte_ring_zc_data *mzcd, uint32_t stage, uint32_t num,
+	uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Release several objects acquired with a zero-copy acquire for given stage
+ * back to the soring.
+ * The objects and metadata values updated in place become visible,
+ * along with the objects, to the next stage or dequeue.
+ * Same as rte_soring_release() with NULL objects.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param stage
+ *   Current stage.
+ * @param n
+ *   The number of objects to release.
+ *   Has to be the same value as returned by acquire() op.
+ * @param ftoken
+ *   Opaque 'token' value obtained from acquire() op.
+ */
+__rte_experimental
+void
+rte_soring_release_zc(struct rte_soring *r, uint32_t stage, uint32_t n,
+	uint32_t ftoken);
+
 #ifdef __cplusplus
 }
 #endif
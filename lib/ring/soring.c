@@ -377,29 +377,32 @@ acquire_state_update(const struct rte_soring *r, uint32_t stage, uint32_t idx,
 			rte_memory_order_relaxed);
 }
 
+/*
+ * Move the stage head and mark the acquired elems in the state ring.
+ * Returns the number of acquired elems and the old stage head.
+ */
 static __rte_always_inline uint32_t
-soring_acquire(struct rte_soring *r, void *objs, void *meta,
-	uint32_t stage, uint32_t num, enum rte_ring_queue_behavior behavior,
+soring_acquire_head(struct rte_soring *r, uint32_t stage, uint32_t num,
+	enum rte_ring_queue_behavior behavior, uint32_t *head,
 	uint32_t *ftoken, uint32_t *available)
 {
-	uint32_t avail, head, idx, n, next, reqn;
+	uint32_t avail, n, next, reqn;
 	struct soring_stage *pstg;
 	struct soring_stage_headtail *cons;
 
 	RTE_ASSERT(r != NULL && stage < r->nb_stage);
-	RTE_ASSERT(meta == NULL || r->meta != NULL);
 
 	cons = &r->stage[stage].sht;
 
 	if (stage == 0)
 		n = __rte_soring_stage_move_head(cons, &r->prod.ht, 0, num,
-			behavior, &head, &next, &avail);
+			behavior, head, &next, &avail);
 	else {
 		pstg = r->stage + stage - 1;
 
 		/* try to grab exactly @num elems */
 		n = __rte_soring_stage_move_head(cons, &pstg->ht, 0, num,
-			RTE_RING_QUEUE_FIXED, &head, &next, &avail);
+			RTE_RING_QUEUE_FIXED, head, &next, &avail);
 		if (n == 0) {
 			/* try to finalize some elems from previous stage */
 			n = __rte_soring_stage_finalize(&pstg->sht, stage - 1,
@@ -410,7 +413,7 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 			reqn = (behavior == RTE_RING_QUEUE_FIXED) ? num : 0;
 			if (avail >= reqn)
 				n = __rte_soring_stage_move_head(cons,
-					&pstg->ht, 0, num, behavior, &head,
+					&pstg->ht, 0, num, behavior, head,
 					&next, &avail);
 			else
 				n = 0;
@@ -418,12 +421,30 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 	}
 
 	if (n != 0) {
-
-		idx = head & r->mask;
-		*ftoken = SORING_FTKN_MAKE(head, stage);
+		*ftoken = SORING_FTKN_MAKE(*head, stage);
 
 		/* check and update state value */
-		acquire_state_update(r, stage, idx, *ftoken, n);
+		acquire_state_update(r, stage, *head & r->mask, *ftoken, n);
+	}
+
+	if (available != NULL)
+		*available = avail - n;
+	return n;
+}
+
+static __rte_always_inline uint32_t
+soring_acquire(struct rte_soring *r, void *objs, void *meta,
+	uint32_t stage, uint32_t num, enum rte_ring_queue_behavior behavior,
+	uint32_t *ftoken, uint32_t *available)
+{
+	uint32_t head, idx, n;
+
+	RTE_ASSERT(meta == NULL || r->meta != NULL);
+
+	n = soring_acquire_head(r, stage, num, behavior, &head, ftoken,
+			available);
+	if (n != 0) {
+		idx = head & r->mask;
 
 		/* copy elems that are ready for given stage */
 		__rte_ring_do_dequeue_elems(objs, &r[1], r->size, idx,
@@ -433,8 +454,46 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 				r->size, idx, r->msize, n);
 	}
 
-	if (available != NULL)
-		*available = avail - n;
+	return n;
+}
+
+/* get addresses of the elems at given index, in one or two parts */
+static __rte_always_inline void
+soring_get_elem_addr(void *base, uint32_t size, uint32_t idx, uint32_t esize,
+	uint32_t num, struct rte_ring_zc_data *zcd)
+{
+	zcd->ptr1 = RTE_PTR_ADD(base, (size_t)idx * esize);
+	if (idx + num <= size) {
+		zcd->n1 = num;
+		zcd->ptr2 = NULL;
+	} else {
+		zcd->n1 = size - idx;
+		zcd->ptr2 = base;
+	}
+}
+
+static __rte_always_inline uint32_t
+soring_acquire_zc(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	struct rte_ring_zc_data *mzcd, uint32_t stage, uint32_t num,
+	enum rte_ring_queue_behavior behavior, uint32_t *ftoken,
+	uint32_t *available)
+{
+	uint32_t head, idx, n;
+
+	RTE_ASSERT(mzcd == NULL || r->meta != NULL);
+
+	n = soring_acquire_head(r, stage, num, behavior, &head, ftoken,
+			available);
+	if (n != 0) {
+		idx = head & r->mask;
+
+		/* point to elems that are ready for given stage */
+		soring_get_elem_addr(&r[1], r->size, idx, r->esize, n, zcd);
+		if (mzcd != NULL)
+			soring_get_elem_addr(r->meta, r->size, idx, r->msize,
+				n, mzcd);
+	}
+
 	return n;
 }
 
@@ -616,6 +675,52 @@ rte_soring_acquirx_burst(struct rte_soring *r, void *objs, void *meta,
 			RTE_RING_QUEUE_VARIABLE, ftoken, available);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_acquire_zc_bulk, 25.07)
+uint32_t
+rte_soring_acquire_zc_bulk(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire_zc(r, zcd, NULL, stage, num,
+			RTE_RING_QUEUE_FIXED, ftoken, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_acquirx_zc_bulk, 25.07)
+uint32_t
+rte_soring_acquirx_zc_bulk(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	struct rte_ring_zc_data *mzcd, uint32_t stage, uint32_t num,
+	uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire_zc(r, zcd, mzcd, stage, num,
+			RTE_RING_QUEUE_FIXED, ftoken, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_acquire_zc_burst, 25.07)
+uint32_t
+rte_soring_acquire_zc_burst(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire_zc(r, zcd, NULL, stage, num,
+			RTE_RING_QUEUE_VARIABLE, ftoken, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_acquirx_zc_burst, 25.07)
+uint32_t
+rte_soring_acquirx_zc_burst(struct rte_soring *r, struct rte_ring_zc_data *zcd,
+	struct rte_ring_zc_data *mzcd, uint32_t stage, uint32_t num,
+	uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire_zc(r, zcd, mzcd, stage, num,
+			RTE_RING_QUEUE_VARIABLE, ftoken, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_release_zc, 25.07)
+void
+rte_soring_release_zc(struct rte_soring *r, uint32_t stage, uint32_t n,
+	uint32_t ftoken)
+{
+	soring_release(r, NULL, NULL, stage, n, ftoken);
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_count, 25.03)
 unsigned int
 rte_soring_count(const struct rte_soring *r)
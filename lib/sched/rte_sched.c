@@ -226,6 +226,7 @@ struct __rte_cache_aligned rte_sched_port {
 	uint32_t mtu;
 	uint32_t frame_overhead;
 	int socket;
+	uint32_t n_lanes;             /* Lanes created on the port */
 
 	/* Timing */
 	uint64_t time_cpu_cycles;     /* Current CPU time measured in CPU cycles */
@@ -238,6 +239,8 @@ struct __rte_cache_aligned rte_sched_port {
 	struct rte_mbuf **pkts_out;
 	uint32_t n_pkts_out;
 	uint32_t subport_id;
+	uint32_t subport_begin;       /* First subport served by dequeue */
+	uint32_t subport_end;         /* Last subport served by dequeue + 1 */
 
 	/* Large data structures */
 	struct rte_sched_subport_profile *subport_profiles;
@@ -1015,6 +1018,8 @@ rte_sched_port_config(struct rte_sched_port_params *params)
 	port->pkts_out = NULL;
 	port->n_pkts_out = 0;
 	port->subport_id = 0;
+	port->subport_begin = 0;
+	port->subport_end = port->n_subports_per_port;
 
 	return port;
 }
@@ -1211,6 +1216,13 @@ rte_sched_subport_config(struct rte_sched_port *port,
 		return 0;
 	}
 
+	/* The lanes have a copy of the subport array */
+	if (port->n_lanes != 0) {
+		SCHED_LOG(ERR,
+			"%s: Port has lanes, cannot configure subport", __func__);
+		return -EBUSY;
+	}
+
 	if (subport_id >= port->n_subports_per_port) {
 		SCHED_LOG(ERR,
 			"%s: Incorrect value for subport id", __func__);
@@ -1527,6 +1539,12 @@ rte_sched_subport_pipe_profile_add(struct rte_sched_port *port,
 		return -EINVAL;
 	}
 
+	if (port->n_lanes != 0) {
+		SCHED_LOG(ERR,
+			"%s: Port has lanes, cannot add pipe profile", __func__);
+		return -EBUSY;
+	}
+
 	/* Subport id not exceeds the max limit */
 	if (subport_id > port->n_subports_per_port) {
 		SCHED_LOG(ERR,
@@ -1604,6 +1622,13 @@ rte_sched_port_subport_profile_add(struct rte_sched_port *port,
 		return -EINVAL;
 	}
 
+	/* The lanes have a copy of the number of subport profiles */
+	if (port->n_lanes != 0) {
+		SCHED_LOG(ERR, "%s: "
+		"Port has lanes, cannot add subport profile", __func__);
+		return -EBUSY;
+	}
+
 	dst = port->subport_profiles + port->n_subport_profiles;
 
 	/* Subport profiles exceeds the max limit */
@@ -2948,7 +2973,7 @@ rte_sched_port_time_resync(struct rte_sched_port *port)
 		port->time = port->time_cpu_bytes;
 
 	/* Reset pipe loop detection */
-	for (i = 0; i < port->n_subports_per_port; i++)
+	for (i = port->subport_begin; i < port->subport_end; i++)
 		port->subports[i]->pipe_loop = RTE_SCHED_PIPE_INVALID;
 }
 
@@ -2973,6 +2998,7 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 {
 	struct rte_sched_subport *subport;
 	uint32_t subport_id = port->subport_id;
+	uint32_t n_subports_dequeue = port->subport_end - port->subport_begin;
 	uint32_t i, n_subports = 0, count;
 
 	port->pkts_out = pkts;
@@ -2990,8 +3016,8 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 		if (count == n_pkts) {
 			subport_id++;
 
-			if (subport_id == port->n_subports_per_port)
-				subport_id = 0;
+			if (subport_id == port->subport_end)
+				subport_id = port->subport_begin;
 
 			port->subport_id = subport_id;
 			break;
@@ -3003,10 +3029,10 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 			n_subports++;
 		}
 
-		if (subport_id == port->n_subports_per_port)
-			subport_id = 0;
+		if (subport_id == port->subport_end)
+			subport_id = port->subport_begin;
 
-		if (n_subports == port->n_subports_per_port) {
+		if (n_subports == n_subports_dequeue) {
 			port->subport_id = subport_id;
 			break;
 		}
@@ -3015,4 +3041,127 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 	return count;
 }
 
+/*
+ * A lane is a copy of the port header, including the subport pointer
+ * array, with the dequeue restricted to a range of subports. The enqueue
+ * path finds the subport of a packet exactly as for the parent port, while
+ * the timing and grinder output state that the dequeue path updates for
+ * every packet is private to the lane.
+ */
+struct rte_sched_lane {
+	struct rte_sched_port *port;
+	struct rte_sched_port *parent;
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_lane_create, 25.07)
+struct rte_sched_lane *
+rte_sched_lane_create(struct rte_sched_port *port, uint32_t subport_id,
+	uint32_t n_subports)
+{
+	struct rte_sched_lane *lane;
+	uint32_t size0, size1, size2;
+	uint32_t i;
+
+	/* Check user parameters */
+	if (port == NULL) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for parameter port", __func__);
+		return NULL;
+	}
+
+	if (n_subports == 0 || subport_id >= port->n_subports_per_port ||
+	    n_subports > port->n_subports_per_port - subport_id) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect subport range", __func__);
+		return NULL;
+	}
+
+	for (i = subport_id; i < subport_id + n_subports; i++) {
+		if (port->subports[i] == NULL) {
+			SCHED_LOG(ERR,
+				"%s: Subport %u is not configured", __func__, i);
+			return NULL;
+		}
+	}
+
+	size0 = RTE_CACHE_LINE_ROUNDUP(sizeof(struct rte_sched_lane));
+	size1 = sizeof(struct rte_sched_port);
+	size2 = port->n_subports_per_port * sizeof(struct rte_sched_subport *);
+
+	lane = rte_zmalloc_socket("qos_lane", size0 + size1 + size2,
+				 RTE_CACHE_LINE_SIZE, port->socket);
+	if (lane == NULL) {
+		SCHED_LOG(ERR, "%s: Memory allocation fails", __func__);
+		return NULL;
+	}
+
+	lane->port = (struct rte_sched_port *)((uint8_t *)lane + size0);
+
+	/*
+	 * Start from the current port time, which the credits of the
+	 * subports and pipes are relative to.
+	 */
+	memcpy(lane->port, port, size1 + size2);
+
+	/* Grinders */
+	lane->port->pkts_out = NULL;
+	lane->port->n_pkts_out = 0;
+	lane->port->subport_id = subport_id;
+	lane->port->subport_begin = subport_id;
+	lane->port->subport_end = subport_id + n_subports;
+	lane->port->n_lanes = 0;
+
+	/* The copy would miss the later changes of the subport config */
+	lane->parent = port;
+	port->n_lanes++;
+
+	return lane;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_lane_free, 25.07)
+void
+rte_sched_lane_free(struct rte_sched_lane *lane)
+{
+	if (lane == NULL)
+		return;
+
+	/* The subports and their queued packets belong to the parent port */
+	lane->parent->n_lanes--;
+	rte_free(lane);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_lane_enqueue, 25.07)
+int
+rte_sched_lane_enqueue(struct rte_sched_lane *lane, struct rte_mbuf **pkts,
+	uint32_t n_pkts)
+{
+	struct rte_sched_port *port = lane->port;
+	uint32_t subport_id, i, n = 0;
+
+	/*
+	 * A packet of another subport would race with the lane owning it,
+	 * drop it as the port drops the packets of a full queue.
+	 */
+	for (i = 0; i < n_pkts; i++) {
+		subport_id = rte_mbuf_sched_queue_get(pkts[i]) >>
+			(port->n_pipes_per_subport_log2 + 4);
+		if (unlikely(subport_id < port->subport_begin ||
+				subport_id >= port->subport_end)) {
+			rte_pktmbuf_free(pkts[i]);
+			continue;
+		}
+		pkts[n++] = pkts[i];
+	}
+
+	return rte_sched_port_enqueue(port, pkts, n);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_lane_dequeue, 25.07)
+int
+rte_sched_lane_dequeue(struct rte_sched_lane *lane, struct rte_mbuf **pkts,
+	uint32_t n_pkts)
+{
+	return rte_sched_port_dequeue(lane->port, pkts, n_pkts);
+}
+
 RTE_LOG_REGISTER_DEFAULT(sched_logtype, INFO);
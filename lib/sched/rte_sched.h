@@ -577,6 +577,103 @@ rte_sched_port_enqueue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 int
 rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint32_t n_pkts);
 
+/** Subset of the subports of a port scheduler, see rte_sched_lane_create(). */
+struct rte_sched_lane;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Hierarchical scheduler lane creation. A lane gives one lcore exclusive
+ * ownership of a contiguous range of subports of the port: enqueue and
+ * dequeue on the lane only touch these subports and the lane private
+ * timing state, so that lanes owning disjoint subport ranges can run
+ * concurrently on different lcores. The packets dequeued by the lanes of
+ * a port are typically merged before TX through one single-producer
+ * single-consumer ring per lane.
+ *
+ * Each lane keeps its own view of the port time, hence the port rate is
+ * not shared between lanes: the subport rates should be configured so
+ * that their sum does not exceed the port rate. Once lanes are created,
+ * rte_sched_port_enqueue() and rte_sched_port_dequeue() must not be used
+ * on the parent port, and rte_sched_subport_config(),
+ * rte_sched_subport_pipe_profile_add() and
+ * rte_sched_port_subport_profile_add() fail with -EBUSY until all lanes
+ * of the port are freed.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param subport_id
+ *   First subport of the lane
+ * @param n_subports
+ *   Number of subports of the lane. All of them must be configured.
+ * @return
+ *   Handle to lane instance upon success or NULL otherwise.
+ */
+__rte_experimental
+struct rte_sched_lane *
+rte_sched_lane_create(struct rte_sched_port *port, uint32_t subport_id,
+	uint32_t n_subports);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Hierarchical scheduler lane free. The packets queued in the subports
+ * of the lane stay in the port and are freed by rte_sched_port_free(),
+ * which must be called after all lanes of the port are freed.
+ *
+ * @param lane
+ *   Handle to lane instance. If lane is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_sched_lane_free(struct rte_sched_lane *lane);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Hierarchical scheduler lane enqueue. Same as rte_sched_port_enqueue(),
+ * except that all packets must belong to the subports of the lane:
+ * the other packets are dropped. The pkts array is modified.
+ *
+ * @param lane
+ *   Handle to lane instance
+ * @param pkts
+ *   Array storing the packet descriptor handles
+ * @param n_pkts
+ *   Number of packets to enqueue from the pkts array into the lane
+ * @return
+ *   Number of packets successfully enqueued
+ */
+__rte_experimental
+int
+rte_sched_lane_enqueue(struct rte_sched_lane *lane, struct rte_mbuf **pkts,
+	uint32_t n_pkts);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Hierarchical scheduler lane dequeue. Same as rte_sched_port_dequeue(),
+ * except that only the subports of the lane are scheduled.
+ *
+ * @param lane
+ *   Handle to lane instance
+ * @param pkts
+ *   Pre-allocated packet descriptor array where the packets dequeued
+ *   from the lane should be stored
+ * @param n_pkts
+ *   Number of packets to dequeue from the lane
+ * @return
+ *   Number of packets successfully dequeued and placed in the pkts array
+ */
+__rte_experimental
+int
+rte_sched_lane_dequeue(struct rte_sched_lane *lane, struct rte_mbuf **pkts,
+	uint32_t n_pkts);
+
 /**
  * Hierarchical scheduler subport traffic class
  * oversubscription enable/disable.